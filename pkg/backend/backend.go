@@ -18,6 +18,7 @@ import (
 	"context"
 	"fmt"
 	"strings"
+	"sync"
 	"time"
 
 	"github.com/pkg/errors"
@@ -26,7 +27,6 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/engine"
 	"github.com/pulumi/pulumi/pkg/v3/operations"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
-	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
 	"github.com/pulumi/pulumi/pkg/v3/secrets"
 	"github.com/pulumi/pulumi/pkg/v3/util/cancel"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
@@ -206,6 +206,19 @@ type SpecificDeploymentExporter interface {
 	ExportDeploymentForVersion(ctx context.Context, stack Stack, version string) (*apitype.UntypedDeployment, error)
 }
 
+// StackOutputsReader is an interface defining an additional capability of a Backend, specifically the ability to
+// read the outputs of a stack without loading its entire deployment. This isn't a requirement for all backends and
+// should be checked for dynamically.
+type StackOutputsReader interface {
+	// GetStackOutputsVersion returns the version of the given stack's latest checkpoint, or "" if the stack does
+	// not exist. The meaning of the version is backend-specific, but it changes whenever the stack's outputs might
+	// have changed and is much cheaper to get than the outputs themselves.
+	GetStackOutputsVersion(ctx context.Context, stackRef StackReference) (string, error)
+	// ReadStackOutputs returns the outputs of the given stack's root resource along with the version of the
+	// checkpoint that they were read from. The outputs are nil if the stack does not exist.
+	ReadStackOutputs(ctx context.Context, stackRef StackReference) (resource.PropertyMap, string, error)
+}
+
 // UpdateOperation is a complete stack update operation (preview, update, import, refresh, or destroy).
 type UpdateOperation struct {
 	Proj               *workspace.Project
@@ -269,17 +282,32 @@ type CancellationScopeSource interface {
 	NewScope(events chan<- engine.Event, isPreview bool) CancellationScope
 }
 
-// NewBackendClient returns a deploy.BackendClient that wraps the given Backend.
+// NewBackendClient returns a deploy.BackendClient that wraps the given Backend. A client is meant to be used for a
+// single update: if the backend is a StackOutputsReader, the client remembers the outputs of each stack that it
+// reads for as long as the stack's checkpoint version does not change.
 func NewBackendClient(backend Backend) deploy.BackendClient {
 	return &backendClient{backend: backend}
 }
 
 type backendClient struct {
 	backend Backend
+
+	outputsLock sync.Mutex
+	outputs     map[stackOutputsKey]resource.PropertyMap // the outputs read by this client.
+}
+
+// stackOutputsKey identifies the outputs of a particular version of a stack.
+type stackOutputsKey struct {
+	name    string
+	version string
 }
 
 // GetStackOutputs returns the outputs of the stack with the given name.
 func (c *backendClient) GetStackOutputs(ctx context.Context, name string) (resource.PropertyMap, error) {
+	if reader, ok := c.backend.(StackOutputsReader); ok {
+		return c.readStackOutputs(ctx, reader, name)
+	}
+
 	ref, err := c.backend.ParseStackReference(name)
 	if err != nil {
 		return nil, err
@@ -291,18 +319,56 @@ func (c *backendClient) GetStackOutputs(ctx context.Context, name string) (resou
 	if s == nil {
 		return nil, errors.Errorf("unknown stack %q", name)
 	}
-	snap, err := s.Snapshot(ctx)
+	snap, err := GetLazySnapshot(ctx, s)
 	if err != nil {
 		return nil, err
 	}
-	res, err := stack.GetRootStackResource(snap)
-	if err != nil {
-		return nil, errors.Wrap(err, "getting root stack resources")
-	}
+	res := snap.RootStackResource()
 	if res == nil {
 		return resource.PropertyMap{}, nil
 	}
-	return res.Outputs, nil
+	return res.Outputs()
+}
+
+// readStackOutputs returns the outputs of the stack with the given name using the backend's outputs-only read path.
+// The outputs of each version of a stack are only read once.
+func (c *backendClient) readStackOutputs(ctx context.Context, reader StackOutputsReader,
+	name string) (resource.PropertyMap, error) {
+
+	ref, err := c.backend.ParseStackReference(name)
+	if err != nil {
+		return nil, err
+	}
+	version, err := reader.GetStackOutputsVersion(ctx, ref)
+	if err != nil {
+		return nil, err
+	}
+	if version == "" {
+		return nil, errors.Errorf("unknown stack %q", name)
+	}
+
+	c.outputsLock.Lock()
+	outputs, ok := c.outputs[stackOutputsKey{name: name, version: version}]
+	c.outputsLock.Unlock()
+	if ok {
+		return outputs.Copy(), nil
+	}
+
+	outputs, version, err = reader.ReadStackOutputs(ctx, ref)
+	if err != nil {
+		return nil, err
+	}
+	if outputs == nil {
+		return nil, errors.Errorf("unknown stack %q", name)
+	}
+
+	c.outputsLock.Lock()
+	if c.outputs == nil {
+		c.outputs = make(map[stackOutputsKey]resource.PropertyMap)
+	}
+	c.outputs[stackOutputsKey{name: name, version: version}] = outputs
+	c.outputsLock.Unlock()
+	return outputs.Copy(), nil
 }
 
 func (c *backendClient) GetStackResourceOutputs(
@@ -318,9 +384,9 @@ func (c *backendClient) GetStackResourceOutputs(
 	if s == nil {
 		return nil, errors.Errorf("unknown stack %q", name)
 	}
-	snap, err := s.Snapshot(ctx)
-	if err != nil {
-		return nil, err
+	snap, err := GetLazySnapshot(ctx, s)
+	if err != nil || snap == nil {
+		return resource.PropertyMap{}, err
 	}
 	pm := resource.PropertyMap{}
 	for _, r := range snap.Resources {
@@ -328,9 +394,13 @@ func (c *backendClient) GetStackResourceOutputs(
 			continue
 		}
 
+		outputs, err := r.Outputs()
+		if err != nil {
+			return nil, err
+		}
 		resc := resource.PropertyMap{
 			resource.PropertyKey("type"):    resource.NewStringProperty(string(r.Type)),
-			resource.PropertyKey("outputs"): resource.NewObjectProperty(r.Outputs)}
+			resource.PropertyKey("outputs"): resource.NewObjectProperty(outputs)}
 		pm[resource.PropertyKey(r.URN)] = resource.NewObjectProperty(resc)
 	}
 	return pm, nil
@@ -96,6 +96,57 @@ func TestGetStackResourceOutputs(t *testing.T) {
 	assert.False(t, exists)
 }
 
+// outputsReaderBackend is a mock backend that reads stack outputs without loading snapshots.
+type outputsReaderBackend struct {
+	MockBackend
+
+	version string
+	reads   int
+}
+
+func (b *outputsReaderBackend) GetStackOutputsVersion(ctx context.Context, ref StackReference) (string, error) {
+	return b.version, nil
+}
+
+func (b *outputsReaderBackend) ReadStackOutputs(ctx context.Context,
+	ref StackReference) (resource.PropertyMap, string, error) {
+
+	b.reads++
+	return resource.PropertyMap{"version": resource.NewStringProperty(b.version)}, b.version, nil
+}
+
+func TestGetStackOutputsMemoizesByVersion(t *testing.T) {
+	be := &outputsReaderBackend{
+		MockBackend: MockBackend{
+			ParseStackReferenceF: func(s string) (StackReference, error) {
+				return nil, nil
+			},
+		},
+		version: "1",
+	}
+	client := NewBackendClient(be)
+
+	// Repeated reads of the same version of a stack are served by the client.
+	for i := 0; i < 3; i++ {
+		outs, err := client.GetStackOutputs(context.Background(), "fakeStack")
+		assert.NoError(t, err)
+		assert.Equal(t, "1", outs["version"].StringValue())
+	}
+	assert.Equal(t, 1, be.reads)
+
+	// A new version of the stack is read again.
+	be.version = "2"
+	outs, err := client.GetStackOutputs(context.Background(), "fakeStack")
+	assert.NoError(t, err)
+	assert.Equal(t, "2", outs["version"].StringValue())
+	assert.Equal(t, 2, be.reads)
+
+	// Stacks that don't exist are reported as such.
+	be.version = ""
+	_, err = client.GetStackOutputs(context.Background(), "fakeStack")
+	assert.Error(t, err)
+}
+
 //
 // Helpers.
 //
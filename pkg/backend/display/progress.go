@@ -32,6 +32,7 @@ import (
 
 	"github.com/pulumi/pulumi/pkg/v3/engine"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/util/metrics"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag/colors"
@@ -164,8 +165,16 @@ type ProgressDisplay struct {
 	// Cache of lines we've already printed.  We don't print a progress message again if it hasn't
 	// changed between the last time we printed and now.
 	printedProgressCache map[string]Progress
+
+	// Whether or not the display has changed since it was last refreshed. In a terminal, we refresh at
+	// most once per frame rather than once per event, so that large updates don't spend all their time
+	// redrawing the display.
+	needsRefresh bool
 }
 
+// framesPerSecond is the maximum number of times per second that the display is refreshed in a terminal.
+const framesPerSecond = 10
+
 var (
 	// policyPayloads is a collection of policy violation events for a single resource.
 	policyPayloads []engine.PolicyViolationEventPayload
@@ -459,11 +468,13 @@ func (display *ProgressDisplay) updateTerminalDimensions() {
 	}
 }
 
+// treeNode is a row in the tree view of the display. A node's columns are only rendered if the node is visible in
+// the terminal.
 type treeNode struct {
 	row Row
 
-	colorizedColumns []string
-	colorizedSuffix  string
+	// prefix is the tree indentation that is prepended to the node's type column.
+	prefix string
 
 	childNodes []*treeNode
 }
@@ -476,11 +487,7 @@ func (display *ProgressDisplay) getOrCreateTreeNode(
 		return node
 	}
 
-	node = &treeNode{
-		row:              row,
-		colorizedColumns: row.ColorizedColumns(),
-		colorizedSuffix:  row.ColorizedSuffix(),
-	}
+	node = &treeNode{row: row}
 
 	urnToTreeNode[urn] = node
 
@@ -515,10 +522,7 @@ func (display *ProgressDisplay) getOrCreateTreeNode(
 func (display *ProgressDisplay) generateTreeNodes() []*treeNode {
 	result := []*treeNode{}
 
-	result = append(result, &treeNode{
-		row:              display.headerRow,
-		colorizedColumns: display.headerRow.ColorizedColumns(),
-	})
+	result = append(result, &treeNode{row: display.headerRow})
 
 	urnToTreeNode := make(map[resource.URN]*treeNode)
 	for urn, row := range display.eventUrnToResourceRow {
@@ -549,30 +553,39 @@ func (display *ProgressDisplay) addIndentations(treeNodes []*treeNode, isRoot bo
 			}
 		}
 
-		node.colorizedColumns[typeColumn] = prefix + node.colorizedColumns[typeColumn]
+		node.prefix = prefix
 		display.addIndentations(node.childNodes, false /*isRoot*/, nestedIndentation)
 	}
 }
 
+// flattenNodes appends the given nodes and their descendants to the given list in display order.
+func flattenNodes(nodes []*treeNode, result *[]*treeNode) {
+	for _, node := range nodes {
+		*result = append(*result, node)
+		flattenNodes(node.childNodes, result)
+	}
+}
+
 func (display *ProgressDisplay) convertNodesToRows(
 	nodes []*treeNode, maxSuffixLength int, rows *[][]string, maxColumnLengths *[]int) {
 
 	for _, node := range nodes {
+		nodeColumns := node.row.ColorizedColumns()
 		if len(*maxColumnLengths) == 0 {
-			*maxColumnLengths = make([]int, len(node.colorizedColumns))
+			*maxColumnLengths = make([]int, len(nodeColumns))
 		}
 
-		colorizedColumns := make([]string, len(node.colorizedColumns))
-		uncolorisedColumns := display.uncolorizeColumns(node.colorizedColumns)
+		colorizedColumns := make([]string, len(nodeColumns))
+		copy(colorizedColumns, nodeColumns)
+		colorizedColumns[typeColumn] = node.prefix + colorizedColumns[typeColumn]
+		uncolorisedColumns := display.uncolorizeColumns(colorizedColumns)
 
-		for i, colorizedColumn := range node.colorizedColumns {
+		for i := range colorizedColumns {
 			columnWidth := utf8.RuneCountInString(uncolorisedColumns[i])
 
 			if i == display.suffixColumn {
 				columnWidth += maxSuffixLength
-				colorizedColumns[i] = colorizedColumn + node.colorizedSuffix
-			} else {
-				colorizedColumns[i] = colorizedColumn
+				colorizedColumns[i] += node.row.ColorizedSuffix()
 			}
 
 			if columnWidth > (*maxColumnLengths)[i] {
@@ -581,9 +594,20 @@ func (display *ProgressDisplay) convertNodesToRows(
 		}
 
 		*rows = append(*rows, colorizedColumns)
+	}
+}
 
-		display.convertNodesToRows(node.childNodes, maxSuffixLength, rows, maxColumnLengths)
+// firstVisibleLine returns the index of the first of the given number of lines that is still visible in a terminal
+// of the given height. Lines above it have scrolled out of the terminal and can no longer be redrawn. The last line
+// of the terminal holds the cursor. If the terminal's height is unknown, every line is considered visible.
+func firstVisibleLine(lines, terminalHeight int) int {
+	if terminalHeight <= 0 {
+		return 0
 	}
+	if first := lines - (terminalHeight - 1); first > 0 {
+		return first
+	}
+	return 0
 }
 
 type sortable []*treeNode
@@ -628,8 +652,13 @@ func (display *ProgressDisplay) filterOutUnnecessaryNodesAndSetDisplayTimes(node
 	return result
 }
 
+// refreshAllRowsIfInTerminal redraws the display if we're in a terminal. Only the rows that are still visible in the
+// terminal are rendered, and of those only the ones that have changed are written out, so the cost of rendering is
+// bounded by the height of the terminal rather than by the number of resources in the update.
 func (display *ProgressDisplay) refreshAllRowsIfInTerminal() {
 	if display.isTerminal && display.headerRow != nil {
+		display.needsRefresh = false
+
 		// make sure our stored dimension info is up to date
 		display.updateTerminalDimensions()
 
@@ -638,6 +667,34 @@ func (display *ProgressDisplay) refreshAllRowsIfInTerminal() {
 		sortNodes(rootNodes)
 		display.addIndentations(rootNodes, true /*isRoot*/, "")
 
+		var nodes []*treeNode
+		flattenNodes(rootNodes, &nodes)
+
+		// Gather the system messages that follow the rows.
+		var systemLines []string
+		for _, payload := range display.systemEventPayloads {
+			msg := payload.Color.Colorize(payload.Message)
+			lines := splitIntoDisplayableLines(msg)
+
+			if len(lines) == 0 {
+				continue
+			}
+
+			if len(systemLines) == 0 {
+				systemLines = append(systemLines, " ", colors.Yellow+"System Messages"+colors.Reset)
+			}
+			for _, line := range lines {
+				systemLines = append(systemLines, fmt.Sprintf("  %s", line))
+			}
+		}
+
+		// Skip any lines that have scrolled out of the terminal.
+		firstLine := firstVisibleLine(len(nodes)+len(systemLines), display.terminalHeight)
+		firstRow := firstLine
+		if firstRow > len(nodes) {
+			firstRow = len(nodes)
+		}
+
 		maxSuffixLength := 0
 		for _, v := range display.suffixesArray {
 			runeCount := utf8.RuneCountInString(v)
@@ -648,46 +705,31 @@ func (display *ProgressDisplay) refreshAllRowsIfInTerminal() {
 
 		var rows [][]string
 		var maxColumnLengths []int
-		display.convertNodesToRows(rootNodes, maxSuffixLength, &rows, &maxColumnLengths)
+		display.convertNodesToRows(nodes[firstRow:], maxSuffixLength, &rows, &maxColumnLengths)
 
-		removeInfoColumnIfUnneeded(rows)
+		// The header is only visible if every row is.
+		if firstRow == 0 {
+			removeInfoColumnIfUnneeded(rows)
+		}
 
 		for i, row := range rows {
-			display.refreshColumns(fmt.Sprintf("%v", i), row, maxColumnLengths)
+			display.refreshColumns(fmt.Sprintf("%v", firstRow+i), row, maxColumnLengths)
 		}
 
-		systemID := len(rows)
-
-		printedHeader := false
-		for _, payload := range display.systemEventPayloads {
-			msg := payload.Color.Colorize(payload.Message)
-			lines := splitIntoDisplayableLines(msg)
-
-			if len(lines) == 0 {
-				continue
-			}
-
-			if !printedHeader {
-				printedHeader = true
-				display.colorizeAndWriteProgress(makeActionProgress(
-					fmt.Sprintf("%v", systemID), " "))
-				systemID++
-
-				display.colorizeAndWriteProgress(makeActionProgress(
-					fmt.Sprintf("%v", systemID),
-					colors.Yellow+"System Messages"+colors.Reset))
-				systemID++
-			}
-
-			for _, line := range lines {
-				display.colorizeAndWriteProgress(makeActionProgress(
-					fmt.Sprintf("%v", systemID), fmt.Sprintf("  %s", line)))
-				systemID++
+		for i, line := range systemLines {
+			if id := len(nodes) + i; id >= firstLine {
+				display.colorizeAndWriteProgress(makeActionProgress(fmt.Sprintf("%v", id), line))
 			}
 		}
 	}
 }
 
+// markNeedsRefresh records that the display has changed. In a terminal, the display will be refreshed at the next
+// frame.
+func (display *ProgressDisplay) markNeedsRefresh() {
+	display.needsRefresh = true
+}
+
 func removeInfoColumnIfUnneeded(rows [][]string) {
 	// If there have been no info messages, then don't print out the info column header.
 	for i := 1; i < len(rows); i++ {
@@ -1131,8 +1173,8 @@ func (display *ProgressDisplay) processNormalEvent(event engine.Event) {
 	}
 
 	if display.isTerminal {
-		// if we're in a terminal, then refresh everything so that all our columns line up
-		display.refreshAllRowsIfInTerminal()
+		// if we're in a terminal, then refresh everything at the next frame so that all our columns line up
+		display.markNeedsRefresh()
 	} else {
 		// otherwise, just print out this single row.
 		display.refreshSingleRow("", row, nil)
@@ -1146,9 +1188,9 @@ func (display *ProgressDisplay) handleSystemEvent(payload engine.StdoutEventPayl
 	display.systemEventPayloads = append(display.systemEventPayloads, payload)
 
 	if display.isTerminal {
-		// if we're in a terminal, then refresh everything.  The system events will come after
-		// all the normal rows
-		display.refreshAllRowsIfInTerminal()
+		// if we're in a terminal, then refresh everything at the next frame.  The system events
+		// will come after all the normal rows
+		display.markNeedsRefresh()
 	} else {
 		// otherwise, in a non-terminal, just print out the actual event.
 		display.writeSimpleMessage(renderStdoutColorEvent(payload, display.opts))
@@ -1186,11 +1228,28 @@ func (display *ProgressDisplay) processEvents(ticker *time.Ticker, events <-chan
 	// Main processing loop.  The purpose of this func is to read in events from the engine
 	// and translate them into Status objects and progress messages to be presented to the
 	// command line.
+	//
+	// In a terminal, events only mark the display as needing a refresh; the display itself
+	// is redrawn at most once per frame.
+	var frames <-chan time.Time
+	if display.isTerminal {
+		frameTicker := time.NewTicker(time.Second / framesPerSecond)
+		defer frameTicker.Stop()
+		frames = frameTicker.C
+	}
+
 	for {
 		select {
 		case <-ticker.C:
 			display.processTick()
 
+		case <-frames:
+			if display.needsRefresh {
+				start := metrics.Now()
+				display.refreshAllRowsIfInTerminal()
+				metrics.ObserveSince("display.refresh", "", start)
+			}
+
 		case event := <-events:
 			if event.Type == "" || event.Type == engine.CancelEvent {
 				// Engine finished sending events.  Do all the final processing and return
@@ -1200,7 +1259,9 @@ func (display *ProgressDisplay) processEvents(ticker *time.Ticker, events <-chan
 				return
 			}
 
+			start := metrics.Now()
 			display.processNormalEvent(event)
+			metrics.ObserveSince("display.event", string(event.Type), start)
 		}
 	}
 }
@@ -0,0 +1,34 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package display
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func TestFirstVisibleLine(t *testing.T) {
+	// Everything is visible if it fits above the cursor line.
+	assert.Equal(t, 0, firstVisibleLine(0, 24))
+	assert.Equal(t, 0, firstVisibleLine(23, 24))
+
+	// Otherwise, only the last lines are visible.
+	assert.Equal(t, 1, firstVisibleLine(24, 24))
+	assert.Equal(t, 9977, firstVisibleLine(10000, 24))
+
+	// If the terminal's height is unknown, everything is visible.
+	assert.Equal(t, 0, firstVisibleLine(10000, 0))
+}
@@ -318,14 +318,16 @@ func (b *localBackend) CreateStack(ctx context.Context, stackRef backend.StackRe
 
 func (b *localBackend) GetStack(ctx context.Context, stackRef backend.StackReference) (backend.Stack, error) {
 	stackName := stackRef.Name()
-	snapshot, path, err := b.getStack(stackName)
+	deployment, path, err := b.getLazyStack(stackName)
 	switch {
 	case gcerrors.Code(errors.Cause(err)) == gcerrors.NotFound:
 		return nil, nil
 	case err != nil:
 		return nil, err
+	case deployment == nil:
+		return newStack(stackRef, path, nil, b), nil
 	default:
-		return newStack(stackRef, path, snapshot, b), nil
+		return newLazyStack(stackRef, path, deployment, b), nil
 	}
 }
 
@@ -363,13 +365,13 @@ func (b *localBackend) RemoveStack(ctx context.Context, stack backend.Stack, for
 	}
 
 	stackName := stack.Ref().Name()
-	snapshot, _, err := b.getStack(stackName)
+	deployment, _, err := b.getLazyStack(stackName)
 	if err != nil {
 		return false, err
 	}
 
 	// Don't remove stacks that still have resources.
-	if !force && snapshot != nil && len(snapshot.Resources) > 0 {
+	if !force && deployment != nil && len(deployment.Resources) > 0 {
 		return true, errors.New("refusing to remove stack because it still contains resources")
 	}
 
@@ -421,9 +423,13 @@ func (b *localBackend) RenameStack(ctx context.Context, stack backend.Stack,
 		return nil, err
 	}
 
-	// To remove the old stack, just make a backup of the file and don't write out anything new.
+	// To remove the old stack, just make a backup of the file and don't write out anything new. Its journal has
+	// already been replayed into the snapshot we just saved.
 	file := b.stackPath(stackName)
 	backupTarget(b.bucket, file)
+	if err = removeAllByPrefix(b.bucket, b.journalDirectory(stackName)); err != nil {
+		logging.V(5).Infof("error removing checkpoint journal for %s: %v", stackName, err)
+	}
 
 	// And rename the histoy folder as well.
 	if err = b.renameHistory(stackName, newName); err != nil {
@@ -559,6 +565,10 @@ func (b *localBackend) apply(
 	if err != nil {
 		return nil, result.FromError(err)
 	}
+	writePolicy, err := backend.GetSnapshotWritePolicy()
+	if err != nil {
+		return nil, result.FromError(err)
+	}
 
 	// Spawn a display loop to show events on the CLI.
 	displayEvents := make(chan engine.Event)
@@ -588,7 +598,7 @@ func (b *localBackend) apply(
 
 	// Create the management machinery.
 	persister := b.newSnapshotPersister(stackName, op.SecretsManager)
-	manager := backend.NewSnapshotManager(persister, update.GetTarget().Snapshot)
+	manager := backend.NewSnapshotManagerWithPolicy(persister, update.GetTarget().Snapshot, writePolicy)
 	engineCtx := &engine.Context{
 		Cancel:          scope.Context(),
 		Events:          engineEvents,
@@ -854,7 +864,7 @@ func (b *localBackend) getLocalStacks() ([]tokens.QName, error) {
 
 		// Read in this stack's information.
 		name := tokens.QName(stackfn[:len(stackfn)-len(ext)])
-		_, _, err := b.getStack(name)
+		_, _, err := b.getLazyStack(name)
 		if err != nil {
 			logging.V(5).Infof("error reading stack: %v (%v) skipping", name, err)
 			continue // failure reading the stack information.
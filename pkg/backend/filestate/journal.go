@@ -0,0 +1,142 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package filestate
+
+import (
+	"context"
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"path/filepath"
+	"sort"
+	"strings"
+
+	"github.com/pkg/errors"
+	"gocloud.dev/gcerrors"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/fsutil"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/workspace"
+)
+
+// CheckpointJournalEnvVar is the environment variable that enables persisting checkpoint deltas to a journal
+// rather than rewriting the full checkpoint file for every step of an update.
+const CheckpointJournalEnvVar = "PULUMI_EXPERIMENTAL_CHECKPOINT_DELTAS"
+
+// A stack's journal is a set of segment objects that live alongside its checkpoint file. Each segment holds a single
+// checkpoint delta and is named after the checkpoint it applies to (its "generation") and its sequence number:
+//
+//     .pulumi/journals/<stack>/<generation>.<sequence>.json
+//
+// The generation is derived from the contents of the checkpoint file, so segments that were written against an
+// older checkpoint are never replayed on top of a newer one, even if the process crashed before it could remove
+// them. Because every object write is atomic, the state of a stack is always its checkpoint file plus the longest
+// contiguous run of segments of its generation.
+
+// journalGeneration returns the generation of the journal that applies to the checkpoint with the given contents.
+func journalGeneration(checkpoint []byte) string {
+	sum := sha256.Sum256(checkpoint)
+	return hex.EncodeToString(sum[:8])
+}
+
+func (b *localBackend) journalDirectory(stack tokens.QName) string {
+	return filepath.Join(b.StateDir(), workspace.JournalDir, fsutil.QnamePath(stack))
+}
+
+func (b *localBackend) journalSegmentPath(stack tokens.QName, generation string, sequence int) string {
+	return filepath.Join(b.journalDirectory(stack), fmt.Sprintf("%s.%010d.json", generation, sequence))
+}
+
+// saveJournalSegment writes the given delta to the journal of the given generation.
+func (b *localBackend) saveJournalSegment(stack tokens.QName, generation string,
+	delta *apitype.CheckpointDeltaV1) error {
+
+	byts, err := json.Marshal(delta)
+	if err != nil {
+		return errors.Wrap(err, "marshalling checkpoint delta")
+	}
+	file := b.journalSegmentPath(stack, generation, delta.Sequence)
+	if err = b.bucket.WriteAll(context.TODO(), file, byts, nil); err != nil {
+		return errors.Wrap(err, "An IO error occurred while writing the checkpoint journal")
+	}
+	logging.V(7).Infof("Saved stack %s checkpoint delta %d to: %s", stack, delta.Sequence, file)
+	return nil
+}
+
+// readJournal returns the deltas of the given generation in the order in which they must be applied.
+func (b *localBackend) readJournal(stack tokens.QName, generation string) ([]apitype.CheckpointDeltaV1, error) {
+	files, err := listBucket(b.bucket, b.journalDirectory(stack))
+	if err != nil {
+		// The journal doesn't exist until a delta has been written.
+		if gcerrors.Code(errors.Cause(err)) == gcerrors.NotFound {
+			return nil, nil
+		}
+		return nil, err
+	}
+
+	var deltas []apitype.CheckpointDeltaV1
+	for _, file := range files {
+		if file.IsDir || !strings.HasPrefix(objectName(file), generation+".") {
+			continue
+		}
+
+		byts, err := b.bucket.ReadAll(context.TODO(), file.Key)
+		if err != nil {
+			return nil, errors.Wrapf(err, "reading checkpoint journal segment %s", file.Key)
+		}
+		var delta apitype.CheckpointDeltaV1
+		if err = json.Unmarshal(byts, &delta); err != nil {
+			return nil, errors.Wrapf(err, "reading checkpoint journal segment %s", file.Key)
+		}
+		deltas = append(deltas, delta)
+	}
+	sort.Slice(deltas, func(i, j int) bool { return deltas[i].Sequence < deltas[j].Sequence })
+
+	// Deltas are written one at a time, so a gap can only be left behind by a failed write. Nothing after a gap can
+	// be applied.
+	for i := 1; i < len(deltas); i++ {
+		if deltas[i].Sequence != deltas[i-1].Sequence+1 {
+			logging.V(5).Infof("checkpoint journal for %s has a gap after delta %d; ignoring %d later deltas",
+				stack, deltas[i-1].Sequence, len(deltas)-i)
+			deltas = deltas[:i]
+			break
+		}
+	}
+	return deltas, nil
+}
+
+// pruneJournal removes all journal segments that do not belong to the given generation.
+func (b *localBackend) pruneJournal(stack tokens.QName, generation string) error {
+	files, err := listBucket(b.bucket, b.journalDirectory(stack))
+	if err != nil {
+		if gcerrors.Code(errors.Cause(err)) == gcerrors.NotFound {
+			return nil
+		}
+		return err
+	}
+
+	for _, file := range files {
+		if file.IsDir || strings.HasPrefix(objectName(file), generation+".") {
+			continue
+		}
+		if err = b.bucket.Delete(context.TODO(), file.Key); err != nil {
+			logging.V(5).Infof("error deleting checkpoint journal segment: %v (%v) skipping", file.Key, err)
+		}
+	}
+	return nil
+}
@@ -0,0 +1,140 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package filestate
+
+import (
+	"context"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/pkg/v3/backend"
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/secrets/b64"
+	"github.com/pulumi/pulumi/pkg/v3/version"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/cmdutil"
+)
+
+func newTestBackend(t *testing.T) *localBackend {
+	dir, err := ioutil.TempDir("", "filestate")
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	t.Cleanup(func() { os.RemoveAll(dir) })
+
+	be, err := New(cmdutil.Diag(), FilePathPrefix+filepath.ToSlash(dir))
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	return be.(*localBackend)
+}
+
+func newTestSnapshot(resources ...*resource.State) *deploy.Snapshot {
+	manifest := deploy.Manifest{Time: time.Now(), Version: version.Version}
+	manifest.Magic = manifest.NewMagic()
+	return deploy.NewSnapshot(manifest, b64.NewBase64SecretsManager(), resources, nil)
+}
+
+func TestCheckpointJournalReplay(t *testing.T) {
+	b := newTestBackend(t)
+	stackName := tokens.QName("journaled")
+
+	resA := &resource.State{Type: "test", URN: "urn:pulumi:journaled::proj::test::a"}
+	resB := &resource.State{Type: "test", URN: "urn:pulumi:journaled::proj::test::b"}
+	resC := &resource.State{Type: "test", URN: "urn:pulumi:journaled::proj::test::c"}
+
+	sp := &localDeltaSnapshotPersister{
+		localSnapshotPersister: localSnapshotPersister{name: stackName, backend: b, sm: b64.NewBase64SecretsManager()},
+	}
+	assert.NoError(t, sp.Save(newTestSnapshot(resA)))
+
+	// Append b, then begin an operation on c.
+	assert.NoError(t, sp.SaveDelta(&backend.SnapshotDelta{
+		Sequence: 0,
+		Records:  []backend.SnapshotDeltaRecord{{Kind: apitype.CheckpointDeltaAppend, ID: 1, State: resB}},
+	}))
+	assert.NoError(t, sp.SaveDelta(&backend.SnapshotDelta{
+		Sequence: 1,
+		Records: []backend.SnapshotDeltaRecord{
+			{Kind: apitype.CheckpointDeltaBeginOperation, ID: 0, State: resC, Operation: resource.OperationTypeCreating},
+		},
+	}))
+
+	snap, _, err := b.getStack(stackName)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	if assert.Len(t, snap.Resources, 2) {
+		assert.Equal(t, resB.URN, snap.Resources[0].URN)
+		assert.Equal(t, resA.URN, snap.Resources[1].URN)
+	}
+	if assert.Len(t, snap.PendingOperations, 1) {
+		assert.Equal(t, resC.URN, snap.PendingOperations[0].Resource.URN)
+	}
+
+	// A delta that follows a gap is ignored.
+	assert.NoError(t, sp.SaveDelta(&backend.SnapshotDelta{
+		Sequence: 3,
+		Records:  []backend.SnapshotDeltaRecord{{Kind: apitype.CheckpointDeltaRemove, ID: 0, State: resA}},
+	}))
+	snap, _, err = b.getStack(stackName)
+	assert.NoError(t, err)
+	assert.Len(t, snap.Resources, 2)
+
+	// Writing a full checkpoint starts a new generation and prunes the old journal.
+	assert.NoError(t, sp.Save(newTestSnapshot(resA, resC)))
+	snap, _, err = b.getStack(stackName)
+	assert.NoError(t, err)
+	assert.Len(t, snap.Resources, 2)
+	assert.Len(t, snap.PendingOperations, 0)
+
+	files, err := listBucket(b.bucket, b.journalDirectory(stackName))
+	assert.NoError(t, err)
+	assert.Len(t, files, 0)
+}
+
+func TestCheckpointJournalIgnoresStaleGenerations(t *testing.T) {
+	b := newTestBackend(t)
+	stackName := tokens.QName("stale")
+
+	a := &resource.State{Type: "test", URN: "urn:pulumi:stale::proj::test::a"}
+	sp := &localDeltaSnapshotPersister{
+		localSnapshotPersister: localSnapshotPersister{name: stackName, backend: b, sm: b64.NewBase64SecretsManager()},
+	}
+	assert.NoError(t, sp.Save(newTestSnapshot(a)))
+	assert.NoError(t, sp.SaveDelta(&backend.SnapshotDelta{
+		Sequence: 0,
+		Records:  []backend.SnapshotDeltaRecord{{Kind: apitype.CheckpointDeltaRemove, ID: 0, State: a}},
+	}))
+
+	// Simulate a crash between writing a new checkpoint and pruning the journal by overwriting the checkpoint file
+	// directly.
+	stale := sp.generation
+	_, err := b.saveStack(stackName, newTestSnapshot(a), nil)
+	assert.NoError(t, err)
+	assert.NoError(t, b.bucket.WriteAll(context.TODO(), b.journalSegmentPath(stackName, stale, 0),
+		[]byte(`{"sequence":0,"appendIndex":0,"records":[{"kind":"remove","id":0}]}`), nil))
+
+	snap, _, err := b.getStack(stackName)
+	assert.NoError(t, err)
+	assert.Len(t, snap.Resources, 1)
+}
@@ -0,0 +1,180 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package filestate
+
+import (
+	"context"
+	"encoding/json"
+	"fmt"
+	"path/filepath"
+
+	"github.com/pkg/errors"
+	"gocloud.dev/gcerrors"
+
+	"github.com/pulumi/pulumi/pkg/v3/backend"
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
+	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/fsutil"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/workspace"
+)
+
+// Whenever a stack's checkpoint is saved, the outputs of its root resource are also written to a small object of
+// their own:
+//
+//     .pulumi/outputs/<stack>.json
+//
+// so that stack references can read them without loading the stack's entire checkpoint. The outputs object records
+// the version of the checkpoint that it was written for. The version is derived from the attributes of the
+// checkpoint file and the contents of the stack's journal, so an outputs object that is out of date--because the
+// checkpoint was written by an older CLI, a write failed, or deltas have since been journaled--is never used.
+
+// stackOutputsFile is the on-disk format of a stack's outputs object.
+type stackOutputsFile struct {
+	Version string                 `json:"version"`
+	Outputs apitype.StackOutputsV1 `json:"outputs"`
+}
+
+var _ backend.StackOutputsReader = (*localBackend)(nil)
+
+func (b *localBackend) stackOutputsPath(stack tokens.QName) string {
+	return filepath.Join(b.StateDir(), workspace.OutputsDir, fsutil.QnamePath(stack)+".json")
+}
+
+// checkpointVersion returns the version of the given stack's checkpoint.
+func (b *localBackend) checkpointVersion(name tokens.QName) (string, error) {
+	attrs, err := b.bucket.Attributes(context.TODO(), b.stackPath(name))
+	if err != nil {
+		return "", err
+	}
+
+	// Journal segments are only ever added to a checkpoint's journal, and the journal is only pruned when the
+	// checkpoint itself is rewritten, so the number of segments is enough to tell whether deltas have been applied.
+	segments := 0
+	files, err := listBucket(b.bucket, b.journalDirectory(name))
+	switch {
+	case err == nil:
+		segments = len(files)
+	case gcerrors.Code(errors.Cause(err)) != gcerrors.NotFound:
+		return "", err
+	}
+	return fmt.Sprintf("%d.%d.%s.%d", attrs.ModTime.UnixNano(), attrs.Size, attrs.ETag, segments), nil
+}
+
+// saveStackOutputs writes the outputs of the given snapshot for the given stack, whose checkpoint has just been
+// saved. Failures are logged rather than returned, since the checkpoint remains the source of truth.
+func (b *localBackend) saveStackOutputs(name tokens.QName, snap *deploy.Snapshot, sm secrets.Manager) {
+	file := b.stackOutputsPath(name)
+	if err := b.writeStackOutputs(name, snap, sm, file); err != nil {
+		logging.V(5).Infof("error saving outputs of stack %s to %s: %v", name, file, err)
+	}
+}
+
+func (b *localBackend) writeStackOutputs(name tokens.QName, snap *deploy.Snapshot, sm secrets.Manager,
+	file string) error {
+
+	version, err := b.checkpointVersion(name)
+	if err != nil {
+		return err
+	}
+	outputs, err := stack.SerializeStackOutputs(snap, sm)
+	if err != nil {
+		return err
+	}
+	byts, err := json.Marshal(stackOutputsFile{Version: version, Outputs: *outputs})
+	if err != nil {
+		return err
+	}
+	if err = b.bucket.WriteAll(context.TODO(), file, byts, nil); err != nil {
+		return err
+	}
+	logging.V(7).Infof("Saved stack %s outputs to: %s", name, file)
+	return nil
+}
+
+// readStackOutputsFile returns the outputs of the given stack from its outputs object, if the object is for the given
+// version of the stack's checkpoint.
+func (b *localBackend) readStackOutputsFile(name tokens.QName, version string) (resource.PropertyMap, bool) {
+	file := b.stackOutputsPath(name)
+	byts, err := b.bucket.ReadAll(context.TODO(), file)
+	if err != nil {
+		if gcerrors.Code(errors.Cause(err)) != gcerrors.NotFound {
+			logging.V(5).Infof("error reading outputs of stack %s from %s: %v", name, file, err)
+		}
+		return nil, false
+	}
+
+	var outputsFile stackOutputsFile
+	if err = json.Unmarshal(byts, &outputsFile); err != nil {
+		logging.V(5).Infof("error reading outputs of stack %s from %s: %v", name, file, err)
+		return nil, false
+	}
+	if outputsFile.Version != version {
+		logging.V(7).Infof("Outputs of stack %s in %s are out of date", name, file)
+		return nil, false
+	}
+
+	outputs, err := stack.DeserializeStackOutputs(outputsFile.Outputs, stack.DefaultSecretsProvider)
+	if err != nil {
+		logging.V(5).Infof("error decoding outputs of stack %s from %s: %v", name, file, err)
+		return nil, false
+	}
+	return outputs, true
+}
+
+// GetStackOutputsVersion returns the version of the given stack's checkpoint.
+func (b *localBackend) GetStackOutputsVersion(ctx context.Context, stackRef backend.StackReference) (string, error) {
+	version, err := b.checkpointVersion(stackRef.Name())
+	if gcerrors.Code(errors.Cause(err)) == gcerrors.NotFound {
+		return "", nil
+	}
+	return version, err
+}
+
+// ReadStackOutputs returns the outputs of the given stack. The outputs are read from the stack's outputs object if it
+// is up to date, and from its checkpoint otherwise.
+func (b *localBackend) ReadStackOutputs(ctx context.Context,
+	stackRef backend.StackReference) (resource.PropertyMap, string, error) {
+
+	name := stackRef.Name()
+	version, err := b.GetStackOutputsVersion(ctx, stackRef)
+	if err != nil || version == "" {
+		return nil, "", err
+	}
+	if outputs, ok := b.readStackOutputsFile(name, version); ok {
+		return outputs, version, nil
+	}
+
+	deployment, _, err := b.getLazyStack(name)
+	switch {
+	case gcerrors.Code(errors.Cause(err)) == gcerrors.NotFound:
+		return nil, "", nil
+	case err != nil:
+		return nil, "", err
+	}
+	root := deployment.RootStackResource()
+	if root == nil {
+		return resource.PropertyMap{}, version, nil
+	}
+	outputs, err := root.Outputs()
+	if err != nil {
+		return nil, "", err
+	}
+	return outputs, version, nil
+}
@@ -0,0 +1,105 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package filestate
+
+import (
+	"context"
+	"encoding/json"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/pkg/v3/backend"
+	"github.com/pulumi/pulumi/pkg/v3/secrets/b64"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+)
+
+// editOutputsFile changes the "plain" output in the given stack's outputs object, so that tests can tell whether the
+// outputs were read from the object or from the checkpoint.
+func editOutputsFile(t *testing.T, b *localBackend, stackName tokens.QName) {
+	byts, err := b.bucket.ReadAll(context.TODO(), b.stackOutputsPath(stackName))
+	assert.NoError(t, err)
+	var file stackOutputsFile
+	assert.NoError(t, json.Unmarshal(byts, &file))
+	file.Outputs.Outputs["plain"] = "from outputs object"
+	byts, err = json.Marshal(file)
+	assert.NoError(t, err)
+	assert.NoError(t, b.bucket.WriteAll(context.TODO(), b.stackOutputsPath(stackName), byts, nil))
+}
+
+func TestReadStackOutputs(t *testing.T) {
+	b := newTestBackend(t)
+	stackName := tokens.QName("outputs")
+	ref, err := b.ParseStackReference(string(stackName))
+	assert.NoError(t, err)
+
+	// Stacks that don't exist have no outputs.
+	outputs, version, err := b.ReadStackOutputs(context.Background(), ref)
+	assert.NoError(t, err)
+	assert.Nil(t, outputs)
+	assert.Equal(t, "", version)
+
+	root := &resource.State{
+		Type: resource.RootStackType,
+		URN:  "urn:pulumi:outputs::proj::pulumi:pulumi:Stack::proj-outputs",
+		Outputs: resource.PropertyMap{
+			"plain":  resource.NewStringProperty("value"),
+			"secret": resource.MakeSecret(resource.NewStringProperty("hunter2")),
+		},
+	}
+	_, err = b.saveStack(stackName, newTestSnapshot(root), b64.NewBase64SecretsManager())
+	assert.NoError(t, err)
+
+	outputs, version, err = b.ReadStackOutputs(context.Background(), ref)
+	assert.NoError(t, err)
+	assert.Equal(t, "value", outputs["plain"].StringValue())
+	assert.True(t, outputs["secret"].IsSecret())
+	assert.Equal(t, "hunter2", outputs["secret"].SecretValue().Element.StringValue())
+	currentVersion, err := b.GetStackOutputsVersion(context.Background(), ref)
+	assert.NoError(t, err)
+	assert.Equal(t, currentVersion, version)
+
+	// The outputs are read from the outputs object while it is up to date.
+	editOutputsFile(t, b, stackName)
+	outputs, _, err = b.ReadStackOutputs(context.Background(), ref)
+	assert.NoError(t, err)
+	assert.Equal(t, "from outputs object", outputs["plain"].StringValue())
+
+	// Once a delta has been journaled, the outputs object is out of date and the checkpoint is read instead.
+	sp := &localDeltaSnapshotPersister{
+		localSnapshotPersister: localSnapshotPersister{name: stackName, backend: b, sm: b64.NewBase64SecretsManager()},
+	}
+	assert.NoError(t, sp.Save(newTestSnapshot(root)))
+	assert.NoError(t, sp.SaveDelta(&backend.SnapshotDelta{
+		Sequence: 0,
+		Records: []backend.SnapshotDeltaRecord{{Kind: apitype.CheckpointDeltaAppend, ID: 1, State: &resource.State{
+			Type: "test", URN: "urn:pulumi:outputs::proj::test::a",
+		}}},
+	}))
+	editOutputsFile(t, b, stackName)
+
+	outputs, version, err = b.ReadStackOutputs(context.Background(), ref)
+	assert.NoError(t, err)
+	assert.Equal(t, "value", outputs["plain"].StringValue())
+	assert.NotEqual(t, currentVersion, version)
+
+	// Removing the stack removes its outputs.
+	assert.NoError(t, b.removeStack(stackName))
+	exists, err := b.bucket.Exists(context.TODO(), b.stackOutputsPath(stackName))
+	assert.NoError(t, err)
+	assert.False(t, exists)
+}
@@ -15,9 +15,16 @@
 package filestate
 
 import (
+	"os"
+
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/pkg/v3/backend"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
 	"github.com/pulumi/pulumi/pkg/v3/secrets"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/cmdutil"
 )
 
 // localSnapshotManager is a simple SnapshotManager implementation that persists snapshots
@@ -26,6 +33,7 @@ type localSnapshotPersister struct {
 	name    tokens.QName
 	backend *localBackend
 	sm      secrets.Manager
+	encoder *stack.DeploymentEncoder // reused across saves so that unchanged resources need not be re-serialized
 }
 
 func (sp *localSnapshotPersister) SecretsManager() secrets.Manager {
@@ -33,11 +41,54 @@ func (sp *localSnapshotPersister) SecretsManager() secrets.Manager {
 }
 
 func (sp *localSnapshotPersister) Save(snapshot *deploy.Snapshot) error {
-	_, err := sp.backend.saveStack(sp.name, snapshot, sp.sm)
+	_, _, err := sp.backend.saveStackWithGeneration(sp.name, snapshot, sp.sm, sp.deploymentEncoder())
 	return err
 
 }
 
-func (b *localBackend) newSnapshotPersister(stackName tokens.QName, sm secrets.Manager) *localSnapshotPersister {
-	return &localSnapshotPersister{name: stackName, backend: b, sm: sm}
+func (sp *localSnapshotPersister) deploymentEncoder() *stack.DeploymentEncoder {
+	if sp.encoder == nil {
+		sp.encoder = stack.NewDeploymentEncoder(sp.sm, false /* showSecrets */)
+	}
+	return sp.encoder
+}
+
+// localDeltaSnapshotPersister persists full snapshots to the stack's checkpoint file and deltas to the stack's
+// checkpoint journal.
+type localDeltaSnapshotPersister struct {
+	localSnapshotPersister
+
+	generation string // the journal generation of the last full snapshot
+}
+
+func (sp *localDeltaSnapshotPersister) Save(snapshot *deploy.Snapshot) error {
+	_, generation, err := sp.backend.saveStackWithGeneration(sp.name, snapshot, sp.sm, sp.deploymentEncoder())
+	if err != nil {
+		return err
+	}
+	sp.generation = generation
+	return nil
+}
+
+func (sp *localDeltaSnapshotPersister) SaveDelta(delta *backend.SnapshotDelta) error {
+	if sp.generation == "" {
+		return errors.New("cannot save a checkpoint delta before saving a full checkpoint")
+	}
+	sdelta, err := delta.Serialize(sp.sm, false /* showSecrets */)
+	if err != nil {
+		return errors.Wrap(err, "serializing checkpoint delta")
+	}
+	return sp.backend.saveJournalSegment(sp.name, sp.generation, sdelta)
+}
+
+var _ backend.DeltaSnapshotPersister = (*localDeltaSnapshotPersister)(nil)
+
+// newSnapshotPersister creates a persister for the given stack. The persister only journals deltas if
+// PULUMI_EXPERIMENTAL_CHECKPOINT_DELTAS is set.
+func (b *localBackend) newSnapshotPersister(stackName tokens.QName, sm secrets.Manager) backend.SnapshotPersister {
+	persister := localSnapshotPersister{name: stackName, backend: b, sm: sm}
+	if cmdutil.IsTruthy(os.Getenv(CheckpointJournalEnvVar)) {
+		return &localDeltaSnapshotPersister{localSnapshotPersister: persister}
+	}
+	return &persister
 }
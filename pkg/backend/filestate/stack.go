@@ -16,14 +16,18 @@ package filestate
 
 import (
 	"context"
+	"sync"
 	"time"
 
+	"github.com/pkg/errors"
+
 	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
 
 	"github.com/pulumi/pulumi/pkg/v3/backend"
 	"github.com/pulumi/pulumi/pkg/v3/engine"
 	"github.com/pulumi/pulumi/pkg/v3/operations"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/result"
 )
@@ -39,7 +43,11 @@ type localStack struct {
 	ref      backend.StackReference // the stack's reference (qualified name).
 	path     string                 // a path to the stack's checkpoint file on disk.
 	snapshot *deploy.Snapshot       // a snapshot representing the latest deployment state.
+	lazy     *stack.LazyDeployment  // the latest deployment state, if it has not yet been materialized.
 	b        *localBackend          // a pointer to the backend this stack belongs to.
+
+	materialize sync.Once // materializes the snapshot from the lazy deployment.
+	snapshotErr error     // the error, if any, that occurred while materializing the snapshot.
 }
 
 func newStack(ref backend.StackReference, path string, snapshot *deploy.Snapshot, b *localBackend) Stack {
@@ -51,10 +59,60 @@ func newStack(ref backend.StackReference, path string, snapshot *deploy.Snapshot
 	}
 }
 
-func (s *localStack) Ref() backend.StackReference                            { return s.ref }
-func (s *localStack) Snapshot(ctx context.Context) (*deploy.Snapshot, error) { return s.snapshot, nil }
-func (s *localStack) Backend() backend.Backend                               { return s.b }
-func (s *localStack) Path() string                                           { return s.path }
+// newLazyStack creates a stack whose snapshot is only materialized once it is requested.
+func newLazyStack(ref backend.StackReference, path string, lazy *stack.LazyDeployment, b *localBackend) Stack {
+	return &localStack{
+		ref:  ref,
+		path: path,
+		lazy: lazy,
+		b:    b,
+	}
+}
+
+func (s *localStack) Ref() backend.StackReference { return s.ref }
+func (s *localStack) Backend() backend.Backend    { return s.b }
+func (s *localStack) Path() string                { return s.path }
+
+func (s *localStack) Snapshot(ctx context.Context) (*deploy.Snapshot, error) {
+	s.materialize.Do(func() {
+		if s.lazy == nil {
+			return
+		}
+
+		snap, err := s.lazy.Snapshot()
+		if err != nil {
+			s.snapshotErr = err
+			return
+		}
+
+		// Ensure the snapshot passes verification before returning it, to catch bugs early.
+		if !DisableIntegrityChecking {
+			if verifyerr := snap.VerifyIntegrity(); verifyerr != nil {
+				s.snapshotErr = errors.Wrapf(verifyerr, "%s: snapshot integrity failure; refusing to use it", s.path)
+				return
+			}
+		}
+		s.snapshot = snap
+	})
+	return s.snapshot, s.snapshotErr
+}
+
+// LazySnapshot returns the stack's latest deployment without decoding the properties of its resources until they are
+// requested.
+func (s *localStack) LazySnapshot(ctx context.Context) (*stack.LazyDeployment, error) {
+	return s.deployment(), nil
+}
+
+func (s *localStack) deployment() *stack.LazyDeployment {
+	switch {
+	case s.lazy != nil:
+		return s.lazy
+	case s.snapshot != nil:
+		return stack.NewLazyDeployment(s.snapshot)
+	default:
+		return nil
+	}
+}
 
 func (s *localStack) Remove(ctx context.Context, force bool) (bool, error) {
 	return backend.RemoveStack(ctx, s, force)
@@ -115,9 +173,9 @@ func (lss localStackSummary) Name() backend.StackReference {
 }
 
 func (lss localStackSummary) LastUpdate() *time.Time {
-	snap := lss.s.snapshot
-	if snap != nil {
-		if t := snap.Manifest.Time; !t.IsZero() {
+	deployment := lss.s.deployment()
+	if deployment != nil {
+		if t := deployment.Manifest.Time; !t.IsZero() {
 			return &t
 		}
 	}
@@ -125,9 +183,9 @@ func (lss localStackSummary) LastUpdate() *time.Time {
 }
 
 func (lss localStackSummary) ResourceCount() *int {
-	snap := lss.s.snapshot
-	if snap != nil {
-		count := len(snap.Resources)
+	deployment := lss.s.deployment()
+	if deployment != nil {
+		count := len(deployment.Resources)
 		return &count
 	}
 	return nil
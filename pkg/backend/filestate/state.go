@@ -15,6 +15,7 @@
 package filestate
 
 import (
+	"bytes"
 	"context"
 	"encoding/json"
 	"fmt"
@@ -36,6 +37,7 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
 	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
 	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/pkg/v3/util/metrics"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/encoding"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
@@ -153,7 +155,32 @@ func (b *localBackend) getStack(name tokens.QName) (*deploy.Snapshot, string, er
 	return snapshot, file, nil
 }
 
+// getLazyStack loads the latest deployment of the given stack without decoding the properties of its resources. The
+// deployment is nil if the stack has never been deployed.
+func (b *localBackend) getLazyStack(name tokens.QName) (*stack.LazyDeployment, string, error) {
+	if name == "" {
+		return nil, "", errors.New("invalid empty stack name")
+	}
+
+	file := b.stackPath(name)
+
+	chk, err := b.getCheckpoint(name)
+	if err != nil {
+		return nil, file, errors.Wrap(err, "failed to load checkpoint")
+	}
+	if chk.Latest == nil {
+		return nil, file, nil
+	}
+
+	deployment, err := stack.DeserializeDeploymentV3Lazy(*chk.Latest, stack.DefaultSecretsProvider)
+	if err != nil {
+		return nil, "", err
+	}
+	return deployment, file, nil
+}
+
 // GetCheckpoint loads a checkpoint file for the given stack in this project, from the current project workspace.
+// Any checkpoint deltas that were journaled on top of the checkpoint file are replayed onto the result.
 func (b *localBackend) getCheckpoint(stackName tokens.QName) (*apitype.CheckpointV3, error) {
 	chkpath := b.stackPath(stackName)
 	bytes, err := b.bucket.ReadAll(context.TODO(), chkpath)
@@ -161,32 +188,59 @@ func (b *localBackend) getCheckpoint(stackName tokens.QName) (*apitype.Checkpoin
 		return nil, err
 	}
 
-	return stack.UnmarshalVersionedCheckpointToLatestCheckpoint(bytes)
+	chk, err := stack.UnmarshalVersionedCheckpointToLatestCheckpoint(bytes)
+	if err != nil {
+		return nil, err
+	}
+
+	deltas, err := b.readJournal(stackName, journalGeneration(bytes))
+	if err != nil {
+		return nil, errors.Wrap(err, "reading checkpoint journal")
+	}
+	if len(deltas) != 0 {
+		logging.V(7).Infof("Replaying %d checkpoint deltas for stack %s", len(deltas), stackName)
+		if chk.Latest, err = stack.ApplyCheckpointDeltas(chk.Latest, deltas); err != nil {
+			return nil, errors.Wrap(err, "replaying checkpoint journal")
+		}
+	}
+	return chk, nil
 }
 
 func (b *localBackend) saveStack(name tokens.QName, snap *deploy.Snapshot, sm secrets.Manager) (string, error) {
+	file, _, err := b.saveStackWithGeneration(name, snap, sm, stack.NewDeploymentEncoder(sm, false /* showSecrets */))
+	return file, err
+}
+
+// saveStackWithGeneration writes a full checkpoint for the given stack and returns the path to the checkpoint file
+// along with the journal generation that applies to it. Unless checkpoints are being retained, any journal segments
+// that belong to other generations are removed. JSON checkpoints are written using the given encoder, which must have
+// been created with the given secrets manager.
+func (b *localBackend) saveStackWithGeneration(name tokens.QName, snap *deploy.Snapshot, sm secrets.Manager,
+	encoder *stack.DeploymentEncoder) (string, string, error) {
+
 	// Make a serializable stack and then use the encoder to encode it.
 	file := b.stackPath(name)
 	m, ext := encoding.Detect(file)
 	if m == nil {
-		return "", errors.Errorf("resource serialization failed; illegal markup extension: '%v'", ext)
+		return "", "", errors.Errorf("resource serialization failed; illegal markup extension: '%v'", ext)
 	}
 	if filepath.Ext(file) == "" {
 		file = file + ext
 	}
-	chk, err := stack.SerializeCheckpoint(name, snap, sm, false /* showSecrets */)
-	if err != nil {
-		return "", errors.Wrap(err, "serializaing checkpoint")
-	}
-	byts, err := m.Marshal(chk)
+	start := metrics.Now()
+	byts, err := marshalCheckpoint(m, name, snap, sm, encoder)
 	if err != nil {
-		return "", errors.Wrap(err, "An IO error occurred while marshalling the checkpoint")
+		return "", "", err
 	}
+	metrics.ObserveSince("checkpoint.encode", "file", start)
+	metrics.ObserveBytes("checkpoint.bytes", "file", len(byts))
+	generation := journalGeneration(byts)
 
 	// Back up the existing file if it already exists.
 	bck := backupTarget(b.bucket, file)
 
 	// And now write out the new snapshot file, overwriting that location.
+	start = metrics.Now()
 	if err = b.bucket.WriteAll(context.TODO(), file, byts, nil); err != nil {
 
 		b.mutex.Lock()
@@ -216,31 +270,71 @@ func (b *localBackend) saveStack(name tokens.QName, snap *deploy.Snapshot, sm se
 			},
 		})
 		if err != nil {
-			return "", err
+			return "", "", err
 		}
 	}
 
+	metrics.ObserveSince("checkpoint.write", "file", start)
 	logging.V(7).Infof("Saved stack %s checkpoint to: %s (backup=%s)", name, file, bck)
 
-	// And if we are retaining historical checkpoint information, write it out again
+	// And if we are retaining historical checkpoint information, write it out again. Journal segments are retained
+	// as well, so the history between two full checkpoints is kept without duplicating the whole state.
 	if cmdutil.IsTruthy(os.Getenv("PULUMI_RETAIN_CHECKPOINTS")) {
 		if err = b.bucket.WriteAll(context.TODO(), fmt.Sprintf("%v.%v", file, time.Now().UnixNano()), byts, nil); err != nil {
-			return "", errors.Wrap(err, "An IO error occurred while writing the new snapshot file")
+			return "", "", errors.Wrap(err, "An IO error occurred while writing the new snapshot file")
 		}
+	} else if err = b.pruneJournal(name, generation); err != nil {
+		logging.V(5).Infof("error pruning checkpoint journal for %s: %v", name, err)
 	}
 
+	// Now that the checkpoint and its journal are in place, save the stack's outputs for stack references.
+	b.saveStackOutputs(name, snap, sm)
+
 	if !DisableIntegrityChecking {
 		// Finally, *after* writing the checkpoint, check the integrity.  This is done afterwards so that we write
 		// out the checkpoint file since it may contain resource state updates.  But we will warn the user that the
 		// file is already written and might be bad.
 		if verifyerr := snap.VerifyIntegrity(); verifyerr != nil {
-			return "", errors.Wrapf(verifyerr,
+			return "", "", errors.Wrapf(verifyerr,
 				"%s: snapshot integrity failure; it was already written, but is invalid (backup available at %s)",
 				file, bck)
 		}
 	}
 
-	return file, nil
+	return file, generation, nil
+}
+
+// marshalCheckpoint serializes a checkpoint for the given stack using the given marshaler. JSON checkpoints are
+// streamed out by the deployment encoder rather than built up as a tree of generic values, which lets the encoder
+// reuse the bytes of resources that have not changed since its last checkpoint. The result is identical to
+// marshaling the checkpoint returned by stack.SerializeCheckpoint.
+func marshalCheckpoint(m encoding.Marshaler, name tokens.QName, snap *deploy.Snapshot, sm secrets.Manager,
+	encoder *stack.DeploymentEncoder) ([]byte, error) {
+
+	if !m.IsJSONLike() {
+		chk, err := stack.SerializeCheckpoint(name, snap, sm, false /* showSecrets */)
+		if err != nil {
+			return nil, errors.Wrap(err, "serializaing checkpoint")
+		}
+		byts, err := m.Marshal(chk)
+		if err != nil {
+			return nil, errors.Wrap(err, "An IO error occurred while marshalling the checkpoint")
+		}
+		return byts, nil
+	}
+
+	var compact bytes.Buffer
+	if err := encoder.EncodeCheckpoint(&compact, name, snap); err != nil {
+		return nil, errors.Wrap(err, "serializaing checkpoint")
+	}
+
+	// Checkpoints have always been written indented, so keep doing so.
+	var indented bytes.Buffer
+	indented.Grow(compact.Len() + compact.Len()/2)
+	if err := json.Indent(&indented, compact.Bytes(), "", "    "); err != nil {
+		return nil, errors.Wrap(err, "An IO error occurred while marshalling the checkpoint")
+	}
+	return indented.Bytes(), nil
 }
 
 // removeStack removes information about a stack from the current workspace.
@@ -251,6 +345,14 @@ func (b *localBackend) removeStack(name tokens.QName) error {
 	file := b.stackPath(name)
 	backupTarget(b.bucket, file)
 
+	if err := removeAllByPrefix(b.bucket, b.journalDirectory(name)); err != nil {
+		logging.V(5).Infof("error removing checkpoint journal for %s: %v", name, err)
+	}
+	if err := b.bucket.Delete(context.TODO(), b.stackOutputsPath(name)); err != nil &&
+		gcerrors.Code(errors.Cause(err)) != gcerrors.NotFound {
+		logging.V(5).Infof("error removing outputs of stack %s: %v", name, err)
+	}
+
 	historyDir := b.historyDirectory(name)
 	return removeAllByPrefix(b.bucket, historyDir)
 }
@@ -116,6 +116,8 @@ type cloudBackend struct {
 	url            string
 	client         *client.Client
 	currentProject *workspace.Project
+
+	noOutputsEndpoint int32 // set once the service is known not to support exporting stack outputs.
 }
 
 // Assert we implement the backend.Backend and backend.SpecificDeploymentExporter interfaces.
@@ -985,6 +987,10 @@ func (b *cloudBackend) runEngineAction(
 	if err != nil {
 		return nil, result.FromError(err)
 	}
+	writePolicy, err := backend.GetSnapshotWritePolicy()
+	if err != nil {
+		return nil, result.FromError(err)
+	}
 
 	// displayEvents renders the event to the console and Pulumi service. The processor for the
 	// will signal all events have been proceed when a value is written to the displayDone channel.
@@ -1017,7 +1023,7 @@ func (b *cloudBackend) runEngineAction(
 		sm = u.GetTarget().Snapshot.SecretsManager
 	}
 	persister := b.newSnapshotPersister(ctx, u.update, u.tokenSource, sm)
-	snapshotManager := backend.NewSnapshotManager(persister, u.GetTarget().Snapshot)
+	snapshotManager := backend.NewSnapshotManagerWithPolicy(persister, u.GetTarget().Snapshot, writePolicy)
 
 	// Depending on the action, kick off the relevant engine activity.  Note that we don't immediately check and
 	// return error conditions, because we will do so below after waiting for the display channels to close.
@@ -1026,7 +1032,7 @@ func (b *cloudBackend) runEngineAction(
 		Cancel:          cancellationScope.Context(),
 		Events:          engineEvents,
 		SnapshotManager: snapshotManager,
-		BackendClient:   httpstateBackendClient{backend: b},
+		BackendClient:   newHTTPStateBackendClient(b),
 	}
 	if parentSpan := opentracing.SpanFromContext(ctx); parentSpan != nil {
 		engineCtx.ParentSpan = parentSpan.Context()
@@ -1470,7 +1476,13 @@ func (b *cloudBackend) UpdateStackTags(ctx context.Context,
 }
 
 type httpstateBackendClient struct {
-	backend Backend
+	client deploy.BackendClient
+}
+
+// newHTTPStateBackendClient returns a client for the given backend. The client is meant to be used for a single
+// update, so that the outputs of the stacks that it references are only read once.
+func newHTTPStateBackendClient(b Backend) httpstateBackendClient {
+	return httpstateBackendClient{client: backend.NewBackendClient(b)}
 }
 
 func (c httpstateBackendClient) GetStackOutputs(ctx context.Context, name string) (resource.PropertyMap, error) {
@@ -1481,10 +1493,10 @@ func (c httpstateBackendClient) GetStackOutputs(ctx context.Context, name string
 			"'<organization>/<project>/<stack>'. See https://pulumi.io/help/stack-reference for more information.")
 	}
 
-	return backend.NewBackendClient(c.backend).GetStackOutputs(ctx, name)
+	return c.client.GetStackOutputs(ctx, name)
 }
 
 func (c httpstateBackendClient) GetStackResourceOutputs(
 	ctx context.Context, name string) (resource.PropertyMap, error) {
-	return backend.NewBackendClient(c.backend).GetStackResourceOutputs(ctx, name)
+	return c.client.GetStackResourceOutputs(ctx, name)
 }
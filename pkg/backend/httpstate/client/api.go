@@ -88,6 +88,9 @@ type httpCallOptions struct {
 
 	// GzipCompress compresses the request using gzip before sending it.
 	GzipCompress bool
+
+	// GzipCompressed indicates that the request has already been compressed using gzip.
+	GzipCompressed bool
 }
 
 // apiAccessToken is an implementation of accessToken for Pulumi API tokens (i.e. tokens of kind
@@ -191,15 +194,19 @@ func pulumiAPICall(ctx context.Context, d diag.Sink, cloudAPI, method, path stri
 
 	// Opt-in to accepting gzip-encoded responses from the service.
 	req.Header.Set("Accept-Encoding", "gzip")
-	if opts.GzipCompress {
+	if opts.GzipCompress || opts.GzipCompressed {
 		// If we're sending something that's gzipped, set that header too.
 		req.Header.Set("Content-Encoding", "gzip")
 	}
 
 	logging.V(apiRequestLogLevel).Infof("Making Pulumi API call: %s", url)
 	if logging.V(apiRequestDetailLogLevel) {
+		logBody := string(body)
+		if opts.GzipCompressed {
+			logBody = fmt.Sprintf("<%d compressed bytes>", len(body))
+		}
 		logging.V(apiRequestDetailLogLevel).Infof(
-			"Pulumi API call details (%s): headers=%v; body=%v", url, req.Header, string(body))
+			"Pulumi API call details (%s): headers=%v; body=%v", url, req.Header, logBody)
 	}
 
 	var resp *http.Response
@@ -311,6 +318,25 @@ func pulumiRESTCall(ctx context.Context, diag diag.Sink, cloudAPI, method, path
 	return nil
 }
 
+// pulumiRawCall calls the Pulumi REST API using the given bytes as the request body. The response body is discarded.
+// As with pulumiRESTCall, the error might be an instance of apitype.ErrorResponse.
+func pulumiRawCall(ctx context.Context, diag diag.Sink, cloudAPI, method, path string, reqBody []byte,
+	tok accessToken, opts httpCallOptions) error {
+
+	url, resp, err := pulumiAPICall(ctx, diag, cloudAPI, method, path, reqBody, tok, opts)
+	if err != nil {
+		return err
+	}
+	respBody, err := readBody(resp)
+	if err != nil {
+		return errors.Wrapf(err, "reading response from API")
+	}
+	if logging.V(apiRequestDetailLogLevel) {
+		logging.V(apiRequestDetailLogLevel).Infof("Pulumi API call response body (%s): %v", url, string(respBody))
+	}
+	return nil
+}
+
 // readBody reads the contents of an http.Response into a byte array, returning an error if one occurred while in the
 // process of doing so. readBody uses the Content-Encoding of the response to pick the correct reader to use.
 func readBody(resp *http.Response) ([]byte, error) {
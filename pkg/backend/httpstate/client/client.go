@@ -20,6 +20,7 @@ import (
 	"fmt"
 	"io"
 	"net/http"
+	"os"
 	"path"
 	"regexp"
 	"strconv"
@@ -372,6 +373,36 @@ func (pc *Client) DecryptValue(ctx context.Context, stack StackIdentifier, ciphe
 	return resp.Plaintext, nil
 }
 
+// BatchEncryptValue encrypts a set of plaintext values in the context of the indicated stack using a single request.
+// The ciphertexts are returned in the same order as the plaintexts.
+func (pc *Client) BatchEncryptValue(ctx context.Context, stack StackIdentifier,
+	plaintexts [][]byte) ([][]byte, error) {
+	req := apitype.BatchEncryptRequest{Plaintexts: plaintexts}
+	var resp apitype.BatchEncryptResponse
+	if err := pc.restCall(ctx, "POST", getStackPath(stack, "batch-encrypt"), nil, &req, &resp); err != nil {
+		return nil, err
+	}
+	if len(resp.Ciphertexts) != len(plaintexts) {
+		return nil, errors.Errorf("expected %d encrypted values, got %d", len(plaintexts), len(resp.Ciphertexts))
+	}
+	return resp.Ciphertexts, nil
+}
+
+// BatchDecryptValue decrypts a set of ciphertext values in the context of the indicated stack using a single request.
+// The plaintexts are returned in the same order as the ciphertexts.
+func (pc *Client) BatchDecryptValue(ctx context.Context, stack StackIdentifier,
+	ciphertexts [][]byte) ([][]byte, error) {
+	req := apitype.BatchDecryptRequest{Ciphertexts: ciphertexts}
+	var resp apitype.BatchDecryptResponse
+	if err := pc.restCall(ctx, "POST", getStackPath(stack, "batch-decrypt"), nil, &req, &resp); err != nil {
+		return nil, err
+	}
+	if len(resp.Plaintexts) != len(ciphertexts) {
+		return nil, errors.Errorf("expected %d decrypted values, got %d", len(ciphertexts), len(resp.Plaintexts))
+	}
+	return resp.Plaintexts, nil
+}
+
 // GetStackUpdates returns all updates to the indicated stack.
 func (pc *Client) GetStackUpdates(
 	ctx context.Context,
@@ -413,6 +444,18 @@ func (pc *Client) ExportStackDeployment(
 	return apitype.UntypedDeployment(resp), nil
 }
 
+// ExportStackOutputs exports the outputs of the indicated stack's root resource, along with the version of the
+// stack's checkpoint that they were read from.
+func (pc *Client) ExportStackOutputs(
+	ctx context.Context, stack StackIdentifier) (apitype.ExportStackOutputsResponse, error) {
+
+	var resp apitype.ExportStackOutputsResponse
+	if err := pc.restCall(ctx, "GET", getStackPath(stack, "outputs"), nil, nil, &resp); err != nil {
+		return apitype.ExportStackOutputsResponse{}, err
+	}
+	return resp, nil
+}
+
 // ImportStackDeployment imports a new deployment into the indicated stack.
 func (pc *Client) ImportStackDeployment(ctx context.Context, stack StackIdentifier,
 	deployment *apitype.UntypedDeployment) (UpdateIdentifier, error) {
@@ -616,6 +659,16 @@ func (pc *Client) PublishPolicyPack(ctx context.Context, orgName string,
 		return "", errors.Wrapf(err, "Failed to upload compressed PolicyPack")
 	}
 
+	// Object storage requires the length of the upload up front, which http.NewRequest only infers for in-memory
+	// readers, so provide it for archives that are streamed from a file.
+	if f, ok := dirArchive.(*os.File); ok {
+		info, err := f.Stat()
+		if err != nil {
+			return "", errors.Wrapf(err, "Failed to upload compressed PolicyPack")
+		}
+		putReq.ContentLength = info.Size()
+	}
+
 	for k, v := range resp.RequiredHeaders {
 		putReq.Header.Add(k, v)
 	}
@@ -836,6 +889,12 @@ func (pc *Client) PatchUpdateCheckpoint(ctx context.Context, update UpdateIdenti
 	if err != nil {
 		return err
 	}
+	return pc.PatchUpdateCheckpointRaw(ctx, update, rawDeployment, token)
+}
+
+// PatchUpdateCheckpointRaw patches the checkpoint for the indicated update with the given serialized deployment.
+func (pc *Client) PatchUpdateCheckpointRaw(ctx context.Context, update UpdateIdentifier,
+	rawDeployment json.RawMessage, token string) error {
 
 	req := apitype.PatchUpdateCheckpointRequest{
 		Version:    3,
@@ -848,6 +907,37 @@ func (pc *Client) PatchUpdateCheckpoint(ctx context.Context, update UpdateIdenti
 		updateAccessToken(token), httpCallOptions{RetryAllMethods: true, GzipCompress: true})
 }
 
+// PatchUpdateCheckpointCompressed patches the checkpoint for the indicated update with the given request, which must
+// be a gzip-compressed, JSON-encoded apitype.PatchUpdateCheckpointRequest. This allows callers to encode and compress
+// large checkpoints once, directly into a buffer of their own.
+func (pc *Client) PatchUpdateCheckpointCompressed(ctx context.Context, update UpdateIdentifier, request []byte,
+	token string) error {
+
+	// As with PatchUpdateCheckpointRaw, it is safe to retry this PATCH operation.
+	return pulumiRawCall(ctx, pc.diag, pc.apiURL, "PATCH", getUpdatePath(update, "checkpoint"), request,
+		updateAccessToken(token), httpCallOptions{RetryAllMethods: true, GzipCompressed: true})
+}
+
+// PatchUpdateCheckpointDelta applies the given delta to the checkpoint for the indicated update.
+func (pc *Client) PatchUpdateCheckpointDelta(ctx context.Context, update UpdateIdentifier,
+	delta *apitype.CheckpointDeltaV1, token string) error {
+
+	rawDelta, err := json.Marshal(delta)
+	if err != nil {
+		return err
+	}
+
+	req := apitype.PatchUpdateCheckpointDeltaRequest{
+		Version: 1,
+		Delta:   rawDelta,
+	}
+
+	// It is safe to retry this PATCH operation, because each delta carries a sequence number that allows the service
+	// to discard deltas it has already applied.
+	return pc.updateRESTCall(ctx, "PATCH", getUpdatePath(update, "checkpointdelta"), nil, req, nil,
+		updateAccessToken(token), httpCallOptions{RetryAllMethods: true, GzipCompress: true})
+}
+
 // CancelUpdate cancels the indicated update.
 func (pc *Client) CancelUpdate(ctx context.Context, update UpdateIdentifier) error {
 
@@ -882,6 +972,24 @@ func (pc *Client) RecordEngineEvents(
 		updateAccessToken(token), callOpts)
 }
 
+// RecordEngineEventsRaw posts a batch of serialized engine events to the Pulumi service. Each event must be the JSON
+// encoding of an apitype.EngineEvent.
+func (pc *Client) RecordEngineEventsRaw(
+	ctx context.Context, update UpdateIdentifier, events []json.RawMessage, token string) error {
+	batch := struct {
+		Events []json.RawMessage `json:"events"`
+	}{Events: events}
+	// This call is not retried here: the caller retries failed batches itself, and knows that a retry whose events
+	// the service has already recorded was successful.
+	callOpts := httpCallOptions{
+		GzipCompress: true,
+	}
+	return pc.updateRESTCall(
+		ctx, "POST", getUpdatePath(update, "events/batch"),
+		nil, batch, nil,
+		updateAccessToken(token), callOpts)
+}
+
 // UpdateStackTags updates the stacks's tags, replacing all existing tags.
 func (pc *Client) UpdateStackTags(
 	ctx context.Context, stack StackIdentifier, tags map[apitype.StackTagName]string) error {
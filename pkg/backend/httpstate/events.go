@@ -0,0 +1,392 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package httpstate
+
+import (
+	"encoding/json"
+	"net/http"
+	"sync"
+	"time"
+
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/pkg/v3/backend/display"
+	"github.com/pulumi/pulumi/pkg/v3/engine"
+	"github.com/pulumi/pulumi/pkg/v3/util/metrics"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
+)
+
+const (
+	// maxEventBatchBytes is the estimated size of serialized events past which a batch is sent.
+	maxEventBatchBytes = 256 * 1024
+	// maxEventTransmissionDelay is the longest that an event waits before the batch that holds it is sent.
+	maxEventTransmissionDelay = 4 * time.Second
+	// maxEventQueueBytes is the budget for the estimated size of batches that are waiting to be sent. Once it is
+	// exceeded, the oldest waiting batches are evicted rather than blocking the engine.
+	maxEventQueueBytes = 64 * 1024 * 1024
+	// minConcurrentEventRequests is the number of concurrent requests used to send batches while there is little
+	// backlog.
+	minConcurrentEventRequests = 3
+	// maxConcurrentEventRequests is the largest number of concurrent requests used to send batches.
+	maxConcurrentEventRequests = 16
+	// eventBatchesPerRequest is how many waiting batches it takes to add another concurrent request.
+	eventBatchesPerRequest = 4
+	// maxEventBatchAttempts is the number of times that sending a batch is attempted before it is abandoned.
+	maxEventBatchAttempts = 3
+	// eventBytesOverhead is the estimated size of a serialized event, not counting its variable-length fields.
+	eventBytesOverhead = 128
+)
+
+// engineEventUploadStats records how the engine events of an update were sent to the service.
+type engineEventUploadStats struct {
+	Events         int           // the number of events that were queued.
+	Batches        int           // the number of batches that were sent.
+	MaxQueueDepth  int           // the largest number of batches that waited to be sent at once.
+	MaxQueueBytes  int           // the largest size of the batches that waited to be sent at once.
+	EvictedBatches int           // the number of batches that were evicted from the queue because it was full.
+	EvictedEvents  int           // the number of events in the evicted batches.
+	FailedBatches  int           // the number of batches that were abandoned because they could not be sent.
+	FailedEvents   int           // the number of events in the failed batches.
+	RetriedBatches int           // the number of times that sending a batch was retried.
+	TotalLatency   time.Duration // the total time spent sending batches.
+	MaxLatency     time.Duration // the longest time spent sending a single batch.
+}
+
+// engineEventBatch is a batch of serialized engine events, in order of their sequence numbers.
+type engineEventBatch struct {
+	sequenceStart int // the sequence number of the first event.
+	events        []json.RawMessage
+	bytes         int
+}
+
+// sequencedEngineEvent is an engine event together with the sequence number and timestamp that it was given when it
+// was added to the uploader.
+type sequencedEngineEvent struct {
+	event     engine.Event
+	sequence  int
+	timestamp int
+}
+
+// pendingEngineEventBatch is a batch of engine events that have not yet been serialized.
+type pendingEngineEventBatch struct {
+	events []sequencedEngineEvent
+	bytes  int       // the estimated size of the serialized events.
+	queued time.Time // when the batch was queued, if metrics are enabled.
+}
+
+// engineEventUploader sends engine events to the service without ever blocking the caller. Events are gathered into
+// batches whose estimated size is bounded, and batches wait in a queue whose estimated size is bounded. Batches are
+// serialized and sent by a number of concurrent requests that grows with the length of the queue, so the caller
+// only pays for assigning each event its sequence number.
+type engineEventUploader struct {
+	send          func(batch engineEventBatch) error // sends a batch to the service.
+	maxBatchBytes int                                // the estimated size past which a batch is sent.
+	maxQueueBytes int                                // the budget for the estimated size of waiting batches.
+	minRequests   int                                // the number of concurrent requests when there's no backlog.
+	maxRequests   int                                // the largest number of concurrent requests.
+	retryDelay    time.Duration                      // the delay before a failed batch is first retried.
+
+	sequence int // the sequence number of the next event; only accessed by the producer.
+
+	m          sync.Mutex
+	idle       *sync.Cond
+	batch      pendingEngineEventBatch   // the batch that is being filled.
+	queue      []pendingEngineEventBatch // the batches that are waiting to be sent.
+	queueBytes int                       // the estimated size of the waiting batches.
+	active     int                       // the number of requests in flight.
+	stats      engineEventUploadStats
+}
+
+func newEngineEventUploader(send func(batch engineEventBatch) error) *engineEventUploader {
+	u := &engineEventUploader{
+		send:          send,
+		maxBatchBytes: maxEventBatchBytes,
+		maxQueueBytes: maxEventQueueBytes,
+		minRequests:   minConcurrentEventRequests,
+		maxRequests:   maxConcurrentEventRequests,
+		retryDelay:    time.Second,
+	}
+	u.idle = sync.NewCond(&u.m)
+	return u
+}
+
+// add adds the given event to the current batch, which is queued to be sent once it is large enough. The event is
+// serialized later, by the request that sends it. add must not be called concurrently with itself.
+func (u *engineEventUploader) add(e engine.Event) {
+	// Each event within an update must have a unique sequence number. Any request to emit an update with the same
+	// sequence number will fail.
+	event := sequencedEngineEvent{event: e, sequence: u.sequence, timestamp: int(time.Now().Unix())}
+	u.sequence++
+	size := estimateEngineEventBytes(e)
+
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	u.batch.events = append(u.batch.events, event)
+	u.batch.bytes += size
+	u.stats.Events++
+	if u.batch.bytes >= u.maxBatchBytes {
+		u.queueBatchLocked()
+	}
+}
+
+// flush queues the current batch to be sent, regardless of its size.
+func (u *engineEventUploader) flush() {
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	u.queueBatchLocked()
+}
+
+// close sends any remaining events and waits for every request to finish.
+func (u *engineEventUploader) close() engineEventUploadStats {
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	u.queueBatchLocked()
+	for u.active > 0 || len(u.queue) > 0 {
+		u.idle.Wait()
+	}
+	return u.stats
+}
+
+// queueBatchLocked adds the current batch to the queue, dropping the oldest waiting batches if the queue is over
+// budget, and starts as many requests as the queue calls for. Must be called with the lock held.
+func (u *engineEventUploader) queueBatchLocked() {
+	if len(u.batch.events) == 0 {
+		return
+	}
+	u.batch.queued = metrics.Now()
+	u.queue = append(u.queue, u.batch)
+	u.queueBytes += u.batch.bytes
+	u.batch = pendingEngineEventBatch{}
+
+	for u.queueBytes > u.maxQueueBytes && len(u.queue) > 1 {
+		evicted := u.queue[0]
+		u.queue, u.queueBytes = u.queue[1:], u.queueBytes-evicted.bytes
+		u.stats.EvictedBatches++
+		u.stats.EvictedEvents += len(evicted.events)
+		logging.V(3).Infof("dropping %d engine events: the upload queue is full", len(evicted.events))
+	}
+	if len(u.queue) > u.stats.MaxQueueDepth {
+		u.stats.MaxQueueDepth = len(u.queue)
+	}
+	if u.queueBytes > u.stats.MaxQueueBytes {
+		u.stats.MaxQueueBytes = u.queueBytes
+	}
+
+	u.dispatchLocked()
+}
+
+// dispatchLocked starts sending waiting batches until the number of requests in flight matches the backlog. Must be
+// called with the lock held.
+func (u *engineEventUploader) dispatchLocked() {
+	for len(u.queue) > 0 {
+		limit := u.minRequests + len(u.queue)/eventBatchesPerRequest
+		if limit > u.maxRequests {
+			limit = u.maxRequests
+		}
+		if u.active >= limit {
+			return
+		}
+
+		batch := u.queue[0]
+		u.queue, u.queueBytes = u.queue[1:], u.queueBytes-batch.bytes
+		u.active++
+		metrics.ObserveSince("events.queue", "service", batch.queued)
+		go u.upload(batch)
+	}
+}
+
+// upload serializes and sends the given batch.
+func (u *engineEventUploader) upload(pending pendingEngineEventBatch) {
+	batch := encodeEngineEventBatch(pending)
+	var err error
+	if len(batch.events) > 0 {
+		err = u.sendWithRetries(batch)
+	}
+
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	// Events that could not be serialized were never sent.
+	u.stats.FailedEvents += len(pending.events) - len(batch.events)
+	switch {
+	case err != nil:
+		logging.V(3).Infof("error recording engine events: %s", err)
+		u.stats.FailedBatches++
+		u.stats.FailedEvents += len(batch.events)
+	case len(batch.events) > 0:
+		u.stats.Batches++
+	}
+	u.active--
+	u.dispatchLocked()
+	if u.active == 0 && len(u.queue) == 0 {
+		u.idle.Broadcast()
+	}
+}
+
+// sendWithRetries sends the given batch, retrying transient failures. This is the only layer that retries sending
+// events: the request itself is not retried by the HTTP client.
+func (u *engineEventUploader) sendWithRetries(batch engineEventBatch) error {
+	for attempt := 1; ; attempt++ {
+		start := time.Now()
+		err := u.send(batch)
+		latency := time.Since(start)
+		u.recordLatency(latency)
+		metrics.ObserveDuration("events.upload", "service", latency)
+		metrics.ObserveBytes("events.batch", "service", batch.bytes)
+
+		// If an earlier attempt reached the service but its response was lost, the service rejects the retry
+		// because it has already recorded events with the batch's sequence numbers.
+		if attempt > 1 && isDuplicateEventError(err) {
+			logging.V(5).Infof("engine events %d-%d were already recorded",
+				batch.sequenceStart, batch.sequenceStart+len(batch.events)-1)
+			return nil
+		}
+		if err == nil || attempt == maxEventBatchAttempts || !isRetryableEventError(err) {
+			return err
+		}
+
+		logging.V(5).Infof("retrying engine events %d-%d: %v",
+			batch.sequenceStart, batch.sequenceStart+len(batch.events)-1, err)
+		u.m.Lock()
+		u.stats.RetriedBatches++
+		u.m.Unlock()
+		time.Sleep(u.retryDelay * time.Duration(attempt))
+	}
+}
+
+// encodeEngineEventBatch converts and serializes the events of the given batch. Events that cannot be serialized
+// are logged and left out of the batch.
+func encodeEngineEventBatch(pending pendingEngineEventBatch) engineEventBatch {
+	start := metrics.Now()
+	defer metrics.ObserveSince("events.encode", "service", start)
+
+	batch := engineEventBatch{events: make([]json.RawMessage, 0, len(pending.events))}
+	for _, e := range pending.events {
+		raw, err := encodeEngineEvent(e)
+		if err != nil {
+			logging.V(3).Infof("error recording engine event %d: %s", e.sequence, err)
+			continue
+		}
+		if len(batch.events) == 0 {
+			batch.sequenceStart = e.sequence
+		}
+		batch.events = append(batch.events, raw)
+		batch.bytes += len(raw)
+	}
+	return batch
+}
+
+func encodeEngineEvent(e sequencedEngineEvent) (json.RawMessage, error) {
+	apiEvent, err := display.ConvertEngineEvent(e.event)
+	if err != nil {
+		return nil, errors.Wrap(err, "converting engine event")
+	}
+	apiEvent.Sequence = e.sequence
+	apiEvent.Timestamp = e.timestamp
+	raw, err := json.Marshal(apiEvent)
+	if err != nil {
+		return nil, errors.Wrap(err, "serializing engine event")
+	}
+	return raw, nil
+}
+
+func (u *engineEventUploader) recordLatency(latency time.Duration) {
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	u.stats.TotalLatency += latency
+	if latency > u.stats.MaxLatency {
+		u.stats.MaxLatency = latency
+	}
+}
+
+// isRetryableEventError returns true if a request that failed with the given error may succeed if it is retried.
+// Requests that the service rejected outright are not retried.
+func isRetryableEventError(err error) bool {
+	errResp, ok := errors.Cause(err).(*apitype.ErrorResponse)
+	return !ok || errResp.Code >= http.StatusInternalServerError || errResp.Code == http.StatusTooManyRequests
+}
+
+// isDuplicateEventError returns true if the given error is the service's rejection of events whose sequence numbers
+// it has already recorded.
+func isDuplicateEventError(err error) bool {
+	errResp, ok := errors.Cause(err).(*apitype.ErrorResponse)
+	return ok && errResp.Code == http.StatusConflict
+}
+
+// estimateEngineEventBytes returns a cheap estimate of the size of the given event once it is serialized, which is
+// used to size batches without serializing events on the caller's goroutine.
+func estimateEngineEventBytes(e engine.Event) int {
+	switch p := e.Payload().(type) {
+	case engine.StdoutEventPayload:
+		return eventBytesOverhead + len(p.Message)
+	case engine.DiagEventPayload:
+		return eventBytesOverhead + len(p.URN) + len(p.Prefix) + len(p.Message)
+	case engine.PolicyViolationEventPayload:
+		return eventBytesOverhead + len(p.ResourceURN) + len(p.Prefix) + len(p.Message)
+	case engine.ResourcePreEventPayload:
+		return eventBytesOverhead + estimateStepEventBytes(p.Metadata)
+	case engine.ResourceOutputsEventPayload:
+		return eventBytesOverhead + estimateStepEventBytes(p.Metadata)
+	case engine.ResourceOperationFailedPayload:
+		return eventBytesOverhead + estimateStepEventBytes(p.Metadata)
+	default:
+		return eventBytesOverhead
+	}
+}
+
+func estimateStepEventBytes(md engine.StepEventMetadata) int {
+	size := len(md.URN) + len(md.Type) + len(md.Provider)
+	for _, state := range []*engine.StepEventStateMetadata{md.Old, md.New} {
+		if state != nil {
+			size += eventBytesOverhead + len(state.URN) + len(state.Type) + len(state.ID) + len(state.Parent) +
+				estimatePropertiesBytes(state.Inputs) + estimatePropertiesBytes(state.Outputs)
+		}
+	}
+	return size
+}
+
+func estimatePropertiesBytes(props resource.PropertyMap) int {
+	size := 2
+	for k, v := range props {
+		size += len(k) + 4 + estimatePropertyValueBytes(v)
+	}
+	return size
+}
+
+func estimatePropertyValueBytes(v resource.PropertyValue) int {
+	switch {
+	case v.IsString():
+		return len(v.StringValue()) + 2
+	case v.IsArray():
+		size := 2
+		for _, elem := range v.ArrayValue() {
+			size += estimatePropertyValueBytes(elem) + 1
+		}
+		return size
+	case v.IsObject():
+		return estimatePropertiesBytes(v.ObjectValue())
+	case v.IsSecret():
+		// Secrets are blinded when they are serialized.
+		return 64
+	default:
+		return 16
+	}
+}
@@ -0,0 +1,226 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package httpstate
+
+import (
+	"encoding/json"
+	"errors"
+	"fmt"
+	"net/http"
+	"sort"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/pkg/v3/engine"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/diag/colors"
+)
+
+func newStdoutEvent(i int) engine.Event {
+	return engine.NewEvent(engine.StdoutColorEvent, engine.StdoutEventPayload{
+		Message: fmt.Sprintf("message %d", i),
+		Color:   colors.Never,
+	})
+}
+
+// recordingSender records the sequence numbers of the events that it is sent.
+type recordingSender struct {
+	m         sync.Mutex
+	sequences []int
+	batches   int
+}
+
+func (s *recordingSender) send(batch engineEventBatch) error {
+	s.m.Lock()
+	defer s.m.Unlock()
+
+	s.batches++
+	for i, raw := range batch.events {
+		var event apitype.EngineEvent
+		if err := json.Unmarshal(raw, &event); err != nil {
+			return err
+		}
+		if event.Sequence != batch.sequenceStart+i {
+			return errors.New("events are out of sequence")
+		}
+		s.sequences = append(s.sequences, event.Sequence)
+	}
+	return nil
+}
+
+func TestEngineEventUploaderBatchesBySize(t *testing.T) {
+	sender := &recordingSender{}
+	u := newEngineEventUploader(sender.send)
+	u.maxBatchBytes = 1024
+
+	const count = 1000
+	for i := 0; i < count; i++ {
+		u.add(newStdoutEvent(i))
+	}
+	stats := u.close()
+
+	assert.Equal(t, count, stats.Events)
+	assert.Equal(t, sender.batches, stats.Batches)
+	assert.True(t, stats.Batches > 1)
+	assert.Equal(t, 0, stats.EvictedBatches)
+	assert.Equal(t, 0, stats.FailedBatches)
+
+	// Every event is sent exactly once.
+	sort.Ints(sender.sequences)
+	for i, seq := range sender.sequences {
+		assert.Equal(t, i, seq)
+	}
+	assert.Len(t, sender.sequences, count)
+}
+
+func TestEngineEventUploaderDoesNotBlock(t *testing.T) {
+	// The service does not respond until the test is done adding events.
+	unblock := make(chan struct{})
+	var m sync.Mutex
+	inflight, maxInflight := 0, 0
+	u := newEngineEventUploader(func(batch engineEventBatch) error {
+		m.Lock()
+		inflight++
+		if inflight > maxInflight {
+			maxInflight = inflight
+		}
+		m.Unlock()
+
+		<-unblock
+
+		m.Lock()
+		inflight--
+		m.Unlock()
+		return nil
+	})
+	u.maxBatchBytes = 1
+	u.maxQueueBytes = 64 * 1024
+
+	// Every event forms a batch of its own. Once the queue is over budget, the oldest waiting batches are evicted.
+	const count = 10000
+	for i := 0; i < count; i++ {
+		u.add(newStdoutEvent(i))
+	}
+
+	// Adding events does not wait for the requests, so wait for them to reach the service before letting them finish.
+	for deadline := time.Now().Add(10 * time.Second); time.Now().Before(deadline); time.Sleep(time.Millisecond) {
+		m.Lock()
+		n := inflight
+		m.Unlock()
+		if n == maxConcurrentEventRequests {
+			break
+		}
+	}
+	close(unblock)
+	stats := u.close()
+
+	assert.Equal(t, count, stats.Events)
+	assert.True(t, stats.EvictedBatches > 0)
+	assert.Equal(t, stats.EvictedBatches, stats.EvictedEvents)
+	assert.Equal(t, 0, stats.FailedBatches)
+	assert.Equal(t, count, stats.Batches+stats.EvictedEvents)
+	assert.True(t, stats.MaxQueueBytes <= u.maxQueueBytes)
+
+	// The backlog spreads the batches over the largest number of concurrent requests.
+	assert.Equal(t, maxConcurrentEventRequests, maxInflight)
+}
+
+func TestEngineEventUploaderRetries(t *testing.T) {
+	attempts := 0
+	u := newEngineEventUploader(func(batch engineEventBatch) error {
+		attempts++
+		if attempts == 1 {
+			return errors.New("connection reset")
+		}
+		return nil
+	})
+	u.retryDelay = time.Millisecond
+
+	u.add(newStdoutEvent(0))
+	stats := u.close()
+	assert.Equal(t, 1, stats.Batches)
+	assert.Equal(t, 1, stats.RetriedBatches)
+	assert.Equal(t, 0, stats.FailedBatches)
+
+	// Batches that the service rejects are not retried.
+	attempts = 0
+	u = newEngineEventUploader(func(batch engineEventBatch) error {
+		attempts++
+		return &apitype.ErrorResponse{Code: http.StatusBadRequest}
+	})
+	u.retryDelay = time.Millisecond
+
+	u.add(newStdoutEvent(0))
+	stats = u.close()
+	assert.Equal(t, 1, attempts)
+	assert.Equal(t, 0, stats.Batches)
+	assert.Equal(t, 1, stats.FailedBatches)
+	assert.Equal(t, 1, stats.FailedEvents)
+	assert.Equal(t, 0, stats.EvictedBatches)
+}
+
+func TestEngineEventUploaderTreatsDuplicateRetriesAsSuccess(t *testing.T) {
+	// The first attempt reaches the service, but its response is lost. The service rejects the retry because it has
+	// already recorded the batch.
+	attempts := 0
+	u := newEngineEventUploader(func(batch engineEventBatch) error {
+		attempts++
+		if attempts == 1 {
+			return errors.New("connection reset")
+		}
+		return &apitype.ErrorResponse{Code: http.StatusConflict}
+	})
+	u.retryDelay = time.Millisecond
+
+	u.add(newStdoutEvent(0))
+	stats := u.close()
+	assert.Equal(t, 2, attempts)
+	assert.Equal(t, 1, stats.Batches)
+	assert.Equal(t, 0, stats.FailedBatches)
+
+	// A conflict on the first attempt is a genuine failure.
+	attempts = 0
+	u = newEngineEventUploader(func(batch engineEventBatch) error {
+		attempts++
+		return &apitype.ErrorResponse{Code: http.StatusConflict}
+	})
+	u.retryDelay = time.Millisecond
+
+	u.add(newStdoutEvent(0))
+	stats = u.close()
+	assert.Equal(t, 1, attempts)
+	assert.Equal(t, 0, stats.Batches)
+	assert.Equal(t, 1, stats.FailedBatches)
+}
+
+func TestEngineEventUploaderSerializesEventsWhenSending(t *testing.T) {
+	// add does not serialize events: an event that is missing its payload is only rejected when its batch is sent,
+	// and the rest of the batch is sent without it.
+	sender := &recordingSender{}
+	u := newEngineEventUploader(sender.send)
+
+	u.add(newStdoutEvent(0))
+	u.add(engine.Event{Type: engine.DiagEvent})
+	stats := u.close()
+
+	assert.Equal(t, 2, stats.Events)
+	assert.Equal(t, 1, stats.Batches)
+	assert.Equal(t, 0, stats.FailedBatches)
+	assert.Equal(t, 1, stats.FailedEvents)
+	assert.Equal(t, []int{0}, sender.sequences)
+}
@@ -0,0 +1,113 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package httpstate
+
+import (
+	"context"
+	"net/http"
+	"strconv"
+	"sync/atomic"
+
+	"github.com/pulumi/pulumi/pkg/v3/backend"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
+)
+
+var _ backend.StackOutputsReader = &cloudBackend{}
+
+func isNotFound(err error) bool {
+	errResp, ok := err.(*apitype.ErrorResponse)
+	return ok && errResp.Code == http.StatusNotFound
+}
+
+// GetStackOutputsVersion returns the version of the given stack, which is the number of its latest update.
+func (b *cloudBackend) GetStackOutputsVersion(ctx context.Context, stackRef backend.StackReference) (string, error) {
+	stackID, err := b.getCloudStackIdentifier(stackRef)
+	if err != nil {
+		return "", err
+	}
+	apistack, err := b.client.GetStack(ctx, stackID)
+	if err != nil {
+		if isNotFound(err) {
+			return "", nil
+		}
+		return "", err
+	}
+	return strconv.Itoa(apistack.Version), nil
+}
+
+// ReadStackOutputs returns the outputs of the given stack. If the service does not support exporting a stack's
+// outputs on their own, the outputs are read from an export of the stack's deployment instead.
+func (b *cloudBackend) ReadStackOutputs(ctx context.Context,
+	stackRef backend.StackReference) (resource.PropertyMap, string, error) {
+
+	stackID, err := b.getCloudStackIdentifier(stackRef)
+	if err != nil {
+		return nil, "", err
+	}
+
+	tryOutputsEndpoint := atomic.LoadInt32(&b.noOutputsEndpoint) == 0
+	if tryOutputsEndpoint {
+		resp, err := b.client.ExportStackOutputs(ctx, stackID)
+		switch {
+		case err == nil:
+			outputs, err := stack.DeserializeStackOutputs(resp.StackOutputsV1, stack.DefaultSecretsProvider)
+			if err != nil {
+				return nil, "", err
+			}
+			return outputs, strconv.Itoa(resp.Version), nil
+		case !isNotFound(err):
+			return nil, "", err
+		}
+	}
+
+	// Either the stack does not exist or the service cannot export its outputs. Tell the two apart using the stack's
+	// metadata, which provides the version to export in the latter case.
+	apistack, err := b.client.GetStack(ctx, stackID)
+	if err != nil {
+		if isNotFound(err) {
+			return nil, "", nil
+		}
+		return nil, "", err
+	}
+	if tryOutputsEndpoint {
+		logging.V(7).Infof("service does not support exporting stack outputs; exporting deployments instead")
+		atomic.StoreInt32(&b.noOutputsEndpoint, 1)
+	}
+
+	version := apistack.Version
+	if version == 0 {
+		return resource.PropertyMap{}, "0", nil
+	}
+	deployment, err := b.exportDeployment(ctx, stackRef, &version)
+	if err != nil {
+		return nil, "", err
+	}
+	snap, err := stack.DeserializeUntypedDeploymentLazy(deployment, stack.DefaultSecretsProvider)
+	if err != nil {
+		return nil, "", err
+	}
+	root := snap.RootStackResource()
+	if root == nil {
+		return resource.PropertyMap{}, strconv.Itoa(version), nil
+	}
+	outputs, err := root.Outputs()
+	if err != nil {
+		return nil, "", err
+	}
+	return outputs, strconv.Itoa(version), nil
+}
@@ -176,25 +176,41 @@ func (pack *cloudPolicyPack) Publish(
 
 	fmt.Println("Compressing policy pack")
 
-	var packTarball []byte
+	var packTarball io.Reader
 
 	// TODO[pulumi/pulumi#1334]: move to the language plugins so we don't have to hard code here.
 	runtime := op.PolicyPack.Runtime.Name()
 	if strings.EqualFold(runtime, "nodejs") {
-		packTarball, err = npm.Pack(op.PlugCtx.Pwd, os.Stderr)
+		tarball, err := npm.Pack(op.PlugCtx.Pwd, os.Stderr)
 		if err != nil {
 			return result.FromError(
 				errors.Wrap(err, "could not publish policies because of error running npm pack"))
 		}
+		packTarball = bytes.NewReader(tarball)
 	} else {
 		// npm pack puts all the files in a "package" subdirectory inside the .tgz it produces, so we'll do
 		// the same for other runtimes. That way, after unpacking, we can look for the PulumiPolicy.yaml inside the
 		// package directory to determine the runtime of the policy pack.
-		packTarball, err = archive.TGZ(op.PlugCtx.Pwd, "package", true /*useDefaultExcludes*/)
+		//
+		// The .tgz is streamed to a temporary file rather than held in memory, and uploaded from there.
+		tarball, err := ioutil.TempFile("", "pulumi-policy-pack-*.tgz")
 		if err != nil {
 			return result.FromError(
 				errors.Wrap(err, "could not publish policies because of error creating the .tgz"))
 		}
+		defer func() {
+			contract.IgnoreClose(tarball)
+			contract.IgnoreError(os.Remove(tarball.Name()))
+		}()
+
+		if err = archive.WriteTGZ(tarball, op.PlugCtx.Pwd, "package", true /*useDefaultExcludes*/); err == nil {
+			_, err = tarball.Seek(0, io.SeekStart)
+		}
+		if err != nil {
+			return result.FromError(
+				errors.Wrap(err, "could not publish policies because of error creating the .tgz"))
+		}
+		packTarball = tarball
 	}
 
 	//
@@ -203,7 +219,7 @@ func (pack *cloudPolicyPack) Publish(
 
 	fmt.Println("Uploading policy pack to Pulumi service")
 
-	publishedVersion, err := pack.cl.PublishPolicyPack(ctx, pack.ref.orgName, analyzerInfo, bytes.NewReader(packTarball))
+	publishedVersion, err := pack.cl.PublishPolicyPack(ctx, pack.ref.orgName, analyzerInfo, packTarball)
 	if err != nil {
 		return result.FromError(err)
 	}
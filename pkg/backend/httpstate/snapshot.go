@@ -15,7 +15,13 @@
 package httpstate
 
 import (
+	"bytes"
+	"compress/gzip"
 	"context"
+	"encoding/json"
+	"os"
+	"sync"
+	"time"
 
 	"github.com/pkg/errors"
 	"github.com/pulumi/pulumi/pkg/v3/backend"
@@ -23,15 +29,204 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
 	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
 	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/pkg/v3/util/metrics"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/cmdutil"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
 )
 
-// cloudSnapshotPersister persists snapshots to the Pulumi service.
+// checkpointUploadStats records how the checkpoints of an update were sent to the service.
+type checkpointUploadStats struct {
+	Checkpoints     int           // the number of checkpoints that were sent.
+	Superseded      int           // the number of checkpoints that were replaced by a newer one before being sent.
+	EncodedBytes    int           // the total size of the checkpoints before compression.
+	CompressedBytes int           // the total size of the checkpoints after compression.
+	TotalLatency    time.Duration // the total time spent compressing and sending checkpoints.
+	MaxLatency      time.Duration // the longest time spent compressing and sending a single checkpoint.
+}
+
+// maxFreeCheckpointBuffers is the number of checkpoint buffers kept for reuse. One buffer is being sent while the
+// next is filled, so two suffice for a steady stream of checkpoints.
+const maxFreeCheckpointBuffers = 2
+
+// checkpointUploader sends checkpoints to the service in the background, one at a time. A checkpoint that is waiting
+// to be sent is replaced by any newer checkpoint, as each checkpoint holds the entire state of the update. Encoded
+// checkpoints are compressed by the uploader, and their buffers are reused for later checkpoints.
+type checkpointUploader struct {
+	send func(request []byte) error // sends a compressed checkpoint request to the service.
+
+	m       sync.Mutex
+	idle    *sync.Cond
+	pending *bytes.Buffer   // the newest checkpoint that has yet to be sent, if any.
+	sending bool            // true if a checkpoint is being sent.
+	free    []*bytes.Buffer // buffers that may be reused for later checkpoints.
+	err     error           // the first error that occurred while sending a checkpoint.
+	stats   checkpointUploadStats
+
+	// The compressed request and its compressor. These are only accessed by the goroutine sending checkpoints.
+	compressed bytes.Buffer
+	gz         *gzip.Writer
+}
+
+func newCheckpointUploader(send func(request []byte) error) *checkpointUploader {
+	u := &checkpointUploader{send: send}
+	u.idle = sync.NewCond(&u.m)
+	return u
+}
+
+// buffer returns an empty buffer into which a checkpoint request may be encoded.
+func (u *checkpointUploader) buffer() *bytes.Buffer {
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	if n := len(u.free); n > 0 {
+		buf := u.free[n-1]
+		u.free = u.free[:n-1]
+		return buf
+	}
+	return &bytes.Buffer{}
+}
+
+// release returns a buffer that was obtained from buffer, but that will not be enqueued, to the free list.
+func (u *checkpointUploader) release(buf *bytes.Buffer) {
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	u.releaseLocked(buf)
+}
+
+// releaseLocked returns the given buffer to the free list. Must be called with the lock held.
+func (u *checkpointUploader) releaseLocked(buf *bytes.Buffer) {
+	if len(u.free) < maxFreeCheckpointBuffers {
+		buf.Reset()
+		u.free = append(u.free, buf)
+	}
+}
+
+// enqueue queues the given encoded checkpoint request to be sent, replacing any checkpoint that has yet to be sent.
+// The uploader takes ownership of the buffer. If sending an earlier checkpoint failed, its error is returned and the
+// checkpoint is discarded.
+func (u *checkpointUploader) enqueue(buf *bytes.Buffer) error {
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	if u.err != nil {
+		u.releaseLocked(buf)
+		return u.err
+	}
+	if u.pending != nil {
+		u.stats.Superseded++
+		u.releaseLocked(u.pending)
+	}
+	u.pending = buf
+	if !u.sending {
+		u.sending = true
+		go u.upload()
+	}
+	return nil
+}
+
+// flush waits until every queued checkpoint has been sent or superseded, and returns the upload stats so far along
+// with the first error that occurred while sending them.
+func (u *checkpointUploader) flush() (checkpointUploadStats, error) {
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	for u.sending {
+		u.idle.Wait()
+	}
+	return u.stats, u.err
+}
+
+// upload sends the pending checkpoint until there is none left.
+func (u *checkpointUploader) upload() {
+	u.m.Lock()
+	defer u.m.Unlock()
+
+	for u.pending != nil && u.err == nil {
+		buf := u.pending
+		u.pending = nil
+		u.m.Unlock()
+
+		start := time.Now()
+		compressedBytes, err := u.compressAndSend(buf.Bytes())
+		latency := time.Since(start)
+		metrics.ObserveDuration("checkpoint.upload", "service", latency)
+		metrics.ObserveBytes("checkpoint.compressed", "service", compressedBytes)
+
+		u.m.Lock()
+		if err != nil {
+			u.err = err
+		} else {
+			u.stats.Checkpoints++
+			u.stats.EncodedBytes += buf.Len()
+			u.stats.CompressedBytes += compressedBytes
+		}
+		u.stats.TotalLatency += latency
+		if latency > u.stats.MaxLatency {
+			u.stats.MaxLatency = latency
+		}
+		u.releaseLocked(buf)
+	}
+	if u.pending != nil {
+		u.releaseLocked(u.pending)
+		u.pending = nil
+	}
+	u.sending = false
+	u.idle.Broadcast()
+}
+
+// compressAndSend compresses the given checkpoint request and sends it, returning the size of the compressed request.
+func (u *checkpointUploader) compressAndSend(request []byte) (int, error) {
+	u.compressed.Reset()
+	if u.gz == nil {
+		u.gz = gzip.NewWriter(&u.compressed)
+	} else {
+		u.gz.Reset(&u.compressed)
+	}
+	if _, err := u.gz.Write(request); err != nil {
+		return 0, errors.Wrap(err, "compressing checkpoint")
+	}
+	if err := u.gz.Close(); err != nil {
+		return 0, errors.Wrap(err, "compressing checkpoint")
+	}
+	logging.V(9).Infof("compressed checkpoint from %d to %d bytes",
+		len(request), u.compressed.Len())
+	return u.compressed.Len(), u.send(u.compressed.Bytes())
+}
+
+// cloudSnapshotPersister persists snapshots to the Pulumi service. Each snapshot is encoded as it is saved, after which
+// it is compressed and sent in the background; the backend.SnapshotManager flushes the persister wherever a snapshot
+// must be durable before the update proceeds.
 type cloudSnapshotPersister struct {
 	context     context.Context         // The context to use for client requests.
 	update      client.UpdateIdentifier // The UpdateIdentifier for this update sequence.
 	tokenSource *tokenSource            // A token source for interacting with the service.
 	backend     *cloudBackend           // A backend for communicating with the service
 	sm          secrets.Manager
+	encoder     *stack.DeploymentEncoder // The encoder for checkpoints, reused across saves.
+	uploader    *checkpointUploader      // The uploader that sends checkpoints to the service.
+}
+
+// checkpointRequestPrefix and checkpointRequestSuffix surround an encoded deployment to form the body of a request to
+// the patch update checkpoint endpoint, i.e. a JSON-encoded apitype.PatchUpdateCheckpointRequest.
+var checkpointRequestPrefix, checkpointRequestSuffix = newCheckpointRequestEnvelope()
+
+// newCheckpointRequestEnvelope returns the JSON that precedes and follows the deployment in a checkpoint request. The
+// envelope is found by marshaling a request whose deployment is a placeholder, so that it always matches the
+// request type.
+func newCheckpointRequestEnvelope() (string, string) {
+	const placeholder = `"deployment placeholder"`
+	request, err := json.Marshal(apitype.PatchUpdateCheckpointRequest{
+		Version:    3,
+		Deployment: json.RawMessage(placeholder),
+	})
+	contract.AssertNoError(err)
+
+	i := bytes.Index(request, []byte(placeholder))
+	contract.Assertf(i >= 0, "checkpoint request %s does not contain its deployment", request)
+	return string(request[:i]), string(request[i+len(placeholder):])
 }
 
 func (persister *cloudSnapshotPersister) SecretsManager() secrets.Manager {
@@ -39,26 +234,77 @@ func (persister *cloudSnapshotPersister) SecretsManager() secrets.Manager {
 }
 
 func (persister *cloudSnapshotPersister) Save(snapshot *deploy.Snapshot) error {
+	// The snapshot must be encoded before Save returns, as the engine goes on to modify its resources.
+	start := metrics.Now()
+	buf := persister.uploader.buffer()
+	buf.WriteString(checkpointRequestPrefix)
+	if err := persister.encoder.Encode(buf, snapshot); err != nil {
+		persister.uploader.release(buf)
+		return errors.Wrap(err, "serializing deployment")
+	}
+	buf.WriteString(checkpointRequestSuffix)
+	metrics.ObserveSince("checkpoint.encode", "service", start)
+	metrics.ObserveBytes("checkpoint.bytes", "service", buf.Len())
+	return persister.uploader.enqueue(buf)
+}
+
+// Flush waits until every saved snapshot has been sent to the service or superseded by a later snapshot.
+func (persister *cloudSnapshotPersister) Flush() error {
+	stats, err := persister.uploader.flush()
+	logging.V(7).Infof("checkpoint upload stats: %+v", stats)
+	return err
+}
+
+func (persister *cloudSnapshotPersister) sendCheckpoint(request []byte) error {
+	token, err := persister.tokenSource.GetToken()
+	if err != nil {
+		return err
+	}
+	return persister.backend.client.PatchUpdateCheckpointCompressed(persister.context, persister.update, request,
+		token)
+}
+
+var _ backend.AsyncSnapshotPersister = (*cloudSnapshotPersister)(nil)
+
+// cloudDeltaSnapshotPersister persists snapshots to the Pulumi service as a series of deltas, interspersed with full
+// checkpoints whenever the backend.SnapshotManager compacts its journal.
+type cloudDeltaSnapshotPersister struct {
+	*cloudSnapshotPersister
+}
+
+func (persister *cloudDeltaSnapshotPersister) SaveDelta(delta *backend.SnapshotDelta) error {
+	// Deltas apply on top of the checkpoint most recently sent, so that checkpoint must be sent first.
+	if err := persister.Flush(); err != nil {
+		return err
+	}
 	token, err := persister.tokenSource.GetToken()
 	if err != nil {
 		return err
 	}
-	deployment, err := stack.SerializeDeployment(snapshot, persister.sm, false /* showSecrets */)
+	sdelta, err := delta.Serialize(persister.sm, false /* showSecrets */)
 	if err != nil {
-		return errors.Wrap(err, "serializing deployment")
+		return errors.Wrap(err, "serializing checkpoint delta")
 	}
-	return persister.backend.client.PatchUpdateCheckpoint(persister.context, persister.update, deployment, token)
+	return persister.backend.client.PatchUpdateCheckpointDelta(persister.context, persister.update, sdelta, token)
 }
 
-var _ backend.SnapshotPersister = (*cloudSnapshotPersister)(nil)
+var _ backend.DeltaSnapshotPersister = (*cloudDeltaSnapshotPersister)(nil)
 
+// newSnapshotPersister creates a persister for the given update. Checkpoint deltas require service support, so the
+// persister only sends deltas if PULUMI_EXPERIMENTAL_CHECKPOINT_DELTAS is set.
 func (cb *cloudBackend) newSnapshotPersister(ctx context.Context, update client.UpdateIdentifier,
-	tokenSource *tokenSource, sm secrets.Manager) *cloudSnapshotPersister {
-	return &cloudSnapshotPersister{
+	tokenSource *tokenSource, sm secrets.Manager) backend.SnapshotPersister {
+	persister := &cloudSnapshotPersister{
 		context:     ctx,
 		update:      update,
 		tokenSource: tokenSource,
 		backend:     cb,
 		sm:          sm,
+		encoder:     stack.NewDeploymentEncoder(sm, false /* showSecrets */),
+	}
+	persister.uploader = newCheckpointUploader(persister.sendCheckpoint)
+	if cmdutil.IsTruthy(os.Getenv("PULUMI_EXPERIMENTAL_CHECKPOINT_DELTAS")) {
+		return &cloudDeltaSnapshotPersister{cloudSnapshotPersister: persister}
 	}
+	return persister
 }
@@ -0,0 +1,139 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package httpstate
+
+import (
+	"bytes"
+	"compress/gzip"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io/ioutil"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+)
+
+// decompressCheckpoint decodes a compressed checkpoint request.
+func decompressCheckpoint(t *testing.T, request []byte) apitype.PatchUpdateCheckpointRequest {
+	r, err := gzip.NewReader(bytes.NewReader(request))
+	assert.NoError(t, err)
+	body, err := ioutil.ReadAll(r)
+	assert.NoError(t, err)
+
+	var req apitype.PatchUpdateCheckpointRequest
+	assert.NoError(t, json.Unmarshal(body, &req))
+	return req
+}
+
+func queueCheckpoint(t *testing.T, u *checkpointUploader, deployment string) error {
+	buf := u.buffer()
+	buf.WriteString(checkpointRequestPrefix)
+	buf.WriteString(deployment)
+	buf.WriteString(checkpointRequestSuffix)
+	return u.enqueue(buf)
+}
+
+func TestCheckpointUploaderSupersedes(t *testing.T) {
+	// The service does not respond to the first checkpoint until the test has queued the others.
+	unblock := make(chan struct{})
+	var sent []string
+	u := newCheckpointUploader(func(request []byte) error {
+		if len(sent) == 0 {
+			<-unblock
+		}
+		req := decompressCheckpoint(t, request)
+		assert.Equal(t, 3, req.Version)
+		assert.False(t, req.IsInvalid)
+		sent = append(sent, string(req.Deployment))
+		return nil
+	})
+
+	assert.NoError(t, queueCheckpoint(t, u, `{"n":0}`))
+	for i := 1; i <= 5; i++ {
+		assert.NoError(t, queueCheckpoint(t, u, fmt.Sprintf(`{"n":%d}`, i)))
+	}
+	close(unblock)
+
+	// Only the first and the newest checkpoints are sent.
+	stats, err := u.flush()
+	assert.NoError(t, err)
+	assert.Equal(t, []string{`{"n":0}`, `{"n":5}`}, sent)
+	assert.Equal(t, 2, stats.Checkpoints)
+	assert.Equal(t, 4, stats.Superseded)
+	assert.True(t, len(u.free) <= maxFreeCheckpointBuffers)
+
+	// Flushing with nothing queued returns immediately.
+	_, err = u.flush()
+	assert.NoError(t, err)
+}
+
+func TestCheckpointUploaderReportsErrors(t *testing.T) {
+	sends := 0
+	u := newCheckpointUploader(func(request []byte) error {
+		sends++
+		return errors.New("service unavailable")
+	})
+
+	assert.NoError(t, queueCheckpoint(t, u, `{}`))
+	_, err := u.flush()
+	assert.EqualError(t, err, "service unavailable")
+
+	// The error is sticky: later checkpoints are rejected rather than sent.
+	assert.EqualError(t, queueCheckpoint(t, u, `{}`), "service unavailable")
+	_, err = u.flush()
+	assert.Error(t, err)
+	assert.Equal(t, 1, sends)
+}
+
+func TestCheckpointRequestEnvelope(t *testing.T) {
+	deployment, err := json.Marshal(apitype.DeploymentV3{
+		Manifest:  apitype.ManifestV1{Version: "1.0.0"},
+		Resources: []apitype.ResourceV3{{URN: "urn:pulumi:stack::project::a:b:c::d", Custom: true}},
+	})
+	assert.NoError(t, err)
+	body := checkpointRequestPrefix + string(deployment) + checkpointRequestSuffix
+
+	var req apitype.PatchUpdateCheckpointRequest
+	assert.NoError(t, json.Unmarshal([]byte(body), &req))
+	assert.Equal(t, 3, req.Version)
+	assert.False(t, req.IsInvalid)
+
+	var actual apitype.DeploymentV3
+	assert.NoError(t, json.Unmarshal(req.Deployment, &actual))
+	assert.Equal(t, "1.0.0", actual.Manifest.Version)
+	assert.Len(t, actual.Resources, 1)
+	assert.Equal(t, "urn:pulumi:stack::project::a:b:c::d", string(actual.Resources[0].URN))
+
+	// The body is exactly what marshaling the request itself produces.
+	expected, err := json.Marshal(apitype.PatchUpdateCheckpointRequest{Version: 3, Deployment: deployment})
+	assert.NoError(t, err)
+	assert.Equal(t, string(expected), body)
+}
+
+func TestCheckpointUploaderReusesReleasedBuffers(t *testing.T) {
+	u := newCheckpointUploader(func(request []byte) error { return nil })
+
+	// A buffer that is abandoned, e.g. because encoding the checkpoint failed, is reused by the next checkpoint.
+	buf := u.buffer()
+	buf.WriteString("partial checkpoint")
+	u.release(buf)
+
+	next := u.buffer()
+	assert.True(t, buf == next)
+	assert.Equal(t, 0, next.Len())
+}
@@ -24,6 +24,7 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/engine"
 	"github.com/pulumi/pulumi/pkg/v3/operations"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
@@ -132,6 +133,18 @@ func (s *cloudStack) Snapshot(ctx context.Context) (*deploy.Snapshot, error) {
 	return *s.snapshot, nil
 }
 
+// LazySnapshot returns the stack's latest deployment without decoding the properties of its resources until they are
+// requested.
+func (s *cloudStack) LazySnapshot(ctx context.Context) (*stack.LazyDeployment, error) {
+	if s.snapshot != nil {
+		if *s.snapshot == nil {
+			return nil, nil
+		}
+		return stack.NewLazyDeployment(*s.snapshot), nil
+	}
+	return s.b.getLazySnapshot(ctx, s.ref)
+}
+
 func (s *cloudStack) Remove(ctx context.Context, force bool) (bool, error) {
 	return backend.RemoveStack(ctx, s, force)
 }
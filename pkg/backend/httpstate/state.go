@@ -17,7 +17,6 @@ package httpstate
 import (
 	"context"
 	"fmt"
-	"sync"
 	"time"
 
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag"
@@ -157,30 +156,13 @@ func (u *cloudUpdate) Complete(status apitype.UpdateStatus) error {
 
 // recordEngineEvents will record the events with the Pulumi Service, enabling things like viewing
 // the update logs or drilling into the timeline of an update.
-func (u *cloudUpdate) recordEngineEvents(startingSeqNumber int, events []engine.Event) error {
+func (u *cloudUpdate) recordEngineEvents(batch engineEventBatch) error {
 	contract.Assert(u.tokenSource != nil)
 	token, err := u.tokenSource.GetToken()
 	if err != nil {
 		return err
 	}
-
-	var apiEvents apitype.EngineEventBatch
-	for idx, event := range events {
-		apiEvent, convErr := display.ConvertEngineEvent(event)
-		if convErr != nil {
-			return errors.Wrap(convErr, "converting engine event")
-		}
-
-		// Each event within an update must have a unique sequence number. Any request to
-		// emit an update with the same sequence number will fail. (Read: the caller needs
-		// to be accurate about this.)
-		apiEvent.Sequence = idx + startingSeqNumber
-		apiEvent.Timestamp = int(time.Now().Unix())
-
-		apiEvents.Events = append(apiEvents.Events, apiEvent)
-	}
-
-	return u.backend.client.RecordEngineEvents(u.context, u.update, apiEvents, token)
+	return u.backend.client.RecordEngineEventsRaw(u.context, u.update, batch.events, token)
 }
 
 // RecordAndDisplayEvents inspects engine events from the given channel, and prints them to the CLI as well as
@@ -278,6 +260,16 @@ func (b *cloudBackend) getSnapshot(ctx context.Context, stackRef backend.StackRe
 	return snapshot, nil
 }
 
+func (b *cloudBackend) getLazySnapshot(ctx context.Context,
+	stackRef backend.StackReference) (*stack.LazyDeployment, error) {
+
+	untypedDeployment, err := b.exportDeployment(ctx, stackRef, nil /* get latest */)
+	if err != nil {
+		return nil, err
+	}
+	return stack.DeserializeUntypedDeploymentLazy(untypedDeployment, stack.DefaultSecretsProvider)
+}
+
 func (b *cloudBackend) getTarget(ctx context.Context, stackRef backend.StackReference,
 	cfg config.Map, dec config.Decrypter) (*deploy.Target, error) {
 
@@ -307,11 +299,6 @@ func isDebugDiagEvent(e engine.Event) bool {
 	return e.Type == engine.DiagEvent && (e.Payload().(engine.DiagEventPayload)).Severity == diag.Debug
 }
 
-type engineEventBatch struct {
-	sequenceStart int
-	events        []engine.Event
-}
-
 // persistEngineEvents reads from a channel of engine events and persists them on the
 // Pulumi Service. This is the data that powers the logs display.
 func persistEngineEvents(
@@ -319,83 +306,27 @@ func persistEngineEvents(
 	events <-chan engine.Event, done chan<- bool) {
 	// A single update can emit hundreds, if not thousands, or tens of thousands of
 	// engine events. We transmit engine events in large batches to reduce the overhead
-	// associated with each HTTP request to the service. We also send multiple HTTP
-	// requests concurrently, as to not block processing subsequent engine events.
-
-	// Maximum number of events to batch up before transmitting.
-	const maxEventsToTransmit = 50
-	// Maximum wait time before sending all batched events.
-	const maxTransmissionDelay = 4 * time.Second
-	// Maximum number of concurrent requests to the Pulumi Service to persist
-	// engine events.
-	const maxConcurrentRequests = 3
+	// associated with each HTTP request to the service, and send multiple HTTP requests
+	// concurrently. Sending events never blocks reading them, so that a slow service
+	// cannot hold up the engine.
+	uploader := newEngineEventUploader(update.recordEngineEvents)
 
 	// We don't want to indicate that we are done processing every engine event in the
-	// provided channel until every HTTP request has completed. We use a wait group to
-	// track all of those requests.
-	var wg sync.WaitGroup
-
+	// provided channel until every HTTP request has completed.
 	defer func() {
-		wg.Wait()
+		stats := uploader.close()
+		logging.V(4).Infof("recorded %d engine events in %d batches: max queue depth %d (%d bytes), "+
+			"%d batches (%d events) evicted, %d batches (%d events) failed, %d retries, "+
+			"total latency %v, max latency %v",
+			stats.Events, stats.Batches, stats.MaxQueueDepth, stats.MaxQueueBytes,
+			stats.EvictedBatches, stats.EvictedEvents, stats.FailedBatches, stats.FailedEvents,
+			stats.RetriedBatches, stats.TotalLatency, stats.MaxLatency)
 		close(done)
 	}()
 
-	var eventBatch []engine.Event
-	maxDelayTicker := time.NewTicker(maxTransmissionDelay)
-
-	// We maintain a sequence counter for each event to ensure that the Pulumi Service can
-	// ensure events can be reconstructured in the same order they were emitted. (And not
-	// out of order from parallel writes and/or network delays.)
-	eventIdx := 0
-
-	// As we identify batches of engine events to transmit, we put them into a channel.
-	// This will allow us to issue HTTP requests concurrently, but also limit the maximum
-	// number of requests in-flight at any one time.
-	//
-	// This channel isn't buffered, so adding a new batch of events to persist will block
-	// until a go-routine is available to send the batch.
-	batchesToTransmit := make(chan engineEventBatch)
-
-	transmitBatchLoop := func() {
-		wg.Add(1)
-		defer wg.Done()
-
-		for eventBatch := range batchesToTransmit {
-			err := update.recordEngineEvents(eventBatch.sequenceStart, eventBatch.events)
-			if err != nil {
-				logging.V(3).Infof("error recording engine events: %s", err)
-			}
-		}
-	}
-	// Start N different go-routines which will all pull from the batchesToTransmit channel
-	// and persist those engine events until the channel is closed.
-	for i := 0; i < maxConcurrentRequests; i++ {
-		go transmitBatchLoop()
-	}
-
-	// transmitBatch sends off the current batch of engine events (eventIdx, eventBatch) to the
-	// batchesToTransmit channel. Will mutate eventIdx, eventBatch as a side effect.
-	transmitBatch := func() {
-		if len(eventBatch) == 0 {
-			return
-		}
-
-		batch := engineEventBatch{
-			sequenceStart: eventIdx,
-			events:        eventBatch,
-		}
-		// This will block until one of the spawned go-routines is available to read the data.
-		// Effectively providing a global rate limit for how quickly we can send data to the
-		// Pulumi Service, if an update is particularly chatty.
-		batchesToTransmit <- batch
-
-		// With the values of eventIdx and eventBatch copied into engineEventBatch,
-		// we now modify their values for the next time transmitBatch is called.
-		eventIdx += len(eventBatch)
-		eventBatch = nil
-	}
+	maxDelayTicker := time.NewTicker(maxEventTransmissionDelay)
+	defer maxDelayTicker.Stop()
 
-	var sawCancelEvent bool
 	for {
 		select {
 		case e := <-events:
@@ -406,31 +337,15 @@ func persistEngineEvents(
 
 			// Stop processing once we see the CancelEvent.
 			if e.Type == engine.CancelEvent {
-				sawCancelEvent = true
-				break
+				return
 			}
 
-			eventBatch = append(eventBatch, e)
-			if len(eventBatch) >= maxEventsToTransmit {
-				transmitBatch()
-			}
+			uploader.add(e)
 
 		case <-maxDelayTicker.C:
 			// If the ticker has fired, send any batched events. This sets an upper bound for
 			// the delay between the event being observed and persisted.
-			transmitBatch()
-		}
-
-		if sawCancelEvent {
-			break
+			uploader.flush()
 		}
 	}
-
-	// Transmit any lingering events.
-	transmitBatch()
-	// Closing the batchesToTransmit channel will signal the worker persistence routines to
-	// terminate, which will trigger the `wg` WaitGroup to be marked as complete, which will
-	// finally close the `done` channel so the caller knows we are finished processing the
-	// engine event stream.
-	close(batchesToTransmit)
 }
@@ -15,8 +15,10 @@
 package backend
 
 import (
+	"os"
 	"reflect"
 	"sort"
+	"strconv"
 	"time"
 
 	"github.com/pkg/errors"
@@ -24,12 +26,73 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/engine"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
 	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/pkg/v3/util/metrics"
 	"github.com/pulumi/pulumi/pkg/v3/version"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
 )
 
+const (
+	// refreshCheckpointInterval is the number of refreshed resources after which the SnapshotManager persists the
+	// results of an ongoing refresh.
+	refreshCheckpointInterval = 256
+	// refreshCheckpointPeriod is the time after which the SnapshotManager persists the results of an ongoing refresh,
+	// regardless of the number of refreshed resources.
+	refreshCheckpointPeriod = 10 * time.Second
+)
+
+const (
+	// CheckpointWriteIntervalEnvVar is the environment variable that supplies SnapshotWritePolicy.MaxDelay, e.g. "2s".
+	CheckpointWriteIntervalEnvVar = "PULUMI_CHECKPOINT_WRITE_INTERVAL"
+	// CheckpointWriteMutationsEnvVar is the environment variable that supplies SnapshotWritePolicy.MaxMutations.
+	CheckpointWriteMutationsEnvVar = "PULUMI_CHECKPOINT_WRITE_MUTATIONS"
+)
+
+// SnapshotWritePolicy determines how the SnapshotManager coalesces checkpoint writes. The zero value writes a
+// checkpoint after every mutation.
+//
+// When writes are coalesced, a completed step may be persisted up to MaxDelay after it completes or after up to
+// MaxMutations further mutations, whichever comes first. The checkpoint is still written--along with any coalesced
+// mutations--before the engine asks a provider to create, update, delete or import a resource, so the pending
+// operation for any such call is always persisted before the call is made. If the update is interrupted, each step
+// that completed but went unpersisted is therefore recorded in the checkpoint either as it was before the step or as
+// a pending operation, exactly as if the interruption had occurred while the step was running.
+type SnapshotWritePolicy struct {
+	// MaxDelay is the longest time that a mutation may go unpersisted. Zero means no time limit.
+	MaxDelay time.Duration
+	// MaxMutations is the largest number of mutations that may go unpersisted before a write. Zero means no limit.
+	MaxMutations int
+}
+
+// coalesces returns true if the policy allows writes to be deferred at all.
+func (p SnapshotWritePolicy) coalesces() bool {
+	return p.MaxDelay > 0 || p.MaxMutations > 1
+}
+
+// GetSnapshotWritePolicy returns the write policy configured by the PULUMI_CHECKPOINT_WRITE_INTERVAL and
+// PULUMI_CHECKPOINT_WRITE_MUTATIONS environment variables. If neither is set, every mutation is written immediately.
+func GetSnapshotWritePolicy() (SnapshotWritePolicy, error) {
+	var policy SnapshotWritePolicy
+	if v := os.Getenv(CheckpointWriteIntervalEnvVar); v != "" {
+		d, err := time.ParseDuration(v)
+		if err != nil || d < 0 {
+			return SnapshotWritePolicy{}, errors.Errorf("invalid %s %q: expected a non-negative duration",
+				CheckpointWriteIntervalEnvVar, v)
+		}
+		policy.MaxDelay = d
+	}
+	if v := os.Getenv(CheckpointWriteMutationsEnvVar); v != "" {
+		n, err := strconv.Atoi(v)
+		if err != nil || n < 0 {
+			return SnapshotWritePolicy{}, errors.Errorf("invalid %s %q: expected a non-negative integer",
+				CheckpointWriteMutationsEnvVar, v)
+		}
+		policy.MaxMutations = n
+	}
+	return policy, nil
+}
+
 // SnapshotPersister is an interface implemented by our backends that implements snapshot
 // persistence. In order to fit into our current model, snapshot persisters have two functions:
 // saving snapshots and invalidating already-persisted snapshots.
@@ -40,6 +103,18 @@ type SnapshotPersister interface {
 	SecretsManager() secrets.Manager
 }
 
+// AsyncSnapshotPersister is an optional interface implemented by snapshot persisters that may finish persisting a
+// snapshot after Save returns. A snapshot that has not been persisted yet may be superseded by a later one, and an
+// error that occurs while persisting a snapshot is returned by a later call to Save or Flush. The SnapshotManager
+// calls Flush whenever a mutation must be durable before the engine proceeds, and when it is closed.
+type AsyncSnapshotPersister interface {
+	SnapshotPersister
+
+	// Flush waits until every snapshot passed to Save has been persisted or superseded, and returns any error that
+	// occurred while persisting them.
+	Flush() error
+}
+
 // SnapshotManager is an implementation of engine.SnapshotManager that inspects steps and performs
 // mutations on the global snapshot object serially. This implementation maintains two bits of state: the "base"
 // snapshot, which is completely immutable and represents the state of the world prior to the application
@@ -63,15 +138,22 @@ type SnapshotManager struct {
 	dones            map[*resource.State]bool // The set of resources that have been operated upon already by this plan
 	completeOps      map[*resource.State]bool // The set of resources that have completed their operation
 	doVerify         bool                     // If true, verify the snapshot before persisting it
+	policy           SnapshotWritePolicy      // The policy used to coalesce checkpoint writes
+	journal          *snapshotJournal         // The journal of unpersisted mutations, if persisting deltas
 	mutationRequests chan<- mutationRequest   // The queue of mutation requests, to be retired serially by the manager
 	cancel           chan bool                // A channel used to request cancellation of any new mutation requests.
 	done             <-chan error             // A channel that sends a single result when the manager has shut down.
+
+	refreshed        map[*resource.State]*resource.State // The refreshed states of base resources
+	refreshes        int                                 // The number of refreshes since the last refresh checkpoint
+	lastRefreshWrite time.Time                           // The time of the last refresh checkpoint
 }
 
 var _ engine.SnapshotManager = (*SnapshotManager)(nil)
 
 type mutationRequest struct {
 	mutator func() bool
+	flush   bool // true if the mutation must be persisted before the request completes
 	result  chan<- error
 }
 
@@ -95,12 +177,34 @@ func (sm *SnapshotManager) Close() error {
 // meaningful changes (see sameSnapshotMutation.mustWrite for details). Any elided writes
 // are flushed by the next non-elided write or the next call to Close.
 //
+// If the manager's write policy coalesces writes, a write may be deferred until enough time has passed or enough
+// mutations have accumulated. Mutations submitted via mutateAndFlush are always persisted before they return.
+//
+// If the persister is a DeltaSnapshotPersister, a write only persists the mutations recorded in the journal since the
+// previous write. A full snapshot is written periodically to compact the journal and by the call to Close.
+//
 // You should never observe or mutate the global snapshot without using this function unless
 // you have a very good justification.
 func (sm *SnapshotManager) mutate(mutator func() bool) error {
+	return sm.request(mutator, false)
+}
+
+// mutateAndFlush is like mutate, but ensures that the snapshot--including any coalesced writes--has been persisted
+// before it returns, regardless of the manager's write policy. It is used to record pending operations before the
+// engine calls a provider to perform an operation that is not idempotent.
+func (sm *SnapshotManager) mutateAndFlush(mutator func() bool) error {
+	return sm.request(mutator, true)
+}
+
+func (sm *SnapshotManager) request(mutator func() bool, flush bool) error {
+	// The time a mutation takes includes the time that it waits for the mutations ahead of it and for any snapshot
+	// that is written on its behalf.
+	start := metrics.Now()
+	defer metrics.ObserveSince("snapshot.mutate", "", start)
+
 	result := make(chan error)
 	select {
-	case sm.mutationRequests <- mutationRequest{mutator: mutator, result: result}:
+	case sm.mutationRequests <- mutationRequest{mutator: mutator, flush: flush, result: result}:
 		return <-result
 	case <-sm.cancel:
 		return errors.New("snapshot manager closed")
@@ -119,7 +223,10 @@ func (sm *SnapshotManager) mutate(mutator func() bool) error {
 // Note that this is completely not thread-safe and defeats the purpose of having a `mutate` callback
 // entirely, but the hope is that this state of things will not be permament.
 func (sm *SnapshotManager) RegisterResourceOutputs(step deploy.Step) error {
-	return sm.mutate(func() bool { return true })
+	return sm.mutate(func() bool {
+		sm.markRewritten(step.New())
+		return true
+	})
 }
 
 // BeginMutation signals to the SnapshotManager that the engine intends to mutate the global snapshot
@@ -296,7 +403,7 @@ func (ssm *sameSnapshotMutation) End(step deploy.Step, successful bool) error {
 
 func (sm *SnapshotManager) doCreate(step deploy.Step) (engine.SnapshotMutation, error) {
 	logging.V(9).Infof("SnapshotManager.doCreate(%s)", step.URN())
-	err := sm.mutate(func() bool {
+	err := sm.mutateAndFlush(func() bool {
 		sm.markOperationPending(step.New(), resource.OperationTypeCreating)
 		return true
 	})
@@ -334,13 +441,17 @@ func (csm *createSnapshotMutation) End(step deploy.Step, successful bool) error
 				csm.manager.markDone(old)
 			}
 		}
+		// Replacements may have marked the old state for deletion in place.
+		if old := step.Old(); old != nil {
+			csm.manager.markRewritten(old)
+		}
 		return true
 	})
 }
 
 func (sm *SnapshotManager) doUpdate(step deploy.Step) (engine.SnapshotMutation, error) {
 	logging.V(9).Infof("SnapshotManager.doUpdate(%s)", step.URN())
-	err := sm.mutate(func() bool {
+	err := sm.mutateAndFlush(func() bool {
 		sm.markOperationPending(step.New(), resource.OperationTypeUpdating)
 		return true
 	})
@@ -370,7 +481,9 @@ func (usm *updateSnapshotMutation) End(step deploy.Step, successful bool) error
 
 func (sm *SnapshotManager) doDelete(step deploy.Step) (engine.SnapshotMutation, error) {
 	logging.V(9).Infof("SnapshotManager.doDelete(%s)", step.URN())
-	err := sm.mutate(func() bool {
+	err := sm.mutateAndFlush(func() bool {
+		// Delete-before-replace steps mark the old state as pending replacement in place.
+		sm.markRewritten(step.Old())
 		sm.markOperationPending(step.Old(), resource.OperationTypeDeleting)
 		return true
 	})
@@ -438,6 +551,10 @@ func (rsm *readSnapshotMutation) End(step deploy.Step, successful bool) error {
 
 			rsm.manager.markNew(step.New())
 		}
+		// Read replacements mark the old state for deletion in place.
+		if old := step.Old(); old != nil {
+			rsm.manager.markRewritten(old)
+		}
 		return true
 	})
 }
@@ -451,11 +568,34 @@ func (rsm *refreshSnapshotMutation) End(step deploy.Step, successful bool) error
 	contract.Require(step.Op() == deploy.OpRefresh, "step.Op() == deploy.OpRefresh")
 	logging.V(9).Infof("SnapshotManager: refreshSnapshotMutation.End(..., %v)", successful)
 	return rsm.manager.mutate(func() bool {
-		// We always elide refreshes. The expectation is that all of these run before any actual mutations and that
+		// We elide most refreshes. The expectation is that all of these run before any actual mutations and that
 		// some other component will rewrite the base snapshot in-memory, so there's no action the snapshot
 		// manager needs to take other than to remember that the base snapshot--and therefore the actual snapshot--may
 		// have changed.
-		return false
+		//
+		// So that the progress of a long refresh isn't lost if it is interrupted, the refreshed states are written
+		// in place of their base states once every refreshCheckpointInterval refreshes or refreshCheckpointPeriod,
+		// whichever comes first. Resources that the refresh found to be deleted are retained until the base
+		// snapshot is rebuilt so that the dependencies of the remaining resources stay intact.
+		sm := rsm.manager
+		if journal := sm.journal; journal != nil {
+			journal.requireCompaction("refresh")
+		}
+		if old, new := step.Old(), step.New(); successful && new != nil && new != old {
+			sm.refreshed[old] = new
+		}
+
+		now := time.Now()
+		if sm.lastRefreshWrite.IsZero() {
+			sm.lastRefreshWrite = now
+		}
+		sm.refreshes++
+		if sm.refreshes < refreshCheckpointInterval && now.Sub(sm.lastRefreshWrite) < refreshCheckpointPeriod {
+			return false
+		}
+		logging.V(9).Infof("SnapshotManager: persisting %d refreshes", sm.refreshes)
+		sm.refreshes, sm.lastRefreshWrite = 0, now
+		return true
 	})
 }
 
@@ -476,7 +616,7 @@ func (rsm *removePendingReplaceSnapshotMutation) End(step deploy.Step, successfu
 
 func (sm *SnapshotManager) doImport(step deploy.Step) (engine.SnapshotMutation, error) {
 	logging.V(9).Infof("SnapshotManager.doImport(%s)", step.URN())
-	err := sm.mutate(func() bool {
+	err := sm.mutateAndFlush(func() bool {
 		sm.markOperationPending(step.New(), resource.OperationTypeImporting)
 		return true
 	})
@@ -501,6 +641,10 @@ func (ism *importSnapshotMutation) End(step deploy.Step, successful bool) error
 		if successful {
 			ism.manager.markNew(step.New())
 		}
+		// Import replacements mark the original state for deletion in place, and that state is not visible to us.
+		if journal := ism.manager.journal; journal != nil && step.Op() == deploy.OpImportReplacement {
+			journal.requireCompaction("import replacement")
+		}
 		return true
 	})
 }
@@ -510,6 +654,9 @@ func (ism *importSnapshotMutation) End(step deploy.Step, successful bool) error
 func (sm *SnapshotManager) markDone(state *resource.State) {
 	contract.Assert(state != nil)
 	sm.dones[state] = true
+	if sm.journal != nil {
+		sm.journal.removeState(state)
+	}
 	logging.V(9).Infof("Marked old state snapshot as done: %v", state.URN)
 }
 
@@ -519,13 +666,28 @@ func (sm *SnapshotManager) markDone(state *resource.State) {
 func (sm *SnapshotManager) markNew(state *resource.State) {
 	contract.Assert(state != nil)
 	sm.resources = append(sm.resources, state)
+	if sm.journal != nil {
+		sm.journal.appendState(state)
+	}
 	logging.V(9).Infof("Appended new state snapshot to be written: %v", state.URN)
 }
 
+// markRewritten records that a resource state that may already be part of the snapshot has been mutated in place.
+// This is only necessary when persisting deltas: full snapshots observe these mutations implicitly.
+func (sm *SnapshotManager) markRewritten(state *resource.State) {
+	contract.Assert(state != nil)
+	if sm.journal != nil {
+		sm.journal.rewriteState(state)
+	}
+}
+
 // markOperationPending marks a resource as undergoing an operation that will now be considered pending.
 func (sm *SnapshotManager) markOperationPending(state *resource.State, op resource.OperationType) {
 	contract.Assert(state != nil)
 	sm.operations = append(sm.operations, resource.NewOperation(state, op))
+	if sm.journal != nil {
+		sm.journal.beginOperation(state, op)
+	}
 	logging.V(9).Infof("SnapshotManager.markPendingOperation(%s, %s)", state.URN, string(op))
 }
 
@@ -533,6 +695,9 @@ func (sm *SnapshotManager) markOperationPending(state *resource.State, op resour
 func (sm *SnapshotManager) markOperationComplete(state *resource.State) {
 	contract.Assert(state != nil)
 	sm.completeOps[state] = true
+	if sm.journal != nil {
+		sm.journal.endOperations(state)
+	}
 	logging.V(9).Infof("SnapshotManager.markOperationComplete(%s)", state.URN)
 }
 
@@ -576,6 +741,9 @@ func (sm *SnapshotManager) snap() *deploy.Snapshot {
 	if base := sm.baseSnapshot; base != nil {
 		for _, res := range base.Resources {
 			if !sm.dones[res] {
+				if refreshed, has := sm.refreshed[res]; has {
+					res = refreshed
+				}
 				resources = append(resources, res)
 			}
 		}
@@ -599,8 +767,14 @@ func (sm *SnapshotManager) snap() *deploy.Snapshot {
 	return deploy.NewSnapshot(manifest, sm.persister.SecretsManager(), resources, operations)
 }
 
-// saveSnapshot persists the current snapshot and optionally verifies it afterwards.
+// saveSnapshot persists the current snapshot and optionally verifies it afterwards. If the manager is persisting
+// deltas, only the mutations recorded since the last write are persisted unless the journal is due for compaction.
 func (sm *SnapshotManager) saveSnapshot() error {
+	if sm.journal != nil && !sm.journal.needsCompaction() {
+		return sm.saveDelta()
+	}
+
+	start := metrics.Now()
 	snap := sm.snap()
 	if err := snap.NormalizeURNReferences(); err != nil {
 		return errors.Wrap(err, "failed to normalize URN references")
@@ -608,6 +782,10 @@ func (sm *SnapshotManager) saveSnapshot() error {
 	if err := sm.persister.Save(snap); err != nil {
 		return errors.Wrap(err, "failed to save snapshot")
 	}
+	metrics.ObserveSince("checkpoint.save", "full", start)
+	if sm.journal != nil {
+		sm.journal.reset(snap, len(sm.resources), sm.baseSnapshot, sm.dones)
+	}
 	if sm.doVerify {
 		if err := snap.VerifyIntegrity(); err != nil {
 			return errors.Wrapf(err, "failed to verify snapshot")
@@ -616,6 +794,30 @@ func (sm *SnapshotManager) saveSnapshot() error {
 	return nil
 }
 
+// flushPersister waits for the persister to finish persisting the snapshots that it has been given, if it persists
+// them asynchronously.
+func (sm *SnapshotManager) flushPersister() error {
+	if persister, ok := sm.persister.(AsyncSnapshotPersister); ok {
+		if err := persister.Flush(); err != nil {
+			return errors.Wrap(err, "failed to save snapshot")
+		}
+	}
+	return nil
+}
+
+// saveDelta persists the mutations recorded by the journal since the last write.
+func (sm *SnapshotManager) saveDelta() error {
+	start := metrics.Now()
+	delta := sm.journal.flush()
+	if err := sm.persister.(DeltaSnapshotPersister).SaveDelta(delta); err != nil {
+		// We no longer know what the persisted state looks like, so any later write must be a full snapshot.
+		sm.journal.requireCompaction("failed delta")
+		return errors.Wrap(err, "failed to save snapshot delta")
+	}
+	metrics.ObserveSince("checkpoint.save", "delta", start)
+	return nil
+}
+
 // NewSnapshotManager creates a new SnapshotManager for the given stack name, using the given persister
 // and base snapshot.
 //
@@ -623,6 +825,14 @@ func (sm *SnapshotManager) saveSnapshot() error {
 // given to the engine! The engine will mutate this object and correctness of the
 // SnapshotManager depends on being able to observe this mutation. (This is not ideal...)
 func NewSnapshotManager(persister SnapshotPersister, baseSnap *deploy.Snapshot) *SnapshotManager {
+	return NewSnapshotManagerWithPolicy(persister, baseSnap, SnapshotWritePolicy{})
+}
+
+// NewSnapshotManagerWithPolicy creates a new SnapshotManager that coalesces checkpoint writes according to the given
+// policy. See NewSnapshotManager for details.
+func NewSnapshotManagerWithPolicy(persister SnapshotPersister, baseSnap *deploy.Snapshot,
+	policy SnapshotWritePolicy) *SnapshotManager {
+
 	mutationRequests, cancel, done := make(chan mutationRequest), make(chan bool), make(chan error)
 
 	manager := &SnapshotManager{
@@ -630,39 +840,93 @@ func NewSnapshotManager(persister SnapshotPersister, baseSnap *deploy.Snapshot)
 		baseSnapshot:     baseSnap,
 		dones:            make(map[*resource.State]bool),
 		completeOps:      make(map[*resource.State]bool),
+		refreshed:        make(map[*resource.State]*resource.State),
 		doVerify:         true,
+		policy:           policy,
 		mutationRequests: mutationRequests,
 		cancel:           cancel,
 		done:             done,
 	}
+	if _, ok := persister.(DeltaSnapshotPersister); ok {
+		manager.journal = newSnapshotJournal()
+	}
 
 	go func() {
 		// True if we have elided writes since the last actual write.
 		hasElidedWrites := false
 
+		// The number of writes that have been deferred by the write policy, the timer that bounds how long they may
+		// be deferred, and the error from the last write made when that timer fired, if any. As there is no request
+		// waiting on such a write, its error is reported by the next request instead.
+		deferred := 0
+		var deadline *time.Timer
+		var deadlineC <-chan time.Time
+		var deferredErr error
+
+		save := func() error {
+			if deadline != nil {
+				deadline.Stop()
+				deadline, deadlineC = nil, nil
+			}
+			deferred, hasElidedWrites = 0, false
+			return manager.saveSnapshot()
+		}
+
 		// Service each mutation request in turn.
 	serviceLoop:
 		for {
 			select {
 			case request := <-mutationRequests:
 				var err error
-				if request.mutator() {
-					err = manager.saveSnapshot()
-					hasElidedWrites = false
-				} else {
-					hasElidedWrites = true
+				mustWrite := request.mutator()
+				hasElidedWrites = true
+				if mustWrite {
+					deferred++
+				}
+				switch {
+				case request.flush, mustWrite && !policy.coalesces(),
+					mustWrite && policy.MaxMutations > 0 && deferred >= policy.MaxMutations:
+					err = save()
+				case mustWrite && deadline == nil && policy.MaxDelay > 0:
+					deadline = time.NewTimer(policy.MaxDelay)
+					deadlineC = deadline.C
+				}
+				if request.flush && err == nil {
+					err = manager.flushPersister()
+				}
+				if deferredErr != nil {
+					err, deferredErr = deferredErr, nil
 				}
 				request.result <- err
+			case <-deadlineC:
+				deadline, deadlineC = nil, nil
+				logging.V(9).Infof("SnapshotManager: persisting %d coalesced writes", deferred)
+				if err := save(); err != nil {
+					deferredErr = err
+				}
 			case <-cancel:
 				break serviceLoop
 			}
 		}
+		if deadline != nil {
+			deadline.Stop()
+		}
 
-		// If we still have elided writes once the channel has closed, flush the snapshot.
-		var err error
+		// If we still have elided writes once the channel has closed, flush the snapshot. If we have been persisting
+		// deltas, compact the journal into a full snapshot.
+		if journal := manager.journal; journal != nil && journal.dirty() {
+			journal.requireCompaction("close")
+			hasElidedWrites = true
+		}
+		err := deferredErr
 		if hasElidedWrites {
 			logging.V(9).Infof("SnapshotManager: flushing elided writes...")
-			err = manager.saveSnapshot()
+			if saveErr := manager.saveSnapshot(); err == nil {
+				err = saveErr
+			}
+		}
+		if flushErr := manager.flushPersister(); err == nil {
+			err = flushErr
 		}
 		done <- err
 	}()
@@ -0,0 +1,259 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package backend
+
+import (
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
+	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
+)
+
+// minSnapshotCompactionInterval is the minimum number of delta records that are persisted before the SnapshotManager
+// writes a full snapshot. Above this floor, a full snapshot is written once the journal holds as many records as the
+// last full snapshot held resources, which bounds the amortized cost of each step by a constant.
+const minSnapshotCompactionInterval = 64
+
+// DeltaSnapshotPersister is an optional interface implemented by snapshot persisters that are able to persist
+// incremental changes to a snapshot. When a SnapshotManager is given a DeltaSnapshotPersister, it only calls Save
+// periodically to compact the journal and when it is closed; every other mutation is persisted by calling SaveDelta
+// with the changes made since the previous call to Save or SaveDelta.
+type DeltaSnapshotPersister interface {
+	SnapshotPersister
+
+	// SaveDelta persists the given delta, which applies on top of the snapshot most recently persisted with Save
+	// and any subsequent deltas. Returns an error if the persistence failed.
+	SaveDelta(delta *SnapshotDelta) error
+}
+
+// SnapshotDeltaRecord is a single mutation of a snapshot. See apitype.CheckpointDeltaRecordV1 for a description of
+// the way in which records identify resources and operations.
+type SnapshotDeltaRecord struct {
+	Kind      apitype.CheckpointDeltaKind // the kind of mutation.
+	ID        int                         // the journal ID of the affected resource or operation.
+	State     *resource.State             // the affected state, if any.
+	Operation resource.OperationType      // the type of the operation, for beginOperation records.
+}
+
+// SnapshotDelta is an ordered set of mutations to the snapshot most recently persisted in full.
+type SnapshotDelta struct {
+	Sequence    int                   // the sequence number of this delta.
+	AppendIndex int                   // the index in the base snapshot at which appended resources are inserted.
+	Records     []SnapshotDeltaRecord // the mutations, in order.
+}
+
+// Serialize turns a delta into a structure suitable for persistence, encrypting any secrets using the given
+// secrets manager.
+func (delta *SnapshotDelta) Serialize(sm secrets.Manager, showSecrets bool) (*apitype.CheckpointDeltaV1, error) {
+	enc := config.NewPanicCrypter()
+	if sm != nil {
+		e, err := sm.Encrypter()
+		if err != nil {
+			return nil, errors.Wrap(err, "getting encrypter for deployment")
+		}
+		enc = e
+	}
+
+	records := make([]apitype.CheckpointDeltaRecordV1, len(delta.Records))
+	for i, rec := range delta.Records {
+		records[i] = apitype.CheckpointDeltaRecordV1{
+			Kind:          rec.Kind,
+			ID:            rec.ID,
+			OperationType: apitype.OperationType(rec.Operation),
+		}
+		if rec.State != nil {
+			records[i].URN = rec.State.URN
+			if rec.Kind != apitype.CheckpointDeltaRemove && rec.Kind != apitype.CheckpointDeltaEndOperation {
+				res, err := stack.SerializeResource(rec.State, enc, showSecrets)
+				if err != nil {
+					return nil, errors.Wrap(err, "serializing resource")
+				}
+				records[i].Resource = &res
+			}
+		}
+	}
+
+	return &apitype.CheckpointDeltaV1{
+		Sequence:    delta.Sequence,
+		AppendIndex: delta.AppendIndex,
+		Records:     records,
+	}, nil
+}
+
+// snapshotJournal tracks the mutations made by a SnapshotManager since it last persisted a full snapshot so that
+// they can be persisted as SnapshotDeltas.
+type snapshotJournal struct {
+	ids         map[*resource.State]int   // the journal ID of each resource state known to the journal
+	opIDs       map[*resource.State][]int // the journal IDs of the outstanding operations on each resource state
+	removable   map[*resource.State]bool  // the states of the base snapshot that have not been removed
+	baseURNs    map[resource.URN]bool     // the URNs of the resources in the last full snapshot
+	nextID      int                       // the next resource ID to allocate
+	nextOpID    int                       // the next operation ID to allocate
+	appendIndex int                       // the index in the last full snapshot at which resources are appended
+	sequence    int                       // the sequence number of the next delta
+	records     []SnapshotDeltaRecord     // the records that have not been persisted yet
+	persisted   int                       // the number of records persisted since the last full snapshot
+	baseSize    int                       // the number of resources in the last full snapshot
+	compact     bool                      // true if the next write must be a full snapshot
+}
+
+func newSnapshotJournal() *snapshotJournal {
+	// The first write is always a full snapshot so that deltas never apply to a base that was not written by
+	// this journal's manager.
+	return &snapshotJournal{
+		ids:       make(map[*resource.State]int),
+		opIDs:     make(map[*resource.State][]int),
+		removable: make(map[*resource.State]bool),
+		baseURNs:  make(map[resource.URN]bool),
+		compact:   true,
+	}
+}
+
+// reset records that the given snapshot has been persisted in full. appendIndex is the number of resources at the
+// front of the snapshot that were produced by the current plan, and base is the plan's base snapshot.
+func (j *snapshotJournal) reset(snap *deploy.Snapshot, appendIndex int, base *deploy.Snapshot,
+	dones map[*resource.State]bool) {
+
+	j.ids = make(map[*resource.State]int, len(snap.Resources))
+	j.baseURNs = make(map[resource.URN]bool, len(snap.Resources))
+	for i, res := range snap.Resources {
+		j.ids[res] = i
+		j.baseURNs[res.URN] = true
+	}
+	j.opIDs = make(map[*resource.State][]int, len(snap.PendingOperations))
+	for i, op := range snap.PendingOperations {
+		j.opIDs[op.Resource] = append(j.opIDs[op.Resource], i)
+	}
+	j.removable = make(map[*resource.State]bool)
+	if base != nil {
+		for _, res := range base.Resources {
+			if !dones[res] {
+				j.removable[res] = true
+			}
+		}
+	}
+
+	j.nextID, j.nextOpID = len(snap.Resources), len(snap.PendingOperations)
+	j.appendIndex, j.baseSize = appendIndex, len(snap.Resources)
+	j.records, j.persisted, j.compact = nil, 0, false
+}
+
+// requireCompaction forces the next write to be a full snapshot. This is necessary whenever the snapshot changes in
+// ways that cannot be expressed as a delta.
+func (j *snapshotJournal) requireCompaction(reason string) {
+	if !j.compact {
+		logging.V(9).Infof("SnapshotManager: journal requires compaction: %s", reason)
+	}
+	j.compact = true
+}
+
+// needsCompaction returns true if the next write should be a full snapshot.
+func (j *snapshotJournal) needsCompaction() bool {
+	if j.compact {
+		return true
+	}
+	threshold := j.baseSize
+	if threshold < minSnapshotCompactionInterval {
+		threshold = minSnapshotCompactionInterval
+	}
+	return j.persisted+len(j.records) >= threshold
+}
+
+// dirty returns true if the journal holds mutations that have not been persisted as part of a full snapshot.
+func (j *snapshotJournal) dirty() bool {
+	return j.persisted != 0 || len(j.records) != 0
+}
+
+func (j *snapshotJournal) appendState(state *resource.State) {
+	id := j.nextID
+	j.nextID++
+	j.ids[state] = id
+	j.records = append(j.records, SnapshotDeltaRecord{Kind: apitype.CheckpointDeltaAppend, ID: id, State: state})
+
+	// An alias that refers to a resource in the last full snapshot may require that references held by other
+	// resources be rewritten. Leave that to NormalizeURNReferences as part of a full write.
+	for _, alias := range state.Aliases {
+		if j.baseURNs[alias] {
+			j.requireCompaction("aliased resource")
+			break
+		}
+	}
+}
+
+func (j *snapshotJournal) rewriteState(state *resource.State) {
+	if id, has := j.ids[state]; has {
+		j.records = append(j.records, SnapshotDeltaRecord{Kind: apitype.CheckpointDeltaRewrite, ID: id, State: state})
+	}
+}
+
+func (j *snapshotJournal) removeState(state *resource.State) {
+	// Only resources from the base snapshot are ever filtered out of a snapshot; see SnapshotManager.snap.
+	if !j.removable[state] {
+		return
+	}
+	delete(j.removable, state)
+	if id, has := j.ids[state]; has {
+		j.records = append(j.records, SnapshotDeltaRecord{Kind: apitype.CheckpointDeltaRemove, ID: id, State: state})
+	}
+}
+
+func (j *snapshotJournal) beginOperation(state *resource.State, op resource.OperationType) {
+	id := j.nextOpID
+	j.nextOpID++
+	j.opIDs[state] = append(j.opIDs[state], id)
+	j.records = append(j.records, SnapshotDeltaRecord{
+		Kind:      apitype.CheckpointDeltaBeginOperation,
+		ID:        id,
+		State:     state,
+		Operation: op,
+	})
+}
+
+func (j *snapshotJournal) endOperations(state *resource.State) {
+	for _, id := range j.opIDs[state] {
+		j.records = append(j.records, SnapshotDeltaRecord{Kind: apitype.CheckpointDeltaEndOperation, ID: id, State: state})
+	}
+	delete(j.opIDs, state)
+}
+
+// flush returns the unpersisted records as a delta. Rewrites of a state that is already appended or rewritten
+// earlier in the same delta are dropped, as the state is serialized only once the delta is persisted.
+func (j *snapshotJournal) flush() *SnapshotDelta {
+	written := make(map[int]bool)
+	records := j.records[:0:0]
+	for _, rec := range j.records {
+		switch rec.Kind {
+		case apitype.CheckpointDeltaAppend:
+			written[rec.ID] = true
+		case apitype.CheckpointDeltaRewrite:
+			if written[rec.ID] {
+				continue
+			}
+			written[rec.ID] = true
+		}
+		records = append(records, rec)
+	}
+
+	delta := &SnapshotDelta{Sequence: j.sequence, AppendIndex: j.appendIndex, Records: records}
+	j.sequence++
+	j.persisted += len(j.records)
+	j.records = nil
+	return delta
+}
@@ -0,0 +1,171 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package backend
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+)
+
+// MockDeltaStackPersister records full snapshots and deltas in their serialized forms.
+type MockDeltaStackPersister struct {
+	MockStackPersister
+
+	Base   *apitype.DeploymentV3
+	Deltas []apitype.CheckpointDeltaV1
+}
+
+func (m *MockDeltaStackPersister) Save(snap *deploy.Snapshot) error {
+	deployment, err := stack.SerializeDeployment(snap, m.SecretsManager(), false)
+	if err != nil {
+		return err
+	}
+	m.Base, m.Deltas = deployment, nil
+	return m.MockStackPersister.Save(snap)
+}
+
+func (m *MockDeltaStackPersister) SaveDelta(delta *SnapshotDelta) error {
+	sdelta, err := delta.Serialize(m.SecretsManager(), false)
+	if err != nil {
+		return err
+	}
+	m.Deltas = append(m.Deltas, *sdelta)
+	return nil
+}
+
+// Replay returns the deployment produced by applying the persisted deltas to the last full snapshot.
+func (m *MockDeltaStackPersister) Replay(t *testing.T) *apitype.DeploymentV3 {
+	deployment, err := stack.ApplyCheckpointDeltas(m.Base, m.Deltas)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	return deployment
+}
+
+func TestDeltaPersistence(t *testing.T) {
+	a := NewResource("a")
+	b := NewResource("b", a.URN)
+	c := NewResource("c", a.URN, b.URN)
+	d := NewResource("d", c.URN)
+	e := NewResource("e", c.URN)
+	snap := NewSnapshot([]*resource.State{a, b, c, d, e})
+
+	sp := &MockDeltaStackPersister{}
+	manager := NewSnapshotManager(sp, snap)
+
+	// assertReplayMatches checks that replaying the persisted deltas produces the same deployment as serializing the
+	// manager's current snapshot.
+	assertReplayMatches := func() {
+		if sp.Base == nil {
+			return
+		}
+		expected, err := stack.SerializeDeployment(manager.snap(), sp.SecretsManager(), false)
+		if !assert.NoError(t, err) {
+			t.FailNow()
+		}
+		actual := sp.Replay(t)
+		assert.Equal(t, expected.Resources, actual.Resources)
+		assert.Equal(t, expected.PendingOperations, actual.PendingOperations)
+	}
+
+	applyStepWith := func(step deploy.Step, successful bool, apply func()) {
+		mutation, err := manager.BeginMutation(step)
+		if !assert.NoError(t, err) {
+			t.FailNow()
+		}
+		assertReplayMatches()
+
+		if apply != nil {
+			apply()
+		}
+
+		err = mutation.End(step, successful)
+		if !assert.NoError(t, err) {
+			t.FailNow()
+		}
+		assertReplayMatches()
+	}
+	applyStep := func(step deploy.Step, successful bool) {
+		applyStepWith(step, successful, nil)
+	}
+
+	// The first write is always a full snapshot.
+	bPrime := NewResource(string(b.URN))
+	bPrime.Outputs = resource.PropertyMap{"foo": resource.NewStringProperty("bar")}
+	applyStep(deploy.NewSameStep(nil, MockRegisterResourceEvent{}, b, bPrime), true)
+	assert.Len(t, sp.SavedSnapshots, 1)
+	assert.Len(t, sp.Deltas, 0)
+
+	// Replace c. Like the engine, mark the old c for deletion in place while the replacement is being created.
+	cPrime := NewResource(string(c.URN), bPrime.URN)
+	createReplacement := deploy.NewCreateReplacementStep(nil, MockRegisterResourceEvent{}, c, cPrime, nil, nil, nil, true)
+	applyStepWith(createReplacement, true, func() { c.Delete = true })
+	applyStep(deploy.NewReplaceStep(nil, c, cPrime, nil, nil, nil, true), true)
+
+	// Update d, then fail to update e, which leaves no pending operation behind.
+	dPrime := NewResource(string(d.URN), cPrime.URN)
+	applyStep(deploy.NewUpdateStep(nil, MockRegisterResourceEvent{}, d, dPrime, nil, nil, nil, nil), true)
+	ePrime := NewResource(string(e.URN), cPrime.URN)
+	applyStep(deploy.NewUpdateStep(nil, MockRegisterResourceEvent{}, e, ePrime, nil, nil, nil, nil), false)
+
+	// Register new outputs for d.
+	dPrime.Outputs = resource.PropertyMap{"baz": resource.NewNumberProperty(42)}
+	assert.NoError(t, manager.RegisterResourceOutputs(deploy.NewSameStep(nil, nil, dPrime, dPrime)))
+	assertReplayMatches()
+
+	// Create f, then delete the old c and a.
+	f := NewResource("f", dPrime.URN)
+	applyStep(deploy.NewCreateStep(nil, &MockRegisterResourceEvent{}, f), true)
+	applyStep(deploy.NewDeleteReplacementStep(nil, c, false), true)
+	applyStep(deploy.NewDeleteStep(nil, a), true)
+
+	// Everything after the first write should have been persisted as deltas.
+	assert.Len(t, sp.SavedSnapshots, 1)
+	assert.NotEmpty(t, sp.Deltas)
+
+	// Closing the manager compacts the journal.
+	expected, err := stack.SerializeDeployment(manager.snap(), sp.SecretsManager(), false)
+	assert.NoError(t, err)
+	assert.NoError(t, manager.Close())
+	assert.Len(t, sp.SavedSnapshots, 2)
+	assert.Len(t, sp.Deltas, 0)
+	assert.Equal(t, expected.Resources, sp.Base.Resources)
+}
+
+func TestDeltaPersistenceCompaction(t *testing.T) {
+	snap := NewSnapshot(nil)
+	sp := &MockDeltaStackPersister{}
+	manager := NewSnapshotManager(sp, snap)
+
+	// Creating many resources eventually requires a compaction.
+	for i := 0; i < 2*minSnapshotCompactionInterval; i++ {
+		res := NewResource(string(rune('a'+i%26)) + string(rune('A'+i/26)))
+		step := deploy.NewCreateStep(nil, &MockRegisterResourceEvent{}, res)
+		mutation, err := manager.BeginMutation(step)
+		assert.NoError(t, err)
+		assert.NoError(t, mutation.End(step, true))
+	}
+	assert.True(t, len(sp.SavedSnapshots) > 1)
+
+	replayed := sp.Replay(t)
+	assert.Len(t, replayed.Resources, 2*minSnapshotCompactionInterval)
+	assert.NoError(t, manager.Close())
+}
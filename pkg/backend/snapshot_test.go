@@ -15,6 +15,8 @@
 package backend
 
 import (
+	"fmt"
+	"os"
 	"testing"
 	"time"
 
@@ -940,3 +942,158 @@ func TestRegisterOutputs(t *testing.T) {
 	assert.Len(t, lastSnap.Resources, 1)
 	assert.Equal(t, resourceA.URN, lastSnap.Resources[0].URN)
 }
+
+func TestRefreshCheckpoints(t *testing.T) {
+	var resources []*resource.State
+	for i := 0; i < refreshCheckpointInterval+1; i++ {
+		resources = append(resources, NewResource(fmt.Sprintf("urn:pulumi:stack::project::type::r%d", i)))
+	}
+	snap := NewSnapshot(resources)
+
+	sp := &MockStackPersister{}
+	manager := NewSnapshotManager(sp, snap)
+
+	// Refreshes are persisted in batches rather than individually.
+	for i, res := range resources {
+		step := deploy.NewRefreshStep(nil, res, nil)
+		mutation, err := manager.BeginMutation(step)
+		if !assert.NoError(t, err) {
+			t.FailNow()
+		}
+		assert.NoError(t, mutation.End(step, true))
+
+		if i < refreshCheckpointInterval-1 {
+			assert.Len(t, sp.SavedSnapshots, 0)
+		} else {
+			assert.Len(t, sp.SavedSnapshots, 1)
+		}
+	}
+
+	// The remaining refresh is flushed by Close.
+	assert.NoError(t, manager.Close())
+	assert.Len(t, sp.SavedSnapshots, 2)
+	assert.Len(t, sp.SavedSnapshots[1].Resources, len(resources))
+}
+
+func TestCoalescedWrites(t *testing.T) {
+	resourceA := NewResource("a")
+	resourceB := NewResource("b")
+	snap := NewSnapshot([]*resource.State{resourceA})
+
+	sp := &MockStackPersister{}
+	manager := NewSnapshotManagerWithPolicy(sp, snap, SnapshotWritePolicy{MaxMutations: 3})
+
+	registerOutputs := func() {
+		assert.NoError(t, manager.RegisterResourceOutputs(deploy.NewSameStep(nil, nil, resourceA, resourceA)))
+	}
+
+	// Writes are deferred until three have accumulated.
+	registerOutputs()
+	registerOutputs()
+	assert.Len(t, sp.SavedSnapshots, 0)
+	registerOutputs()
+	assert.Len(t, sp.SavedSnapshots, 1)
+
+	// Beginning a create always writes the pending operation, along with any deferred writes.
+	registerOutputs()
+	step := deploy.NewCreateStep(nil, &MockRegisterResourceEvent{}, resourceB)
+	mutation, err := manager.BeginMutation(step)
+	assert.NoError(t, err)
+	assert.Len(t, sp.SavedSnapshots, 2)
+	assert.Len(t, sp.LastSnap().PendingOperations, 1)
+
+	// Completing it does not.
+	assert.NoError(t, mutation.End(step, true /* successful */))
+	assert.Len(t, sp.SavedSnapshots, 2)
+
+	// The deferred write is flushed by Close.
+	assert.NoError(t, manager.Close())
+	assert.Len(t, sp.SavedSnapshots, 3)
+	assert.Len(t, sp.LastSnap().Resources, 2)
+	assert.Len(t, sp.LastSnap().PendingOperations, 0)
+}
+
+// notifyingStackPersister is a MockStackPersister that signals each save on a channel.
+type notifyingStackPersister struct {
+	MockStackPersister
+	saved chan bool
+}
+
+func (m *notifyingStackPersister) Save(snap *deploy.Snapshot) error {
+	err := m.MockStackPersister.Save(snap)
+	m.saved <- true
+	return err
+}
+
+func TestCoalescedWritesMaxDelay(t *testing.T) {
+	resourceA := NewResource("a")
+	snap := NewSnapshot([]*resource.State{resourceA})
+
+	sp := &notifyingStackPersister{saved: make(chan bool, 4)}
+	manager := NewSnapshotManagerWithPolicy(sp, snap, SnapshotWritePolicy{MaxDelay: 10 * time.Millisecond})
+
+	// The write is deferred, but is made once the delay has passed.
+	assert.NoError(t, manager.RegisterResourceOutputs(deploy.NewSameStep(nil, nil, resourceA, resourceA)))
+	select {
+	case <-sp.saved:
+	case <-time.After(10 * time.Second):
+		assert.Fail(t, "timed out waiting for coalesced write")
+	}
+	assert.Len(t, sp.SavedSnapshots, 1)
+
+	// Nothing is left to flush.
+	assert.NoError(t, manager.Close())
+	assert.Len(t, sp.SavedSnapshots, 1)
+}
+
+// asyncStackPersister is a MockStackPersister that counts the number of times that it is flushed.
+type asyncStackPersister struct {
+	MockStackPersister
+	flushes int
+}
+
+func (m *asyncStackPersister) Flush() error {
+	m.flushes++
+	return nil
+}
+
+func TestAsyncPersisterFlushes(t *testing.T) {
+	resourceA := NewResource("a")
+	resourceB := NewResource("b")
+	snap := NewSnapshot([]*resource.State{resourceA})
+
+	sp := &asyncStackPersister{}
+	manager := NewSnapshotManager(sp, snap)
+
+	// Outputs need not be durable before the engine proceeds.
+	assert.NoError(t, manager.RegisterResourceOutputs(deploy.NewSameStep(nil, nil, resourceA, resourceA)))
+	assert.Len(t, sp.SavedSnapshots, 1)
+	assert.Equal(t, 0, sp.flushes)
+
+	// Pending operations must be.
+	step := deploy.NewCreateStep(nil, &MockRegisterResourceEvent{}, resourceB)
+	mutation, err := manager.BeginMutation(step)
+	assert.NoError(t, err)
+	assert.Equal(t, 1, sp.flushes)
+	assert.NoError(t, mutation.End(step, true /* successful */))
+	assert.Equal(t, 1, sp.flushes)
+
+	// Everything must be durable once the manager is closed.
+	assert.NoError(t, manager.Close())
+	assert.Equal(t, 2, sp.flushes)
+}
+
+func TestGetSnapshotWritePolicy(t *testing.T) {
+	defer os.Unsetenv(CheckpointWriteIntervalEnvVar)
+	defer os.Unsetenv(CheckpointWriteMutationsEnvVar)
+
+	os.Setenv(CheckpointWriteIntervalEnvVar, "2s")
+	os.Setenv(CheckpointWriteMutationsEnvVar, "100")
+	policy, err := GetSnapshotWritePolicy()
+	assert.NoError(t, err)
+	assert.Equal(t, SnapshotWritePolicy{MaxDelay: 2 * time.Second, MaxMutations: 100}, policy)
+
+	os.Setenv(CheckpointWriteMutationsEnvVar, "many")
+	_, err = GetSnapshotWritePolicy()
+	assert.Error(t, err)
+}
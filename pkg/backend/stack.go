@@ -24,6 +24,7 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/engine"
 	"github.com/pulumi/pulumi/pkg/v3/operations"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
@@ -123,6 +124,27 @@ func ExportStackDeployment(ctx context.Context, s Stack) (*apitype.UntypedDeploy
 	return s.Backend().ExportDeployment(ctx, s)
 }
 
+// LazySnapshotStack is implemented by stacks that can load their latest snapshot without decoding the properties of
+// every resource up front.
+type LazySnapshotStack interface {
+	// LazySnapshot returns the stack's latest deployment, or nil if the stack has never been deployed.
+	LazySnapshot(ctx context.Context) (*stack.LazyDeployment, error)
+}
+
+// GetLazySnapshot returns the given stack's latest deployment, decoding resource properties on demand if the stack
+// supports it. Returns nil if the stack has never been deployed. Read-only operations that only need a few resources
+// should prefer this to Stack.Snapshot.
+func GetLazySnapshot(ctx context.Context, s Stack) (*stack.LazyDeployment, error) {
+	if lazy, ok := s.(LazySnapshotStack); ok {
+		return lazy.LazySnapshot(ctx)
+	}
+	snap, err := s.Snapshot(ctx)
+	if err != nil || snap == nil {
+		return nil, err
+	}
+	return stack.NewLazyDeployment(snap), nil
+}
+
 // ImportStackDeployment imports the given deployment into the indicated stack.
 func ImportStackDeployment(ctx context.Context, s Stack, deployment *apitype.UntypedDeployment) error {
 	return s.Backend().ImportDeployment(ctx, s, deployment)
@@ -40,9 +40,11 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/backend/filestate"
 	"github.com/pulumi/pulumi/pkg/v3/backend/httpstate"
 	"github.com/pulumi/pulumi/pkg/v3/backend/httpstate/client"
+	"github.com/pulumi/pulumi/pkg/v3/util/metrics"
 	"github.com/pulumi/pulumi/pkg/v3/version"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag/colors"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/cmdutil"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/httputil"
@@ -58,6 +60,7 @@ func NewPulumiCmd() *cobra.Command {
 	var tracing string
 	var tracingHeaderFlag string
 	var profiling string
+	var metricsFile string
 	var verbose int
 	var color string
 
@@ -123,6 +126,16 @@ func NewPulumiCmd() *cobra.Command {
 				if err := cmdutil.InitProfiling(profiling); err != nil {
 					logging.Warningf("could not initialize profiling: %v", err)
 				}
+				metrics.EnableProfilerLabels()
+			}
+			if metricsFile != "" {
+				metrics.Enable()
+			}
+
+			if cmdutil.IsTruthy(os.Getenv("PULUMI_DISABLE_ASSET_HASH_CACHE")) {
+				logging.V(5).Infof("asset hash cache disabled")
+			} else if path, err := workspace.GetAssetHashCachePath(); err == nil {
+				resource.EnableAssetHashCache(path)
 			}
 
 			if cmdutil.IsTruthy(os.Getenv("PULUMI_SKIP_UPDATE_CHECK")) {
@@ -149,6 +162,11 @@ func NewPulumiCmd() *cobra.Command {
 				cmdutil.Diag().Warningf(checkVersionMsg)
 			}
 
+			// A failure to save the asset hash cache is not fatal: the hashes will be recomputed next time.
+			if err := resource.FlushAssetHashCache(); err != nil {
+				logging.V(5).Infof("failed to save asset hash cache: %v", err)
+			}
+
 			logging.Flush()
 			cmdutil.CloseTracing()
 
@@ -157,6 +175,11 @@ func NewPulumiCmd() *cobra.Command {
 					logging.Warningf("could not close profiling: %v", err)
 				}
 			}
+			if metricsFile != "" {
+				if err := metrics.WriteSummary(metricsFile); err != nil {
+					logging.Warningf("could not write metrics: %v", err)
+				}
+			}
 		},
 	}
 
@@ -176,6 +199,8 @@ func NewPulumiCmd() *cobra.Command {
 		"Emit tracing to the specified endpoint. Use the `file:` scheme to write tracing data to a local file")
 	cmd.PersistentFlags().StringVar(&profiling, "profiling", "",
 		"Emit CPU and memory profiles and an execution trace to '[filename].[pid].{cpu,mem,trace}', respectively")
+	cmd.PersistentFlags().StringVar(&metricsFile, "metrics", "",
+		"Write a JSON summary of engine latencies and checkpoint sizes to the specified file on exit")
 	cmd.PersistentFlags().IntVarP(&verbose, "verbose", "v", 0,
 		"Enable verbose logging (e.g., v=3); anything >3 is very verbose")
 	cmd.PersistentFlags().StringVar(
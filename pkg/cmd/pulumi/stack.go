@@ -26,6 +26,7 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/backend/display"
 	"github.com/pulumi/pulumi/pkg/v3/backend/httpstate"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/cmdutil"
 )
@@ -135,7 +136,7 @@ func newStackCmd() *cobra.Command {
 					Prefix:  "    ",
 				})
 
-				outputs, err := getStackOutputs(snap, showSecrets)
+				outputs, err := getStackOutputs(stack.NewLazyDeployment(snap), showSecrets)
 				if err == nil {
 					fmt.Printf("\n")
 					printStackOutputs(outputs)
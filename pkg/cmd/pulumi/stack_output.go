@@ -20,8 +20,8 @@ import (
 	"github.com/pkg/errors"
 	"github.com/spf13/cobra"
 
+	"github.com/pulumi/pulumi/pkg/v3/backend"
 	"github.com/pulumi/pulumi/pkg/v3/backend/display"
-	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
 	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/cmdutil"
@@ -50,7 +50,7 @@ func newStackOutputCmd() *cobra.Command {
 			if err != nil {
 				return err
 			}
-			snap, err := s.Snapshot(commandContext())
+			snap, err := backend.GetLazySnapshot(commandContext(), s)
 			if err != nil {
 				return err
 			}
@@ -99,19 +99,21 @@ func newStackOutputCmd() *cobra.Command {
 	return cmd
 }
 
-func getStackOutputs(snap *deploy.Snapshot, showSecrets bool) (map[string]interface{}, error) {
-	state, err := stack.GetRootStackResource(snap)
-	if err != nil {
-		return nil, err
-	}
-
+func getStackOutputs(snap *stack.LazyDeployment, showSecrets bool) (map[string]interface{}, error) {
+	state := snap.RootStackResource()
 	if state == nil {
 		return map[string]interface{}{}, nil
 	}
 
+	// Only the outputs of the root stack resource are needed, so the rest of the deployment is never decoded.
+	outputs, err := state.Outputs()
+	if err != nil {
+		return nil, err
+	}
+
 	// massageSecrets will remove all the secrets from the property map, so it should be safe to pass a panic
 	// crypter. This also ensure that if for some reason we didn't remove everything, we don't accidentally disclose
 	// secret values!
-	return stack.SerializeProperties(display.MassageSecrets(state.Outputs, showSecrets),
+	return stack.SerializeProperties(display.MassageSecrets(outputs, showSecrets),
 		config.NewPanicCrypter(), showSecrets)
 }
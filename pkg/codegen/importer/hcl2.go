@@ -38,12 +38,10 @@ var Null = &model.Variable{
 // GenerateHCL2Definition generates a Pulumi HCL2 definition for a given resource.
 func GenerateHCL2Definition(loader schema.Loader, state *resource.State, names NameTable) (*model.Block, error) {
 	// TODO: pull the package version from the resource's provider
-	pkg, err := loader.LoadPackage(string(state.Type.Package()), nil)
+	r, ok, err := schema.LoadResource(loader, string(state.Type.Package()), nil, string(state.Type))
 	if err != nil {
 		return nil, err
 	}
-
-	r, ok := pkg.GetResource(string(state.Type))
 	if !ok {
 		return nil, fmt.Errorf("unknown resource type '%v'", r)
 	}
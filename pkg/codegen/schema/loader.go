@@ -1,6 +1,13 @@
 package schema
 
 import (
+	"bufio"
+	"bytes"
+	"encoding/json"
+	"fmt"
+	"io/ioutil"
+	"os"
+	"path/filepath"
 	"sync"
 
 	"github.com/blang/semver"
@@ -8,9 +15,17 @@ import (
 	"github.com/pkg/errors"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/plugin"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/workspace"
 )
 
+// schemaCacheDir is the name of the directory under the plugin directory that holds cached provider schemas.
+const schemaCacheDir = "schemas"
+
+// schemaCacheFormatVersion is the version of the schema cache's file format.
+const schemaCacheFormatVersion = 1
+
 type Loader interface {
 	LoadPackage(pkg string, version *semver.Version) (*Package, error)
 }
@@ -18,17 +33,21 @@ type Loader interface {
 type pluginLoader struct {
 	m sync.RWMutex
 
-	host    plugin.Host
-	entries map[string]*Package
+	host     plugin.Host
+	entries  map[string]*Package
+	partials map[string]*PartialPackage
 }
 
 func NewPluginLoader(host plugin.Host) Loader {
 	return &pluginLoader{
-		host:    host,
-		entries: map[string]*Package{},
+		host:     host,
+		entries:  map[string]*Package{},
+		partials: map[string]*PartialPackage{},
 	}
 }
 
+var _ PartialLoader = (*pluginLoader)(nil)
+
 func (l *pluginLoader) getPackage(key string) (*Package, bool) {
 	l.m.RLock()
 	defer l.m.RUnlock()
@@ -64,11 +83,16 @@ func (l *pluginLoader) ensurePlugin(pkg string, version *semver.Version) error {
 	return nil
 }
 
-func (l *pluginLoader) LoadPackage(pkg string, version *semver.Version) (*Package, error) {
+func packageKey(pkg string, version *semver.Version) string {
 	key := pkg + "@"
 	if version != nil {
 		key += version.String()
 	}
+	return key
+}
+
+func (l *pluginLoader) LoadPackage(pkg string, version *semver.Version) (*Package, error) {
+	key := packageKey(pkg, version)
 
 	if p, ok := l.getPackage(key); ok {
 		return p, nil
@@ -78,23 +102,64 @@ func (l *pluginLoader) LoadPackage(pkg string, version *semver.Version) (*Packag
 		return nil, err
 	}
 
-	provider, err := l.host.Provider(tokens.Package(pkg), version)
+	schemaBytes, err := l.loadSchemaBytes(pkg, version)
 	if err != nil {
 		return nil, err
 	}
 
-	schemaFormatVersion := 0
-	schemaBytes, err := provider.GetSchema(schemaFormatVersion)
+	var spec PackageSpec
+	if err := jsoniter.Unmarshal(schemaBytes, &spec); err != nil {
+		return nil, err
+	}
+
+	p, err := importSpec(spec, nil, l)
 	if err != nil {
 		return nil, err
 	}
 
-	var spec PackageSpec
+	l.m.Lock()
+	defer l.m.Unlock()
+
+	if p, ok := l.entries[key]; ok {
+		return p, nil
+	}
+	l.entries[key] = p
+
+	return p, nil
+}
+
+func (l *pluginLoader) getPartialPackage(key string) (*PartialPackage, bool) {
+	l.m.RLock()
+	defer l.m.RUnlock()
+
+	p, ok := l.partials[key]
+	return p, ok
+}
+
+// LoadPartialPackage loads the given package without binding any of its types, resources, or functions. These are
+// bound on first use.
+func (l *pluginLoader) LoadPartialPackage(pkg string, version *semver.Version) (*PartialPackage, error) {
+	key := packageKey(pkg, version)
+
+	if p, ok := l.getPartialPackage(key); ok {
+		return p, nil
+	}
+
+	if err := l.ensurePlugin(pkg, version); err != nil {
+		return nil, err
+	}
+
+	schemaBytes, err := l.loadSchemaBytes(pkg, version)
+	if err != nil {
+		return nil, err
+	}
+
+	var spec PartialPackageSpec
 	if err := jsoniter.Unmarshal(schemaBytes, &spec); err != nil {
 		return nil, err
 	}
 
-	p, err := importSpec(spec, nil, l)
+	p, err := ImportPartialSpec(spec, l)
 	if err != nil {
 		return nil, err
 	}
@@ -102,10 +167,140 @@ func (l *pluginLoader) LoadPackage(pkg string, version *semver.Version) (*Packag
 	l.m.Lock()
 	defer l.m.Unlock()
 
-	if p, ok := l.entries[pkg]; ok {
+	if p, ok := l.partials[key]; ok {
 		return p, nil
 	}
-	l.entries[key] = p
+	l.partials[key] = p
 
 	return p, nil
 }
+
+// loadSchemaBytes returns the schema for the given package. If the schema for the package's plugin binary has been
+// cached on disk, the cached schema is returned. Otherwise, the schema is fetched from the provider and cached.
+func (l *pluginLoader) loadSchemaBytes(pkg string, version *semver.Version) ([]byte, error) {
+	cachePath, header, cacheable := getSchemaCacheEntry(pkg, version)
+	if cacheable {
+		if schemaBytes, ok := readCachedSchema(cachePath, header); ok {
+			logging.V(7).Infof("loaded schema for %s from %s", pkg, cachePath)
+			return schemaBytes, nil
+		}
+	}
+
+	provider, err := l.host.Provider(tokens.Package(pkg), version)
+	if err != nil {
+		return nil, err
+	}
+
+	schemaFormatVersion := 0
+	schemaBytes, err := provider.GetSchema(schemaFormatVersion)
+	if err != nil {
+		return nil, err
+	}
+
+	if cacheable {
+		// A failure to cache the schema is not fatal: we'll just ask the provider again next time.
+		if err := writeCachedSchema(cachePath, header, schemaBytes); err != nil {
+			logging.V(5).Infof("failed to cache schema for %s: %v", pkg, err)
+		}
+	}
+	return schemaBytes, nil
+}
+
+// schemaCacheHeader identifies the plugin binary that produced a cached schema. A cached schema is only used if the
+// plugin binary that the host would launch still matches its header.
+type schemaCacheHeader struct {
+	FormatVersion int    `json:"formatVersion"`
+	PluginPath    string `json:"pluginPath"`
+	Size          int64  `json:"size"`
+	ModTime       int64  `json:"modTime"`
+}
+
+// getSchemaCacheEntry returns the path of the on-disk cache entry for the given package's schema and the header that
+// the entry must have to be valid. Only the schemas of versioned, installed plugins are cached.
+func getSchemaCacheEntry(pkg string, version *semver.Version) (string, schemaCacheHeader, bool) {
+	if version == nil {
+		return "", schemaCacheHeader{}, false
+	}
+
+	_, pluginPath, err := workspace.GetPluginPath(workspace.ResourcePlugin, pkg, version)
+	if err != nil || pluginPath == "" {
+		return "", schemaCacheHeader{}, false
+	}
+	stat, err := os.Stat(pluginPath)
+	if err != nil {
+		return "", schemaCacheHeader{}, false
+	}
+
+	pluginDir, err := workspace.GetPluginDir()
+	if err != nil {
+		return "", schemaCacheHeader{}, false
+	}
+	cachePath := filepath.Join(pluginDir, schemaCacheDir, fmt.Sprintf("%s-v%s.json", pkg, version))
+
+	return cachePath, schemaCacheHeader{
+		FormatVersion: schemaCacheFormatVersion,
+		PluginPath:    pluginPath,
+		Size:          stat.Size(),
+		ModTime:       stat.ModTime().UnixNano(),
+	}, true
+}
+
+// readCachedSchema reads the cached schema at the given path. The cached schema is only returned if the cache entry's
+// header matches the given header.
+func readCachedSchema(path string, header schemaCacheHeader) ([]byte, bool) {
+	contents, err := ioutil.ReadFile(path)
+	if err != nil {
+		return nil, false
+	}
+
+	newline := bytes.IndexByte(contents, '\n')
+	if newline == -1 {
+		return nil, false
+	}
+	var cached schemaCacheHeader
+	if err := json.Unmarshal(contents[:newline], &cached); err != nil || cached != header {
+		return nil, false
+	}
+	return contents[newline+1:], true
+}
+
+// writeCachedSchema writes the given schema to the cache entry at the given path. The file is written to a temporary
+// location and then renamed into place so that concurrent readers never observe a partially-written entry.
+func writeCachedSchema(path string, header schemaCacheHeader, schemaBytes []byte) error {
+	headerBytes, err := json.Marshal(header)
+	if err != nil {
+		return err
+	}
+
+	dir := filepath.Dir(path)
+	if err := os.MkdirAll(dir, 0700); err != nil {
+		return err
+	}
+	f, err := ioutil.TempFile(dir, filepath.Base(path)+".*.tmp")
+	if err != nil {
+		return err
+	}
+	defer func() {
+		// Once the entry has been renamed into place, this is a no-op.
+		contract.IgnoreError(os.Remove(f.Name()))
+	}()
+
+	w := bufio.NewWriter(f)
+	_, err = w.Write(headerBytes)
+	if err == nil {
+		err = w.WriteByte('\n')
+	}
+	if err == nil {
+		_, err = w.Write(schemaBytes)
+	}
+	if err == nil {
+		err = w.Flush()
+	}
+	if closeErr := f.Close(); err == nil {
+		err = closeErr
+	}
+	if err != nil {
+		return err
+	}
+	return os.Rename(f.Name(), path)
+}
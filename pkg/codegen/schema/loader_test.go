@@ -0,0 +1,71 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package schema
+
+import (
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func TestSchemaCache(t *testing.T) {
+	dir, err := ioutil.TempDir("", "schema-cache")
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	defer os.RemoveAll(dir)
+
+	path := filepath.Join(dir, schemaCacheDir, "test-v1.0.0.json")
+	header := schemaCacheHeader{
+		FormatVersion: schemaCacheFormatVersion,
+		PluginPath:    "/plugins/pulumi-resource-test",
+		Size:          42,
+		ModTime:       1600000000,
+	}
+	schemaBytes := []byte(`{"name":"test","version":"1.0.0"}` + "\n")
+
+	// Nothing has been cached yet.
+	_, ok := readCachedSchema(path, header)
+	assert.False(t, ok)
+
+	assert.NoError(t, writeCachedSchema(path, header, schemaBytes))
+	cached, ok := readCachedSchema(path, header)
+	assert.True(t, ok)
+	assert.Equal(t, schemaBytes, cached)
+
+	// The temporary file has been renamed into place.
+	files, err := ioutil.ReadDir(filepath.Dir(path))
+	assert.NoError(t, err)
+	assert.Len(t, files, 1)
+
+	// A different plugin binary invalidates the entry.
+	changed := header
+	changed.ModTime++
+	_, ok = readCachedSchema(path, changed)
+	assert.False(t, ok)
+
+	// So does a corrupt entry.
+	assert.NoError(t, ioutil.WriteFile(path, []byte("not a header"), 0600))
+	_, ok = readCachedSchema(path, header)
+	assert.False(t, ok)
+}
+
+func TestSchemaCacheEntryRequiresVersion(t *testing.T) {
+	_, _, ok := getSchemaCacheEntry("test", nil)
+	assert.False(t, ok)
+}
@@ -0,0 +1,330 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package schema
+
+import (
+	"encoding/json"
+	"strings"
+	"sync"
+
+	"github.com/blang/semver"
+	jsoniter "github.com/json-iterator/go"
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
+)
+
+// PartialPackageSpec is a PackageSpec whose complex types, resources, and functions have not yet been decoded.
+type PartialPackageSpec struct {
+	PackageSpec
+
+	// Types is a map from type token to the undecoded ComplexTypeSpec that describes the type.
+	Types map[string]json.RawMessage `json:"types,omitempty"`
+	// Resources is a map from type token to the undecoded ResourceSpec that describes the resource.
+	Resources map[string]json.RawMessage `json:"resources,omitempty"`
+	// Functions is a map from token to the undecoded FunctionSpec that describes the function.
+	Functions map[string]json.RawMessage `json:"functions,omitempty"`
+}
+
+// PartialPackage is a Package whose types, resources, and functions are decoded and bound on first use. This allows
+// callers that only need a few members of a large package to avoid binding the rest of it. A PartialPackage is safe
+// for concurrent use.
+type PartialPackage struct {
+	m sync.Mutex
+
+	spec  *PartialPackageSpec
+	pkg   *Package
+	types *types
+
+	resources map[string]*Resource
+	functions map[string]*Function
+	errors    map[string]error // the errors encountered while binding members, keyed by member kind and token.
+	pending   []string         // the referenced resources that have yet to be bound.
+}
+
+// ImportPartialSpec converts a serializable PartialPackageSpec into a PartialPackage. The package's metadata is bound
+// immediately; its members are bound on first use. The given loader is used to resolve references to other packages,
+// and must not be nil.
+func ImportPartialSpec(spec PartialPackageSpec, loader Loader) (*PartialPackage, error) {
+	contract.Require(loader != nil, "loader")
+
+	pkg, err := bindPackageHeader(&spec.PackageSpec)
+	if err != nil {
+		return nil, err
+	}
+
+	p := &PartialPackage{
+		spec:      &spec,
+		pkg:       pkg,
+		resources: map[string]*Resource{},
+		functions: map[string]*Function{},
+		errors:    map[string]error{},
+	}
+	p.types = newTypes(pkg, loader)
+	p.types.partial = p
+	return p, nil
+}
+
+// Name returns the unqualified name of the package.
+func (p *PartialPackage) Name() string {
+	return p.pkg.Name
+}
+
+// Version returns the version of the package, if any.
+func (p *PartialPackage) Version() *semver.Version {
+	return p.pkg.Version
+}
+
+// TokenToModule extracts a package member's module name from its token.
+func (p *PartialPackage) TokenToModule(tok string) string {
+	return p.pkg.TokenToModule(tok)
+}
+
+// GetResource returns the resource with the given token, binding it if necessary.
+func (p *PartialPackage) GetResource(token string) (*Resource, bool, error) {
+	p.m.Lock()
+	defer p.m.Unlock()
+
+	r, err := p.bindResource(token)
+	if pendingErr := p.bindPending(); err == nil {
+		err = pendingErr
+	}
+	return r, r != nil, err
+}
+
+// GetResourceType returns the resource type with the given token, binding its resource if necessary.
+func (p *PartialPackage) GetResourceType(token string) (*ResourceType, bool, error) {
+	p.m.Lock()
+	defer p.m.Unlock()
+
+	r, err := p.bindResource(token)
+	if pendingErr := p.bindPending(); err == nil {
+		err = pendingErr
+	}
+	if r == nil || err != nil {
+		return nil, false, err
+	}
+	t, ok := p.types.resources[token]
+	return t, ok, nil
+}
+
+// GetFunction returns the function with the given token, binding it if necessary.
+func (p *PartialPackage) GetFunction(token string) (*Function, bool, error) {
+	p.m.Lock()
+	defer p.m.Unlock()
+
+	f, err := p.bindFunction(token)
+	if pendingErr := p.bindPending(); err == nil {
+		err = pendingErr
+	}
+	return f, f != nil, err
+}
+
+// GetType returns the object or enum type with the given token, binding it if necessary.
+func (p *PartialPackage) GetType(token string) (Type, bool, error) {
+	p.m.Lock()
+	defer p.m.Unlock()
+
+	err := p.bindType(token)
+	if pendingErr := p.bindPending(); err == nil {
+		err = pendingErr
+	}
+	if err != nil {
+		return nil, false, err
+	}
+	t, ok := p.types.named[token]
+	return t, ok, nil
+}
+
+// referenceResource records a reference to the resource with the given token. Referenced resources are bound once
+// the member that refers to them has been bound, which allows resources and their methods to refer to each other.
+func (p *PartialPackage) referenceResource(token string) {
+	if _, ok := p.resources[token]; !ok {
+		p.pending = append(p.pending, token)
+	}
+}
+
+// bindPending binds any referenced resources that have not yet been bound. Must be called with the package's lock
+// held.
+func (p *PartialPackage) bindPending() error {
+	for len(p.pending) != 0 {
+		token := p.pending[0]
+		p.pending = p.pending[1:]
+		if _, err := p.bindResource(token); err != nil {
+			p.pending = nil
+			return err
+		}
+	}
+	return nil
+}
+
+// fail records the error encountered while binding the given member.
+func (p *PartialPackage) fail(key string, err error) error {
+	p.errors[key] = err
+	return err
+}
+
+// bindType binds the complex type with the given token if it has not already been bound. Must be called with the
+// package's lock held.
+func (p *PartialPackage) bindType(token string) error {
+	key := typesRef + "/" + token
+	raw, ok := p.spec.Types[token]
+	if !ok {
+		// The type is either unknown or has already been bound.
+		return p.errors[key]
+	}
+	delete(p.spec.Types, token)
+
+	var spec ComplexTypeSpec
+	if err := jsoniter.Unmarshal(raw, &spec); err != nil {
+		return p.fail(key, errors.Wrapf(err, "failed to decode type %s", token))
+	}
+
+	// Declare the type before binding its details so that recursive references to the type resolve to it.
+	if err := p.types.declareComplexType(token, spec); err != nil {
+		return p.fail(key, errors.Wrapf(err, "failed to bind type %s", token))
+	}
+	if obj, ok := p.types.objects[token]; ok {
+		if err := p.types.bindObjectTypeDetails(obj, token, spec.ObjectTypeSpec); err != nil {
+			return p.fail(key, errors.Wrapf(err, "failed to bind type %s", token))
+		}
+	}
+	return nil
+}
+
+// bindFunction binds the function with the given token if it has not already been bound. Must be called with the
+// package's lock held.
+func (p *PartialPackage) bindFunction(token string) (*Function, error) {
+	if f, ok := p.functions[token]; ok {
+		return f, nil
+	}
+	key := "functions/" + token
+	if err, ok := p.errors[key]; ok {
+		return nil, err
+	}
+	raw, ok := p.spec.Functions[token]
+	if !ok {
+		return nil, nil
+	}
+
+	var spec FunctionSpec
+	if err := jsoniter.Unmarshal(raw, &spec); err != nil {
+		return nil, p.fail(key, errors.Wrapf(err, "error decoding function %v", token))
+	}
+	f, err := bindFunction(token, spec, p.types)
+	if err != nil {
+		return nil, p.fail(key, errors.Wrapf(err, "error binding function %v", token))
+	}
+	p.functions[token] = f
+
+	// If the function may be a method, make sure that the resource that would own it is bound so that IsMethod is
+	// accurate.
+	if idx := strings.LastIndex(token, "/"); idx != -1 {
+		p.referenceResource(token[:idx])
+	}
+	return f, nil
+}
+
+// bindResource binds the resource with the given token if it has not already been bound. Must be called with the
+// package's lock held.
+func (p *PartialPackage) bindResource(token string) (*Resource, error) {
+	if r, ok := p.resources[token]; ok {
+		return r, nil
+	}
+	key := resourcesRef + "/" + token
+	if err, ok := p.errors[key]; ok {
+		return nil, err
+	}
+
+	isProvider := token == "pulumi:providers:"+p.pkg.Name
+	var spec ResourceSpec
+	if isProvider {
+		spec = p.spec.Provider
+	} else {
+		raw, ok := p.spec.Resources[token]
+		if !ok {
+			return nil, nil
+		}
+		if err := jsoniter.Unmarshal(raw, &spec); err != nil {
+			return nil, p.fail(key, errors.Wrapf(err, "error decoding resource %v", token))
+		}
+	}
+
+	// Bind the resource's methods.
+	functionTable := map[string]*Function{}
+	for _, fn := range spec.Methods {
+		f, err := p.bindFunction(fn)
+		if err != nil {
+			return nil, p.fail(key, errors.Wrapf(err, "error binding resource %v", token))
+		}
+		if f != nil {
+			functionTable[fn] = f
+		}
+	}
+
+	if isProvider {
+		res, err := bindProvider(p.pkg.Name, spec, p.types, functionTable)
+		if err != nil {
+			return nil, p.fail(key, errors.Wrap(err, "binding provider"))
+		}
+		p.resources[token] = res
+		return res, nil
+	}
+
+	res, err := bindResource(token, spec, p.types, functionTable)
+	if err != nil {
+		return nil, p.fail(key, errors.Wrapf(err, "error binding resource %v", token))
+	}
+	p.resources[token] = res
+
+	if rt, ok := p.types.resources[token]; ok {
+		if rt.Resource == nil {
+			rt.Resource = res
+		}
+	} else {
+		p.types.resources[token] = &ResourceType{
+			Token:    res.Token,
+			Resource: res,
+		}
+	}
+	return res, nil
+}
+
+// PartialLoader is a Loader that can also load packages that are bound on demand.
+type PartialLoader interface {
+	Loader
+
+	// LoadPartialPackage loads the given package without binding any of its members.
+	LoadPartialPackage(pkg string, version *semver.Version) (*PartialPackage, error)
+}
+
+// LoadResource loads the schema for the resource with the given token from the given package. If the loader is a
+// PartialLoader, only the parts of the package that describe the resource are bound.
+func LoadResource(loader Loader, pkg string, version *semver.Version, token string) (*Resource, bool, error) {
+	if partialLoader, ok := loader.(PartialLoader); ok {
+		p, err := partialLoader.LoadPartialPackage(pkg, version)
+		if err != nil {
+			return nil, false, err
+		}
+		return p.GetResource(token)
+	}
+
+	p, err := loader.LoadPackage(pkg, version)
+	if err != nil {
+		return nil, false, err
+	}
+	r, ok := p.GetResource(token)
+	return r, ok, nil
+}
@@ -0,0 +1,142 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package schema
+
+import (
+	"encoding/json"
+	"io/ioutil"
+	"path/filepath"
+	"testing"
+
+	"github.com/blang/semver"
+	"github.com/pkg/errors"
+	"github.com/stretchr/testify/assert"
+)
+
+type nullLoader struct{}
+
+func (nullLoader) LoadPackage(pkg string, version *semver.Version) (*Package, error) {
+	return nil, errors.Errorf("unknown package %v", pkg)
+}
+
+func importPartialSchemaFile(t *testing.T, file string) *PartialPackage {
+	schemaBytes, err := ioutil.ReadFile(filepath.Join("..", "internal", "test", "testdata", file))
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+
+	var spec PartialPackageSpec
+	if !assert.NoError(t, json.Unmarshal(schemaBytes, &spec)) {
+		t.FailNow()
+	}
+
+	p, err := ImportPartialSpec(spec, nullLoader{})
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	return p
+}
+
+func TestPartialPackageBindsOnDemand(t *testing.T) {
+	p := importPartialSchemaFile(t, filepath.Join("simple-resource-schema", "schema.json"))
+	assert.Equal(t, "example", p.Name())
+	assert.Len(t, p.spec.Types, 5)
+
+	// Binding a resource with no type references binds nothing else.
+	res, ok, err := p.GetResource("example::Resource")
+	assert.NoError(t, err)
+	assert.True(t, ok)
+	assert.Equal(t, "example::Resource", res.Token)
+	assert.Len(t, p.spec.Types, 5)
+
+	// Binding a resource binds the types it references, and only those types.
+	uses, ok, err := p.GetResource("example::TypeUses")
+	assert.NoError(t, err)
+	assert.True(t, ok)
+	assert.Len(t, p.spec.Types, 1)
+
+	obj, ok, err := p.GetType("example::Object")
+	assert.NoError(t, err)
+	assert.True(t, ok)
+	for _, prop := range uses.Properties {
+		if prop.Name == "foo" {
+			assert.Same(t, obj, plainType(prop.Type))
+		}
+	}
+	foo, ok := obj.(*ObjectType).Property("foo")
+	if assert.True(t, ok) {
+		assert.Same(t, res, plainType(foo.Type).(*ResourceType).Resource)
+	}
+
+	_, ok, err = p.GetResource("example::Missing")
+	assert.NoError(t, err)
+	assert.False(t, ok)
+}
+
+func TestPartialPackageMatchesImportSpec(t *testing.T) {
+	file := filepath.Join("simple-resource-schema", "schema.json")
+	pkg, err := ImportSpec(readSchemaFile(file), nil)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	p := importPartialSchemaFile(t, file)
+
+	for _, expected := range pkg.Resources {
+		actual, ok, err := p.GetResource(expected.Token)
+		assert.NoError(t, err)
+		if !assert.True(t, ok) {
+			continue
+		}
+		assert.Equal(t, expected.IsComponent, actual.IsComponent)
+		assert.Equal(t, len(expected.InputProperties), len(actual.InputProperties))
+		for i, prop := range expected.InputProperties {
+			assert.Equal(t, prop.Name, actual.InputProperties[i].Name)
+			assert.Equal(t, prop.Type.String(), actual.InputProperties[i].Type.String())
+		}
+	}
+	for _, expected := range pkg.Functions {
+		actual, ok, err := p.GetFunction(expected.Token)
+		assert.NoError(t, err)
+		if assert.True(t, ok) {
+			assert.Equal(t, expected.Token, actual.Token)
+			assert.Equal(t, expected.IsMethod, actual.IsMethod)
+		}
+	}
+}
+
+func TestPartialPackageMethods(t *testing.T) {
+	p := importPartialSchemaFile(t, filepath.Join("schema", "good-methods-1.json"))
+
+	// Looking up a method's function binds its resource, which marks the function as a method.
+	f, ok, err := p.GetFunction("xyz:index:Foo/bar")
+	assert.NoError(t, err)
+	assert.True(t, ok)
+	assert.True(t, f.IsMethod)
+
+	res, ok, err := p.GetResource("xyz:index:Foo")
+	assert.NoError(t, err)
+	if assert.True(t, ok) && assert.Len(t, res.Methods, 1) {
+		assert.Same(t, f, res.Methods[0].Function)
+	}
+
+	// Binding errors are reported on every lookup.
+	p = importPartialSchemaFile(t, filepath.Join("schema", "bad-methods-2.json"))
+	for i := 0; i < 2; i++ {
+		_, _, err = p.GetResource("xyz:index:Foo")
+		if assert.Error(t, err) {
+			assert.Contains(t, err.Error(), "function xyz:index:Foo/bar for method baz is already a method")
+		}
+	}
+}
@@ -1357,24 +1357,9 @@ var defaultModuleFormat = regexp.MustCompile("(.*)")
 // works as a singleton -- if it is nil, a new loader is instantiated, else the provided loader is used. This avoids
 // breaking downstream consumers of ImportSpec while allowing us to extend schema support to external packages.
 func importSpec(spec PackageSpec, languages map[string]Language, loader Loader) (*Package, error) {
-	// Parse the version, if any.
-	var version *semver.Version
-	if spec.Version != "" {
-		v, err := semver.ParseTolerant(spec.Version)
-		if err != nil {
-			return nil, errors.Wrap(err, "parsing package version")
-		}
-		version = &v
-	}
-
-	// Parse the module format, if any.
-	moduleFormat := "(.*)"
-	if spec.Meta != nil && spec.Meta.ModuleFormat != "" {
-		moduleFormat = spec.Meta.ModuleFormat
-	}
-	moduleFormatRegexp, err := regexp.Compile(moduleFormat)
+	header, err := bindPackageHeader(&spec)
 	if err != nil {
-		return nil, errors.Wrap(err, "compiling module format regexp")
+		return nil, err
 	}
 
 	pkg := &Package{}
@@ -1450,12 +1435,52 @@ func importSpec(spec PackageSpec, languages map[string]Language, loader Loader)
 		return typeList[i].String() < typeList[j].String()
 	})
 
+	*pkg = *header
+	pkg.Config = config
+	pkg.Types = typeList
+	pkg.Provider = provider
+	pkg.Resources = resources
+	pkg.Functions = functions
+	pkg.resourceTable = resourceTable
+	pkg.functionTable = functionTable
+	pkg.typeTable = types.named
+	pkg.resourceTypeTable = types.resources
+	if err := pkg.ImportLanguages(languages); err != nil {
+		return nil, err
+	}
+	return pkg, nil
+
+}
+
+// bindPackageHeader binds the package-level metadata in the given PackageSpec. The returned Package does not contain
+// any types, resources, or functions.
+func bindPackageHeader(spec *PackageSpec) (*Package, error) {
+	// Parse the version, if any.
+	var version *semver.Version
+	if spec.Version != "" {
+		v, err := semver.ParseTolerant(spec.Version)
+		if err != nil {
+			return nil, errors.Wrap(err, "parsing package version")
+		}
+		version = &v
+	}
+
+	// Parse the module format, if any.
+	moduleFormat := "(.*)"
+	if spec.Meta != nil && spec.Meta.ModuleFormat != "" {
+		moduleFormat = spec.Meta.ModuleFormat
+	}
+	moduleFormatRegexp, err := regexp.Compile(moduleFormat)
+	if err != nil {
+		return nil, errors.Wrap(err, "compiling module format regexp")
+	}
+
 	language := make(map[string]interface{})
 	for name, raw := range spec.Language {
 		language[name] = json.RawMessage(raw)
 	}
 
-	*pkg = Package{
+	return &Package{
 		moduleFormat:      moduleFormatRegexp,
 		Name:              spec.Name,
 		Version:           version,
@@ -1466,22 +1491,8 @@ func importSpec(spec PackageSpec, languages map[string]Language, loader Loader)
 		Attribution:       spec.Attribution,
 		Repository:        spec.Repository,
 		PluginDownloadURL: spec.PluginDownloadURL,
-		Config:            config,
-		Types:             typeList,
-		Provider:          provider,
-		Resources:         resources,
-		Functions:         functions,
 		Language:          language,
-		resourceTable:     resourceTable,
-		functionTable:     functionTable,
-		typeTable:         types.named,
-		resourceTypeTable: types.resources,
-	}
-	if err := pkg.ImportLanguages(languages); err != nil {
-		return nil, err
-	}
-	return pkg, nil
-
+	}, nil
 }
 
 // ImportSpec converts a serializable PackageSpec into a Package.
@@ -1506,6 +1517,10 @@ type types struct {
 	named     map[string]Type // objects and enums
 	inputs    map[Type]*InputType
 	optionals map[Type]*OptionalType
+
+	// partial is the partially-bound package that owns these types, if any. If partial is non-nil, the package's
+	// complex types and resources are bound after they are first referenced.
+	partial *PartialPackage
 }
 
 func (t *types) bindPrimitiveType(name string) (Type, error) {
@@ -1728,6 +1743,11 @@ func (t *types) bindTypeSpecRef(spec TypeSpec, inputShape bool) (Type, error) {
 
 	switch ref.Kind {
 	case typesRef:
+		if t.partial != nil {
+			if err := t.partial.bindType(ref.Token); err != nil {
+				return nil, err
+			}
+		}
 		if typ, ok := t.objects[ref.Token]; ok {
 			if inputShape {
 				return typ.InputShape, nil
@@ -1751,6 +1771,9 @@ func (t *types) bindTypeSpecRef(spec TypeSpec, inputShape bool) (Type, error) {
 		}
 		return typ, nil
 	case resourcesRef, providerRef:
+		if t.partial != nil {
+			t.partial.referenceResource(ref.Token)
+		}
 		typ, ok := t.resources[ref.Token]
 		if !ok {
 			typ = &ResourceType{Token: ref.Token}
@@ -2142,8 +2165,8 @@ func (t *types) bindEnumType(token string, spec ComplexTypeSpec) (*EnumType, err
 	return enum, nil
 }
 
-func bindTypes(pkg *Package, complexTypes map[string]ComplexTypeSpec, loader Loader) (*types, error) {
-	typs := &types{
+func newTypes(pkg *Package, loader Loader) *types {
+	return &types{
 		pkg:       pkg,
 		loader:    loader,
 		resources: map[string]*ResourceType{},
@@ -2157,27 +2180,40 @@ func bindTypes(pkg *Package, complexTypes map[string]ComplexTypeSpec, loader Loa
 		inputs:    map[Type]*InputType{},
 		optionals: map[Type]*OptionalType{},
 	}
+}
+
+// declareComplexType declares the given object or enum type. Enum types are bound immediately. Object types must be
+// bound separately using bindObjectTypeDetails once all of the types they may refer to have been declared.
+func (t *types) declareComplexType(token string, spec ComplexTypeSpec) error {
+	if spec.Type == "object" {
+		// It's important that we set the token here. This package interns types so that they can be equality-compared
+		// for identity. Types are interned based on their string representation, and the string representation of an
+		// object type is its token. While this doesn't affect object types directly, it breaks the interning of types
+		// that reference object types (e.g. arrays, maps, unions)
+		typ := &ObjectType{Token: token}
+		typ.InputShape = &ObjectType{Token: token, PlainShape: typ}
+		t.objects[token] = typ
+		t.named[token] = typ
+	} else if len(spec.Enum) > 0 {
+		typ := &EnumType{Token: token}
+		t.enums[token] = typ
+		t.named[token] = typ
+
+		// Bind enums before object types because object type generation depends on enum values to be present.
+		if err := t.bindEnumTypeDetails(t.enums[token], token, spec); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+func bindTypes(pkg *Package, complexTypes map[string]ComplexTypeSpec, loader Loader) (*types, error) {
+	typs := newTypes(pkg, loader)
 
 	// Declare object and enum types before processing properties.
 	for token, spec := range complexTypes {
-		if spec.Type == "object" {
-			// It's important that we set the token here. This package interns types so that they can be equality-compared
-			// for identity. Types are interned based on their string representation, and the string representation of an
-			// object type is its token. While this doesn't affect object types directly, it breaks the interning of types
-			// that reference object types (e.g. arrays, maps, unions)
-			typ := &ObjectType{Token: token}
-			typ.InputShape = &ObjectType{Token: token, PlainShape: typ}
-			typs.objects[token] = typ
-			typs.named[token] = typ
-		} else if len(spec.Enum) > 0 {
-			typ := &EnumType{Token: token}
-			typs.enums[token] = typ
-			typs.named[token] = typ
-
-			// Bind enums before object types because object type generation depends on enum values to be present.
-			if err := typs.bindEnumTypeDetails(typs.enums[token], token, spec); err != nil {
-				return nil, errors.Wrapf(err, "failed to bind type %s", token)
-			}
+		if err := typs.declareComplexType(token, spec); err != nil {
+			return nil, errors.Wrapf(err, "failed to bind type %s", token)
 		}
 	}
 
@@ -17,6 +17,8 @@ package engine
 import (
 	"context"
 	"fmt"
+	"os"
+	"strconv"
 	"time"
 
 	"github.com/opentracing/opentracing-go"
@@ -35,6 +37,18 @@ import (
 
 const clientRuntimeName = "client"
 
+// providerParallelismEnvVar is the environment variable that supplies per-package parallelism limits, e.g.
+// "aws=8,kubernetes=32", when UpdateOptions.ProviderParallelism is not set.
+const providerParallelismEnvVar = "PULUMI_PROVIDER_PARALLELISM"
+
+// refreshParallelismEnvVar is the environment variable that supplies the per-package limit on concurrent refreshes
+// when UpdateOptions.RefreshParallelism is not set.
+const refreshParallelismEnvVar = "PULUMI_REFRESH_PARALLELISM"
+
+// cachedInvokesEnvVar is the environment variable that lists the functions whose results may be cached for the
+// duration of a deployment when UpdateOptions.CachedInvokes is not set.
+const cachedInvokesEnvVar = "PULUMI_CACHED_INVOKES"
+
 // ProjectInfoContext returns information about the current project, including its pwd, main, and plugin context.
 func ProjectInfoContext(projinfo *Projinfo, host plugin.Host, config plugin.ConfigSource,
 	diag, statusDiag diag.Sink, disableProviderPreview bool,
@@ -226,6 +240,38 @@ func (deployment *deployment) run(cancelCtx *Context, actions runActions, policy
 	}
 	defer chdir()
 
+	// Per-package parallelism limits may be supplied through the environment when they aren't set explicitly.
+	providerParallelism := deployment.Options.ProviderParallelism
+	if providerParallelism == nil {
+		if spec := os.Getenv(providerParallelismEnvVar); spec != "" {
+			limits, err := deploy.ParseProviderParallelism(spec)
+			if err != nil {
+				return nil, result.FromError(errors.Wrapf(err, "parsing %s", providerParallelismEnvVar))
+			}
+			providerParallelism = limits
+		}
+	}
+	refreshParallelism := deployment.Options.RefreshParallelism
+	if refreshParallelism == 0 {
+		if spec := os.Getenv(refreshParallelismEnvVar); spec != "" {
+			limit, err := strconv.Atoi(spec)
+			if err != nil || limit < 1 {
+				return nil, result.Errorf("%s must be a positive integer", refreshParallelismEnvVar)
+			}
+			refreshParallelism = limit
+		}
+	}
+	cachedInvokes := deployment.Options.CachedInvokes
+	if cachedInvokes == nil {
+		if spec := os.Getenv(cachedInvokesEnvVar); spec != "" {
+			toks, err := deploy.ParseCachedInvokes(spec)
+			if err != nil {
+				return nil, result.FromError(errors.Wrapf(err, "parsing %s", cachedInvokesEnvVar))
+			}
+			cachedInvokes = toks
+		}
+	}
+
 	// Create a new context for cancellation and tracing.
 	ctx, cancelFunc := context.WithCancel(context.Background())
 
@@ -256,6 +302,9 @@ func (deployment *deployment) run(cancelCtx *Context, actions runActions, policy
 			TrustDependencies:         deployment.Options.trustDependencies,
 			UseLegacyDiff:             deployment.Options.UseLegacyDiff,
 			DisableResourceReferences: deployment.Options.DisableResourceReferences,
+			ProviderParallelism:       providerParallelism,
+			RefreshParallelism:        refreshParallelism,
+			CachedInvokes:             cachedInvokes,
 		}
 		walkResult = deployment.Deployment.Execute(ctx, opts, preview)
 		close(done)
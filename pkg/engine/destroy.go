@@ -67,6 +67,9 @@ func newDestroySource(
 		logging.V(7).Infof("newDestroySource(): failed to install missing plugins: %v", err)
 	}
 
+	// Start the providers that will delete the existing resources in the background.
+	prewarmProviders(plugctx, plugins)
+
 	// We don't need the language plugin, since destroy doesn't run code, so we will leave that out.
 	if err := ensurePluginsAreLoaded(plugctx, plugins, plugin.AnalyzerPlugins); err != nil {
 		return nil, err
@@ -0,0 +1,470 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package lifecycletest
+
+import (
+	"bytes"
+	"compress/gzip"
+	"context"
+	"fmt"
+	"io"
+	"io/ioutil"
+	"math"
+	"os"
+	"runtime/metrics"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/blang/semver"
+
+	"github.com/pulumi/pulumi/pkg/v3/backend"
+	. "github.com/pulumi/pulumi/pkg/v3/engine"
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy/deploytest"
+	"github.com/pulumi/pulumi/pkg/v3/resource/stack"
+	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/pkg/v3/secrets/b64"
+	"github.com/pulumi/pulumi/pkg/v3/util/cancel"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/plugin"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/result"
+)
+
+// The engine benchmarks run synthetic programs of several sizes through each kind of operation, persisting
+// checkpoints the way each backend does. Run them with e.g.
+//
+//     go test ./engine/lifeycletest -run XXX -bench Engine/1000 -benchtime 3x
+//
+// Besides time and allocations, each benchmark reports the steps executed per second, the bytes of checkpoint data
+// written per operation, and the peak size of the Go heap.
+
+var benchmarkSizes = []int{1000, 10000, 50000}
+
+var benchmarkPackages = []tokens.Package{"pkgA", "pkgB", "pkgC", "pkgD"}
+
+const (
+	// benchmarkLayerWidth is the number of resources in each layer of a synthetic program. The resources in a layer
+	// are registered concurrently and depend on resources in the previous layer.
+	benchmarkLayerWidth = 100
+	// benchmarkHubs is the number of resources in the first layer that every later resource depends on one of.
+	benchmarkHubs = 10
+	// benchmarkComponentSize is the number of resources that share a parent component.
+	benchmarkComponentSize = 100
+	// benchmarkTargetFraction is the fraction of resources that a targeted update changes.
+	benchmarkTargetFraction = 100
+)
+
+// syntheticProgram is a program whose resources have a shape similar to that of a real program: resources are spread
+// across several providers and parented by components, most resources depend on a few resources in the layer before
+// them, a few hub resources have a large number of dependents, and some resources have secret inputs.
+type syntheticProgram struct {
+	size int
+
+	// changed holds the resources whose inputs are changed by a targeted update, and version is mixed into their
+	// inputs so that each targeted update changes them again.
+	changed map[int]bool
+	version int
+}
+
+func (p *syntheticProgram) name(i int) string {
+	return fmt.Sprintf("res-%d", i)
+}
+
+func (p *syntheticProgram) typ(i int) tokens.Type {
+	return tokens.Type(string(benchmarkPackages[i%len(benchmarkPackages)]) + ":index:Resource")
+}
+
+func (p *syntheticProgram) inputs(i int) resource.PropertyMap {
+	layer := i / benchmarkLayerWidth
+	inputs := resource.PropertyMap{
+		"index": resource.NewNumberProperty(float64(i)),
+		"name":  resource.NewStringProperty(p.name(i)),
+		"tags": resource.NewObjectProperty(resource.PropertyMap{
+			"layer":   resource.NewNumberProperty(float64(layer)),
+			"package": resource.NewStringProperty(string(benchmarkPackages[i%len(benchmarkPackages)])),
+		}),
+		"rules": resource.NewArrayProperty([]resource.PropertyValue{
+			resource.NewStringProperty(fmt.Sprintf("allow-%d", i%7)),
+			resource.NewStringProperty(fmt.Sprintf("deny-%d", i%11)),
+		}),
+	}
+	if i%5 == 0 {
+		inputs["password"] = resource.MakeSecret(resource.NewStringProperty(fmt.Sprintf("secret-%d", i)))
+	}
+	if p.changed[i] {
+		inputs["version"] = resource.NewNumberProperty(float64(p.version))
+	}
+	return inputs
+}
+
+// dependencies returns the indices of the resources that resource i depends on.
+func (p *syntheticProgram) dependencies(i int) []int {
+	layer := i / benchmarkLayerWidth
+	if layer == 0 {
+		return nil
+	}
+
+	deps := []int{i % benchmarkHubs}
+	for k := 0; k <= i%3; k++ {
+		deps = append(deps, (layer-1)*benchmarkLayerWidth+(i+k)%benchmarkLayerWidth)
+	}
+	return deps
+}
+
+func (p *syntheticProgram) targets(newURN func(i int) resource.URN) []resource.URN {
+	var urns []resource.URN
+	for i := range p.changed {
+		urns = append(urns, newURN(i))
+	}
+	return urns
+}
+
+func (p *syntheticProgram) run(_ plugin.RunInfo, monitor *deploytest.ResourceMonitor) error {
+	components := make([]resource.URN, (p.size+benchmarkComponentSize-1)/benchmarkComponentSize)
+	for c := range components {
+		urn, _, _, err := monitor.RegisterResource("bench:index:Component", fmt.Sprintf("component-%d", c), false)
+		if err != nil {
+			return err
+		}
+		components[c] = urn
+	}
+
+	var m sync.Mutex
+	var firstErr error
+	urns := make([]resource.URN, p.size)
+	for start := 0; start < p.size; start += benchmarkLayerWidth {
+		var wg sync.WaitGroup
+		for i := start; i < start+benchmarkLayerWidth && i < p.size; i++ {
+			deps := p.dependencies(i)
+			depURNs := make([]resource.URN, len(deps))
+			for k, d := range deps {
+				depURNs[k] = urns[d]
+			}
+
+			wg.Add(1)
+			go func(i int) {
+				defer wg.Done()
+				urn, _, _, err := monitor.RegisterResource(p.typ(i), p.name(i), true, deploytest.ResourceOptions{
+					Parent:       components[i/benchmarkComponentSize],
+					Dependencies: depURNs,
+					Inputs:       p.inputs(i),
+					PropertyDeps: map[resource.PropertyKey][]resource.URN{"tags": depURNs},
+				})
+				if err != nil {
+					m.Lock()
+					if firstErr == nil {
+						firstErr = err
+					}
+					m.Unlock()
+					return
+				}
+				urns[i] = urn
+			}(i)
+		}
+		wg.Wait()
+		if firstErr != nil {
+			return firstErr
+		}
+	}
+	return nil
+}
+
+func newBenchmarkHost(p *syntheticProgram) plugin.Host {
+	var loaders []*deploytest.ProviderLoader
+	for _, pkg := range benchmarkPackages {
+		loaders = append(loaders, deploytest.NewProviderLoader(pkg, semver.MustParse("1.0.0"),
+			func() (plugin.Provider, error) {
+				return &deploytest.Provider{
+					CreateF: func(urn resource.URN, news resource.PropertyMap, timeout float64,
+						preview bool) (resource.ID, resource.PropertyMap, resource.Status, error) {
+						return resource.ID("id-" + urn.Name()), news, resource.StatusOK, nil
+					},
+					ReadF: func(urn resource.URN, id resource.ID,
+						inputs, state resource.PropertyMap) (plugin.ReadResult, resource.Status, error) {
+						return plugin.ReadResult{Inputs: inputs, Outputs: state}, resource.StatusOK, nil
+					},
+				}, nil
+			}))
+	}
+	return deploytest.NewPluginHost(nil, nil, deploytest.NewLanguageRuntime(p.run), loaders...)
+}
+
+// benchmarkPersister persists checkpoints the way one of the backends does, counting the bytes that it writes.
+type benchmarkPersister struct {
+	name  string
+	write func(snap *deploy.Snapshot) (int, error)
+
+	bytes       int
+	checkpoints int
+	last        *deploy.Snapshot
+}
+
+func (p *benchmarkPersister) Save(snap *deploy.Snapshot) error {
+	n, err := p.write(snap)
+	if err != nil {
+		return err
+	}
+	p.bytes, p.checkpoints, p.last = p.bytes+n, p.checkpoints+1, snap
+	return nil
+}
+
+func (p *benchmarkPersister) SecretsManager() secrets.Manager {
+	return b64.NewBase64SecretsManager()
+}
+
+// countingWriter counts the bytes written to an underlying writer.
+type countingWriter struct {
+	w io.Writer
+	n int
+}
+
+func (w *countingWriter) Write(b []byte) (int, error) {
+	n, err := w.w.Write(b)
+	w.n += n
+	return n, err
+}
+
+// newFilePersister returns a persister that writes each checkpoint to a file, as the filestate backend does.
+func newFilePersister(b *testing.B, stackName tokens.QName) *benchmarkPersister {
+	dir, err := ioutil.TempDir("", "engine-benchmark")
+	if err != nil {
+		b.Fatal(err)
+	}
+	b.Cleanup(func() { contract.IgnoreError(os.RemoveAll(dir)) })
+
+	encoder := stack.NewDeploymentEncoder(b64.NewBase64SecretsManager(), false /* showSecrets */)
+	path := dir + "/checkpoint.json"
+	return &benchmarkPersister{name: "filestate", write: func(snap *deploy.Snapshot) (int, error) {
+		f, err := os.Create(path)
+		if err != nil {
+			return 0, err
+		}
+		defer contract.IgnoreClose(f)
+
+		w := &countingWriter{w: f}
+		err = encoder.EncodeCheckpoint(w, stackName, snap)
+		return w.n, err
+	}}
+}
+
+// newServicePersister returns a persister that encodes and compresses each checkpoint as the httpstate backend does
+// before sending it to the service, and then discards it.
+func newServicePersister() *benchmarkPersister {
+	encoder := stack.NewDeploymentEncoder(b64.NewBase64SecretsManager(), false /* showSecrets */)
+	var buf bytes.Buffer
+	gz := gzip.NewWriter(ioutil.Discard)
+	return &benchmarkPersister{name: "httpstate", write: func(snap *deploy.Snapshot) (int, error) {
+		buf.Reset()
+		if err := encoder.Encode(&buf, snap); err != nil {
+			return 0, err
+		}
+		gz.Reset(ioutil.Discard)
+		if _, err := gz.Write(buf.Bytes()); err != nil {
+			return 0, err
+		}
+		return buf.Len(), gz.Close()
+	}}
+}
+
+// heapSampler tracks the peak size of the Go heap while it runs.
+type heapSampler struct {
+	done chan struct{}
+	peak chan uint64
+}
+
+func startHeapSampler() *heapSampler {
+	s := &heapSampler{done: make(chan struct{}), peak: make(chan uint64)}
+	go func() {
+		samples := []metrics.Sample{{Name: "/memory/classes/heap/objects:bytes"}}
+		var peak uint64
+		ticker := time.NewTicker(5 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			metrics.Read(samples)
+			if v := samples[0].Value; v.Kind() == metrics.KindUint64 && v.Uint64() > peak {
+				peak = v.Uint64()
+			}
+			select {
+			case <-s.done:
+				s.peak <- peak
+				return
+			case <-ticker.C:
+			}
+		}
+	}()
+	return s
+}
+
+func (s *heapSampler) stop() uint64 {
+	close(s.done)
+	return <-s.peak
+}
+
+// runBenchmarkOp runs a single operation, persisting its checkpoints with the given persister, and returns the
+// number of steps that it executed.
+func runBenchmarkOp(b *testing.B, op TestOp, plan *TestPlan, snap *deploy.Snapshot, dryRun bool,
+	persister *benchmarkPersister) int {
+
+	var manager SnapshotManager = NewJournal()
+	if !dryRun {
+		manager = backend.NewSnapshotManager(persister, snap)
+	}
+
+	cancelCtx, _ := cancel.NewContext(context.Background())
+	events := make(chan Event)
+	go func() {
+		for range events {
+		}
+	}()
+	defer close(events)
+
+	ctx := &Context{Cancel: cancelCtx, Events: events, SnapshotManager: manager}
+	info := &updateInfo{project: plan.GetProject(), target: plan.GetTarget(snap)}
+	changes, res := op(info, ctx, plan.Options, dryRun)
+	if err := manager.Close(); err != nil && res == nil {
+		res = result.FromError(err)
+	}
+	if res != nil {
+		b.Fatalf("operation failed: %v", res.Error())
+	}
+
+	steps := 0
+	for _, n := range changes {
+		steps += n
+	}
+	return steps
+}
+
+// benchmarkState is a snapshot that every iteration of a benchmark starts from.
+type benchmarkState struct {
+	deployment *apitype.DeploymentV3
+}
+
+func newBenchmarkState(b *testing.B, snap *deploy.Snapshot) benchmarkState {
+	deployment, err := stack.SerializeDeployment(snap, b64.NewBase64SecretsManager(), false /* showSecrets */)
+	if err != nil {
+		b.Fatal(err)
+	}
+	return benchmarkState{deployment: deployment}
+}
+
+// snapshot returns a fresh copy of the state, as the engine mutates the snapshots that it is given.
+func (s benchmarkState) snapshot(b *testing.B) *deploy.Snapshot {
+	if s.deployment == nil {
+		return nil
+	}
+	snap, err := stack.DeserializeDeploymentV3(*s.deployment, stack.DefaultSecretsProvider)
+	if err != nil {
+		b.Fatal(err)
+	}
+	return snap
+}
+
+// benchmarkOp runs an operation once per iteration, starting each iteration from the same state.
+func benchmarkOp(b *testing.B, op TestOp, plan *TestPlan, state benchmarkState, dryRun bool,
+	newPersister func() *benchmarkPersister, before func()) {
+
+	b.ReportAllocs()
+
+	steps, checkpointBytes := 0, 0
+	var elapsed time.Duration
+	var peakHeap uint64
+	for i := 0; i < b.N; i++ {
+		b.StopTimer()
+		snap, persister := state.snapshot(b), newPersister()
+		if before != nil {
+			before()
+		}
+		sampler := startHeapSampler()
+		b.StartTimer()
+
+		start := time.Now()
+		steps += runBenchmarkOp(b, op, plan, snap, dryRun, persister)
+		elapsed += time.Since(start)
+
+		b.StopTimer()
+		if peak := sampler.stop(); peak > peakHeap {
+			peakHeap = peak
+		}
+		checkpointBytes += persister.bytes
+		b.StartTimer()
+	}
+
+	b.ReportMetric(float64(steps)/elapsed.Seconds(), "steps/s")
+	b.ReportMetric(float64(checkpointBytes)/float64(b.N), "checkpoint-B/op")
+	b.ReportMetric(float64(peakHeap), "peak-heap-B")
+}
+
+func BenchmarkEngine(b *testing.B) {
+	for _, size := range benchmarkSizes {
+		size := size
+		b.Run(fmt.Sprint(size), func(b *testing.B) {
+			program := &syntheticProgram{size: size, changed: map[int]bool{}}
+			for i := 0; i < size; i += benchmarkTargetFraction {
+				program.changed[i] = true
+			}
+
+			plan := &TestPlan{
+				Options: UpdateOptions{
+					Host: newBenchmarkHost(program),
+					// Match the CLI's default of unbounded parallelism.
+					Parallel: math.MaxInt32,
+				},
+			}
+
+			// Every operation other than the initial update starts from the state that the initial update produces.
+			initial := newServicePersister()
+			runBenchmarkOp(b, Update, plan, nil, false, initial)
+			state := newBenchmarkState(b, initial.last)
+
+			targetedPlan := *plan
+			targetedPlan.Options.UpdateTargets = program.targets(func(i int) resource.URN {
+				parent := plan.NewURN("bench:index:Component", fmt.Sprintf("component-%d", i/benchmarkComponentSize), "")
+				return plan.NewURN(program.typ(i), program.name(i), parent)
+			})
+			changeTargets := func() { program.version++ }
+			resetTargets := func() { program.version = 0 }
+
+			persisters := map[string]func() *benchmarkPersister{
+				"filestate": func() *benchmarkPersister { return newFilePersister(b, "test") },
+				"httpstate": newServicePersister,
+			}
+			for _, name := range []string{"filestate", "httpstate"} {
+				newPersister := persisters[name]
+				b.Run(name, func(b *testing.B) {
+					b.Run("update", func(b *testing.B) {
+						benchmarkOp(b, Update, plan, benchmarkState{}, false, newPersister, nil)
+					})
+					b.Run("preview", func(b *testing.B) {
+						benchmarkOp(b, Update, plan, state, true, newPersister, resetTargets)
+					})
+					b.Run("refresh", func(b *testing.B) {
+						benchmarkOp(b, Refresh, plan, state, false, newPersister, resetTargets)
+					})
+					b.Run("targeted-update", func(b *testing.B) {
+						benchmarkOp(b, Update, &targetedPlan, state, false, newPersister, changeTargets)
+					})
+					b.Run("destroy", func(b *testing.B) {
+						benchmarkOp(b, Destroy, plan, state, false, newPersister, nil)
+					})
+				})
+			}
+		})
+	}
+}
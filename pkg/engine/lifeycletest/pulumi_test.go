@@ -2356,3 +2356,122 @@ func TestSingleComponentMethodResourceDefaultProviderLifecycle(t *testing.T) {
 	}
 	p.Run(t, nil)
 }
+
+// Tests that a resource whose diff arguments are unchanged since a diff that found no changes is not diffed again.
+func TestDiffFingerprintSkipsUnchangedDiffs(t *testing.T) {
+	diffs := 0
+	loaders := []*deploytest.ProviderLoader{
+		deploytest.NewProviderLoader("pkgA", semver.MustParse("1.0.0"), func() (plugin.Provider, error) {
+			return &deploytest.Provider{
+				DiffF: func(urn resource.URN, id resource.ID, olds, news resource.PropertyMap,
+					ignoreChanges []string) (plugin.DiffResult, error) {
+
+					diffs++
+					return plugin.DiffResult{Changes: plugin.DiffNone}, nil
+				},
+			}, nil
+		}),
+	}
+
+	inputs := resource.PropertyMap{"foo": resource.NewStringProperty("bar")}
+	program := deploytest.NewLanguageRuntime(func(_ plugin.RunInfo, monitor *deploytest.ResourceMonitor) error {
+		_, _, _, err := monitor.RegisterResource("pkgA:m:typA", "resA", true, deploytest.ResourceOptions{
+			Inputs: inputs,
+		})
+		assert.NoError(t, err)
+		return nil
+	})
+	host := deploytest.NewPluginHost(nil, nil, program, loaders...)
+	p := &TestPlan{Options: UpdateOptions{Host: host}}
+	project := p.GetProject()
+
+	update := func(snap *deploy.Snapshot) *deploy.Snapshot {
+		snap, res := TestOp(Update).Run(project, p.GetTarget(snap), p.Options, false, p.BackendClient, nil)
+		assert.Nil(t, res)
+		return snap
+	}
+	resA := func(snap *deploy.Snapshot) *resource.State {
+		for _, res := range snap.Resources {
+			if res.URN.Name() == "resA" {
+				return res
+			}
+		}
+		t.Fatal("resA is missing from the snapshot")
+		return nil
+	}
+
+	// The first update that diffs the resource records the fingerprint of the diff, and the next skips the diff.
+	snap := update(nil)
+	assert.Equal(t, 0, diffs)
+	snap = update(snap)
+	assert.Equal(t, 1, diffs)
+	assert.NotEqual(t, resource.PropertyFingerprint(0), resA(snap).DiffFingerprint)
+	snap = update(snap)
+	assert.Equal(t, 1, diffs)
+	assert.NotEqual(t, resource.PropertyFingerprint(0), resA(snap).DiffFingerprint)
+
+	// Changing an input changes the fingerprint.
+	inputs = resource.PropertyMap{"foo": resource.NewStringProperty("baz")}
+	snap = update(snap)
+	assert.Equal(t, 2, diffs)
+	snap = update(snap)
+	assert.Equal(t, 2, diffs)
+
+	// Diffs of resources with secrets are never skipped, as their fingerprints are not recorded.
+	inputs = resource.PropertyMap{"foo": resource.MakeSecret(resource.NewStringProperty("baz"))}
+	snap = update(snap)
+	assert.Equal(t, 3, diffs)
+	assert.Equal(t, resource.PropertyFingerprint(0), resA(snap).DiffFingerprint)
+	update(snap)
+	assert.Equal(t, 4, diffs)
+}
+
+// Tests that a diff is not skipped once the provider's plugin version changes, even if the resource's inputs have not.
+func TestDiffFingerprintIncludesProviderVersion(t *testing.T) {
+	diffs := 0
+	version := semver.MustParse("1.0.0")
+	loaders := []*deploytest.ProviderLoader{
+		deploytest.NewProviderLoader("pkgA", semver.MustParse("1.0.0"), func() (plugin.Provider, error) {
+			return &deploytest.Provider{
+				Version: version,
+				DiffF: func(urn resource.URN, id resource.ID, olds, news resource.PropertyMap,
+					ignoreChanges []string) (plugin.DiffResult, error) {
+
+					diffs++
+					return plugin.DiffResult{Changes: plugin.DiffNone}, nil
+				},
+			}, nil
+		}),
+	}
+
+	// The program does not pin the provider's version, so the engine uses whichever plugin is installed.
+	program := deploytest.NewLanguageRuntime(func(_ plugin.RunInfo, monitor *deploytest.ResourceMonitor) error {
+		_, _, _, err := monitor.RegisterResource("pkgA:m:typA", "resA", true, deploytest.ResourceOptions{
+			Inputs: resource.PropertyMap{"foo": resource.NewStringProperty("bar")},
+		})
+		assert.NoError(t, err)
+		return nil
+	})
+	host := deploytest.NewPluginHost(nil, nil, program, loaders...)
+	p := &TestPlan{Options: UpdateOptions{Host: host}}
+	project := p.GetProject()
+
+	update := func(snap *deploy.Snapshot) *deploy.Snapshot {
+		snap, res := TestOp(Update).Run(project, p.GetTarget(snap), p.Options, false, p.BackendClient, nil)
+		assert.Nil(t, res)
+		return snap
+	}
+
+	snap := update(nil)
+	snap = update(snap)
+	assert.Equal(t, 1, diffs)
+	snap = update(snap)
+	assert.Equal(t, 1, diffs)
+
+	// Installing a newer plugin changes the fingerprint, so the new plugin is asked for a diff.
+	version = semver.MustParse("2.0.0")
+	snap = update(snap)
+	assert.Equal(t, 2, diffs)
+	update(snap)
+	assert.Equal(t, 2, diffs)
+}
@@ -161,6 +161,15 @@ func ensurePluginsAreLoaded(plugctx *plugin.Context, plugins pluginSet, kinds pl
 	return plugctx.Host.EnsurePlugins(plugins.Values(), kinds)
 }
 
+// prewarmProviders starts the provider plugins in the given plugin set in the background if the plugin host supports
+// it, so that they are ready by the time the provider registry asks for them.
+func prewarmProviders(plugctx *plugin.Context, plugins pluginSet) {
+	if prewarmer, ok := plugctx.Host.(plugin.ProviderPrewarmer); ok {
+		logging.V(preparePluginLog).Infof("prewarmProviders(): starting %d plugins", len(plugins))
+		prewarmer.PrewarmProviders(plugins.Values())
+	}
+}
+
 // installPlugin installs a plugin from the given backend client.
 func installPlugin(plugin workspace.PluginInfo) error {
 	logging.V(preparePluginLog).Infof("installPlugin(%s, %s): beginning install", plugin.Name, plugin.Version)
@@ -70,6 +70,9 @@ func newRefreshSource(client deploy.BackendClient, opts deploymentOptions, proj
 		logging.V(7).Infof("newRefreshSource(): failed to install missing plugins: %v", err)
 	}
 
+	// Start the providers that will read the existing resources in the background.
+	prewarmProviders(plugctx, plugins)
+
 	// Just return an error source. Refresh doesn't use its source.
 	return deploy.NewErrorSource(proj.Name), nil
 }
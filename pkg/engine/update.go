@@ -106,6 +106,18 @@ type UpdateOptions struct {
 	// the degree of parallelism for resource operations (<=1 for serial).
 	Parallel int
 
+	// per-package limits on the number of concurrent resource operations. If nil, the limits are read from the
+	// PULUMI_PROVIDER_PARALLELISM environment variable.
+	ProviderParallelism map[tokens.Package]int
+
+	// the maximum number of concurrent refreshes per package. If zero, the limit is read from the
+	// PULUMI_REFRESH_PARALLELISM environment variable or defaults to deploy.DefaultRefreshParallelism.
+	RefreshParallelism int
+
+	// the functions whose results may be cached for the duration of a deployment. If nil, the functions are read from
+	// the PULUMI_CACHED_INVOKES environment variable.
+	CachedInvokes []tokens.ModuleMember
+
 	// true if debugging output it enabled
 	Debug bool
 
@@ -367,6 +379,13 @@ func newUpdateSource(
 		return nil, err
 	}
 
+	// Start the providers that the existing resources need in the background while the rest of the plugins load.
+	snapshotPlugins, err := gatherPluginsFromSnapshot(plugctx, target)
+	if err != nil {
+		return nil, err
+	}
+	prewarmProviders(plugctx, snapshotPlugins)
+
 	// Once we've installed all of the plugins we need, make sure that all analyzers and language plugins are
 	// loaded up and ready to go. Provider plugins are loaded lazily by the provider registry and thus don't
 	// need to be loaded here.
@@ -0,0 +1,112 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package deploy
+
+import (
+	"context"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
+)
+
+// A deleteSchedule orders a set of delete steps by the dependencies between the resources they delete. A resource
+// can only be deleted once every condemned resource that depends on it has been deleted, so each step tracks the
+// number of steps that must complete before it may start (its "blockers") and the steps that it unblocks in turn.
+//
+// The schedule itself is not safe for concurrent use; it is driven by a single goroutine in execute.
+type deleteSchedule struct {
+	steps    []Step  // the steps to execute.
+	blockers []int   // for each step, the number of steps that must complete before it may start.
+	unblocks [][]int // for each step, the steps that are blocked on its completion.
+}
+
+// newSerialDeleteSchedule returns a schedule that executes the given steps one at a time, in order.
+func newSerialDeleteSchedule(steps []Step) *deleteSchedule {
+	s := &deleteSchedule{
+		steps:    steps,
+		blockers: make([]int, len(steps)),
+		unblocks: make([][]int, len(steps)),
+	}
+	for i := 1; i < len(steps); i++ {
+		s.blockers[i] = 1
+		s.unblocks[i-1] = []int{i}
+	}
+	return s
+}
+
+// ready returns the steps that have no blockers.
+func (s *deleteSchedule) ready() []int {
+	var ready []int
+	for i, n := range s.blockers {
+		if n == 0 {
+			ready = append(ready, i)
+		}
+	}
+	return ready
+}
+
+// complete records the completion of the given step and returns the steps that became ready as a result.
+func (s *deleteSchedule) complete(i int) []int {
+	var ready []int
+	for _, j := range s.unblocks[i] {
+		s.blockers[j]--
+		if s.blockers[j] == 0 {
+			ready = append(ready, j)
+		}
+	}
+	return ready
+}
+
+// execute submits the schedule's steps to the given step executor, each as soon as all of the steps it is blocked on
+// have completed, and waits for them to finish. If onDispatch is non-nil, it is called with each step immediately
+// before the step is submitted. execute returns early if the given context is canceled.
+//
+// Unlike executing a sequence of antichains, a slow delete only holds up the resources that it actually depends on;
+// unrelated branches of the dependency graph continue deleting in the meantime.
+func (s *deleteSchedule) execute(ctx context.Context, stepExec *stepExecutor, onDispatch func(Step)) {
+	if len(s.steps) == 0 {
+		return
+	}
+
+	// Completions are reported on a buffered channel so that waiting goroutines never block on the scheduler, which
+	// may itself be blocked submitting a step while the step executor's workers are all busy.
+	completed := make(chan int, len(s.steps))
+	dispatch := func(i int) {
+		step := s.steps[i]
+		if onDispatch != nil {
+			onDispatch(step)
+		}
+		logging.V(7).Infof("deleteSchedule.execute(...): dispatching deletion of '%v'", step.URN())
+		tok := stepExec.ExecuteSerial(chain{step})
+		go func() {
+			tok.Wait(ctx)
+			completed <- i
+		}()
+	}
+
+	for _, i := range s.ready() {
+		dispatch(i)
+	}
+	for remaining := len(s.steps); remaining > 0; remaining-- {
+		select {
+		case i := <-completed:
+			for _, j := range s.complete(i) {
+				dispatch(j)
+			}
+		case <-ctx.Done():
+			logging.V(7).Infof("deleteSchedule.execute(...): canceled with %d deletions outstanding", remaining)
+			return
+		}
+	}
+}
@@ -0,0 +1,94 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package deploy
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/graph"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+)
+
+func newDeleteScheduleTestResource(name string, deps ...resource.URN) *resource.State {
+	return &resource.State{
+		Type:         "test:index:resource",
+		URN:          resource.URN("urn:pulumi:stack::project::test:index:resource::" + name),
+		Dependencies: deps,
+	}
+}
+
+func urnsOf(schedule *deleteSchedule, indices []int) []resource.URN {
+	var urns []resource.URN
+	for _, i := range indices {
+		urns = append(urns, schedule.steps[i].URN())
+	}
+	return urns
+}
+
+func TestScheduleDeletes(t *testing.T) {
+	// a <- b <- c, a <- d. e is unrelated.
+	a := newDeleteScheduleTestResource("a")
+	b := newDeleteScheduleTestResource("b", a.URN)
+	c := newDeleteScheduleTestResource("c", b.URN)
+	d := newDeleteScheduleTestResource("d", a.URN)
+	e := newDeleteScheduleTestResource("e")
+	resources := []*resource.State{a, b, c, d, e}
+
+	sg := &stepGenerator{
+		deployment: &Deployment{depGraph: graph.NewDependencyGraph(resources)},
+		opts:       Options{TrustDependencies: true},
+	}
+
+	var steps []Step
+	for i := len(resources) - 1; i >= 0; i-- {
+		steps = append(steps, NewDeleteStep(nil, resources[i]))
+	}
+	schedule := sg.ScheduleDeletes(steps)
+
+	// Everything that nothing depends upon is ready immediately.
+	assert.ElementsMatch(t, []resource.URN{c.URN, d.URN, e.URN}, urnsOf(schedule, schedule.ready()))
+
+	// The steps are [e, d, c, b, a]. Completing d does not unblock a, which still waits on b.
+	assert.Empty(t, schedule.complete(1))
+	assert.Equal(t, []resource.URN{b.URN}, urnsOf(schedule, schedule.complete(2)))
+	assert.Equal(t, []resource.URN{a.URN}, urnsOf(schedule, schedule.complete(3)))
+	assert.Empty(t, schedule.complete(4))
+}
+
+func TestScheduleDeletesSerial(t *testing.T) {
+	a := newDeleteScheduleTestResource("a")
+	b := newDeleteScheduleTestResource("b")
+	c := newDeleteScheduleTestResource("c")
+	resources := []*resource.State{a, b, c}
+
+	sg := &stepGenerator{
+		deployment: &Deployment{depGraph: graph.NewDependencyGraph(resources)},
+		opts:       Options{TrustDependencies: false},
+	}
+
+	var steps []Step
+	for _, res := range resources {
+		steps = append(steps, NewDeleteStep(nil, res))
+	}
+	schedule := sg.ScheduleDeletes(steps)
+
+	// Without trusted dependencies, each delete waits for the one before it.
+	assert.Equal(t, []resource.URN{a.URN}, urnsOf(schedule, schedule.ready()))
+	assert.Equal(t, []resource.URN{b.URN}, urnsOf(schedule, schedule.complete(0)))
+	assert.Equal(t, []resource.URN{c.URN}, urnsOf(schedule, schedule.complete(1)))
+	assert.Empty(t, schedule.complete(2))
+}
@@ -61,6 +61,28 @@ type Options struct {
 	TrustDependencies         bool           // whether or not to trust the resource dependency graph.
 	UseLegacyDiff             bool           // whether or not to use legacy diffing behavior.
 	DisableResourceReferences bool           // true to disable resource reference support.
+
+	// ProviderParallelism limits the number of concurrent resource operations per package. Packages that are not
+	// listed are only limited by Parallel.
+	ProviderParallelism map[tokens.Package]int
+
+	// RefreshParallelism limits the number of concurrent refreshes per package. If zero,
+	// DefaultRefreshParallelism is used.
+	RefreshParallelism int
+
+	// CachedInvokes lists the functions whose results are deterministic for the duration of a deployment. Invokes of
+	// these functions with the same provider and arguments are only sent to the provider once.
+	CachedInvokes []tokens.ModuleMember
+}
+
+// DefaultRefreshParallelism is the default limit on concurrent refreshes per package.
+const DefaultRefreshParallelism = 32
+
+func (o Options) refreshParallelism() int {
+	if o.RefreshParallelism <= 0 {
+		return DefaultRefreshParallelism
+	}
+	return o.RefreshParallelism
 }
 
 // DegreeOfParallelism returns the degree of parallelism that should be used during the
@@ -24,6 +24,7 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/resource/graph"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/result"
@@ -329,21 +330,11 @@ func (ex *deploymentExecutor) performDeletes(
 		return res
 	}
 
-	deletes := ex.stepGen.ScheduleDeletes(deleteSteps)
-
-	// ScheduleDeletes gives us a list of lists of steps. Each list of steps can safely be executed
-	// in parallel, but each list must execute completes before the next list can safely begin
-	// executing.
-	//
-	// This is not "true" delete parallelism, since there may be resources that could safely begin
-	// deleting but we won't until the previous set of deletes fully completes. This approximation
-	// is conservative, but correct.
-	for _, antichain := range deletes {
-		logging.V(4).Infof("deploymentExecutor.Execute(...): beginning delete antichain")
-		tok := ex.stepExec.ExecuteParallel(antichain)
-		tok.Wait(ctx)
-		logging.V(4).Infof("deploymentExecutor.Execute(...): antichain complete")
-	}
+	// ScheduleDeletes orders the deletes by their dependencies. Each delete is submitted to the step executor as soon
+	// as all of the condemned resources that depend on it have been deleted.
+	logging.V(4).Infof("deploymentExecutor.Execute(...): beginning deletes")
+	ex.stepGen.ScheduleDeletes(deleteSteps).execute(ctx, ex.stepExec, nil)
+	logging.V(4).Infof("deploymentExecutor.Execute(...): deletes complete")
 
 	// After executing targeted deletes, we may now have resources that depend on the resource that
 	// were deleted.  Go through and clean things up accordingly for them.
@@ -405,16 +396,10 @@ func (ex *deploymentExecutor) retirePendingDeletes(callerCtx context.Context, op
 	ctx, cancel := context.WithCancel(callerCtx)
 
 	stepExec := newStepExecutor(ctx, cancel, ex.deployment, opts, preview, false)
-	antichains := ex.stepGen.ScheduleDeletes(steps)
 	// Submit the deletes for execution and wait for them all to retire.
-	for _, antichain := range antichains {
-		for _, step := range antichain {
-			ex.deployment.Ctx().StatusDiag.Infof(diag.RawMessage(step.URN(), "completing deletion from previous update"))
-		}
-
-		tok := stepExec.ExecuteParallel(antichain)
-		tok.Wait(ctx)
-	}
+	ex.stepGen.ScheduleDeletes(steps).execute(ctx, stepExec, func(step Step) {
+		ex.deployment.Ctx().StatusDiag.Infof(diag.RawMessage(step.URN(), "completing deletion from previous update"))
+	})
 
 	stepExec.SignalCompletion()
 	stepExec.WaitForCompletion()
@@ -495,10 +480,28 @@ func (ex *deploymentExecutor) refresh(callerCtx context.Context, opts Options, p
 		}
 	}
 
-	// Fire up a worker pool and issue each refresh in turn.
+	// Fire up a worker pool and issue each refresh in turn. Each package is limited to at most
+	// RefreshParallelism concurrent reads so that large stacks don't flood a single provider.
+	refreshOpts := opts
+	refreshOpts.ProviderParallelism = make(map[tokens.Package]int)
+	for pkg, limit := range opts.ProviderParallelism {
+		refreshOpts.ProviderParallelism[pkg] = limit
+	}
+	for _, step := range steps {
+		pkg := stepPackage(step)
+		if limit, has := refreshOpts.ProviderParallelism[pkg]; !has || limit > opts.refreshParallelism() {
+			refreshOpts.ProviderParallelism[pkg] = opts.refreshParallelism()
+		}
+	}
+
 	ctx, cancel := context.WithCancel(callerCtx)
-	stepExec := newStepExecutor(ctx, cancel, ex.deployment, opts, preview, true)
-	stepExec.ExecuteParallel(steps)
+	stepExec := newStepExecutor(ctx, cancel, ex.deployment, refreshOpts, preview, true)
+
+	// The results of each refresh are applied in bulk by rebuildBaseState below, so there is no need to wait on the
+	// individual steps; just stream them to the step executor.
+	for _, step := range steps {
+		stepExec.ExecuteSerial(chain{step})
+	}
 	stepExec.SignalCompletion()
 	stepExec.WaitForCompletion()
 
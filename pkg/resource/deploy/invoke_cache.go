@@ -0,0 +1,163 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package deploy
+
+import (
+	"strings"
+	"sync"
+
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/plugin"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
+)
+
+// ParseCachedInvokes parses a comma-separated list of the functions whose results may be cached for the duration of
+// a deployment, e.g. "aws:index/getRegion:getRegion,aws:index/getCallerIdentity:getCallerIdentity".
+func ParseCachedInvokes(spec string) ([]tokens.ModuleMember, error) {
+	var toks []tokens.ModuleMember
+	for _, entry := range strings.Split(spec, ",") {
+		entry = strings.TrimSpace(entry)
+		if entry == "" {
+			continue
+		}
+		if tokens.Token(entry).Delimiters() != 2 {
+			return nil, errors.Errorf("invalid cached invoke %q: expected <package>:<module>:<function>", entry)
+		}
+		toks = append(toks, tokens.ModuleMember(entry))
+	}
+	return toks, nil
+}
+
+// InvokeCacheStats records how the invokes that were eligible for caching were served.
+type InvokeCacheStats struct {
+	Hits      int // the number of invokes that were served from the cache.
+	Coalesced int // the number of invokes that waited for an identical invoke that was in flight.
+	Misses    int // the number of invokes that were sent to their provider.
+}
+
+// invokeCache remembers the results of deterministic invokes for the duration of a deployment. Results are keyed by
+// the provider that served the invoke, the function's token, and the invoke's arguments. Concurrent invokes with the
+// same key share a single call to the provider. Invokes that fail are not cached, so they are retried by the next
+// caller.
+type invokeCache struct {
+	cacheable map[tokens.ModuleMember]bool // the functions whose results may be cached.
+
+	m       sync.Mutex
+	entries map[invokeCacheKey][]*invokeCacheEntry // the cached results, bucketed by fingerprint.
+	stats   InvokeCacheStats
+}
+
+// invokeCacheKey identifies a bucket of cached invokes. The fingerprint of an invoke's arguments is only used to
+// find its bucket; the arguments of each entry are compared in full.
+type invokeCacheKey struct {
+	provider string
+	tok      tokens.ModuleMember
+	args     resource.PropertyFingerprint
+}
+
+// invokeCacheEntry holds the result of an invoke. done is closed once the result is available.
+type invokeCacheEntry struct {
+	args     resource.PropertyMap
+	done     chan struct{}
+	ret      resource.PropertyMap
+	failures []plugin.CheckFailure
+	err      error
+}
+
+func newInvokeCache(cacheable []tokens.ModuleMember) *invokeCache {
+	if len(cacheable) == 0 {
+		return nil
+	}
+	c := &invokeCache{
+		cacheable: make(map[tokens.ModuleMember]bool, len(cacheable)),
+		entries:   make(map[invokeCacheKey][]*invokeCacheEntry),
+	}
+	for _, tok := range cacheable {
+		c.cacheable[tok] = true
+	}
+	return c
+}
+
+// invoke returns the result of invoking the given function with the given arguments, calling invoke if the result
+// is not already known. Only functions that were marked as cacheable and whose arguments are known are cached.
+func (c *invokeCache) invoke(provider string, tok tokens.ModuleMember, args resource.PropertyMap,
+	invoke func() (resource.PropertyMap, []plugin.CheckFailure, error)) (
+	resource.PropertyMap, []plugin.CheckFailure, error) {
+
+	if c == nil || !c.cacheable[tok] || args.ContainsUnknowns() {
+		return invoke()
+	}
+
+	fingerprint, _ := args.Fingerprint()
+	key := invokeCacheKey{provider: provider, tok: tok, args: fingerprint}
+
+	c.m.Lock()
+	for _, entry := range c.entries[key] {
+		if entry.args.DeepEquals(args) {
+			select {
+			case <-entry.done:
+				c.stats.Hits++
+			default:
+				c.stats.Coalesced++
+			}
+			c.m.Unlock()
+
+			<-entry.done
+			if entry.err != nil {
+				// The entry has been removed, so the next caller will try again. This caller shares the error of the
+				// call that it waited for.
+				return nil, nil, entry.err
+			}
+			logging.V(7).Infof("invokeCache.invoke(%s): served from cache", tok)
+			return entry.ret, entry.failures, nil
+		}
+	}
+	entry := &invokeCacheEntry{args: args, done: make(chan struct{})}
+	c.entries[key] = append(c.entries[key], entry)
+	c.stats.Misses++
+	c.m.Unlock()
+
+	entry.ret, entry.failures, entry.err = invoke()
+	if entry.err != nil {
+		c.m.Lock()
+		bucket := c.entries[key]
+		for i, e := range bucket {
+			if e == entry {
+				if len(bucket) == 1 {
+					delete(c.entries, key)
+				} else {
+					c.entries[key] = append(bucket[:i:i], bucket[i+1:]...)
+				}
+				break
+			}
+		}
+		c.m.Unlock()
+	}
+	close(entry.done)
+	return entry.ret, entry.failures, entry.err
+}
+
+// getStats returns the cache's stats so far.
+func (c *invokeCache) getStats() InvokeCacheStats {
+	if c == nil {
+		return InvokeCacheStats{}
+	}
+	c.m.Lock()
+	defer c.m.Unlock()
+	return c.stats
+}
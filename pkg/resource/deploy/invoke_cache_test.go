@@ -0,0 +1,144 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package deploy
+
+import (
+	"errors"
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/plugin"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+)
+
+const (
+	getRegion = tokens.ModuleMember("aws:index/getRegion:getRegion")
+	getAmi    = tokens.ModuleMember("aws:ec2/getAmi:getAmi")
+)
+
+func TestParseCachedInvokes(t *testing.T) {
+	toks, err := ParseCachedInvokes(" aws:index/getRegion:getRegion, ,aws:ec2/getAmi:getAmi")
+	assert.NoError(t, err)
+	assert.Equal(t, []tokens.ModuleMember{getRegion, getAmi}, toks)
+
+	_, err = ParseCachedInvokes("aws:getRegion")
+	assert.Error(t, err)
+}
+
+func TestInvokeCacheHits(t *testing.T) {
+	cache := newInvokeCache([]tokens.ModuleMember{getRegion})
+
+	calls := 0
+	invoke := func() (resource.PropertyMap, []plugin.CheckFailure, error) {
+		calls++
+		return resource.PropertyMap{"name": resource.NewStringProperty("us-west-2")}, nil, nil
+	}
+	args := func(name string) resource.PropertyMap {
+		return resource.PropertyMap{"name": resource.NewStringProperty(name)}
+	}
+
+	// Identical invokes are only sent to the provider once.
+	for i := 0; i < 3; i++ {
+		ret, _, err := cache.invoke("provider", getRegion, args("a"), invoke)
+		assert.NoError(t, err)
+		assert.Equal(t, "us-west-2", ret["name"].StringValue())
+	}
+	assert.Equal(t, 1, calls)
+
+	// Invokes with different arguments, providers, or functions are not shared.
+	_, _, err := cache.invoke("provider", getRegion, args("b"), invoke)
+	assert.NoError(t, err)
+	_, _, err = cache.invoke("other", getRegion, args("a"), invoke)
+	assert.NoError(t, err)
+	assert.Equal(t, 3, calls)
+
+	// Functions that are not cacheable and arguments that are unknown are never cached.
+	for i := 0; i < 2; i++ {
+		_, _, err = cache.invoke("provider", getAmi, args("a"), invoke)
+		assert.NoError(t, err)
+		_, _, err = cache.invoke("provider", getRegion, resource.PropertyMap{
+			"name": resource.MakeComputed(resource.NewStringProperty("")),
+		}, invoke)
+		assert.NoError(t, err)
+	}
+	assert.Equal(t, 7, calls)
+
+	assert.Equal(t, InvokeCacheStats{Hits: 2, Misses: 3}, cache.getStats())
+}
+
+func TestInvokeCacheDoesNotCacheErrors(t *testing.T) {
+	cache := newInvokeCache([]tokens.ModuleMember{getRegion})
+
+	calls := 0
+	invoke := func() (resource.PropertyMap, []plugin.CheckFailure, error) {
+		calls++
+		if calls == 1 {
+			return nil, nil, errors.New("throttled")
+		}
+		return resource.PropertyMap{}, nil, nil
+	}
+
+	_, _, err := cache.invoke("provider", getRegion, resource.PropertyMap{}, invoke)
+	assert.EqualError(t, err, "throttled")
+	_, _, err = cache.invoke("provider", getRegion, resource.PropertyMap{}, invoke)
+	assert.NoError(t, err)
+	_, _, err = cache.invoke("provider", getRegion, resource.PropertyMap{}, invoke)
+	assert.NoError(t, err)
+	assert.Equal(t, 2, calls)
+}
+
+func TestInvokeCacheCoalescesConcurrentInvokes(t *testing.T) {
+	cache := newInvokeCache([]tokens.ModuleMember{getRegion})
+
+	// The first invoke does not complete until every other invoke is waiting for it.
+	const count = 8
+	var calls int32
+	release := make(chan struct{})
+	invoke := func() (resource.PropertyMap, []plugin.CheckFailure, error) {
+		atomic.AddInt32(&calls, 1)
+		<-release
+		return resource.PropertyMap{}, []plugin.CheckFailure{{Property: "name", Reason: "deprecated"}}, nil
+	}
+
+	var wg sync.WaitGroup
+	for i := 0; i < count; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			_, failures, err := cache.invoke("provider", getRegion, resource.PropertyMap{}, invoke)
+			assert.NoError(t, err)
+			assert.Len(t, failures, 1)
+		}()
+	}
+	for {
+		stats := cache.getStats()
+		if stats.Misses+stats.Coalesced+stats.Hits == count {
+			break
+		}
+		runtime.Gosched()
+	}
+	close(release)
+	wg.Wait()
+
+	assert.Equal(t, int32(1), atomic.LoadInt32(&calls))
+	stats := cache.getStats()
+	assert.Equal(t, 1, stats.Misses)
+	assert.Equal(t, count-1, stats.Coalesced+stats.Hits)
+}
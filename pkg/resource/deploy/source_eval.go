@@ -405,6 +405,7 @@ type resmon struct {
 	cancel                    chan bool                          // a channel that can cancel the server.
 	done                      chan error                         // a channel that resolves when the server completes.
 	disableResourceReferences bool                               // true if resource references are disabled.
+	invokes                   *invokeCache                       // the cache of deterministic invoke results, if any.
 }
 
 var _ SourceResourceMonitor = (*resmon)(nil)
@@ -436,6 +437,7 @@ func newResourceMonitor(src *evalSource, provs ProviderSource, regChan chan *reg
 		regReadChan:               regReadChan,
 		cancel:                    cancel,
 		disableResourceReferences: opts.DisableResourceReferences,
+		invokes:                   newInvokeCache(opts.CachedInvokes),
 	}
 
 	// Fire up a gRPC server and start listening for incomings.
@@ -473,7 +475,11 @@ func (rm *resmon) Address() string {
 // Cancel signals that the engine should be terminated, awaits its termination, and returns any errors that result.
 func (rm *resmon) Cancel() error {
 	close(rm.cancel)
-	return <-rm.done
+	err := <-rm.done
+	if rm.invokes != nil {
+		logging.V(4).Infof("ResourceMonitor: invoke cache stats: %+v", rm.invokes.getStats())
+	}
+	return err
 }
 
 // getProviderReference fetches the provider reference for a resource, read, or invoke from the given package with the
@@ -539,6 +545,8 @@ func (rm *resmon) SupportsFeature(ctx context.Context,
 		hasSupport = true
 	case "resourceReferences":
 		hasSupport = !rm.disableResourceReferences
+	case "registerResourceBatches":
+		hasSupport = true
 	}
 
 	logging.V(5).Infof("ResourceMonitor.SupportsFeature(id: %s) = %t", req.Id, hasSupport)
@@ -556,10 +564,14 @@ func (rm *resmon) Invoke(ctx context.Context, req *pulumirpc.InvokeRequest) (*pu
 	if err != nil {
 		return nil, err
 	}
-	prov, err := getProviderFromSource(rm.providers, rm.defaultProviders, providerReq, req.GetProvider())
+	providerRef, err := getProviderReference(rm.defaultProviders, providerReq, req.GetProvider())
 	if err != nil {
 		return nil, err
 	}
+	prov, ok := rm.providers.GetProvider(providerRef)
+	if !ok {
+		return nil, errors.Errorf("unknown provider '%v'", req.GetProvider())
+	}
 
 	label := fmt.Sprintf("ResourceMonitor.Invoke(%s)", tok)
 
@@ -576,7 +588,10 @@ func (rm *resmon) Invoke(ctx context.Context, req *pulumirpc.InvokeRequest) (*pu
 
 	// Do the invoke and then return the arguments.
 	logging.V(5).Infof("ResourceMonitor.Invoke received: tok=%v #args=%v", tok, len(args))
-	ret, failures, err := prov.Invoke(tok, args)
+	ret, failures, err := rm.invokes.invoke(providerRef.String(), tok, args,
+		func() (resource.PropertyMap, []plugin.CheckFailure, error) {
+			return prov.Invoke(tok, args)
+		})
 	if err != nil {
 		return nil, errors.Wrapf(err, "invocation of %v returned an error", tok)
 	}
@@ -835,6 +850,72 @@ func (rm *resmon) ReadResource(ctx context.Context,
 func (rm *resmon) RegisterResource(ctx context.Context,
 	req *pulumirpc.RegisterResourceRequest) (*pulumirpc.RegisterResourceResponse, error) {
 
+	wait, err := rm.registerResource(req)
+	if err != nil {
+		return nil, err
+	}
+	return wait()
+}
+
+// RegisterResources is invoked by a language process when a batch of new resources has been allocated. The
+// registrations are sent to the engine in the order in which they appear in the request, and a response is streamed
+// back for each registration as soon as it completes. Each response carries the index of its registration.
+func (rm *resmon) RegisterResources(req *pulumirpc.RegisterResourcesRequest,
+	stream pulumirpc.ResourceMonitor_RegisterResourcesServer) error {
+
+	type registerResult struct {
+		index    int
+		response *pulumirpc.RegisterResourceResponse
+		err      error
+	}
+
+	// Send each registration to the engine in order. The engine processes the registrations concurrently, so we wait
+	// for each of them on its own goroutine.
+	reqs := req.GetRequests()
+	results := make(chan registerResult, len(reqs))
+	for i, r := range reqs {
+		wait, err := rm.registerResource(r)
+		if err != nil {
+			results <- registerResult{index: i, err: err}
+			continue
+		}
+
+		i := i
+		go func() {
+			resp, err := wait()
+			results <- registerResult{index: i, response: resp, err: err}
+		}()
+	}
+
+	// Stream the responses back to the language host as they arrive. A failed registration fails the entire request,
+	// just as it would have failed the corresponding call to RegisterResource.
+	for range reqs {
+		var result registerResult
+		select {
+		case result = <-results:
+		case <-stream.Context().Done():
+			return stream.Context().Err()
+		}
+		if result.err != nil {
+			return result.err
+		}
+
+		if err := stream.Send(&pulumirpc.RegisterResourcesResponse{
+			Index:    int32(result.index),
+			Response: result.response,
+		}); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// registerResource validates the given registration and sends it to the engine. The returned function waits for the
+// registration to finish and returns the response for the language host. Registrations are sent to the engine in the
+// order in which registerResource is called, regardless of the order in which they are waited upon.
+func (rm *resmon) registerResource(
+	req *pulumirpc.RegisterResourceRequest) (func() (*pulumirpc.RegisterResourceResponse, error), error) {
+
 	// Communicate the type, name, and object information to the iterator that is awaiting us.
 	name := tokens.QName(req.GetName())
 	custom := req.GetCustom()
@@ -973,65 +1054,76 @@ func (rm *resmon) RegisterResource(ctx context.Context,
 		aliases, timeouts, providerRefs, replaceOnChanges)
 
 	// If this is a remote component, fetch its provider and issue the construct call. Otherwise, register the resource.
-	var result *RegisterResult
-	var outputDeps map[string]*pulumirpc.RegisterResourceResponse_PropertyDependencies
 	if remote {
 		provider, ok := rm.providers.GetProvider(providerRef)
 		if !ok {
 			return nil, errors.Errorf("unknown provider '%v'", providerRef)
 		}
 
-		// Invoke the provider's Construct RPC method.
-		options := plugin.ConstructOptions{
-			Aliases:              aliases,
-			Protect:              protect,
-			PropertyDependencies: propertyDependencies,
-			Providers:            providerRefs,
-		}
-		constructResult, err := provider.Construct(rm.constructInfo, t, name, parent, props, options)
-		if err != nil {
-			return nil, err
-		}
-		result = &RegisterResult{State: &resource.State{URN: constructResult.URN, Outputs: constructResult.Outputs}}
-
-		outputDeps = map[string]*pulumirpc.RegisterResourceResponse_PropertyDependencies{}
-		for k, deps := range constructResult.OutputDependencies {
-			urns := make([]string, len(deps))
-			for i, d := range deps {
-				urns[i] = string(d)
+		return func() (*pulumirpc.RegisterResourceResponse, error) {
+			// Invoke the provider's Construct RPC method.
+			options := plugin.ConstructOptions{
+				Aliases:              aliases,
+				Protect:              protect,
+				PropertyDependencies: propertyDependencies,
+				Providers:            providerRefs,
 			}
-			outputDeps[string(k)] = &pulumirpc.RegisterResourceResponse_PropertyDependencies{Urns: urns}
-		}
-	} else {
-		// Send the goal state to the engine.
-		step := &registerResourceEvent{
-			goal: resource.NewGoal(t, name, custom, props, parent, protect, dependencies,
-				providerRef.String(), nil, propertyDependencies, deleteBeforeReplace, ignoreChanges,
-				additionalSecretOutputs, aliases, id, &timeouts, replaceOnChanges),
-			done: make(chan *RegisterResult),
-		}
+			constructResult, err := provider.Construct(rm.constructInfo, t, name, parent, props, options)
+			if err != nil {
+				return nil, err
+			}
+			result := &RegisterResult{State: &resource.State{URN: constructResult.URN, Outputs: constructResult.Outputs}}
+
+			outputDeps := map[string]*pulumirpc.RegisterResourceResponse_PropertyDependencies{}
+			for k, deps := range constructResult.OutputDependencies {
+				urns := make([]string, len(deps))
+				for i, d := range deps {
+					urns[i] = string(d)
+				}
+				outputDeps[string(k)] = &pulumirpc.RegisterResourceResponse_PropertyDependencies{Urns: urns}
+			}
+			return newRegisterResourceResponse(req, label, result, outputDeps)
+		}, nil
+	}
 
-		select {
-		case rm.regChan <- step:
-		case <-rm.cancel:
-			logging.V(5).Infof("ResourceMonitor.RegisterResource operation canceled, name=%s", name)
-			return nil, rpcerror.New(codes.Unavailable, "resource monitor shut down while sending resource registration")
-		}
+	// Send the goal state to the engine.
+	step := &registerResourceEvent{
+		goal: resource.NewGoal(t, name, custom, props, parent, protect, dependencies,
+			providerRef.String(), nil, propertyDependencies, deleteBeforeReplace, ignoreChanges,
+			additionalSecretOutputs, aliases, id, &timeouts, replaceOnChanges),
+		done: make(chan *RegisterResult),
+	}
+
+	select {
+	case rm.regChan <- step:
+	case <-rm.cancel:
+		logging.V(5).Infof("ResourceMonitor.RegisterResource operation canceled, name=%s", name)
+		return nil, rpcerror.New(codes.Unavailable, "resource monitor shut down while sending resource registration")
+	}
 
+	return func() (*pulumirpc.RegisterResourceResponse, error) {
 		// Now block waiting for the operation to finish.
+		var result *RegisterResult
 		select {
 		case result = <-step.done:
 		case <-rm.cancel:
 			logging.V(5).Infof("ResourceMonitor.RegisterResource operation canceled, name=%s", name)
 			return nil, rpcerror.New(codes.Unavailable, "resource monitor shut down while waiting on step's done channel")
 		}
-	}
+		return newRegisterResourceResponse(req, label, result, nil)
+	}, nil
+}
+
+// newRegisterResourceResponse unpacks the result of a resource registration into the response for the language host.
+func newRegisterResourceResponse(req *pulumirpc.RegisterResourceRequest, label string, result *RegisterResult,
+	outputDeps map[string]*pulumirpc.RegisterResourceResponse_PropertyDependencies,
+) (*pulumirpc.RegisterResourceResponse, error) {
 
 	// Filter out partially-known values if the requestor does not support them.
 	outputs := result.State.Outputs
 
 	// Local ComponentResources may contain unresolved resource refs, so ignore those outputs.
-	if !req.GetCustom() && !remote {
+	if !req.GetCustom() && !req.GetRemote() {
 		// In the case of a SameStep, the old resource outputs are returned to the language host after the step is
 		// executed. The outputs of a ComponentResource may depend on resources that have not been registered at the
 		// time the ComponentResource is itself registered, as the outputs are set by a later call to
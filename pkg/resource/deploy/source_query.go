@@ -509,6 +509,13 @@ func (rm *queryResmon) RegisterResource(ctx context.Context,
 	return nil, fmt.Errorf("Query mode does not support creating, updating, or deleting resources")
 }
 
+// RegisterResources is invoked by a language process when a batch of new resources has been allocated.
+func (rm *queryResmon) RegisterResources(req *pulumirpc.RegisterResourcesRequest,
+	stream pulumirpc.ResourceMonitor_RegisterResourcesServer) error {
+
+	return fmt.Errorf("Query mode does not support creating, updating, or deleting resources")
+}
+
 // RegisterResourceOutputs records some new output properties for a resource that have arrived after its initial
 // provisioning.  These will make their way into the eventual checkpoint state file for that resource.
 func (rm *queryResmon) RegisterResourceOutputs(ctx context.Context,
@@ -20,6 +20,7 @@ import (
 
 	"github.com/pkg/errors"
 
+	"github.com/pulumi/pulumi/pkg/v3/codegen/schema"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy/providers"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag/colors"
@@ -909,12 +910,11 @@ func (s *ImportStep) Apply(preview bool) (resource.Status, StepCompleteFunc, err
 	if s.planned {
 		contract.Assert(len(s.new.Inputs) == 0)
 
-		pkg, err := s.deployment.schemaLoader.LoadPackage(string(s.new.Type.Package()), nil)
+		r, ok, err := schema.LoadResource(s.deployment.schemaLoader, string(s.new.Type.Package()), nil,
+			string(s.new.Type))
 		if err != nil {
 			return resource.StatusOK, nil, errors.Wrapf(err, "failed to fetch provider schema")
 		}
-
-		r, ok := pkg.GetResource(string(s.new.Type))
 		if !ok {
 			return resource.StatusOK, nil, errors.Errorf("unknown resource type '%v'", s.new.Type)
 		}
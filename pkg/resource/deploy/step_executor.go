@@ -19,10 +19,14 @@ import (
 	"fmt"
 	"sync"
 	"sync/atomic"
+	"time"
 
 	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/pkg/v3/util/metrics"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
 )
@@ -75,6 +79,9 @@ func (c completionToken) Wait(ctx context.Context) {
 type incomingChain struct {
 	Chain          chain     // The chain we intend to execute
 	CompletionChan chan bool // A completion channel to be closed when the chain has completed execution
+
+	pkg      tokens.Package // The package responsible for executing the chain
+	enqueued time.Time      // The time at which the chain was submitted
 }
 
 // stepExecutor is the component of the engine responsible for taking steps and executing
@@ -91,8 +98,10 @@ type stepExecutor struct {
 	pendingNews     sync.Map    // Resources that have been created but are pending a RegisterResourceOutputs.
 	continueOnError bool        // True if we want to continue the deployment after a step error.
 
-	workers        sync.WaitGroup     // WaitGroup tracking the worker goroutines that are owned by this step executor.
-	incomingChains chan incomingChain // Incoming chains that we are to execute
+	workers        sync.WaitGroup      // WaitGroup tracking the worker goroutines that are owned by this step executor.
+	incomingChains chan incomingChain  // Incoming chains that we are to execute
+	scheduler      *chainScheduler     // The chains waiting for a worker
+	retired        chan tokens.Package // The packages of chains that workers have finished executing
 
 	ctx      context.Context    // cancellation context for the current deployment.
 	cancel   context.CancelFunc // CancelFunc that cancels the above context.
@@ -108,12 +117,22 @@ type stepExecutor struct {
 // Execute submits a Chain for asynchronous execution. The execution of the chain will begin as soon as there
 // is a worker available to execute it.
 func (se *stepExecutor) ExecuteSerial(chain chain) completionToken {
+	completion := make(chan bool)
+	if len(chain) == 0 {
+		close(completion)
+		return completionToken{channel: completion}
+	}
+
 	// The select here is to avoid blocking on a send to se.incomingChains if a cancellation is pending.
 	// If one is pending, we should exit early - we will shortly be tearing down the engine and exiting.
-
-	completion := make(chan bool)
+	request := incomingChain{
+		Chain:          chain,
+		CompletionChan: completion,
+		pkg:            stepPackage(chain[0]),
+		enqueued:       time.Now(),
+	}
 	select {
-	case se.incomingChains <- incomingChain{Chain: chain, CompletionChan: completion}:
+	case se.incomingChains <- request:
 	case <-se.ctx.Done():
 		close(completion)
 	}
@@ -182,6 +201,11 @@ func (se *stepExecutor) ExecuteRegisterResourceOutputs(e RegisterResourceOutputs
 	e.Done()
 }
 
+// QueueStats returns the scheduling stats of the chains executed so far, by package.
+func (se *stepExecutor) QueueStats() map[tokens.Package]ProviderQueueStats {
+	return se.scheduler.queueStats()
+}
+
 // Errored returns whether or not this step executor saw a step whose execution ended in failure.
 func (se *stepExecutor) Errored() bool {
 	return se.sawError.Load().(bool)
@@ -268,7 +292,14 @@ func (se *stepExecutor) executeStep(workerID int, step Step) error {
 	}
 
 	se.log(workerID, "applying step %v on %v (preview %v)", step.Op(), step.URN(), se.preview)
-	status, stepComplete, err := step.Apply(se.preview)
+	var status resource.Status
+	var stepComplete StepCompleteFunc
+	var err error
+	pkg, start := stepPackage(step), metrics.Now()
+	metrics.Do(se.ctx, func(context.Context) {
+		status, stepComplete, err = step.Apply(se.preview)
+	}, "urn", string(step.URN()), "provider", string(pkg), "phase", string(step.Op()))
+	metrics.ObserveSince("step.apply", string(pkg)+":"+string(step.Op()), start)
 
 	if err == nil {
 		// If we have a state object, and this is a create or update, remember it, as we may need to update it later.
@@ -333,52 +364,93 @@ func (se *stepExecutor) log(workerID int, msg string, args ...interface{}) {
 // executing steps. By default, as we ease into the waters of parallelism, there is at most one worker
 // active.
 //
-// Workers continuously pull from se.incomingChains, executing chains as they are provided to the executor.
-// There are two reasons why a worker would exit:
+// A single scheduling goroutine continuously pulls from se.incomingChains and queues the chains it receives
+// by package. Whenever a worker is idle, the scheduler hands it the next chain whose package has not reached its
+// concurrency limit (see Options.ProviderParallelism). There are two reasons why a worker would exit:
 //
 //  1. A worker exits if se.ctx is canceled. There are two ways that se.ctx gets canceled: first, if there is
 //     a step error in another worker, it will cancel the context. Second, if the deployment executor experiences an
 //     error when generating steps or doing pre or post-step events, it will cancel the context.
-//  2. A worker exits if it experiences an error when running a step.
+//  2. A worker exits once the step executor has been signalled for completion and every chain submitted to it has
+//     been executed.
 //
 
-// worker is the base function for all step executor worker goroutines. It continuously polls for new chains
-// and executes any that it gets from the channel. If `launchAsync` is true, worker launches a new goroutine
-// that will execute the chain so that the execution continues asynchronously and this worker can proceed to
-// the next chain.
-func (se *stepExecutor) worker(workerID int, launchAsync bool) {
-	se.log(workerID, "worker coming online")
+// schedule is the base function of the step executor's scheduling goroutine. It queues incoming chains and hands
+// them to workers until the step executor is signalled for completion and all queued chains have retired. If ready
+// is nil, every chain is executed on its own goroutine as soon as its package's limit allows.
+func (se *stepExecutor) schedule(ready chan<- incomingChain) {
+	se.log(synchronousWorkerID, "scheduler coming online")
 	defer se.workers.Done()
+	if ready != nil {
+		defer close(ready)
+	}
+	defer func() {
+		for pkg, stats := range se.scheduler.queueStats() {
+			se.log(synchronousWorkerID, "package %v: dispatched %d chains, max queue depth %d, total wait %v, max wait %v",
+				pkg, stats.Dispatched, stats.MaxQueueDepth, stats.TotalWait, stats.MaxWait)
+		}
+	}()
 
 	oneshotWorkerID := 0
+	incoming := se.incomingChains
+	for incoming != nil || !se.scheduler.idle() {
+		next, nextIndex, hasNext := se.scheduler.peek()
+
+		// If we're launching asynchronously, make up a new worker ID for each new oneshot worker and record its
+		// launch with our worker wait group.
+		if hasNext && ready == nil {
+			se.scheduler.dispatch(next, nextIndex)
+			se.workers.Add(1)
+			go se.oneshotWorker(oneshotWorkerID, next)
+			oneshotWorkerID++
+			continue
+		}
+
+		var readyChains chan<- incomingChain
+		if hasNext {
+			readyChains = ready
+		}
+
+		select {
+		case request, ok := <-incoming:
+			if !ok {
+				se.log(synchronousWorkerID, "scheduler received completion signal")
+				incoming = nil
+				continue
+			}
+			se.scheduler.enqueue(request)
+		case readyChains <- next:
+			se.scheduler.dispatch(next, nextIndex)
+		case pkg := <-se.retired:
+			se.scheduler.retire(pkg)
+		case <-se.ctx.Done():
+			se.log(synchronousWorkerID, "scheduler exiting due to cancellation")
+			se.scheduler.cancel()
+			return
+		}
+	}
+	se.log(synchronousWorkerID, "scheduler exiting, all chains retired")
+}
+
+// worker is the base function for all step executor worker goroutines. It continuously polls for chains
+// handed to it by the scheduler and executes them.
+func (se *stepExecutor) worker(workerID int, ready <-chan incomingChain) {
+	se.log(workerID, "worker coming online")
+	defer se.workers.Done()
+
 	for {
 		se.log(workerID, "worker waiting for incoming chains")
 		select {
-		case request := <-se.incomingChains:
-			if request.Chain == nil {
-				se.log(workerID, "worker received nil chain, exiting")
+		case request, ok := <-ready:
+			if !ok {
+				se.log(workerID, "worker received completion signal, exiting")
 				return
 			}
 
 			se.log(workerID, "worker received chain for execution")
-			if !launchAsync {
-				se.executeChain(workerID, request.Chain)
-				close(request.CompletionChan)
-				continue
-			}
-
-			// If we're launching asynchronously, make up a new worker ID for this new oneshot worker and record its
-			// launch with our worker wait group.
-			se.workers.Add(1)
-			newWorkerID := oneshotWorkerID
-			go func() {
-				defer se.workers.Done()
-				se.log(newWorkerID, "launching oneshot worker")
-				se.executeChain(newWorkerID, request.Chain)
-				close(request.CompletionChan)
-			}()
-
-			oneshotWorkerID++
+			se.executeChain(workerID, request.Chain)
+			close(request.CompletionChan)
+			se.retire(request.pkg)
 		case <-se.ctx.Done():
 			se.log(workerID, "worker exiting due to cancellation")
 			return
@@ -386,6 +458,23 @@ func (se *stepExecutor) worker(workerID int, launchAsync bool) {
 	}
 }
 
+// oneshotWorker executes a single chain on its own goroutine.
+func (se *stepExecutor) oneshotWorker(workerID int, request incomingChain) {
+	defer se.workers.Done()
+	se.log(workerID, "launching oneshot worker")
+	se.executeChain(workerID, request.Chain)
+	close(request.CompletionChan)
+	se.retire(request.pkg)
+}
+
+// retire notifies the scheduler that a chain of the given package has finished executing.
+func (se *stepExecutor) retire(pkg tokens.Package) {
+	select {
+	case se.retired <- pkg:
+	case <-se.ctx.Done():
+	}
+}
+
 func newStepExecutor(ctx context.Context, cancel context.CancelFunc, deployment *Deployment, opts Options,
 	preview, continueOnError bool) *stepExecutor {
 	exec := &stepExecutor{
@@ -394,25 +483,31 @@ func newStepExecutor(ctx context.Context, cancel context.CancelFunc, deployment
 		preview:         preview,
 		continueOnError: continueOnError,
 		incomingChains:  make(chan incomingChain),
+		scheduler:       newChainScheduler(opts.ProviderParallelism),
+		retired:         make(chan tokens.Package),
 		ctx:             ctx,
 		cancel:          cancel,
 	}
 
 	exec.sawError.Store(false)
 
-	// If we're being asked to run as parallel as possible, spawn a single worker that launches chain executions
+	// If we're being asked to run as parallel as possible, let the scheduler launch chain executions
 	// asynchronously.
 	if opts.InfiniteParallelism() {
 		exec.workers.Add(1)
-		go exec.worker(infiniteWorkerID, true /*launchAsync*/)
+		go exec.schedule(nil)
 		return exec
 	}
 
 	// Otherwise, launch a worker goroutine for each degree of parallelism.
+	ready := make(chan incomingChain)
+	exec.workers.Add(1)
+	go exec.schedule(ready)
+
 	fanout := opts.DegreeOfParallelism()
 	for i := 0; i < fanout; i++ {
 		exec.workers.Add(1)
-		go exec.worker(i, false /*launchAsync*/)
+		go exec.worker(i, ready)
 	}
 
 	return exec
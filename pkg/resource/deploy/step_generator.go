@@ -19,7 +19,7 @@ import (
 
 	"github.com/pkg/errors"
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy/providers"
-	"github.com/pulumi/pulumi/pkg/v3/resource/graph"
+	"github.com/pulumi/pulumi/pkg/v3/util/metrics"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
@@ -66,6 +66,10 @@ type stepGenerator struct {
 
 	// a map from old names (aliased URNs) to the new URN that aliased to them.
 	aliased map[resource.URN]resource.URN
+
+	// a map from provider references to the fingerprints of the providers' inputs and plugin versions, which
+	// contribute to the diff fingerprints of their resources.
+	providerFingerprints map[string]resource.PropertyFingerprint
 }
 
 func (sg *stepGenerator) isTargetedUpdate() bool {
@@ -149,7 +153,9 @@ func (sg *stepGenerator) GenerateReadSteps(event ReadResourceEvent) ([]Step, res
 // If the given resource is a custom resource, the step generator will invoke Diff and Check on the
 // provider associated with that resource. If those fail, an error is returned.
 func (sg *stepGenerator) GenerateSteps(event RegisterResourceEvent) ([]Step, result.Result) {
+	start := metrics.Now()
 	steps, res := sg.generateSteps(event)
+	metrics.ObserveSince("step.generate", string(typePackage(event.Goal().Type)), start)
 	if res != nil {
 		contract.Assert(len(steps) == 0)
 		return nil, res
@@ -308,9 +314,9 @@ func (sg *stepGenerator) generateSteps(event RegisterResourceEvent) ([]Step, res
 		// don't consider those inputs since Pulumi does not own them. Finally, if the resource has been
 		// targeted for replacement, ignore its old state.
 		if recreating || wasExternal || sg.isTargetedReplace(urn) {
-			inputs, failures, err = prov.Check(urn, nil, goal.Properties, allowUnknowns)
+			inputs, failures, err = checkResource(prov, urn, nil, goal.Properties, allowUnknowns)
 		} else {
-			inputs, failures, err = prov.Check(urn, oldInputs, inputs, allowUnknowns)
+			inputs, failures, err = checkResource(prov, urn, oldInputs, inputs, allowUnknowns)
 		}
 
 		if err != nil {
@@ -555,7 +561,7 @@ func (sg *stepGenerator) generateStepsFromDiff(
 			// Note that if we're performing a targeted replace, we already have the correct inputs.
 			if prov != nil && !sg.isTargetedReplace(urn) {
 				var failures []plugin.CheckFailure
-				inputs, failures, err = prov.Check(urn, nil, goal.Properties, allowUnknowns)
+				inputs, failures, err = checkResource(prov, urn, nil, goal.Properties, allowUnknowns)
 				if err != nil {
 					return nil, result.FromError(err)
 				} else if issueCheckErrors(sg.deployment, new, urn, failures) {
@@ -858,91 +864,49 @@ func (sg *stepGenerator) GeneratePendingDeletes() []Step {
 	return dels
 }
 
-// scheduleDeletes takes a list of steps that will delete resources and "schedules" them by producing a list of list of
-// steps, where each list can be executed in parallel but a previous list must be executed to completion before advacing
-// to the next list.
-//
-// In lieu of tracking per-step dependencies and orienting the step executor around these dependencies, this function
-// provides a conservative approximation of what deletions can safely occur in parallel. The insight here is that the
-// resource dependency graph is a partially-ordered set and all partially-ordered sets can be easily decomposed into
-// antichains - subsets of the set that are all not comparable to one another. (In this definition, "not comparable"
-// means "do not depend on one another").
-//
-// The algorithm for decomposing a poset into antichains is:
-//  1. While there exist elements in the poset,
-//    1a. There must exist at least one "maximal" element of the poset. Let E_max be those elements.
-//    2a. Remove all elements E_max from the poset. E_max is an antichain.
-//    3a. Goto 1.
+// ScheduleDeletes takes a list of steps that will delete resources and "schedules" them by determining, for each step,
+// the set of other deletions that must complete before it may begin. A resource can only be deleted once every
+// condemned resource that depends on it has been deleted.
 //
-// Translated to our dependency graph:
-//  1. While the set of condemned resources is not empty:
-//    1a. Remove all resources with no outgoing edges from the graph and add them to the current antichain.
-//    2a. Goto 1.
+// Rather than decomposing the condemned set into antichains and executing each antichain to completion before
+// advancing to the next, the resulting schedule tracks the number of outstanding dependents of each condemned resource.
+// The deployment executor dispatches a delete as soon as that count drops to zero, so the time taken to delete a set
+// of resources is bounded by the longest chain of dependencies rather than by the slowest deletion in each layer.
 //
-// The resulting list of antichains is a list of list of steps that can be safely executed in parallel. Since we must
-// process deletes in reverse (so we don't delete resources upon which other resources depend), we reverse the list and
-// hand it back to the deployment executor for safe execution.
-func (sg *stepGenerator) ScheduleDeletes(deleteSteps []Step) []antichain {
-	var antichains []antichain                // the list of parallelizable steps we intend to return.
-	dg := sg.deployment.depGraph              // the current deployment's dependency graph.
-	condemned := make(graph.ResourceSet)      // the set of condemned resources.
-	stepMap := make(map[*resource.State]Step) // a map from resource states to the steps that delete them.
-
+// Building the schedule visits the dependencies of each condemned resource exactly once.
+func (sg *stepGenerator) ScheduleDeletes(deleteSteps []Step) *deleteSchedule {
 	// If we don't trust the dependency graph we've been given, we must be conservative and delete everything serially.
 	if !sg.opts.TrustDependencies {
 		logging.V(7).Infof("Planner does not trust dependency graph, scheduling deletions serially")
-		for _, step := range deleteSteps {
-			antichains = append(antichains, antichain{step})
-		}
-
-		return antichains
+		return newSerialDeleteSchedule(deleteSteps)
 	}
 
 	logging.V(7).Infof("Planner trusts dependency graph, scheduling deletions in parallel")
 
-	// For every step we've been given, record it as condemned and save the step that will be used to delete it. We'll
-	// iteratively place these steps into antichains as we remove elements from the condemned set.
-	for _, step := range deleteSteps {
-		condemned[step.Res()] = true
-		stepMap[step.Res()] = step
-	}
-
-	for len(condemned) > 0 {
-		var steps antichain
-		logging.V(7).Infof("Planner beginning schedule of new deletion antichain")
-		for res := range condemned {
-			// Does res have any outgoing edges to resources that haven't already been removed from the graph?
-			condemnedDependencies := dg.DependenciesOf(res).Intersect(condemned)
-			if len(condemnedDependencies) == 0 {
-				// If not, it's safe to delete res at this stage.
-				logging.V(7).Infof("Planner scheduling deletion of '%v'", res.URN)
-				steps = append(steps, stepMap[res])
+	dg := sg.deployment.depGraph               // the current deployment's dependency graph.
+	condemned := make(map[*resource.State]int) // a map from condemned resources to the index of their delete step.
+	for i, step := range deleteSteps {
+		condemned[step.Res()] = i
+	}
+
+	schedule := &deleteSchedule{
+		steps:    deleteSteps,
+		blockers: make([]int, len(deleteSteps)),
+		unblocks: make([][]int, len(deleteSteps)),
+	}
+	for i, step := range deleteSteps {
+		// Each condemned dependency of this resource (including its parent and provider) must wait until this
+		// resource has been deleted.
+		for dep := range dg.DependenciesOf(step.Res()) {
+			if j, has := condemned[dep]; has && j != i {
+				logging.V(7).Infof("Planner scheduling deletion of '%v' after '%v'", dep.URN, step.URN())
+				schedule.blockers[j]++
+				schedule.unblocks[i] = append(schedule.unblocks[i], j)
 			}
-
-			// If one of this resource's dependencies or this resource's parent hasn't been removed from the graph yet,
-			// it can't be deleted this round.
-		}
-
-		// For all reosurces that are to be deleted in this round, remove them from the graph.
-		for _, step := range steps {
-			delete(condemned, step.Res())
 		}
-
-		antichains = append(antichains, steps)
 	}
 
-	// Up until this point, all logic has been "backwards" - we're scheduling resources for deletion when all of their
-	// dependencies finish deletion, but that's exactly the opposite of what we need to do. We can only delete a
-	// resource when all *resources that depend on it* complete deletion. Our solution is still correct, though, it's
-	// just backwards.
-	//
-	// All we have to do here is reverse the list and then our solution is correct.
-	for i := len(antichains)/2 - 1; i >= 0; i-- {
-		opp := len(antichains) - 1 - i
-		antichains[i], antichains[opp] = antichains[opp], antichains[i]
-	}
-
-	return antichains
+	return schedule
 }
 
 // providerChanged diffs the Provider field of old and new resources, returning true if the rest of the step generator
@@ -1047,6 +1011,27 @@ func (sg *stepGenerator) diff(urn resource.URN, old, new *resource.State, oldInp
 		return plugin.DiffResult{Changes: plugin.DiffSome, ReplaceKeys: []resource.PropertyKey{"provider"}}, nil
 	}
 
+	// If the last diff of this resource with exactly these arguments found no changes, this one would find none
+	// either, so there is no need to ask the provider again. Remember the fingerprint of any diff that finds no
+	// changes so that the next deployment can do the same.
+	fingerprint := sg.diffFingerprint(old, new, oldInputs, oldOutputs, newInputs, prov, ignoreChanges)
+	if fingerprint != 0 && fingerprint == old.DiffFingerprint {
+		logging.V(7).Infof("sg.diff(%s, ...): skipping diff: arguments unchanged since the last diff", urn)
+		new.DiffFingerprint = fingerprint
+		return plugin.DiffResult{Changes: plugin.DiffNone}, nil
+	}
+	diff, err := sg.diffArguments(urn, old, oldInputs, oldOutputs, newInputs, prov, allowUnknowns, ignoreChanges)
+	if err == nil && diff.Changes == plugin.DiffNone {
+		new.DiffFingerprint = fingerprint
+	}
+	return diff, err
+}
+
+// diffArguments returns a DiffResult for the given resource once its provider is known not to have changed.
+func (sg *stepGenerator) diffArguments(urn resource.URN, old *resource.State, oldInputs, oldOutputs,
+	newInputs resource.PropertyMap, prov plugin.Provider, allowUnknowns bool,
+	ignoreChanges []string) (plugin.DiffResult, error) {
+
 	// Apply legacy diffing behavior if requested. In this mode, if the provider-calculated inputs for a resource did
 	// not change, then the resource is considered to have no diff between its desired and actual state.
 	if sg.opts.UseLegacyDiff && oldInputs.DeepEquals(newInputs) {
@@ -1065,6 +1050,86 @@ func (sg *stepGenerator) diff(urn resource.URN, old, new *resource.State, oldInp
 	return diffResource(urn, old.ID, oldInputs, oldOutputs, newInputs, prov, allowUnknowns, ignoreChanges)
 }
 
+// diffFingerprintVersion is mixed into every diff fingerprint. Bump it whenever the engine's diff semantics change,
+// so that diffs skipped on the strength of fingerprints recorded by older engines are performed again.
+const diffFingerprintVersion = 1
+
+// diffFingerprint returns a fingerprint of the arguments to a diff of the given resource: its URN and ID, its old
+// inputs and outputs, its new inputs, the changes that it ignores, and the reference to, inputs of, and plugin
+// version of its provider. Returns zero if any of them contain secrets, as diff fingerprints are persisted in
+// plaintext, or if the provider's version cannot be determined.
+func (sg *stepGenerator) diffFingerprint(old, new *resource.State, oldInputs, oldOutputs,
+	newInputs resource.PropertyMap, prov plugin.Provider, ignoreChanges []string) resource.PropertyFingerprint {
+
+	f := resource.NewFingerprinter()
+	f.WriteUint64(diffFingerprintVersion)
+	f.WriteString(string(new.URN))
+	f.WriteString(string(old.ID))
+	f.WriteString(new.Provider)
+	if new.Provider != "" {
+		providerFingerprint, ok := sg.providerFingerprints[new.Provider]
+		if !ok {
+			providerFingerprint = sg.providerFingerprint(new.URN, new.Provider, prov)
+			sg.providerFingerprints[new.Provider] = providerFingerprint
+		}
+		if providerFingerprint == 0 {
+			return 0
+		}
+		f.WriteFingerprint(providerFingerprint)
+	}
+	if sg.opts.UseLegacyDiff {
+		// Legacy diffs find no changes without consulting the provider, so their fingerprints must not be mistaken
+		// for those of ordinary diffs.
+		f.WriteString("legacy")
+	}
+	f.WriteProperties(oldInputs)
+	f.WriteProperties(oldOutputs)
+	f.WriteProperties(newInputs)
+	for _, path := range ignoreChanges {
+		f.WriteString(path)
+	}
+	if f.Secret() {
+		return 0
+	}
+	return f.Sum()
+}
+
+// providerFingerprint returns a fingerprint of the inputs and plugin version of the given provider, which contributes
+// to the diff fingerprints of its resources. The plugin version matters because a provider whose version is not
+// pinned loads the newest plugin that is installed, and a newer plugin may find differences that an older one did
+// not. Returns zero if the provider's inputs contain secrets or its version cannot be determined.
+func (sg *stepGenerator) providerFingerprint(urn resource.URN, ref string,
+	prov plugin.Provider) resource.PropertyFingerprint {
+
+	inputs, secret := sg.getProviderResource(urn, ref).Inputs.Fingerprint()
+	if secret || prov == nil {
+		return 0
+	}
+	info, err := prov.GetPluginInfo()
+	if err != nil {
+		logging.V(7).Infof("sg.providerFingerprint(%s, ...): not fingerprinting diffs: %v", urn, err)
+		return 0
+	}
+
+	f := resource.NewFingerprinter()
+	f.WriteFingerprint(inputs)
+	f.WriteBool(info.Version != nil)
+	if info.Version != nil {
+		f.WriteString(info.Version.String())
+	}
+	return f.Sum()
+}
+
+// checkResource invokes the Check function for the given resource's provider and returns the result.
+func checkResource(prov plugin.Provider, urn resource.URN, olds, news resource.PropertyMap,
+	allowUnknowns bool) (resource.PropertyMap, []plugin.CheckFailure, error) {
+
+	start := metrics.Now()
+	inputs, failures, err := prov.Check(urn, olds, news, allowUnknowns)
+	metrics.ObserveSince("provider.check", string(typePackage(urn.Type())), start)
+	return inputs, failures, err
+}
+
 // diffResource invokes the Diff function for the given custom resource's provider and returns the result.
 func diffResource(urn resource.URN, id resource.ID, oldInputs, oldOutputs,
 	newInputs resource.PropertyMap, prov plugin.Provider, allowUnknowns bool,
@@ -1074,7 +1139,9 @@ func diffResource(urn resource.URN, id resource.ID, oldInputs, oldOutputs,
 
 	// Grab the diff from the provider. At this point we know that there were changes to the Pulumi inputs, so if the
 	// provider returns an "unknown" diff result, pretend it returned "diffs exist".
+	start := metrics.Now()
 	diff, err := prov.Diff(urn, id, oldOutputs, newInputs, allowUnknowns, ignoreChanges)
+	metrics.ObserveSince("provider.diff", string(typePackage(urn.Type())), start)
 	if err != nil {
 		return diff, err
 	}
@@ -1485,5 +1552,6 @@ func newStepGenerator(
 		providers:            make(map[resource.URN]*resource.State),
 		dependentReplaceKeys: make(map[resource.URN][]resource.PropertyKey),
 		aliased:              make(map[resource.URN]resource.URN),
+		providerFingerprints: make(map[string]resource.PropertyFingerprint),
 	}
 }
@@ -0,0 +1,201 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package deploy
+
+import (
+	"strconv"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy/providers"
+	"github.com/pulumi/pulumi/pkg/v3/util/metrics"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+)
+
+// ParseProviderParallelism parses a comma-separated list of per-package limits on the number of concurrent resource
+// operations, e.g. "aws=8,kubernetes=32", as accepted by Options.ProviderParallelism.
+func ParseProviderParallelism(spec string) (map[tokens.Package]int, error) {
+	limits := make(map[tokens.Package]int)
+	for _, entry := range strings.Split(spec, ",") {
+		entry = strings.TrimSpace(entry)
+		if entry == "" {
+			continue
+		}
+
+		eq := strings.IndexByte(entry, '=')
+		if eq <= 0 {
+			return nil, errors.Errorf("invalid provider parallelism %q: expected <package>=<limit>", entry)
+		}
+		limit, err := strconv.Atoi(strings.TrimSpace(entry[eq+1:]))
+		if err != nil || limit < 1 {
+			return nil, errors.Errorf("invalid provider parallelism %q: the limit must be a positive integer", entry)
+		}
+		limits[tokens.Package(strings.TrimSpace(entry[:eq]))] = limit
+	}
+	return limits, nil
+}
+
+// ProviderQueueStats records how the chains that operate on resources of a single package were scheduled.
+type ProviderQueueStats struct {
+	Dispatched    int           // the number of chains dispatched to a worker.
+	MaxQueueDepth int           // the largest number of chains that were waiting for a worker at once.
+	TotalWait     time.Duration // the total time that chains spent waiting for a worker.
+	MaxWait       time.Duration // the longest time that a single chain spent waiting for a worker.
+}
+
+// stepPackage returns the package that is responsible for executing the given step.
+func stepPackage(step Step) tokens.Package {
+	return typePackage(step.Type())
+}
+
+// typePackage returns the package whose provider manages resources of the given type.
+func typePackage(t tokens.Type) tokens.Package {
+	switch {
+	case providers.IsProviderType(t):
+		return providers.GetProviderPackage(t)
+	case tokens.Token(t).HasModuleMember():
+		return t.Package()
+	default:
+		// Malformed types are scheduled together with no package.
+		return ""
+	}
+}
+
+// chainScheduler holds the chains that have been submitted to a step executor but not yet handed to a worker.
+//
+// Chains are queued per package. Whenever a worker is idle, it is handed the oldest chain of the next package that
+// has not reached its concurrency limit, which lets the workers that would otherwise wait on a throttled package
+// pick up work queued for any other package. Packages share workers round-robin so that a deep queue for one package
+// cannot starve the others.
+//
+// With the exception of stats, a chainScheduler is owned by the step executor's scheduling goroutine.
+type chainScheduler struct {
+	limits  map[tokens.Package]int             // the concurrency limit of each package; unlisted packages are unlimited.
+	queues  map[tokens.Package][]incomingChain // the chains waiting for a worker, by package.
+	order   []tokens.Package                   // the packages with waiting chains, in round-robin order.
+	running map[tokens.Package]int             // the number of chains of each package that are executing.
+	active  int                                // the total number of chains that are executing.
+
+	statsLock sync.Mutex                             // protects stats.
+	stats     map[tokens.Package]*ProviderQueueStats // the scheduling stats for each package.
+}
+
+func newChainScheduler(limits map[tokens.Package]int) *chainScheduler {
+	return &chainScheduler{
+		limits:  limits,
+		queues:  make(map[tokens.Package][]incomingChain),
+		running: make(map[tokens.Package]int),
+		stats:   make(map[tokens.Package]*ProviderQueueStats),
+	}
+}
+
+// idle returns true if no chains are waiting or executing.
+func (s *chainScheduler) idle() bool {
+	return len(s.order) == 0 && s.active == 0
+}
+
+// enqueue adds a chain to the queue of its package.
+func (s *chainScheduler) enqueue(c incomingChain) {
+	queue, has := s.queues[c.pkg]
+	if !has || len(queue) == 0 {
+		s.order = append(s.order, c.pkg)
+	}
+	queue = append(queue, c)
+	s.queues[c.pkg] = queue
+
+	s.statsLock.Lock()
+	defer s.statsLock.Unlock()
+	stats := s.statsFor(c.pkg)
+	if len(queue) > stats.MaxQueueDepth {
+		stats.MaxQueueDepth = len(queue)
+	}
+}
+
+// peek returns the chain that should be handed to the next idle worker, if any.
+func (s *chainScheduler) peek() (incomingChain, int, bool) {
+	for i, pkg := range s.order {
+		if limit, has := s.limits[pkg]; has && s.running[pkg] >= limit {
+			continue
+		}
+		return s.queues[pkg][0], i, true
+	}
+	return incomingChain{}, 0, false
+}
+
+// dispatch records that the chain returned by peek has been handed to a worker.
+func (s *chainScheduler) dispatch(c incomingChain, orderIndex int) {
+	queue := s.queues[c.pkg][1:]
+	s.queues[c.pkg] = queue
+
+	// Move the package to the back of the line so that the next worker serves a different package, if possible.
+	s.order = append(s.order[:orderIndex], s.order[orderIndex+1:]...)
+	if len(queue) != 0 {
+		s.order = append(s.order, c.pkg)
+	}
+	s.running[c.pkg]++
+	s.active++
+
+	wait := time.Since(c.enqueued)
+	metrics.ObserveDuration("step.queue", string(c.pkg), wait)
+	s.statsLock.Lock()
+	defer s.statsLock.Unlock()
+	stats := s.statsFor(c.pkg)
+	stats.Dispatched++
+	stats.TotalWait += wait
+	if wait > stats.MaxWait {
+		stats.MaxWait = wait
+	}
+}
+
+// retire records that a chain of the given package has finished executing.
+func (s *chainScheduler) retire(pkg tokens.Package) {
+	s.running[pkg]--
+	s.active--
+}
+
+// cancel completes all waiting chains without executing them.
+func (s *chainScheduler) cancel() {
+	for _, pkg := range s.order {
+		for _, c := range s.queues[pkg] {
+			close(c.CompletionChan)
+		}
+		delete(s.queues, pkg)
+	}
+	s.order = nil
+}
+
+func (s *chainScheduler) statsFor(pkg tokens.Package) *ProviderQueueStats {
+	stats, has := s.stats[pkg]
+	if !has {
+		stats = &ProviderQueueStats{}
+		s.stats[pkg] = stats
+	}
+	return stats
+}
+
+// queueStats returns a copy of the scheduling stats for each package.
+func (s *chainScheduler) queueStats() map[tokens.Package]ProviderQueueStats {
+	s.statsLock.Lock()
+	defer s.statsLock.Unlock()
+
+	stats := make(map[tokens.Package]ProviderQueueStats, len(s.stats))
+	for pkg, st := range s.stats {
+		stats[pkg] = *st
+	}
+	return stats
+}
@@ -0,0 +1,115 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package deploy
+
+import (
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+)
+
+func TestParseProviderParallelism(t *testing.T) {
+	limits, err := ParseProviderParallelism("aws=8, kubernetes = 32,")
+	assert.NoError(t, err)
+	assert.Equal(t, map[tokens.Package]int{"aws": 8, "kubernetes": 32}, limits)
+
+	_, err = ParseProviderParallelism("aws")
+	assert.Error(t, err)
+	_, err = ParseProviderParallelism("aws=0")
+	assert.Error(t, err)
+	_, err = ParseProviderParallelism("=4")
+	assert.Error(t, err)
+}
+
+func TestChainSchedulerLimits(t *testing.T) {
+	s := newChainScheduler(map[tokens.Package]int{"aws": 1})
+
+	newChain := func(pkg tokens.Package) incomingChain {
+		return incomingChain{CompletionChan: make(chan bool), pkg: pkg, enqueued: time.Now()}
+	}
+	dispatchNext := func() (tokens.Package, bool) {
+		c, i, ok := s.peek()
+		if !ok {
+			return "", false
+		}
+		s.dispatch(c, i)
+		return c.pkg, true
+	}
+
+	s.enqueue(newChain("aws"))
+	s.enqueue(newChain("aws"))
+	s.enqueue(newChain("kubernetes"))
+	s.enqueue(newChain("kubernetes"))
+
+	// The second aws chain must wait for the first, but the kubernetes chains may proceed in the meantime.
+	pkg, ok := dispatchNext()
+	assert.True(t, ok)
+	assert.Equal(t, tokens.Package("aws"), pkg)
+	for i := 0; i < 2; i++ {
+		pkg, ok = dispatchNext()
+		assert.True(t, ok)
+		assert.Equal(t, tokens.Package("kubernetes"), pkg)
+	}
+	_, ok = dispatchNext()
+	assert.False(t, ok)
+	assert.False(t, s.idle())
+
+	s.retire("aws")
+	pkg, ok = dispatchNext()
+	assert.True(t, ok)
+	assert.Equal(t, tokens.Package("aws"), pkg)
+
+	s.retire("aws")
+	s.retire("kubernetes")
+	s.retire("kubernetes")
+	assert.True(t, s.idle())
+
+	stats := s.queueStats()
+	assert.Equal(t, 2, stats["aws"].Dispatched)
+	assert.Equal(t, 2, stats["aws"].MaxQueueDepth)
+	assert.Equal(t, 2, stats["kubernetes"].Dispatched)
+}
+
+func TestChainSchedulerRoundRobin(t *testing.T) {
+	s := newChainScheduler(nil)
+	for _, pkg := range []tokens.Package{"a", "a", "a", "b", "c"} {
+		s.enqueue(incomingChain{CompletionChan: make(chan bool), pkg: pkg, enqueued: time.Now()})
+	}
+
+	var order []tokens.Package
+	for {
+		c, i, ok := s.peek()
+		if !ok {
+			break
+		}
+		s.dispatch(c, i)
+		order = append(order, c.pkg)
+	}
+	assert.Equal(t, []tokens.Package{"a", "b", "c", "a", "a"}, order)
+}
+
+func TestChainSchedulerCancel(t *testing.T) {
+	s := newChainScheduler(nil)
+	c := incomingChain{CompletionChan: make(chan bool), pkg: "a", enqueued: time.Now()}
+	s.enqueue(c)
+	s.cancel()
+
+	_, ok := <-c.CompletionChan
+	assert.False(t, ok)
+	assert.True(t, s.idle())
+}
@@ -3,70 +3,79 @@
 package graph
 
 import (
+	"container/heap"
+	"sort"
+
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy/providers"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
 )
 
 // DependencyGraph represents a dependency graph encoded within a resource snapshot.
+//
+// Edges in the snapshot are expressed in terms of URNs, and a snapshot may contain several resources with the same URN
+// (e.g. a resource and an older copy of it that is pending deletion). The graph interns each URN once and records,
+// for every URN, the resources that have that URN and the resources that refer to it as a dependency or a provider.
+// This allows queries to visit only the edges that are relevant to them rather than the entire resource list.
 type DependencyGraph struct {
 	index     map[*resource.State]int // A mapping of resource pointers to indexes within the snapshot
 	resources []*resource.State       // The list of resources, obtained from the snapshot
+
+	urnIDs       map[resource.URN]int // A mapping of URNs to their interned IDs
+	urns         []int                // The interned URN of each resource
+	parents      []int                // The interned URN of each resource's parent, or -1 if it has no parent
+	dependencies [][]int              // The interned URNs of each resource's dependencies, including its provider
+	instances    [][]int              // For each interned URN, the indexes of the resources with that URN
+	referrers    [][]int              // For each interned URN, the indexes of the resources that depend on that URN
 }
 
 // DependingOn returns a slice containing all resources that directly or indirectly
 // depend upon the given resource. The returned slice is guaranteed to be in topological
 // order with respect to the snapshot dependency graph.
 //
-// The time complexity of DependingOn is linear with respect to the number of resources.
+// The time complexity of DependingOn is proportional to the number of dependency edges that lead to the returned
+// resources.
 func (dg *DependencyGraph) DependingOn(res *resource.State, ignore map[resource.URN]bool) []*resource.State {
 	// This implementation relies on the detail that snapshots are stored in a valid
 	// topological order.
 	var dependents []*resource.State
-	dependentSet := make(map[resource.URN]bool)
 
 	cursorIndex, ok := dg.index[res]
 	contract.Assert(ok)
-	dependentSet[res.URN] = true
 
-	isDependent := func(candidate *resource.State) bool {
-		if ignore[candidate.URN] {
-			return false
-		}
-		if candidate.Provider != "" {
-			ref, err := providers.ParseReference(candidate.Provider)
-			contract.Assert(err == nil)
-			if dependentSet[ref.URN()] {
-				return true
-			}
+	// A resource depends on res if it follows res in the snapshot and refers to a URN that was already known to be a
+	// dependent when the resource was reached. Visiting candidates in snapshot order using a heap of indexes preserves
+	// both that condition and the topological order of the result, while only ever touching the referrers of URNs
+	// that are in the dependent set.
+	seen := make(map[int]bool)
+	visited := make(map[int]bool)
+	var candidates indexHeap
+	addReferrers := func(urn, after int) {
+		if seen[urn] {
+			return
 		}
-		for _, dependency := range candidate.Dependencies {
-			if dependentSet[dependency] {
-				return true
-			}
+		seen[urn] = true
+
+		referrers := dg.referrers[urn]
+		for i := sort.SearchInts(referrers, after+1); i < len(referrers); i++ {
+			heap.Push(&candidates, referrers[i])
 		}
-		return false
 	}
 
-	// The dependency graph encoded directly within the snapshot is the reverse of
-	// the graph that we actually want to operate upon. Edges in the snapshot graph
-	// originate in a resource and go to that resource's dependencies.
-	//
-	// The `DependingOn` is simpler when operating on the reverse of the snapshot graph,
-	// where edges originate in a resource and go to resources that depend on that resource.
-	// In this graph, `DependingOn` for a resource is the set of resources that are reachable from the
-	// given resource.
-	//
-	// To accomplish this without building up an entire graph data structure, we'll do a linear
-	// scan of the resource list starting at the requested resource and ending at the end of
-	// the list. All resources that depend directly or indirectly on `res` are prepended
-	// onto `dependents`.
-	for i := cursorIndex + 1; i < len(dg.resources); i++ {
+	addReferrers(dg.urns[cursorIndex], cursorIndex)
+	for candidates.Len() > 0 {
+		i := heap.Pop(&candidates).(int)
+		if visited[i] {
+			continue
+		}
+		visited[i] = true
+
 		candidate := dg.resources[i]
-		if isDependent(candidate) {
-			dependents = append(dependents, candidate)
-			dependentSet[candidate.URN] = true
+		if ignore[candidate.URN] {
+			continue
 		}
+		dependents = append(dependents, candidate)
+		addReferrers(dg.urns[i], i)
 	}
 
 	return dependents
@@ -77,25 +86,23 @@ func (dg *DependencyGraph) DependingOn(res *resource.State, ignore map[resource.
 func (dg *DependencyGraph) DependenciesOf(res *resource.State) ResourceSet {
 	set := make(ResourceSet)
 
-	dependentUrns := make(map[resource.URN]bool)
-	for _, dep := range res.Dependencies {
-		dependentUrns[dep] = true
-	}
-
-	if res.Provider != "" {
-		ref, err := providers.ParseReference(res.Provider)
-		contract.Assert(err == nil)
-		dependentUrns[ref.URN()] = true
-	}
-
 	cursorIndex, ok := dg.index[res]
 	contract.Assert(ok)
-	for i := cursorIndex - 1; i >= 0; i-- {
-		candidate := dg.resources[i]
-		if dependentUrns[candidate.URN] || candidate.URN == res.Parent {
-			set[candidate] = true
+
+	addInstances := func(urn int) {
+		for _, i := range dg.instances[urn] {
+			if i >= cursorIndex {
+				break
+			}
+			set[dg.resources[i]] = true
 		}
 	}
+	for _, urn := range dg.dependencies[cursorIndex] {
+		addInstances(urn)
+	}
+	if parent := dg.parents[cursorIndex]; parent != -1 {
+		addInstances(parent)
+	}
 
 	return set
 }
@@ -103,10 +110,73 @@ func (dg *DependencyGraph) DependenciesOf(res *resource.State) ResourceSet {
 // NewDependencyGraph creates a new DependencyGraph from a list of resources.
 // The resources should be in topological order with respect to their dependencies.
 func NewDependencyGraph(resources []*resource.State) *DependencyGraph {
-	index := make(map[*resource.State]int)
+	dg := &DependencyGraph{
+		index:        make(map[*resource.State]int, len(resources)),
+		resources:    resources,
+		urnIDs:       make(map[resource.URN]int, len(resources)),
+		urns:         make([]int, len(resources)),
+		parents:      make([]int, len(resources)),
+		dependencies: make([][]int, len(resources)),
+	}
+
+	intern := func(urn resource.URN) int {
+		id, has := dg.urnIDs[urn]
+		if !has {
+			id = len(dg.instances)
+			dg.urnIDs[urn] = id
+			dg.instances, dg.referrers = append(dg.instances, nil), append(dg.referrers, nil)
+		}
+		return id
+	}
+
 	for idx, res := range resources {
-		index[res] = idx
+		dg.index[res] = idx
+
+		urn := intern(res.URN)
+		dg.urns[idx], dg.instances[urn] = urn, append(dg.instances[urn], idx)
+
+		dg.parents[idx] = -1
+		if res.Parent != "" {
+			dg.parents[idx] = intern(res.Parent)
+		}
+
+		addDependency := func(dep resource.URN) {
+			id := intern(dep)
+			// Resources are visited in order, so a resource that refers to the same URN more than once is always the
+			// last referrer recorded for that URN.
+			if referrers := dg.referrers[id]; len(referrers) != 0 && referrers[len(referrers)-1] == idx {
+				return
+			}
+			dg.dependencies[idx] = append(dg.dependencies[idx], id)
+			dg.referrers[id] = append(dg.referrers[id], idx)
+		}
+		for _, dep := range res.Dependencies {
+			addDependency(dep)
+		}
+		if res.Provider != "" {
+			// Provider references are validated as part of snapshot integrity checks; a reference that cannot be
+			// parsed cannot refer to a resource in the graph.
+			if ref, err := providers.ParseReference(res.Provider); err == nil {
+				addDependency(ref.URN())
+			}
+		}
 	}
 
-	return &DependencyGraph{index, resources}
+	return dg
+}
+
+// indexHeap is a min-heap of resource indexes.
+type indexHeap []int
+
+func (h indexHeap) Len() int            { return len(h) }
+func (h indexHeap) Less(i, j int) bool  { return h[i] < h[j] }
+func (h indexHeap) Swap(i, j int)       { h[i], h[j] = h[j], h[i] }
+func (h *indexHeap) Push(x interface{}) { *h = append(*h, x.(int)) }
+
+func (h *indexHeap) Pop() interface{} {
+	old := *h
+	n := len(old)
+	x := old[n-1]
+	*h = old[:n-1]
+	return x
 }
@@ -3,6 +3,8 @@
 package graph
 
 import (
+	"fmt"
+	"math/rand"
 	"testing"
 
 	"github.com/pulumi/pulumi/pkg/v3/resource/deploy/providers"
@@ -173,3 +175,100 @@ func TestDependenciesOf(t *testing.T) {
 	assert.False(t, dDepends[b])
 	assert.False(t, dDepends[c])
 }
+
+// Tests that resources that share a URN with an earlier resource are treated as that URN's dependents only if they
+// follow it, which mirrors the linear scan over the snapshot.
+func TestGraphDuplicateURNs(t *testing.T) {
+	a := NewResource("a", nil)
+	b := NewResource("b", nil, a.URN)
+	aOld := NewResource("a", nil)
+	aOld.Delete = true
+	c := NewResource("c", nil, a.URN)
+
+	dg := NewDependencyGraph([]*resource.State{
+		a,
+		b,
+		aOld,
+		c,
+	})
+
+	assert.Equal(t, []*resource.State{
+		b, c,
+	}, dg.DependingOn(a, nil))
+	assert.Equal(t, []*resource.State{
+		c,
+	}, dg.DependingOn(aOld, nil))
+
+	cDepends := dg.DependenciesOf(c)
+	assert.True(t, cDepends[a])
+	assert.True(t, cDepends[aOld])
+	assert.False(t, cDepends[b])
+
+	assert.Len(t, dg.DependenciesOf(a), 0)
+}
+
+// newBenchmarkGraph returns a synthetic snapshot of the given size. Each resource uses one of a handful of providers,
+// is parented to a recent resource, and depends on a few resources chosen at random from the ones before it.
+func newBenchmarkGraph(size int) []*resource.State {
+	r := rand.New(rand.NewSource(42)) //nolint:gosec
+	var provs []*resource.State
+	resources := make([]*resource.State, 0, size)
+	for i := 0; i < 4 && i < size; i++ {
+		p := NewProviderResource("test", fmt.Sprintf("p%d", i), fmt.Sprintf("%d", i))
+		provs, resources = append(provs, p), append(resources, p)
+	}
+
+	for i := len(resources); i < size; i++ {
+		var deps []resource.URN
+		for j := 0; j < 3; j++ {
+			deps = append(deps, resources[r.Intn(len(resources))].URN)
+		}
+		res := NewResource(fmt.Sprintf("r%d", i), provs[r.Intn(len(provs))], deps...)
+		if i > 10 {
+			res.Parent = resources[i-1-r.Intn(10)].URN
+		}
+		resources = append(resources, res)
+	}
+	return resources
+}
+
+func benchmarkGraphSizes(b *testing.B, f func(b *testing.B, resources []*resource.State)) {
+	for _, size := range []int{10000, 50000} {
+		resources := newBenchmarkGraph(size)
+		b.Run(fmt.Sprintf("%d", size), func(b *testing.B) {
+			f(b, resources)
+		})
+	}
+}
+
+func BenchmarkNewDependencyGraph(b *testing.B) {
+	benchmarkGraphSizes(b, func(b *testing.B, resources []*resource.State) {
+		for n := 0; n < b.N; n++ {
+			NewDependencyGraph(resources)
+		}
+	})
+}
+
+func BenchmarkDependingOn(b *testing.B) {
+	benchmarkGraphSizes(b, func(b *testing.B, resources []*resource.State) {
+		dg := NewDependencyGraph(resources)
+		// Query a resource towards the end of the snapshot, as targeted operations on a single resource typically do.
+		target := resources[len(resources)-len(resources)/10]
+		b.ResetTimer()
+		for n := 0; n < b.N; n++ {
+			dg.DependingOn(target, nil)
+		}
+	})
+}
+
+func BenchmarkDependenciesOfAll(b *testing.B) {
+	benchmarkGraphSizes(b, func(b *testing.B, resources []*resource.State) {
+		dg := NewDependencyGraph(resources)
+		b.ResetTimer()
+		for n := 0; n < b.N; n++ {
+			for _, res := range resources {
+				dg.DependenciesOf(res)
+			}
+		}
+	})
+}
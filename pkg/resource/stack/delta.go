@@ -0,0 +1,136 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package stack
+
+import (
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+)
+
+// ApplyCheckpointDeltas replays the given deltas, in order, on top of the given base deployment and returns the
+// resulting deployment. The base deployment is not modified.
+//
+// Replay operates entirely on the serialized form of the deployment, so no secrets are decrypted in the process.
+// The deltas must have been produced relative to the base deployment, i.e. they must be the deltas that were
+// persisted after the base deployment was last written in full.
+func ApplyCheckpointDeltas(base *apitype.DeploymentV3,
+	deltas []apitype.CheckpointDeltaV1) (*apitype.DeploymentV3, error) {
+
+	if base == nil {
+		base = &apitype.DeploymentV3{}
+	}
+	if len(deltas) == 0 {
+		return base, nil
+	}
+
+	baseCount := len(base.Resources)
+	appendIndex := deltas[0].AppendIndex
+	if appendIndex < 0 || appendIndex > baseCount {
+		return nil, errors.Errorf("checkpoint delta %d has an invalid append index %d", deltas[0].Sequence, appendIndex)
+	}
+
+	// Resources and operations are addressed by journal ID. Base resources and operations take the IDs that
+	// correspond to their positions in the base deployment; appended resources and operations take the next ID.
+	resources := make([]*apitype.ResourceV3, baseCount)
+	for i := range base.Resources {
+		resources[i] = &base.Resources[i]
+	}
+	operations := make([]*apitype.OperationV2, len(base.PendingOperations))
+	for i := range base.PendingOperations {
+		operations[i] = &base.PendingOperations[i]
+	}
+	removed := make(map[int]bool)
+	var appended []int
+
+	for _, delta := range deltas {
+		if delta.AppendIndex != appendIndex {
+			return nil, errors.Errorf("checkpoint delta %d has append index %d; expected %d",
+				delta.Sequence, delta.AppendIndex, appendIndex)
+		}
+
+		for _, rec := range delta.Records {
+			switch rec.Kind {
+			case apitype.CheckpointDeltaAppend:
+				if rec.Resource == nil {
+					return nil, errors.Errorf("checkpoint delta %d: append of %v is missing a resource", delta.Sequence, rec.URN)
+				}
+				if rec.ID != len(resources) {
+					return nil, errors.Errorf("checkpoint delta %d: append of %v has ID %d; expected %d",
+						delta.Sequence, rec.URN, rec.ID, len(resources))
+				}
+				resources, appended = append(resources, rec.Resource), append(appended, rec.ID)
+			case apitype.CheckpointDeltaRewrite:
+				if rec.Resource == nil {
+					return nil, errors.Errorf("checkpoint delta %d: rewrite of %v is missing a resource", delta.Sequence, rec.URN)
+				}
+				if rec.ID < 0 || rec.ID >= len(resources) {
+					return nil, errors.Errorf("checkpoint delta %d: rewrite of %v refers to unknown resource %d",
+						delta.Sequence, rec.URN, rec.ID)
+				}
+				resources[rec.ID] = rec.Resource
+			case apitype.CheckpointDeltaRemove:
+				if rec.ID < appendIndex || rec.ID >= baseCount {
+					return nil, errors.Errorf("checkpoint delta %d: remove of %v refers to resource %d, which is not "+
+						"a base resource", delta.Sequence, rec.URN, rec.ID)
+				}
+				removed[rec.ID] = true
+			case apitype.CheckpointDeltaBeginOperation:
+				if rec.Resource == nil {
+					return nil, errors.Errorf("checkpoint delta %d: operation on %v is missing a resource",
+						delta.Sequence, rec.URN)
+				}
+				if rec.ID != len(operations) {
+					return nil, errors.Errorf("checkpoint delta %d: operation on %v has ID %d; expected %d",
+						delta.Sequence, rec.URN, rec.ID, len(operations))
+				}
+				operations = append(operations, &apitype.OperationV2{Resource: *rec.Resource, Type: rec.OperationType})
+			case apitype.CheckpointDeltaEndOperation:
+				if rec.ID < 0 || rec.ID >= len(operations) {
+					return nil, errors.Errorf("checkpoint delta %d: operation %d on %v is unknown",
+						delta.Sequence, rec.ID, rec.URN)
+				}
+				operations[rec.ID] = nil
+			default:
+				return nil, errors.Errorf("checkpoint delta %d: unknown record kind %q", delta.Sequence, rec.Kind)
+			}
+		}
+	}
+
+	// The resulting resource list is the prefix of the base that was produced by the current update, followed by
+	// the resources appended by the deltas, followed by the remainder of the base. This mirrors the merge performed
+	// by backend.SnapshotManager and preserves the topological order of the list.
+	result := &apitype.DeploymentV3{
+		Manifest:         base.Manifest,
+		SecretsProviders: base.SecretsProviders,
+	}
+	for id := 0; id < appendIndex; id++ {
+		result.Resources = append(result.Resources, *resources[id])
+	}
+	for _, id := range appended {
+		result.Resources = append(result.Resources, *resources[id])
+	}
+	for id := appendIndex; id < baseCount; id++ {
+		if !removed[id] {
+			result.Resources = append(result.Resources, *resources[id])
+		}
+	}
+	for _, op := range operations {
+		if op != nil {
+			result.PendingOperations = append(result.PendingOperations, *op)
+		}
+	}
+	return result, nil
+}
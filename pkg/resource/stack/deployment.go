@@ -60,23 +60,7 @@ func SerializeDeployment(snap *deploy.Snapshot, sm secrets.Manager, showSecrets
 	contract.Require(snap != nil, "snap")
 
 	// Capture the version information into a manifest.
-	manifest := apitype.ManifestV1{
-		Time:    snap.Manifest.Time,
-		Magic:   snap.Manifest.Magic,
-		Version: snap.Manifest.Version,
-	}
-	for _, plug := range snap.Manifest.Plugins {
-		var version string
-		if plug.Version != nil {
-			version = plug.Version.String()
-		}
-		manifest.Plugins = append(manifest.Plugins, apitype.PluginInfoV1{
-			Name:    plug.Name,
-			Path:    plug.Path,
-			Type:    plug.Kind,
-			Version: version,
-		})
-	}
+	manifest := serializeManifest(snap)
 
 	// If a specific secrets manager was not provided, use the one in the snapshot, if present.
 	if sm == nil {
@@ -94,6 +78,16 @@ func SerializeDeployment(snap *deploy.Snapshot, sm secrets.Manager, showSecrets
 		enc = config.NewPanicCrypter()
 	}
 
+	// If the encrypter can encrypt values in bulk, encrypt all of the snapshot's secrets up front.
+	if c, ok := batchingCrypter(enc); ok {
+		err := encryptResourceSecrets(c, snapshotResources(snap), func(secret *resource.Secret) (string, error) {
+			return serializeSecretPlaintext(secret, showSecrets)
+		})
+		if err != nil {
+			return nil, errors.Wrap(err, "failed to encrypt secret values")
+		}
+	}
+
 	// Serialize all vertices and only include a vertex section if non-empty.
 	var resources []apitype.ResourceV3
 	for _, res := range snap.Resources {
@@ -113,18 +107,9 @@ func SerializeDeployment(snap *deploy.Snapshot, sm secrets.Manager, showSecrets
 		operations = append(operations, sop)
 	}
 
-	var secretsProvider *apitype.SecretsProvidersV1
-	if sm != nil {
-		secretsProvider = &apitype.SecretsProvidersV1{
-			Type: sm.Type(),
-		}
-		if state := sm.State(); state != nil {
-			rm, err := json.Marshal(state)
-			if err != nil {
-				return nil, err
-			}
-			secretsProvider.State = rm
-		}
+	secretsProvider, err := serializeSecretsProvider(sm)
+	if err != nil {
+		return nil, err
 	}
 
 	return &apitype.DeploymentV3{
@@ -135,6 +120,47 @@ func SerializeDeployment(snap *deploy.Snapshot, sm secrets.Manager, showSecrets
 	}, nil
 }
 
+// serializeManifest captures the version information of a snapshot into a manifest.
+func serializeManifest(snap *deploy.Snapshot) apitype.ManifestV1 {
+	manifest := apitype.ManifestV1{
+		Time:    snap.Manifest.Time,
+		Magic:   snap.Manifest.Magic,
+		Version: snap.Manifest.Version,
+	}
+	for _, plug := range snap.Manifest.Plugins {
+		var version string
+		if plug.Version != nil {
+			version = plug.Version.String()
+		}
+		manifest.Plugins = append(manifest.Plugins, apitype.PluginInfoV1{
+			Name:    plug.Name,
+			Path:    plug.Path,
+			Type:    plug.Kind,
+			Version: version,
+		})
+	}
+	return manifest
+}
+
+// serializeSecretsProvider records the type and state of a secrets manager, if any.
+func serializeSecretsProvider(sm secrets.Manager) (*apitype.SecretsProvidersV1, error) {
+	if sm == nil {
+		return nil, nil
+	}
+
+	secretsProvider := &apitype.SecretsProvidersV1{
+		Type: sm.Type(),
+	}
+	if state := sm.State(); state != nil {
+		rm, err := json.Marshal(state)
+		if err != nil {
+			return nil, err
+		}
+		secretsProvider.State = rm
+	}
+	return secretsProvider, nil
+}
+
 // DeserializeUntypedDeployment deserializes an untyped deployment and produces a `deploy.Snapshot`
 // from it. DeserializeDeployment will return an error if the untyped deployment's version is
 // not within the range `DeploymentSchemaVersionCurrent` and `DeploymentSchemaVersionOldestSupported`.
@@ -142,6 +168,15 @@ func DeserializeUntypedDeployment(
 	deployment *apitype.UntypedDeployment, secretsProv SecretsProvider) (*deploy.Snapshot, error) {
 
 	contract.Require(deployment != nil, "deployment")
+	v3deployment, err := migrateUntypedDeployment(deployment)
+	if err != nil {
+		return nil, err
+	}
+	return DeserializeDeploymentV3(*v3deployment, secretsProv)
+}
+
+// migrateUntypedDeployment unmarshals an untyped deployment and migrates it to the current schema version.
+func migrateUntypedDeployment(deployment *apitype.UntypedDeployment) (*apitype.DeploymentV3, error) {
 	switch {
 	case deployment.Version > apitype.DeploymentSchemaVersionCurrent:
 		return nil, ErrDeploymentSchemaVersionTooNew
@@ -171,8 +206,7 @@ func DeserializeUntypedDeployment(
 	default:
 		contract.Failf("unrecognized version: %d", deployment.Version)
 	}
-
-	return DeserializeDeploymentV3(v3deployment, secretsProv)
+	return &v3deployment, nil
 }
 
 // DeserializeDeploymentV3 deserializes a typed DeploymentV3 into a `deploy.Snapshot`.
@@ -229,6 +263,21 @@ func DeserializeDeploymentV3(deployment apitype.DeploymentV3, secretsProv Secret
 			return nil, err
 		}
 		enc = e
+
+		// Decrypt all of the deployment's secrets in bulk before deserializing its resources.
+		seen := make(map[string]struct{})
+		var ciphertexts []string
+		for _, res := range deployment.Resources {
+			ciphertexts = collectCiphertexts(res.Inputs, seen, ciphertexts)
+			ciphertexts = collectCiphertexts(res.Outputs, seen, ciphertexts)
+		}
+		for _, op := range deployment.PendingOperations {
+			ciphertexts = collectCiphertexts(op.Resource.Inputs, seen, ciphertexts)
+			ciphertexts = collectCiphertexts(op.Resource.Outputs, seen, ciphertexts)
+		}
+		if dec, err = prefetchSecrets(dec, ciphertexts); err != nil {
+			return nil, err
+		}
 	}
 
 	// For every serialized resource vertex, create a ResourceDeployment out of it.
@@ -300,6 +349,9 @@ func SerializeResource(res *resource.State, enc config.Encrypter, showSecrets bo
 	if res.CustomTimeouts.IsNotEmpty() {
 		v3Resource.CustomTimeouts = &res.CustomTimeouts
 	}
+	if res.DiffFingerprint != 0 {
+		v3Resource.DiffFingerprint = res.DiffFingerprint.String()
+	}
 
 	return v3Resource, nil
 }
@@ -385,18 +437,10 @@ func SerializePropertyValue(prop resource.PropertyValue, enc config.Encrypter,
 	}
 
 	if prop.IsSecret() {
-		// Since we are going to encrypt property value, we can elide encrypting sub-elements. We'll mark them as
-		// "secret" so we retain that information when deserializaing the overall structure, but there is no
-		// need to double encrypt everything.
-		value, err := SerializePropertyValue(prop.SecretValue().Element, config.NopEncrypter, showSecrets)
+		plaintext, err := serializeSecretPlaintext(prop.SecretValue(), showSecrets)
 		if err != nil {
 			return nil, err
 		}
-		bytes, err := json.Marshal(value)
-		if err != nil {
-			return nil, errors.Wrap(err, "encoding serialized property value")
-		}
-		plaintext := string(bytes)
 
 		// If the encrypter is a cachingCrypter, call through its encryptSecret method, which will look for a matching
 		// *resource.Secret + plaintext in its cache in order to avoid re-encrypting the value.
@@ -428,6 +472,35 @@ func SerializePropertyValue(prop resource.PropertyValue, enc config.Encrypter,
 	return prop.V, nil
 }
 
+// serializeSecretPlaintext returns the plaintext of a secret value, i.e. the JSON encoding of its serialized element.
+func serializeSecretPlaintext(secret *resource.Secret, showSecrets bool) (string, error) {
+	// Since we are going to encrypt property value, we can elide encrypting sub-elements. We'll mark them as
+	// "secret" so we retain that information when deserializaing the overall structure, but there is no
+	// need to double encrypt everything.
+	value, err := SerializePropertyValue(secret.Element, config.NopEncrypter, showSecrets)
+	if err != nil {
+		return "", err
+	}
+	bytes, err := json.Marshal(value)
+	if err != nil {
+		return "", errors.Wrap(err, "encoding serialized property value")
+	}
+	return string(bytes), nil
+}
+
+// snapshotResources returns the resources of a snapshot followed by the resources of its pending operations.
+func snapshotResources(snap *deploy.Snapshot) []*resource.State {
+	if len(snap.PendingOperations) == 0 {
+		return snap.Resources
+	}
+	resources := make([]*resource.State, 0, len(snap.Resources)+len(snap.PendingOperations))
+	resources = append(resources, snap.Resources...)
+	for _, op := range snap.PendingOperations {
+		resources = append(resources, op.Resource)
+	}
+	return resources
+}
+
 // DeserializeResource turns a serialized resource back into its usual form.
 func DeserializeResource(res apitype.ResourceV3, dec config.Decrypter, enc config.Encrypter) (*resource.State, error) {
 	// Deserialize the resource properties, if they exist.
@@ -440,23 +513,44 @@ func DeserializeResource(res apitype.ResourceV3, dec config.Decrypter, enc confi
 		return nil, err
 	}
 
-	if res.URN == "" {
-		return nil, errors.Errorf("resource missing required 'urn' field")
+	if err := checkResourceHeader(res); err != nil {
+		return nil, err
 	}
 
-	if res.Type == "" {
-		return nil, errors.Errorf("resource '%s' missing required 'type' field", res.URN)
+	state := resource.NewState(
+		res.Type, res.URN, res.Custom, res.Delete, res.ID,
+		inputs, outputs, res.Parent, res.Protect, res.External, res.Dependencies, res.InitErrors, res.Provider,
+		res.PropertyDependencies, res.PendingReplacement, res.AdditionalSecretOutputs, res.Aliases, res.CustomTimeouts,
+		res.ImportID)
+	state.DiffFingerprint = deserializeDiffFingerprint(res)
+	return state, nil
+}
+
+// deserializeDiffFingerprint returns the diff fingerprint of a serialized resource. The fingerprint only serves to
+// skip redundant diffs, so one that cannot be parsed is ignored.
+func deserializeDiffFingerprint(res apitype.ResourceV3) resource.PropertyFingerprint {
+	if res.DiffFingerprint == "" {
+		return 0
+	}
+	fingerprint, err := resource.ParsePropertyFingerprint(res.DiffFingerprint)
+	if err != nil {
+		return 0
 	}
+	return fingerprint
+}
 
+// checkResourceHeader checks that a serialized resource has the fields that every resource requires.
+func checkResourceHeader(res apitype.ResourceV3) error {
+	if res.URN == "" {
+		return errors.Errorf("resource missing required 'urn' field")
+	}
+	if res.Type == "" {
+		return errors.Errorf("resource '%s' missing required 'type' field", res.URN)
+	}
 	if !res.Custom && res.ID != "" {
-		return nil, errors.Errorf("resource '%s' has 'custom' false but non-empty ID", res.URN)
+		return errors.Errorf("resource '%s' has 'custom' false but non-empty ID", res.URN)
 	}
-
-	return resource.NewState(
-		res.Type, res.URN, res.Custom, res.Delete, res.ID,
-		inputs, outputs, res.Parent, res.Protect, res.External, res.Dependencies, res.InitErrors, res.Provider,
-		res.PropertyDependencies, res.PendingReplacement, res.AdditionalSecretOutputs, res.Aliases, res.CustomTimeouts,
-		res.ImportID), nil
+	return nil
 }
 
 func DeserializeOperation(op apitype.OperationV2, dec config.Decrypter,
@@ -565,9 +659,7 @@ func DeserializePropertyValue(v interface{}, dec config.Decrypter,
 					prop := resource.MakeSecret(ev)
 					// If the decrypter is a cachingCrypter, insert the plain- and ciphertext into the cache with the
 					// new *resource.Secret as the key.
-					if cachingCrypter, ok := dec.(*cachingCrypter); ok {
-						cachingCrypter.insert(prop.SecretValue(), plaintext, ciphertext)
-					}
+					cacheDecryptedSecret(dec, prop.SecretValue(), plaintext, ciphertext)
 					return prop, nil
 				case resource.ResourceReferenceSig:
 					var packageVersion string
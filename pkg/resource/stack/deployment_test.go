@@ -435,3 +435,27 @@ func TestDeserializeInvalidResourceErrors(t *testing.T) {
 	assert.Error(t, err)
 	assert.Equal(t, fmt.Sprintf("resource '%s' has 'custom' false but non-empty ID", urn), err.Error())
 }
+
+func TestDiffFingerprintSerialization(t *testing.T) {
+	res := &resource.State{
+		Type:            "pkg:index:Resource",
+		URN:             "urn:pulumi:stack::proj::pkg:index:Resource::res",
+		Custom:          true,
+		ID:              "id",
+		Inputs:          resource.PropertyMap{},
+		DiffFingerprint: 0x1234abcd,
+	}
+	sres, err := SerializeResource(res, config.NopEncrypter, false)
+	assert.NoError(t, err)
+	assert.Equal(t, "1234abcd", sres.DiffFingerprint)
+
+	dres, err := DeserializeResource(sres, config.NopDecrypter, config.NopEncrypter)
+	assert.NoError(t, err)
+	assert.Equal(t, res.DiffFingerprint, dres.DiffFingerprint)
+
+	// Fingerprints that cannot be parsed are ignored.
+	sres.DiffFingerprint = "not a fingerprint"
+	dres, err = DeserializeResource(sres, config.NopDecrypter, config.NopEncrypter)
+	assert.NoError(t, err)
+	assert.Equal(t, resource.PropertyFingerprint(0), dres.DiffFingerprint)
+}
@@ -0,0 +1,667 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package stack
+
+import (
+	"bufio"
+	"encoding/json"
+	"io"
+	"math"
+	"sort"
+	"strconv"
+	"unicode/utf8"
+
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
+)
+
+// A DeploymentEncoder writes serialized deployments directly to an io.Writer.
+//
+// The output of Encode is identical to the JSON encoding of the apitype.DeploymentV3 returned by SerializeDeployment,
+// but the encoder never builds the intermediate tree of generic maps that SerializeDeployment does. In addition, the
+// encoder remembers the serialized form of each resource that it encodes. If a later call to Encode is passed the same
+// *resource.State and the state has not changed in the meantime, the remembered bytes are written as-is rather than
+// serializing (and re-encrypting) the resource again. Whether a state has changed is determined by a fingerprint of
+// its contents, so states may be safely mutated between calls.
+//
+// A DeploymentEncoder is not safe for concurrent use.
+type DeploymentEncoder struct {
+	sm          secrets.Manager // the secrets manager to use, if any.
+	showSecrets bool            // true to write secrets in plaintext.
+
+	cacheSM       secrets.Manager                     // the secrets manager that encrypted the cached resources.
+	cache         map[*resource.State]encodedResource // the serialized resources from the previous Encode.
+	fingerprinter *resource.Fingerprinter             // the fingerprinter used to detect changed resources.
+	scratch       []byte                              // the buffer into which resources are serialized.
+	keys          []string                            // the buffer used to sort property dependencies.
+}
+
+// encodedResource is the serialized form of a resource, along with the fingerprint of the state it was produced from.
+type encodedResource struct {
+	fingerprint resource.PropertyFingerprint
+	json        []byte
+}
+
+// encodeWriter is the set of methods the encoder uses to write its output.
+type encodeWriter interface {
+	io.Writer
+	io.StringWriter
+}
+
+// NewDeploymentEncoder creates a new deployment encoder. If sm is nil, the secrets manager of each snapshot is used.
+func NewDeploymentEncoder(sm secrets.Manager, showSecrets bool) *DeploymentEncoder {
+	return &DeploymentEncoder{
+		sm:            sm,
+		showSecrets:   showSecrets,
+		cache:         make(map[*resource.State]encodedResource),
+		fingerprinter: resource.NewExactFingerprinter(),
+	}
+}
+
+// EncodeCheckpoint writes a versioned checkpoint for the given stack and snapshot to the given writer. The output is
+// identical to the compact JSON encoding of the result of SerializeCheckpoint. If snap is nil, the checkpoint is
+// written without a deployment.
+func (e *DeploymentEncoder) EncodeCheckpoint(w io.Writer, stack tokens.QName, snap *deploy.Snapshot) error {
+	ew, flush := newEncodeWriter(w)
+
+	var buf []byte
+	buf = append(buf, `{"version":`...)
+	buf = strconv.AppendInt(buf, int64(apitype.DeploymentSchemaVersionCurrent), 10)
+	buf = append(buf, `,"checkpoint":{"stack":`...)
+	buf = appendJSONString(buf, string(stack))
+	if snap != nil {
+		buf = append(buf, `,"latest":`...)
+	}
+	if _, err := ew.Write(buf); err != nil {
+		return err
+	}
+
+	if snap != nil {
+		if err := e.encode(ew, snap); err != nil {
+			return errors.Wrap(err, "serializing deployment")
+		}
+	}
+
+	if _, err := ew.WriteString("}}"); err != nil {
+		return err
+	}
+	return flush()
+}
+
+// Encode writes the serialized form of the given snapshot to the given writer. The output is identical to the JSON
+// encoding of the result of SerializeDeployment.
+func (e *DeploymentEncoder) Encode(w io.Writer, snap *deploy.Snapshot) error {
+	ew, flush := newEncodeWriter(w)
+	if err := e.encode(ew, snap); err != nil {
+		return err
+	}
+	return flush()
+}
+
+// newEncodeWriter returns an encodeWriter for the given writer, buffering it if necessary, and a function that
+// flushes any buffered output.
+func newEncodeWriter(w io.Writer) (encodeWriter, func() error) {
+	if ew, ok := w.(encodeWriter); ok {
+		return ew, func() error { return nil }
+	}
+	bw := bufio.NewWriterSize(w, 64*1024)
+	return bw, bw.Flush
+}
+
+func (e *DeploymentEncoder) encode(w encodeWriter, snap *deploy.Snapshot) error {
+	contract.Require(snap != nil, "snap")
+
+	// If a specific secrets manager was not provided, use the one in the snapshot, if present.
+	sm := e.sm
+	if sm == nil {
+		sm = snap.SecretsManager
+	}
+
+	var enc config.Encrypter
+	if sm != nil {
+		ee, err := sm.Encrypter()
+		if err != nil {
+			return errors.Wrap(err, "getting encrypter for deployment")
+		}
+		enc = ee
+	} else {
+		enc = config.NewPanicCrypter()
+	}
+
+	// Cached resources hold ciphertext, so they can only be reused with the secrets manager that produced them.
+	cache := e.cache
+	if sm != e.cacheSM {
+		cache = nil
+	}
+	next := make(map[*resource.State]encodedResource, len(snap.Resources))
+	defer func() {
+		e.cache, e.cacheSM = next, sm
+	}()
+
+	// Fingerprint each resource up front, then encrypt the secrets of the resources that have changed in bulk if the
+	// encrypter supports it.
+	resources := snapshotResources(snap)
+	fingerprints := make([]resource.PropertyFingerprint, len(resources))
+	var changed []*resource.State
+	for i, res := range resources {
+		contract.Assert(res != nil)
+		contract.Assertf(string(res.URN) != "", "Unexpected empty resource resource.URN")
+
+		fingerprints[i] = e.fingerprintResource(res)
+		if entry, ok := cache[res]; !ok || entry.fingerprint != fingerprints[i] {
+			changed = append(changed, res)
+		}
+	}
+	if c, ok := batchingCrypter(enc); ok && len(changed) != 0 {
+		err := encryptResourceSecrets(c, changed, func(secret *resource.Secret) (string, error) {
+			plaintext, err := e.appendPropertyValue(nil, secret.Element, config.NopEncrypter)
+			return string(plaintext), err
+		})
+		if err != nil {
+			return errors.Wrap(err, "failed to encrypt secret values")
+		}
+	}
+
+	manifest, err := json.Marshal(serializeManifest(snap))
+	if err != nil {
+		return err
+	}
+	if _, err = w.WriteString(`{"manifest":`); err != nil {
+		return err
+	}
+	if _, err = w.Write(manifest); err != nil {
+		return err
+	}
+
+	secretsProvider, err := serializeSecretsProvider(sm)
+	if err != nil {
+		return err
+	}
+	if secretsProvider != nil {
+		sp, err := json.Marshal(secretsProvider)
+		if err != nil {
+			return err
+		}
+		if _, err = w.WriteString(`,"secrets_providers":`); err != nil {
+			return err
+		}
+		if _, err = w.Write(sp); err != nil {
+			return err
+		}
+	}
+
+	// Only include the resource and operation sections if they are non-empty.
+	if len(snap.Resources) != 0 {
+		if _, err = w.WriteString(`,"resources":[`); err != nil {
+			return err
+		}
+		for i, res := range snap.Resources {
+			if i != 0 {
+				if _, err = w.WriteString(","); err != nil {
+					return err
+				}
+			}
+			sres, err := e.encodeResource(res, fingerprints[i], enc, cache, next)
+			if err != nil {
+				return errors.Wrap(err, "serializing resources")
+			}
+			if _, err = w.Write(sres); err != nil {
+				return err
+			}
+		}
+		if _, err = w.WriteString("]"); err != nil {
+			return err
+		}
+	}
+
+	if len(snap.PendingOperations) != 0 {
+		if _, err = w.WriteString(`,"pending_operations":[`); err != nil {
+			return err
+		}
+		for i, op := range snap.PendingOperations {
+			if i != 0 {
+				if _, err = w.WriteString(","); err != nil {
+					return err
+				}
+			}
+			sres, err := e.encodeResource(op.Resource, fingerprints[len(snap.Resources)+i], enc, cache, next)
+			if err != nil {
+				return errors.Wrap(err, "serializing resource")
+			}
+			if _, err = w.WriteString(`{"resource":`); err != nil {
+				return err
+			}
+			if _, err = w.Write(sres); err != nil {
+				return err
+			}
+			buf := append(e.scratch[:0], `,"type":`...)
+			buf = appendJSONString(buf, string(op.Type))
+			buf = append(buf, '}')
+			if _, err = w.Write(buf); err != nil {
+				return err
+			}
+		}
+		if _, err = w.WriteString("]"); err != nil {
+			return err
+		}
+	}
+
+	_, err = w.WriteString("}")
+	return err
+}
+
+// encodeResource returns the serialized form of the given resource, reusing the entry in cache if the resource has
+// not changed since it was cached. The result is recorded in next.
+func (e *DeploymentEncoder) encodeResource(res *resource.State, fingerprint resource.PropertyFingerprint,
+	enc config.Encrypter, cache, next map[*resource.State]encodedResource) ([]byte, error) {
+
+	if entry, ok := cache[res]; ok && entry.fingerprint == fingerprint {
+		next[res] = entry
+		return entry.json, nil
+	}
+
+	buf, err := e.appendResource(e.scratch[:0], res, enc)
+	if err != nil {
+		return nil, err
+	}
+	e.scratch = buf
+
+	entry := encodedResource{fingerprint: fingerprint, json: append([]byte(nil), buf...)}
+	next[res] = entry
+	return entry.json, nil
+}
+
+// appendResource appends the serialized form of the given resource to buf. The fields are written in the same order
+// and with the same omission rules as the JSON encoding of apitype.ResourceV3.
+func (e *DeploymentEncoder) appendResource(buf []byte, res *resource.State, enc config.Encrypter) ([]byte, error) {
+	var err error
+
+	buf = append(buf, `{"urn":`...)
+	buf = appendJSONString(buf, string(res.URN))
+	buf = append(buf, `,"custom":`...)
+	buf = strconv.AppendBool(buf, res.Custom)
+	if res.Delete {
+		buf = append(buf, `,"delete":true`...)
+	}
+	if res.ID != "" {
+		buf = append(buf, `,"id":`...)
+		buf = appendJSONString(buf, string(res.ID))
+	}
+	buf = append(buf, `,"type":`...)
+	buf = appendJSONString(buf, string(res.Type))
+	if len(res.Inputs) != 0 {
+		buf = append(buf, `,"inputs":`...)
+		if buf, err = e.appendProperties(buf, res.Inputs, enc); err != nil {
+			return nil, err
+		}
+	}
+	if len(res.Outputs) != 0 {
+		buf = append(buf, `,"outputs":`...)
+		if buf, err = e.appendProperties(buf, res.Outputs, enc); err != nil {
+			return nil, err
+		}
+	}
+	if res.Parent != "" {
+		buf = append(buf, `,"parent":`...)
+		buf = appendJSONString(buf, string(res.Parent))
+	}
+	if res.Protect {
+		buf = append(buf, `,"protect":true`...)
+	}
+	if res.External {
+		buf = append(buf, `,"external":true`...)
+	}
+	if len(res.Dependencies) != 0 {
+		buf = append(buf, `,"dependencies":`...)
+		buf = appendURNs(buf, res.Dependencies)
+	}
+	if len(res.InitErrors) != 0 {
+		buf = append(buf, `,"initErrors":[`...)
+		for i, msg := range res.InitErrors {
+			if i != 0 {
+				buf = append(buf, ',')
+			}
+			buf = appendJSONString(buf, msg)
+		}
+		buf = append(buf, ']')
+	}
+	if res.Provider != "" {
+		buf = append(buf, `,"provider":`...)
+		buf = appendJSONString(buf, res.Provider)
+	}
+	if len(res.PropertyDependencies) != 0 {
+		keys := make([]string, 0, len(res.PropertyDependencies))
+		for k := range res.PropertyDependencies {
+			keys = append(keys, string(k))
+		}
+		sort.Strings(keys)
+
+		buf = append(buf, `,"propertyDependencies":{`...)
+		for i, k := range keys {
+			if i != 0 {
+				buf = append(buf, ',')
+			}
+			buf = appendJSONString(buf, k)
+			buf = append(buf, ':')
+			if deps := res.PropertyDependencies[resource.PropertyKey(k)]; deps == nil {
+				buf = append(buf, "null"...)
+			} else {
+				buf = appendURNs(buf, deps)
+			}
+		}
+		buf = append(buf, '}')
+	}
+	if res.PendingReplacement {
+		buf = append(buf, `,"pendingReplacement":true`...)
+	}
+	if len(res.AdditionalSecretOutputs) != 0 {
+		buf = append(buf, `,"additionalSecretOutputs":[`...)
+		for i, k := range res.AdditionalSecretOutputs {
+			if i != 0 {
+				buf = append(buf, ',')
+			}
+			buf = appendJSONString(buf, string(k))
+		}
+		buf = append(buf, ']')
+	}
+	if len(res.Aliases) != 0 {
+		buf = append(buf, `,"aliases":`...)
+		buf = appendURNs(buf, res.Aliases)
+	}
+	if res.CustomTimeouts.IsNotEmpty() {
+		timeouts, err := json.Marshal(&res.CustomTimeouts)
+		if err != nil {
+			return nil, err
+		}
+		buf = append(buf, `,"customTimeouts":`...)
+		buf = append(buf, timeouts...)
+	}
+	if res.ImportID != "" {
+		buf = append(buf, `,"importID":`...)
+		buf = appendJSONString(buf, string(res.ImportID))
+	}
+	if res.DiffFingerprint != 0 {
+		buf = append(buf, `,"diffFingerprint":`...)
+		buf = appendJSONString(buf, res.DiffFingerprint.String())
+	}
+	return append(buf, '}'), nil
+}
+
+// appendProperties appends the serialized form of the given property map to buf.
+func (e *DeploymentEncoder) appendProperties(buf []byte, props resource.PropertyMap,
+	enc config.Encrypter) ([]byte, error) {
+
+	buf = append(buf, '{')
+	for i, k := range props.StableKeys() {
+		if i != 0 {
+			buf = append(buf, ',')
+		}
+		buf = appendJSONString(buf, string(k))
+		buf = append(buf, ':')
+
+		var err error
+		if buf, err = e.appendPropertyValue(buf, props[k], enc); err != nil {
+			return nil, err
+		}
+	}
+	return append(buf, '}'), nil
+}
+
+// appendPropertyValue appends the serialized form of the given property value to buf. The result is identical to the
+// JSON encoding of the result of SerializePropertyValue.
+func (e *DeploymentEncoder) appendPropertyValue(buf []byte, prop resource.PropertyValue,
+	enc config.Encrypter) ([]byte, error) {
+
+	switch {
+	case prop.IsNull():
+		return append(buf, "null"...), nil
+	case prop.IsComputed() || prop.IsOutput():
+		return appendJSONString(buf, computedValuePlaceholder), nil
+	case prop.IsBool():
+		return strconv.AppendBool(buf, prop.BoolValue()), nil
+	case prop.IsNumber():
+		return appendJSONNumber(buf, prop.NumberValue())
+	case prop.IsString():
+		return appendJSONString(buf, prop.StringValue()), nil
+	case prop.IsArray():
+		buf = append(buf, '[')
+		for i, elem := range prop.ArrayValue() {
+			if i != 0 {
+				buf = append(buf, ',')
+			}
+			var err error
+			if buf, err = e.appendPropertyValue(buf, elem, enc); err != nil {
+				return nil, err
+			}
+		}
+		return append(buf, ']'), nil
+	case prop.IsObject():
+		return e.appendProperties(buf, prop.ObjectValue(), enc)
+	case prop.IsAsset(), prop.IsArchive():
+		// Assets and archives are rare enough that it is not worth duplicating their serialization logic.
+		v, err := SerializePropertyValue(prop, enc, e.showSecrets)
+		if err != nil {
+			return nil, err
+		}
+		b, err := json.Marshal(v)
+		if err != nil {
+			return nil, err
+		}
+		return append(buf, b...), nil
+	case prop.IsResourceReference():
+		// These keys are written in the order in which encoding/json would sort them.
+		ref := prop.ResourceReferenceValue()
+		buf = append(buf, '{')
+		buf = appendJSONString(buf, resource.SigKey)
+		buf = append(buf, ':')
+		buf = appendJSONString(buf, resource.ResourceReferenceSig)
+		if id, hasID := ref.IDString(); hasID {
+			buf = append(buf, `,"id":`...)
+			buf = appendJSONString(buf, id)
+		}
+		buf = append(buf, `,"packageVersion":`...)
+		buf = appendJSONString(buf, ref.PackageVersion)
+		buf = append(buf, `,"urn":`...)
+		buf = appendJSONString(buf, string(ref.URN))
+		return append(buf, '}'), nil
+	case prop.IsSecret():
+		// As in SerializePropertyValue, the elements of the secret are serialized without encryption and then the
+		// whole is encrypted at once.
+		plaintext, err := e.appendPropertyValue(nil, prop.SecretValue().Element, config.NopEncrypter)
+		if err != nil {
+			return nil, err
+		}
+
+		var ciphertext string
+		if cachingCrypter, ok := enc.(*cachingCrypter); ok {
+			ciphertext, err = cachingCrypter.encryptSecret(prop.SecretValue(), string(plaintext))
+		} else {
+			ciphertext, err = enc.EncryptValue(string(plaintext))
+		}
+		if err != nil {
+			return nil, errors.Wrap(err, "failed to encrypt secret value")
+		}
+
+		buf = append(buf, '{')
+		buf = appendJSONString(buf, resource.SigKey)
+		buf = append(buf, ':')
+		buf = appendJSONString(buf, resource.SecretSig)
+		if e.showSecrets {
+			if len(plaintext) != 0 {
+				buf = append(buf, `,"plaintext":`...)
+				buf = appendJSONString(buf, string(plaintext))
+			}
+		} else if ciphertext != "" {
+			buf = append(buf, `,"ciphertext":`...)
+			buf = appendJSONString(buf, ciphertext)
+		}
+		return append(buf, '}'), nil
+	default:
+		b, err := json.Marshal(prop.V)
+		if err != nil {
+			return nil, err
+		}
+		return append(buf, b...), nil
+	}
+}
+
+func appendURNs(buf []byte, urns []resource.URN) []byte {
+	buf = append(buf, '[')
+	for i, urn := range urns {
+		if i != 0 {
+			buf = append(buf, ',')
+		}
+		buf = appendJSONString(buf, string(urn))
+	}
+	return append(buf, ']')
+}
+
+// appendJSONNumber appends the JSON encoding of the given number to buf using the same format as encoding/json.
+func appendJSONNumber(buf []byte, f float64) ([]byte, error) {
+	if math.IsInf(f, 0) || math.IsNaN(f) {
+		return nil, errors.Errorf("unsupported number: %v", f)
+	}
+
+	// Like ES6, use exponents only for very small and very large magnitudes.
+	format := byte('f')
+	if abs := math.Abs(f); abs != 0 && (abs < 1e-6 || abs >= 1e21) {
+		format = 'e'
+	}
+	buf = strconv.AppendFloat(buf, f, format, -1, 64)
+	if format == 'e' {
+		// Clean up e-09 to e-9.
+		if n := len(buf); n >= 4 && buf[n-4] == 'e' && buf[n-3] == '-' && buf[n-2] == '0' {
+			buf[n-2] = buf[n-1]
+			buf = buf[:n-1]
+		}
+	}
+	return buf, nil
+}
+
+const hexDigits = "0123456789abcdef"
+
+// appendJSONString appends the JSON encoding of the given string to buf, escaping the same characters as
+// encoding/json (including HTML-sensitive characters).
+func appendJSONString(buf []byte, s string) []byte {
+	buf = append(buf, '"')
+	start := 0
+	for i := 0; i < len(s); {
+		if b := s[i]; b < utf8.RuneSelf {
+			if b >= ' ' && b != '"' && b != '\\' && b != '<' && b != '>' && b != '&' {
+				i++
+				continue
+			}
+			buf = append(buf, s[start:i]...)
+			switch b {
+			case '"', '\\':
+				buf = append(buf, '\\', b)
+			case '\n':
+				buf = append(buf, '\\', 'n')
+			case '\r':
+				buf = append(buf, '\\', 'r')
+			case '\t':
+				buf = append(buf, '\\', 't')
+			default:
+				buf = append(buf, '\\', 'u', '0', '0', hexDigits[b>>4], hexDigits[b&0xf])
+			}
+			i++
+			start = i
+			continue
+		}
+
+		c, size := utf8.DecodeRuneInString(s[i:])
+		switch {
+		case c == utf8.RuneError && size == 1:
+			buf = append(buf, s[start:i]...)
+			buf = append(buf, `\ufffd`...)
+		case c == '\u2028' || c == '\u2029':
+			// These are valid JSON but break JSONP, so encoding/json escapes them.
+			buf = append(buf, s[start:i]...)
+			buf = append(buf, '\\', 'u', '2', '0', '2', hexDigits[c&0xf])
+		default:
+			i += size
+			continue
+		}
+		i += size
+		start = i
+	}
+	buf = append(buf, s[start:]...)
+	return append(buf, '"')
+}
+
+// fingerprintResource computes a fingerprint of the contents of the given resource state that changes whenever its
+// serialized form would. Secrets contribute their plaintext to the fingerprint.
+func (e *DeploymentEncoder) fingerprintResource(res *resource.State) resource.PropertyFingerprint {
+	f := e.fingerprinter
+	f.Reset()
+
+	f.WriteString(string(res.URN))
+	f.WriteBool(res.Custom)
+	f.WriteBool(res.Delete)
+	f.WriteString(string(res.ID))
+	f.WriteString(string(res.Type))
+	f.WriteProperties(res.Inputs)
+	f.WriteProperties(res.Outputs)
+	f.WriteString(string(res.Parent))
+	f.WriteBool(res.Protect)
+	f.WriteBool(res.External)
+	writeURNs(f, res.Dependencies)
+	f.WriteUint64(uint64(len(res.InitErrors)))
+	for _, msg := range res.InitErrors {
+		f.WriteString(msg)
+	}
+	f.WriteString(res.Provider)
+	f.WriteUint64(uint64(len(res.PropertyDependencies)))
+	if len(res.PropertyDependencies) != 0 {
+		keys := e.keys[:0]
+		for k := range res.PropertyDependencies {
+			keys = append(keys, string(k))
+		}
+		sort.Strings(keys)
+		for _, k := range keys {
+			deps := res.PropertyDependencies[resource.PropertyKey(k)]
+			f.WriteString(k)
+			f.WriteBool(deps == nil)
+			writeURNs(f, deps)
+		}
+		e.keys = keys
+	}
+	f.WriteBool(res.PendingReplacement)
+	f.WriteUint64(uint64(len(res.AdditionalSecretOutputs)))
+	for _, k := range res.AdditionalSecretOutputs {
+		f.WriteString(string(k))
+	}
+	writeURNs(f, res.Aliases)
+	f.WriteUint64(math.Float64bits(res.CustomTimeouts.Create))
+	f.WriteUint64(math.Float64bits(res.CustomTimeouts.Update))
+	f.WriteUint64(math.Float64bits(res.CustomTimeouts.Delete))
+	f.WriteString(string(res.ImportID))
+	f.WriteFingerprint(res.DiffFingerprint)
+	return f.Sum()
+}
+
+func writeURNs(f *resource.Fingerprinter, urns []resource.URN) {
+	f.WriteUint64(uint64(len(urns)))
+	for _, urn := range urns {
+		f.WriteString(string(urn))
+	}
+}
@@ -0,0 +1,221 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package stack
+
+import (
+	"bytes"
+	"encoding/json"
+	"math"
+	"testing"
+	"time"
+
+	"github.com/blang/semver"
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/workspace"
+)
+
+func newEncoderTestSnapshot() *deploy.Snapshot {
+	version := semver.MustParse("1.2.3")
+	manifest := deploy.Manifest{
+		Time:    time.Unix(1600000000, 0).UTC(),
+		Magic:   "magic",
+		Version: "3.0.0",
+		Plugins: []workspace.PluginInfo{{Name: "test", Kind: workspace.ResourcePlugin, Version: &version}},
+	}
+
+	asset, err := resource.NewTextAsset("hello")
+	if err != nil {
+		panic(err)
+	}
+	archive, err := resource.NewAssetArchive(map[string]interface{}{"a.txt": asset})
+	if err != nil {
+		panic(err)
+	}
+
+	props := resource.NewPropertyMapFromMap(map[string]interface{}{
+		"string":  "<html> & \"quotes\" \\ \n\t  日本 \xff",
+		"number":  1e21,
+		"small":   0.0000001,
+		"integer": 42,
+		"bool":    true,
+		"null":    nil,
+		"array":   []interface{}{"a", 1, false, []interface{}{}},
+		"object":  map[string]interface{}{"z": "last", "a": "first"},
+		"empty":   map[string]interface{}{},
+	})
+	props["secret"] = resource.MakeSecret(resource.NewObjectProperty(resource.PropertyMap{
+		"nested": resource.MakeSecret(resource.NewStringProperty("inner")),
+	}))
+	props["computed"] = resource.MakeComputed(resource.NewStringProperty(""))
+	props["asset"] = resource.NewAssetProperty(asset)
+	props["archive"] = resource.NewArchiveProperty(archive)
+	props["ref"] = resource.MakeCustomResourceReference("urn:pulumi:stack::proj::pkg:index:t::ref", "ref-id", "4.0.0")
+	props["componentRef"] = resource.MakeComponentResourceReference("urn:pulumi:stack::proj::pkg:index:c::c", "")
+
+	provider := &resource.State{
+		Type:   "pulumi:providers:pkg",
+		URN:    "urn:pulumi:stack::proj::pulumi:providers:pkg::default",
+		Custom: true,
+		ID:     "provider-id",
+	}
+	parent := &resource.State{
+		Type: "pkg:index:Component",
+		URN:  "urn:pulumi:stack::proj::pkg:index:Component::parent",
+	}
+	child := &resource.State{
+		Type:         "pkg:index:Resource",
+		URN:          "urn:pulumi:stack::proj::pkg:index:Component$pkg:index:Resource::child",
+		Custom:       true,
+		ID:           "child-id",
+		Parent:       parent.URN,
+		Inputs:       props,
+		Outputs:      props.Copy(),
+		Protect:      true,
+		Dependencies: []resource.URN{parent.URN},
+		InitErrors:   []string{"failed <once>"},
+		Provider:     string(provider.URN) + "::provider-id",
+		PropertyDependencies: map[resource.PropertyKey][]resource.URN{
+			"string": {parent.URN},
+			"empty":  {},
+			"nil":    nil,
+		},
+		AdditionalSecretOutputs: []resource.PropertyKey{"string"},
+		Aliases:                 []resource.URN{"urn:pulumi:stack::proj::pkg:index:Resource::old"},
+		CustomTimeouts:          resource.CustomTimeouts{Create: 60},
+	}
+	deleted := &resource.State{
+		Type:               "pkg:index:Resource",
+		URN:                "urn:pulumi:stack::proj::pkg:index:Resource::deleted",
+		Custom:             true,
+		Delete:             true,
+		External:           true,
+		ID:                 "deleted-id",
+		Inputs:             resource.PropertyMap{},
+		PendingReplacement: true,
+		ImportID:           "import-id",
+		DiffFingerprint:    0xfedcba9876543210,
+	}
+	pending := &resource.State{
+		Type:   "pkg:index:Resource",
+		URN:    "urn:pulumi:stack::proj::pkg:index:Resource::pending",
+		Custom: true,
+	}
+
+	sm := NewCachingSecretsManager(&testSecretsManager{})
+	return deploy.NewSnapshot(manifest, sm, []*resource.State{provider, parent, child, deleted},
+		[]resource.Operation{resource.NewOperation(pending, resource.OperationTypeCreating)})
+}
+
+func marshalDeployment(t *testing.T, snap *deploy.Snapshot, showSecrets bool) string {
+	deployment, err := SerializeDeployment(snap, nil, showSecrets)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	b, err := json.Marshal(deployment)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	return string(b)
+}
+
+func TestDeploymentEncoderMatchesSerializeDeployment(t *testing.T) {
+	snap := newEncoderTestSnapshot()
+
+	for _, showSecrets := range []bool{false, true} {
+		var buf bytes.Buffer
+		err := NewDeploymentEncoder(nil, showSecrets).Encode(&buf, snap)
+		assert.NoError(t, err)
+		assert.Equal(t, marshalDeployment(t, snap, showSecrets), buf.String())
+	}
+
+	// An empty snapshot omits the resource and operation sections.
+	empty := deploy.NewSnapshot(snap.Manifest, nil, nil, nil)
+	var buf bytes.Buffer
+	err := NewDeploymentEncoder(nil, false).Encode(&buf, empty)
+	assert.NoError(t, err)
+	assert.Equal(t, marshalDeployment(t, empty, false), buf.String())
+}
+
+func TestDeploymentEncoderCheckpoint(t *testing.T) {
+	snap := newEncoderTestSnapshot()
+
+	for _, s := range []*deploy.Snapshot{snap, nil} {
+		chk, err := SerializeCheckpoint("stack", s, nil, false /* showSecrets */)
+		assert.NoError(t, err)
+		expected, err := json.Marshal(chk)
+		assert.NoError(t, err)
+
+		var buf bytes.Buffer
+		err = NewDeploymentEncoder(nil, false).EncodeCheckpoint(&buf, "stack", s)
+		assert.NoError(t, err)
+		assert.Equal(t, string(expected), buf.String())
+	}
+}
+
+func TestDeploymentEncoderReusesUnchangedResources(t *testing.T) {
+	snap := newEncoderTestSnapshot()
+	sm := &testSecretsManager{}
+	snap.SecretsManager = sm
+	encoder := NewDeploymentEncoder(nil, false)
+
+	var first bytes.Buffer
+	assert.NoError(t, encoder.Encode(&first, snap))
+	encryptCalls := sm.encryptCalls
+	assert.NotEqual(t, 0, encryptCalls)
+
+	// Nothing has changed, so no secrets are re-encrypted.
+	var second bytes.Buffer
+	assert.NoError(t, encoder.Encode(&second, snap))
+	assert.Equal(t, encryptCalls, sm.encryptCalls)
+	assert.Equal(t, first.String(), second.String())
+
+	// Changing a resource in place causes it to be serialized again.
+	child := snap.Resources[2]
+	child.Outputs["number"] = resource.NewNumberProperty(math.Pi)
+	var third bytes.Buffer
+	assert.NoError(t, encoder.Encode(&third, snap))
+	assert.Greater(t, sm.encryptCalls, encryptCalls)
+	assert.Contains(t, third.String(), "3.141592653589793")
+
+	// Unsupported values are reported as errors.
+	child.Outputs["number"] = resource.NewNumberProperty(math.NaN())
+	assert.Error(t, encoder.Encode(&bytes.Buffer{}, snap))
+}
+
+func TestDeploymentEncoderDetectsChangesToEqualValues(t *testing.T) {
+	snap := newEncoderTestSnapshot()
+	encoder := NewDeploymentEncoder(nil, false)
+	assert.NoError(t, encoder.Encode(&bytes.Buffer{}, snap))
+
+	// These changes leave the resource's outputs deeply equal to what they were, but change their serialized form.
+	child := snap.Resources[2]
+	changes := []func(){
+		func() { child.Outputs["null"] = resource.NewNullProperty() },
+		func() { child.Outputs["zero"] = resource.NewNumberProperty(0) },
+		func() { child.Outputs["zero"] = resource.NewNumberProperty(math.Copysign(0, -1)) },
+		func() { child.Outputs["asset"] = resource.NewAssetProperty(&resource.Asset{Hash: "abc", Text: "a"}) },
+		func() { child.Outputs["asset"] = resource.NewAssetProperty(&resource.Asset{Hash: "abc", Text: "b"}) },
+	}
+	for _, change := range changes {
+		change()
+
+		var buf bytes.Buffer
+		assert.NoError(t, encoder.Encode(&buf, snap))
+		assert.Equal(t, marshalDeployment(t, snap, false), buf.String())
+	}
+}
@@ -0,0 +1,465 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package stack
+
+import (
+	"encoding/json"
+	"sync"
+
+	"github.com/blang/semver"
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/tokens"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/workspace"
+)
+
+// A LazyDeployment is a deserialized deployment whose resource properties are decoded on demand.
+//
+// The manifest and the header of each resource (its URN, type, ID, parent, provider and dependencies) are decoded
+// eagerly. A resource's inputs and outputs are only decoded--and their secrets decrypted--when they are first
+// requested, and the deployment's secrets manager is only constructed once a secret needs to be decrypted. This makes
+// loading a deployment cheap for commands that only look at a few of its resources, such as reading stack outputs.
+//
+// A LazyDeployment is safe for concurrent use.
+type LazyDeployment struct {
+	Manifest  deploy.Manifest // the deployment's manifest.
+	Resources []*LazyResource // the deployment's resources, in order.
+
+	pendingOperations []apitype.OperationV2       // the deployment's serialized pending operations.
+	secretsProviders  *apitype.SecretsProvidersV1 // the serialized secrets manager, if any.
+	secretsProv       SecretsProvider             // the provider for the secrets manager.
+
+	cryptersOnce sync.Once
+	sm           secrets.Manager
+	dec          config.Decrypter
+	enc          config.Encrypter
+	cryptersErr  error
+
+	snapshot *deploy.Snapshot // the materialized snapshot, if this deployment wraps one.
+}
+
+// A LazyResource is a resource in a LazyDeployment.
+type LazyResource struct {
+	URN          resource.URN   // the resource's URN.
+	Type         tokens.Type    // the resource's type.
+	Custom       bool           // true if the resource is a custom resource.
+	Delete       bool           // true if the resource is pending deletion.
+	ID           resource.ID    // the resource's ID, if any.
+	Parent       resource.URN   // the resource's parent, if any.
+	Provider     string         // a reference to the resource's provider, if any.
+	Dependencies []resource.URN // the resources that this resource depends on.
+
+	deployment *LazyDeployment
+	serialized apitype.ResourceV3
+	rawInputs  json.RawMessage // the undecoded inputs of a resource read by DeserializeUntypedDeploymentLazy.
+	rawOutputs json.RawMessage // the undecoded outputs of a resource read by DeserializeUntypedDeploymentLazy.
+
+	inputs  lazyPropertyMap
+	outputs lazyPropertyMap
+	state   struct {
+		once  sync.Once
+		state *resource.State
+		err   error
+	}
+}
+
+type lazyPropertyMap struct {
+	parseOnce  sync.Once
+	serialized map[string]interface{}
+	parseErr   error
+
+	once  sync.Once
+	props resource.PropertyMap
+	err   error
+}
+
+// lazyResourceV3 is the serialized form of a resource whose properties are left undecoded.
+type lazyResourceV3 struct {
+	apitype.ResourceV3
+
+	Inputs  json.RawMessage `json:"inputs,omitempty"`
+	Outputs json.RawMessage `json:"outputs,omitempty"`
+}
+
+// lazyDeploymentV3 is the serialized form of a deployment whose resource properties are left undecoded.
+type lazyDeploymentV3 struct {
+	Manifest          apitype.ManifestV1          `json:"manifest"`
+	SecretsProviders  *apitype.SecretsProvidersV1 `json:"secrets_providers,omitempty"`
+	Resources         []lazyResourceV3            `json:"resources,omitempty"`
+	PendingOperations []apitype.OperationV2       `json:"pending_operations,omitempty"`
+}
+
+// DeserializeUntypedDeploymentLazy deserializes an untyped deployment into a LazyDeployment. Like
+// DeserializeUntypedDeployment, it returns an error if the deployment's version is not supported. The properties of
+// the resources in a current-version deployment are not even parsed until they are requested.
+func DeserializeUntypedDeploymentLazy(
+	deployment *apitype.UntypedDeployment, secretsProv SecretsProvider) (*LazyDeployment, error) {
+
+	contract.Require(deployment != nil, "deployment")
+	if deployment.Version != apitype.DeploymentSchemaVersionCurrent {
+		v3deployment, err := migrateUntypedDeployment(deployment)
+		if err != nil {
+			return nil, err
+		}
+		return DeserializeDeploymentV3Lazy(*v3deployment, secretsProv)
+	}
+
+	var lazy lazyDeploymentV3
+	if err := json.Unmarshal([]byte(deployment.Deployment), &lazy); err != nil {
+		return nil, err
+	}
+
+	resources := make([]apitype.ResourceV3, len(lazy.Resources))
+	for i, res := range lazy.Resources {
+		resources[i] = res.ResourceV3
+	}
+	d, err := DeserializeDeploymentV3Lazy(apitype.DeploymentV3{
+		Manifest:          lazy.Manifest,
+		SecretsProviders:  lazy.SecretsProviders,
+		Resources:         resources,
+		PendingOperations: lazy.PendingOperations,
+	}, secretsProv)
+	if err != nil {
+		return nil, err
+	}
+	for i, res := range d.Resources {
+		res.rawInputs, res.rawOutputs = lazy.Resources[i].Inputs, lazy.Resources[i].Outputs
+	}
+	return d, nil
+}
+
+// DeserializeDeploymentV3Lazy deserializes a typed DeploymentV3 into a LazyDeployment. The resulting deployment
+// decodes the same snapshot as DeserializeDeploymentV3, but defers decoding resource properties until they are
+// requested.
+func DeserializeDeploymentV3Lazy(deployment apitype.DeploymentV3,
+	secretsProv SecretsProvider) (*LazyDeployment, error) {
+
+	manifest := deploy.Manifest{
+		Time:    deployment.Manifest.Time,
+		Magic:   deployment.Manifest.Magic,
+		Version: deployment.Manifest.Version,
+	}
+	for _, plug := range deployment.Manifest.Plugins {
+		var version *semver.Version
+		if v := plug.Version; v != "" {
+			sv, err := semver.ParseTolerant(v)
+			if err != nil {
+				return nil, err
+			}
+			version = &sv
+		}
+		manifest.Plugins = append(manifest.Plugins, workspace.PluginInfo{
+			Name:    plug.Name,
+			Kind:    plug.Type,
+			Version: version,
+		})
+	}
+
+	secretsProviders := deployment.SecretsProviders
+	if secretsProviders != nil && secretsProviders.Type == "" {
+		secretsProviders = nil
+	}
+	if secretsProviders != nil && secretsProv == nil {
+		return nil, errors.New("deployment uses a SecretsProvider but no SecretsProvider was provided")
+	}
+
+	d := &LazyDeployment{
+		Manifest:          manifest,
+		pendingOperations: deployment.PendingOperations,
+		secretsProviders:  secretsProviders,
+		secretsProv:       secretsProv,
+	}
+
+	// Check the headers of the resources up front, so that a malformed deployment fails to load in the same way that
+	// it does when it is deserialized eagerly.
+	d.Resources = make([]*LazyResource, len(deployment.Resources))
+	for i, res := range deployment.Resources {
+		if err := checkResourceHeader(res); err != nil {
+			return nil, err
+		}
+		d.Resources[i] = &LazyResource{
+			URN:          res.URN,
+			Type:         res.Type,
+			Custom:       res.Custom,
+			Delete:       res.Delete,
+			ID:           res.ID,
+			Parent:       res.Parent,
+			Provider:     res.Provider,
+			Dependencies: res.Dependencies,
+			deployment:   d,
+			serialized:   res,
+		}
+	}
+	return d, nil
+}
+
+// NewLazyDeployment wraps an already-materialized snapshot in a LazyDeployment.
+func NewLazyDeployment(snap *deploy.Snapshot) *LazyDeployment {
+	contract.Require(snap != nil, "snap")
+
+	d := &LazyDeployment{
+		Manifest:  snap.Manifest,
+		Resources: make([]*LazyResource, len(snap.Resources)),
+		sm:        snap.SecretsManager,
+		snapshot:  snap,
+	}
+	d.cryptersOnce.Do(func() {})
+	for i, res := range snap.Resources {
+		r := &LazyResource{
+			URN:          res.URN,
+			Type:         res.Type,
+			Custom:       res.Custom,
+			Delete:       res.Delete,
+			ID:           res.ID,
+			Parent:       res.Parent,
+			Provider:     res.Provider,
+			Dependencies: res.Dependencies,
+			deployment:   d,
+		}
+		r.inputs.once.Do(func() { r.inputs.props = res.Inputs })
+		r.outputs.once.Do(func() { r.outputs.props = res.Outputs })
+		r.state.once.Do(func() { r.state.state = res })
+		d.Resources[i] = r
+	}
+	return d
+}
+
+// SecretsManager returns the deployment's secrets manager, constructing it if necessary.
+func (d *LazyDeployment) SecretsManager() (secrets.Manager, error) {
+	_, _, err := d.crypters()
+	return d.sm, err
+}
+
+func (d *LazyDeployment) crypters() (config.Decrypter, config.Encrypter, error) {
+	d.cryptersOnce.Do(func() {
+		if d.secretsProviders == nil {
+			d.dec, d.enc = config.NewPanicCrypter(), config.NewPanicCrypter()
+			return
+		}
+
+		sm, err := d.secretsProv.OfType(d.secretsProviders.Type, d.secretsProviders.State)
+		if err != nil {
+			d.cryptersErr = err
+			return
+		}
+		dec, err := sm.Decrypter()
+		if err != nil {
+			d.cryptersErr = err
+			return
+		}
+		enc, err := sm.Encrypter()
+		if err != nil {
+			d.cryptersErr = err
+			return
+		}
+		d.sm, d.dec, d.enc = sm, dec, enc
+	})
+	return d.dec, d.enc, d.cryptersErr
+}
+
+// RootStackResource returns the root stack resource of the deployment, or nil if there is none.
+func (d *LazyDeployment) RootStackResource() *LazyResource {
+	if d != nil {
+		for _, res := range d.Resources {
+			if res.Type == resource.RootStackType {
+				return res
+			}
+		}
+	}
+	return nil
+}
+
+// Snapshot decodes the properties of every resource and returns the resulting snapshot.
+func (d *LazyDeployment) Snapshot() (*deploy.Snapshot, error) {
+	if d.snapshot != nil {
+		return d.snapshot, nil
+	}
+
+	// Decrypt the secrets of every resource in bulk before decoding the resources themselves.
+	seen := make(map[string]struct{})
+	var ciphertexts []string
+	for _, res := range d.Resources {
+		inputs, err := res.inputs.parse(res.serialized.Inputs, res.rawInputs)
+		if err != nil {
+			return nil, err
+		}
+		outputs, err := res.outputs.parse(res.serialized.Outputs, res.rawOutputs)
+		if err != nil {
+			return nil, err
+		}
+		ciphertexts = collectCiphertexts(inputs, seen, ciphertexts)
+		ciphertexts = collectCiphertexts(outputs, seen, ciphertexts)
+	}
+	for _, op := range d.pendingOperations {
+		ciphertexts = collectCiphertexts(op.Resource.Inputs, seen, ciphertexts)
+		ciphertexts = collectCiphertexts(op.Resource.Outputs, seen, ciphertexts)
+	}
+	var prefetched config.Decrypter
+	if len(ciphertexts) != 0 {
+		dec, _, err := d.crypters()
+		if err != nil {
+			return nil, err
+		}
+		if prefetched, err = prefetchSecrets(dec, ciphertexts); err != nil {
+			return nil, err
+		}
+	}
+
+	resources := make([]*resource.State, len(d.Resources))
+	for i, res := range d.Resources {
+		state, err := res.materialize(prefetched)
+		if err != nil {
+			return nil, err
+		}
+		resources[i] = state
+	}
+
+	var ops []resource.Operation
+	if len(d.pendingOperations) != 0 {
+		dec, enc, err := d.crypters()
+		if err != nil {
+			return nil, err
+		}
+		if prefetched != nil {
+			dec = prefetched
+		}
+		for _, op := range d.pendingOperations {
+			desop, err := DeserializeOperation(op, dec, enc)
+			if err != nil {
+				return nil, err
+			}
+			ops = append(ops, desop)
+		}
+	}
+
+	sm, err := d.SecretsManager()
+	if err != nil {
+		return nil, err
+	}
+	return deploy.NewSnapshot(d.Manifest, sm, resources, ops), nil
+}
+
+// Inputs returns the resource's inputs, decoding them if necessary.
+func (r *LazyResource) Inputs() (resource.PropertyMap, error) {
+	return r.inputs.get(r.deployment, r.serialized.Inputs, r.rawInputs, nil)
+}
+
+// Outputs returns the resource's outputs, decoding them if necessary.
+func (r *LazyResource) Outputs() (resource.PropertyMap, error) {
+	return r.outputs.get(r.deployment, r.serialized.Outputs, r.rawOutputs, nil)
+}
+
+// State returns the resource's complete state, decoding its properties if necessary.
+func (r *LazyResource) State() (*resource.State, error) {
+	return r.materialize(nil)
+}
+
+// materialize returns the resource's complete state. If prefetched is non-nil, it is used to decrypt the resource's
+// secrets.
+func (r *LazyResource) materialize(prefetched config.Decrypter) (*resource.State, error) {
+	r.state.once.Do(func() {
+		inputs, err := r.inputs.get(r.deployment, r.serialized.Inputs, r.rawInputs, prefetched)
+		if err != nil {
+			r.state.err = err
+			return
+		}
+		outputs, err := r.outputs.get(r.deployment, r.serialized.Outputs, r.rawOutputs, prefetched)
+		if err != nil {
+			r.state.err = err
+			return
+		}
+
+		res := r.serialized
+		r.state.state = resource.NewState(
+			res.Type, res.URN, res.Custom, res.Delete, res.ID,
+			inputs, outputs, res.Parent, res.Protect, res.External, res.Dependencies, res.InitErrors, res.Provider,
+			res.PropertyDependencies, res.PendingReplacement, res.AdditionalSecretOutputs, res.Aliases,
+			res.CustomTimeouts, res.ImportID)
+		r.state.state.DiffFingerprint = deserializeDiffFingerprint(res)
+	})
+	return r.state.state, r.state.err
+}
+
+// parse returns the serialized form of the properties, parsing raw if it is non-nil.
+func (m *lazyPropertyMap) parse(props map[string]interface{}, raw json.RawMessage) (map[string]interface{}, error) {
+	m.parseOnce.Do(func() {
+		m.serialized = props
+		if raw != nil {
+			m.parseErr = json.Unmarshal(raw, &m.serialized)
+		}
+	})
+	return m.serialized, m.parseErr
+}
+
+// get returns the decoded properties, decoding them if necessary. If prefetched is nil, the secrets in the properties
+// are decrypted in a single batch using the deployment's decrypter.
+func (m *lazyPropertyMap) get(d *LazyDeployment, props map[string]interface{}, raw json.RawMessage,
+	prefetched config.Decrypter) (resource.PropertyMap, error) {
+
+	m.once.Do(func() {
+		serialized, err := m.parse(props, raw)
+		if err != nil {
+			m.err = err
+			return
+		}
+
+		// Only construct the secrets manager if these properties actually contain secrets.
+		dec, enc := config.NewPanicCrypter(), config.NewPanicCrypter()
+		if containsSecrets(serialized) {
+			if dec, enc, err = d.crypters(); err != nil {
+				m.err = err
+				return
+			}
+			if prefetched == nil {
+				prefetched, err = prefetchSecrets(dec, collectCiphertexts(serialized, map[string]struct{}{}, nil))
+				if err != nil {
+					m.err = err
+					return
+				}
+			}
+			dec = prefetched
+		}
+		m.props, m.err = DeserializeProperties(serialized, dec, enc)
+	})
+	return m.props, m.err
+}
+
+// containsSecrets returns true if the given serialized property value contains a secret.
+func containsSecrets(v interface{}) bool {
+	switch v := v.(type) {
+	case []interface{}:
+		for _, elem := range v {
+			if containsSecrets(elem) {
+				return true
+			}
+		}
+	case map[string]interface{}:
+		if v[resource.SigKey] == resource.SecretSig {
+			return true
+		}
+		for _, elem := range v {
+			if containsSecrets(elem) {
+				return true
+			}
+		}
+	}
+	return false
+}
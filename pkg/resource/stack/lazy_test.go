@@ -0,0 +1,147 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package stack
+
+import (
+	"encoding/json"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+)
+
+type testSecretsProvider struct {
+	calls int
+}
+
+func (p *testSecretsProvider) OfType(ty string, state json.RawMessage) (secrets.Manager, error) {
+	p.calls++
+	return NewCachingSecretsManager(&testSecretsManager{}), nil
+}
+
+func newLazyTestDeployment(t *testing.T) *apitype.UntypedDeployment {
+	stackRes := &resource.State{
+		Type: resource.RootStackType,
+		URN:  "urn:pulumi:stack::proj::pulumi:pulumi:Stack::proj-stack",
+		Outputs: resource.PropertyMap{
+			"plain": resource.NewStringProperty("value"),
+		},
+	}
+	secretRes := &resource.State{
+		Type:         "pkg:index:Resource",
+		URN:          "urn:pulumi:stack::proj::pkg:index:Resource::secret",
+		Custom:       true,
+		ID:           "secret-id",
+		Parent:       stackRes.URN,
+		Dependencies: []resource.URN{stackRes.URN},
+		Inputs: resource.PropertyMap{
+			"password": resource.MakeSecret(resource.NewStringProperty("hunter2")),
+		},
+	}
+	pending := &resource.State{
+		Type:   "pkg:index:Resource",
+		URN:    "urn:pulumi:stack::proj::pkg:index:Resource::pending",
+		Custom: true,
+	}
+
+	snap := deploy.NewSnapshot(deploy.Manifest{}, NewCachingSecretsManager(&testSecretsManager{}),
+		[]*resource.State{stackRes, secretRes},
+		[]resource.Operation{resource.NewOperation(pending, resource.OperationTypeCreating)})
+	deployment, err := SerializeDeployment(snap, nil, false /* showSecrets */)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	b, err := json.Marshal(deployment)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	return &apitype.UntypedDeployment{Version: apitype.DeploymentSchemaVersionCurrent, Deployment: b}
+}
+
+func TestLazyDeploymentDecodesOnDemand(t *testing.T) {
+	prov := &testSecretsProvider{}
+	d, err := DeserializeUntypedDeploymentLazy(newLazyTestDeployment(t), prov)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+
+	// The headers are available immediately.
+	if assert.Len(t, d.Resources, 2) {
+		assert.Equal(t, resource.ID("secret-id"), d.Resources[1].ID)
+		assert.Equal(t, []resource.URN{d.Resources[0].URN}, d.Resources[1].Dependencies)
+	}
+
+	// Reading the stack's outputs does not require the secrets manager.
+	root := d.RootStackResource()
+	if assert.NotNil(t, root) {
+		outputs, err := root.Outputs()
+		assert.NoError(t, err)
+		assert.Equal(t, resource.NewStringProperty("value"), outputs["plain"])
+	}
+	assert.Equal(t, 0, prov.calls)
+
+	// Decoding a secret constructs the secrets manager once.
+	inputs, err := d.Resources[1].Inputs()
+	assert.NoError(t, err)
+	assert.True(t, inputs["password"].IsSecret())
+	assert.Equal(t, "hunter2", inputs["password"].SecretValue().Element.StringValue())
+	assert.Equal(t, 1, prov.calls)
+
+	snap, err := d.Snapshot()
+	assert.NoError(t, err)
+	assert.Equal(t, 1, prov.calls)
+	if assert.Len(t, snap.Resources, 2) {
+		assert.Equal(t, root.URN, snap.Resources[0].URN)
+		assert.Equal(t, inputs, snap.Resources[1].Inputs)
+	}
+	assert.Len(t, snap.PendingOperations, 1)
+	assert.NotNil(t, snap.SecretsManager)
+}
+
+func TestLazyDeploymentMatchesEagerDeserialization(t *testing.T) {
+	untyped := newLazyTestDeployment(t)
+
+	eager, err := DeserializeUntypedDeployment(untyped, &testSecretsProvider{})
+	assert.NoError(t, err)
+
+	lazy, err := DeserializeUntypedDeploymentLazy(untyped, &testSecretsProvider{})
+	assert.NoError(t, err)
+	snap, err := lazy.Snapshot()
+	assert.NoError(t, err)
+
+	expected, err := SerializeDeployment(eager, nil, true /* showSecrets */)
+	assert.NoError(t, err)
+	actual, err := SerializeDeployment(snap, nil, true /* showSecrets */)
+	assert.NoError(t, err)
+	assert.Equal(t, expected, actual)
+}
+
+func TestLazyDeploymentChecksHeaders(t *testing.T) {
+	_, err := DeserializeUntypedDeploymentLazy(&apitype.UntypedDeployment{
+		Version:    apitype.DeploymentSchemaVersionCurrent,
+		Deployment: []byte(`{"manifest":{},"resources":[{"urn":"urn:pulumi:stack::proj::t::r","custom":true}]}`),
+	}, DefaultSecretsProvider)
+	assert.Error(t, err)
+
+	_, err = DeserializeUntypedDeploymentLazy(&apitype.UntypedDeployment{
+		Version:    apitype.DeploymentSchemaVersionCurrent + 1,
+		Deployment: []byte(`{}`),
+	}, DefaultSecretsProvider)
+	assert.Equal(t, ErrDeploymentSchemaVersionTooNew, err)
+}
@@ -0,0 +1,78 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package stack
+
+import (
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
+)
+
+// SerializeStackOutputs serializes the outputs of the given snapshot's root stack resource. Secret outputs are
+// encrypted using the given secrets manager or, if it is nil, the snapshot's own. The outputs are empty if the
+// snapshot is nil or has no root stack resource.
+func SerializeStackOutputs(snap *deploy.Snapshot, sm secrets.Manager) (*apitype.StackOutputsV1, error) {
+	if sm == nil && snap != nil {
+		sm = snap.SecretsManager
+	}
+
+	root, err := GetRootStackResource(snap)
+	if err != nil {
+		return nil, err
+	}
+	if root == nil || len(root.Outputs) == 0 {
+		return &apitype.StackOutputsV1{}, nil
+	}
+
+	var enc config.Encrypter
+	if sm != nil {
+		if enc, err = sm.Encrypter(); err != nil {
+			return nil, errors.Wrap(err, "getting encrypter for stack outputs")
+		}
+	} else {
+		enc = config.NewPanicCrypter()
+	}
+	outputs, err := SerializeProperties(root.Outputs, enc, false /* showSecrets */)
+	if err != nil {
+		return nil, errors.Wrap(err, "serializing stack outputs")
+	}
+	secretsProvider, err := serializeSecretsProvider(sm)
+	if err != nil {
+		return nil, err
+	}
+	return &apitype.StackOutputsV1{SecretsProviders: secretsProvider, Outputs: outputs}, nil
+}
+
+// DeserializeStackOutputs deserializes the outputs of a stack's root resource. As with a LazyDeployment, the secrets
+// manager is only constructed if the outputs contain secrets.
+func DeserializeStackOutputs(outputs apitype.StackOutputsV1,
+	secretsProv SecretsProvider) (resource.PropertyMap, error) {
+
+	secretsProviders := outputs.SecretsProviders
+	if secretsProviders != nil && secretsProviders.Type == "" {
+		secretsProviders = nil
+	}
+	if secretsProviders != nil && secretsProv == nil {
+		return nil, errors.New("stack outputs use a SecretsProvider but no SecretsProvider was provided")
+	}
+
+	d := &LazyDeployment{secretsProviders: secretsProviders, secretsProv: secretsProv}
+	var props lazyPropertyMap
+	return props.get(d, outputs.Outputs, nil, nil)
+}
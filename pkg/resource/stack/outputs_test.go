@@ -0,0 +1,81 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package stack
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+)
+
+func newOutputsTestSnapshot(outputs resource.PropertyMap) *deploy.Snapshot {
+	return deploy.NewSnapshot(deploy.Manifest{}, NewCachingSecretsManager(&testSecretsManager{}),
+		[]*resource.State{
+			{
+				Type:    resource.RootStackType,
+				URN:     "urn:pulumi:stack::proj::pulumi:pulumi:Stack::proj-stack",
+				Outputs: outputs,
+			},
+			{
+				Type:    "pkg:index:Resource",
+				URN:     "urn:pulumi:stack::proj::pkg:index:Resource::res",
+				Custom:  true,
+				Outputs: resource.PropertyMap{"other": resource.NewStringProperty("value")},
+			},
+		}, nil)
+}
+
+func TestStackOutputsRoundTrip(t *testing.T) {
+	// Outputs without secrets do not require the secrets manager.
+	plain := resource.PropertyMap{"plain": resource.NewStringProperty("value")}
+	serialized, err := SerializeStackOutputs(newOutputsTestSnapshot(plain), nil)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	assert.Len(t, serialized.Outputs, 1)
+
+	prov := &testSecretsProvider{}
+	outputs, err := DeserializeStackOutputs(*serialized, prov)
+	assert.NoError(t, err)
+	assert.Equal(t, plain, outputs)
+	assert.Equal(t, 0, prov.calls)
+
+	// Secret outputs are encrypted and decrypted using the stack's secrets provider.
+	secret := resource.PropertyMap{"password": resource.MakeSecret(resource.NewStringProperty("hunter2"))}
+	serialized, err = SerializeStackOutputs(newOutputsTestSnapshot(secret), nil)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	assert.NotNil(t, serialized.SecretsProviders)
+
+	outputs, err = DeserializeStackOutputs(*serialized, prov)
+	assert.NoError(t, err)
+	assert.True(t, outputs["password"].IsSecret())
+	assert.Equal(t, "hunter2", outputs["password"].SecretValue().Element.StringValue())
+	assert.Equal(t, 1, prov.calls)
+}
+
+func TestStackOutputsWithoutRootStack(t *testing.T) {
+	serialized, err := SerializeStackOutputs(nil, nil)
+	if !assert.NoError(t, err) {
+		t.FailNow()
+	}
+	outputs, err := DeserializeStackOutputs(*serialized, nil)
+	assert.NoError(t, err)
+	assert.Len(t, outputs, 0)
+}
@@ -25,6 +25,7 @@ import (
 	"github.com/pulumi/pulumi/pkg/v3/secrets/service"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
 )
 
 // DefaultSecretsProvider is the default SecretsProvider to use when deserializing deployments.
@@ -129,6 +130,14 @@ func (c *cachingCrypter) DecryptValue(ciphertext string) (string, error) {
 	return c.decrypter.DecryptValue(ciphertext)
 }
 
+func (c *cachingCrypter) BatchEncrypt(plaintexts []string) ([]string, error) {
+	return config.BatchEncrypt(c.encrypter, plaintexts)
+}
+
+func (c *cachingCrypter) BatchDecrypt(ciphertexts []string) ([]string, error) {
+	return config.BatchDecrypt(c.decrypter, ciphertexts)
+}
+
 // encryptSecret encrypts the plaintext associated with the given secret value.
 func (c *cachingCrypter) encryptSecret(secret *resource.Secret, plaintext string) (string, error) {
 	// If the cache has an entry for this secret and the plaintext has not changed, re-use the ciphertext.
@@ -150,3 +159,159 @@ func (c *cachingCrypter) encryptSecret(secret *resource.Secret, plaintext string
 func (c *cachingCrypter) insert(secret *resource.Secret, plaintext, ciphertext string) {
 	c.cache[secret] = cacheEntry{plaintext, ciphertext}
 }
+
+// encryptSecrets encrypts the plaintexts associated with the given secret values in bulk. Secrets whose plaintext
+// already has a cached ciphertext are skipped. The results are added to the cache, where encryptSecret will find them.
+func (c *cachingCrypter) encryptSecrets(secrets []*resource.Secret, plaintexts []string) error {
+	contract.Assert(len(secrets) == len(plaintexts))
+
+	var pending []*resource.Secret
+	var pendingPlaintexts []string
+	for i, secret := range secrets {
+		if entry, ok := c.cache[secret]; !ok || entry.plaintext != plaintexts[i] {
+			pending, pendingPlaintexts = append(pending, secret), append(pendingPlaintexts, plaintexts[i])
+		}
+	}
+	if len(pending) == 0 {
+		return nil
+	}
+
+	ciphertexts, err := config.BatchEncrypt(c.encrypter, pendingPlaintexts)
+	if err != nil {
+		return err
+	}
+	for i, secret := range pending {
+		c.insert(secret, pendingPlaintexts[i], ciphertexts[i])
+	}
+	return nil
+}
+
+// batchingCrypter returns the given encrypter as a cachingCrypter if it is one and the encrypter it wraps is able to
+// encrypt values in bulk. Serializers use it to decide whether to encrypt a deployment's secrets ahead of time.
+func batchingCrypter(enc config.Encrypter) (*cachingCrypter, bool) {
+	c, ok := enc.(*cachingCrypter)
+	if !ok {
+		return nil, false
+	}
+	_, ok = c.encrypter.(config.BatchEncrypter)
+	return c, ok
+}
+
+// encryptResourceSecrets encrypts the secrets in the inputs and outputs of the given resources in bulk and caches the
+// results. The plaintext function returns the plaintext that the serializer will encrypt for a secret.
+func encryptResourceSecrets(c *cachingCrypter, resources []*resource.State,
+	plaintext func(secret *resource.Secret) (string, error)) error {
+
+	var secrets []*resource.Secret
+	var plaintexts []string
+	visit := func(secret *resource.Secret) error {
+		p, err := plaintext(secret)
+		if err != nil {
+			return err
+		}
+		secrets, plaintexts = append(secrets, secret), append(plaintexts, p)
+		return nil
+	}
+	for _, res := range resources {
+		if err := walkSecrets(res.Inputs, visit); err != nil {
+			return err
+		}
+		if err := walkSecrets(res.Outputs, visit); err != nil {
+			return err
+		}
+	}
+	return c.encryptSecrets(secrets, plaintexts)
+}
+
+// walkSecrets calls visit for each secret in the given property map. Secrets nested within other secrets are not
+// visited, as they are encrypted along with their parent.
+func walkSecrets(props resource.PropertyMap, visit func(secret *resource.Secret) error) error {
+	for _, v := range props {
+		if err := walkSecretsValue(v, visit); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+func walkSecretsValue(v resource.PropertyValue, visit func(secret *resource.Secret) error) error {
+	switch {
+	case v.IsSecret():
+		return visit(v.SecretValue())
+	case v.IsArray():
+		for _, elem := range v.ArrayValue() {
+			if err := walkSecretsValue(elem, visit); err != nil {
+				return err
+			}
+		}
+	case v.IsObject():
+		return walkSecrets(v.ObjectValue(), visit)
+	}
+	return nil
+}
+
+// prefetchedDecrypter is a Decrypter that answers from a set of values that were decrypted ahead of time.
+type prefetchedDecrypter struct {
+	decrypter  config.Decrypter
+	plaintexts map[string]string
+}
+
+func (d *prefetchedDecrypter) DecryptValue(ciphertext string) (string, error) {
+	if plaintext, ok := d.plaintexts[ciphertext]; ok {
+		return plaintext, nil
+	}
+	return d.decrypter.DecryptValue(ciphertext)
+}
+
+// prefetchSecrets decrypts the given ciphertexts in bulk and returns a Decrypter that answers from the results. Any
+// other values are passed through to dec.
+func prefetchSecrets(dec config.Decrypter, ciphertexts []string) (config.Decrypter, error) {
+	if len(ciphertexts) == 0 {
+		return dec, nil
+	}
+	plaintexts, err := config.BatchDecrypt(dec, ciphertexts)
+	if err != nil {
+		return nil, errors.Wrap(err, "decrypting secret values")
+	}
+	prefetched := &prefetchedDecrypter{decrypter: dec, plaintexts: make(map[string]string, len(ciphertexts))}
+	for i, ciphertext := range ciphertexts {
+		prefetched.plaintexts[ciphertext] = plaintexts[i]
+	}
+	return prefetched, nil
+}
+
+// collectCiphertexts appends the ciphertext of each encrypted secret in the given serialized property value to
+// ciphertexts. Ciphertexts that are already present in seen are skipped.
+func collectCiphertexts(v interface{}, seen map[string]struct{}, ciphertexts []string) []string {
+	switch v := v.(type) {
+	case []interface{}:
+		for _, elem := range v {
+			ciphertexts = collectCiphertexts(elem, seen, ciphertexts)
+		}
+	case map[string]interface{}:
+		if v[resource.SigKey] == resource.SecretSig {
+			if ciphertext, ok := v["ciphertext"].(string); ok {
+				if _, ok := seen[ciphertext]; !ok {
+					seen[ciphertext] = struct{}{}
+					ciphertexts = append(ciphertexts, ciphertext)
+				}
+			}
+			return ciphertexts
+		}
+		for _, elem := range v {
+			ciphertexts = collectCiphertexts(elem, seen, ciphertexts)
+		}
+	}
+	return ciphertexts
+}
+
+// cacheDecryptedSecret records the plain- and ciphertext of a freshly-decrypted secret in the cache of the
+// cachingCrypter underlying dec, if any.
+func cacheDecryptedSecret(dec config.Decrypter, secret *resource.Secret, plaintext, ciphertext string) {
+	switch dec := dec.(type) {
+	case *cachingCrypter:
+		dec.insert(secret, plaintext, ciphertext)
+	case *prefetchedDecrypter:
+		cacheDecryptedSecret(dec.decrypter, secret, plaintext, ciphertext)
+	}
+}
@@ -7,6 +7,9 @@ import (
 	"testing"
 
 	"github.com/pkg/errors"
+	"github.com/pulumi/pulumi/pkg/v3/resource/deploy"
+	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
 	"github.com/stretchr/testify/assert"
@@ -43,6 +46,40 @@ func (t *testSecretsManager) DecryptValue(ciphertext string) (string, error) {
 	return ciphertext[i+1:], nil
 }
 
+// batchTestSecretsManager is a testSecretsManager that also supports batch encryption and decryption.
+type batchTestSecretsManager struct {
+	testSecretsManager
+
+	batchEncryptCalls int
+	batchDecryptCalls int
+}
+
+func (t *batchTestSecretsManager) Encrypter() (config.Encrypter, error) {
+	return t, nil
+}
+
+func (t *batchTestSecretsManager) Decrypter() (config.Decrypter, error) {
+	return t, nil
+}
+
+func (t *batchTestSecretsManager) BatchEncrypt(plaintexts []string) ([]string, error) {
+	t.batchEncryptCalls++
+	return config.BatchEncrypt(&t.testSecretsManager, plaintexts)
+}
+
+func (t *batchTestSecretsManager) BatchDecrypt(ciphertexts []string) ([]string, error) {
+	t.batchDecryptCalls++
+	return config.BatchDecrypt(&t.testSecretsManager, ciphertexts)
+}
+
+type staticSecretsProvider struct {
+	sm secrets.Manager
+}
+
+func (p staticSecretsProvider) OfType(ty string, state json.RawMessage) (secrets.Manager, error) {
+	return NewCachingSecretsManager(p.sm), nil
+}
+
 func deserializeProperty(v interface{}, dec config.Decrypter) (resource.PropertyValue, error) {
 	b, err := json.Marshal(v)
 	if err != nil {
@@ -172,3 +209,56 @@ func TestCachingCrypter(t *testing.T) {
 	assert.Equal(t, 3, sm.encryptCalls)
 	assert.Equal(t, barSer, barSer2)
 }
+
+func TestBatchCrypter(t *testing.T) {
+	sm := &batchTestSecretsManager{}
+	csm := NewCachingSecretsManager(sm)
+
+	res := &resource.State{
+		Type:   "pkg:index:Resource",
+		URN:    "urn:pulumi:stack::proj::pkg:index:Resource::res",
+		Custom: true,
+		ID:     "id",
+		Inputs: resource.PropertyMap{
+			"a": resource.MakeSecret(resource.NewStringProperty("a")),
+			"b": resource.NewArrayProperty([]resource.PropertyValue{
+				resource.MakeSecret(resource.NewStringProperty("b")),
+			}),
+		},
+		Outputs: resource.PropertyMap{
+			"c": resource.MakeSecret(resource.NewObjectProperty(resource.PropertyMap{
+				"nested": resource.MakeSecret(resource.NewStringProperty("c")),
+			})),
+		},
+	}
+	snap := deploy.NewSnapshot(deploy.Manifest{}, csm, []*resource.State{res}, nil)
+
+	// All three secrets are encrypted in a single batch.
+	deployment, err := SerializeDeployment(snap, nil, false /* showSecrets */)
+	assert.NoError(t, err)
+	assert.Equal(t, 1, sm.batchEncryptCalls)
+	assert.Equal(t, 3, sm.encryptCalls)
+
+	// Serializing again reuses the cached ciphertexts.
+	_, err = SerializeDeployment(snap, nil, false /* showSecrets */)
+	assert.NoError(t, err)
+	assert.Equal(t, 3, sm.encryptCalls)
+
+	// Likewise, all three secrets are decrypted in a single batch.
+	b, err := json.Marshal(deployment)
+	assert.NoError(t, err)
+	var roundTripped apitype.DeploymentV3
+	assert.NoError(t, json.Unmarshal(b, &roundTripped))
+
+	snap2, err := DeserializeDeploymentV3(roundTripped, staticSecretsProvider{sm})
+	assert.NoError(t, err)
+	assert.Equal(t, 1, sm.batchDecryptCalls)
+	assert.Equal(t, 3, sm.decryptCalls)
+	assert.True(t, res.Inputs.DeepEquals(snap2.Resources[0].Inputs))
+	assert.True(t, res.Outputs.DeepEquals(snap2.Resources[0].Outputs))
+
+	// The decrypted values are cached, so re-serializing the new snapshot does not encrypt anything.
+	_, err = SerializeDeployment(snap2, nil, false /* showSecrets */)
+	assert.NoError(t, err)
+	assert.Equal(t, 3, sm.encryptCalls)
+}
@@ -20,11 +20,14 @@ import (
 	"encoding/base64"
 	"encoding/json"
 	"io/ioutil"
+	"net/http"
+	"sync/atomic"
 
 	"github.com/pkg/errors"
 
 	"github.com/pulumi/pulumi/pkg/v3/backend/httpstate/client"
 	"github.com/pulumi/pulumi/pkg/v3/secrets"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/diag"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/resource/config"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
@@ -33,10 +36,16 @@ import (
 
 const Type = "service"
 
+// maxBatchSize is the maximum number of values sent to the service in a single batch request.
+const maxBatchSize = 1000
+
 // serviceCrypter is an encrypter/decrypter that uses the Pulumi servce to encrypt/decrypt a stack's secrets.
 type serviceCrypter struct {
 	client *client.Client
 	stack  client.StackIdentifier
+
+	// noBatch is set to 1 once the service has reported that it does not support batch requests.
+	noBatch int32
 }
 
 func newServiceCrypter(client *client.Client, stack client.StackIdentifier) config.Crypter {
@@ -63,6 +72,106 @@ func (c *serviceCrypter) DecryptValue(cipherstring string) (string, error) {
 	return string(plaintext), nil
 }
 
+func (c *serviceCrypter) BatchEncrypt(plaintexts []string) ([]string, error) {
+	ciphertexts := make([]string, 0, len(plaintexts))
+	for len(plaintexts) > 0 {
+		n := len(plaintexts)
+		if n > maxBatchSize {
+			n = maxBatchSize
+		}
+		batch, err := c.batchEncrypt(plaintexts[:n])
+		if err != nil {
+			return nil, err
+		}
+		ciphertexts, plaintexts = append(ciphertexts, batch...), plaintexts[n:]
+	}
+	return ciphertexts, nil
+}
+
+func (c *serviceCrypter) batchEncrypt(plaintexts []string) ([]string, error) {
+	if atomic.LoadInt32(&c.noBatch) == 0 {
+		request := make([][]byte, len(plaintexts))
+		for i, plaintext := range plaintexts {
+			request[i] = []byte(plaintext)
+		}
+		response, err := c.client.BatchEncryptValue(context.Background(), c.stack, request)
+		if err == nil {
+			ciphertexts := make([]string, len(response))
+			for i, ciphertext := range response {
+				ciphertexts[i] = base64.StdEncoding.EncodeToString(ciphertext)
+			}
+			return ciphertexts, nil
+		}
+		if !isBatchUnsupported(err) {
+			return nil, err
+		}
+		atomic.StoreInt32(&c.noBatch, 1)
+	}
+	return cryptEach(plaintexts, c.EncryptValue)
+}
+
+func (c *serviceCrypter) BatchDecrypt(ciphertexts []string) ([]string, error) {
+	plaintexts := make([]string, 0, len(ciphertexts))
+	for len(ciphertexts) > 0 {
+		n := len(ciphertexts)
+		if n > maxBatchSize {
+			n = maxBatchSize
+		}
+		batch, err := c.batchDecrypt(ciphertexts[:n])
+		if err != nil {
+			return nil, err
+		}
+		plaintexts, ciphertexts = append(plaintexts, batch...), ciphertexts[n:]
+	}
+	return plaintexts, nil
+}
+
+func (c *serviceCrypter) batchDecrypt(ciphertexts []string) ([]string, error) {
+	if atomic.LoadInt32(&c.noBatch) == 0 {
+		request := make([][]byte, len(ciphertexts))
+		for i, cipherstring := range ciphertexts {
+			ciphertext, err := base64.StdEncoding.DecodeString(cipherstring)
+			if err != nil {
+				return nil, err
+			}
+			request[i] = ciphertext
+		}
+		response, err := c.client.BatchDecryptValue(context.Background(), c.stack, request)
+		if err == nil {
+			plaintexts := make([]string, len(response))
+			for i, plaintext := range response {
+				plaintexts[i] = string(plaintext)
+			}
+			return plaintexts, nil
+		}
+		if !isBatchUnsupported(err) {
+			return nil, err
+		}
+		atomic.StoreInt32(&c.noBatch, 1)
+	}
+	return cryptEach(ciphertexts, c.DecryptValue)
+}
+
+// cryptEach applies crypt to each of the given values in turn.
+func cryptEach(values []string, crypt func(string) (string, error)) ([]string, error) {
+	results := make([]string, len(values))
+	for i, v := range values {
+		result, err := crypt(v)
+		if err != nil {
+			return nil, err
+		}
+		results[i] = result
+	}
+	return results, nil
+}
+
+// isBatchUnsupported returns true if the given error indicates that the service does not implement the batch
+// encryption endpoints, in which case values are encrypted or decrypted one at a time.
+func isBatchUnsupported(err error) bool {
+	errResp, ok := err.(*apitype.ErrorResponse)
+	return ok && (errResp.Code == http.StatusNotFound || errResp.Code == http.StatusMethodNotAllowed)
+}
+
 type serviceSecretsManagerState struct {
 	URL     string `json:"url,omitempty"`
 	Owner   string `json:"owner"`
@@ -0,0 +1,234 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Package metrics records where the engine spends its time, so that a slow update can be attributed to providers,
+// checkpointing, event uploads, or the display. Metrics are only recorded once they have been enabled, so until then
+// each instrumented call site costs a single atomic load.
+package metrics
+
+import (
+	"context"
+	"encoding/json"
+	"io/ioutil"
+	"math"
+	"math/bits"
+	"runtime/pprof"
+	"sort"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+var (
+	enabled       int32 // non-zero if metrics are being recorded.
+	labelsEnabled int32 // non-zero if profiler labels are being attached.
+
+	m      sync.Mutex
+	series = map[seriesKey]*histogram{}
+)
+
+// Enable starts recording metrics.
+func Enable() {
+	atomic.StoreInt32(&enabled, 1)
+}
+
+// Enabled returns true if metrics are being recorded.
+func Enabled() bool {
+	return atomic.LoadInt32(&enabled) != 0
+}
+
+// EnableProfilerLabels causes Do to attach its labels to the goroutines that it runs, so that CPU profiles can be
+// broken down by those labels.
+func EnableProfilerLabels() {
+	atomic.StoreInt32(&labelsEnabled, 1)
+}
+
+// Do calls f, attaching the given key-value pairs as profiler labels if profiler labels are enabled. Goroutines that
+// f starts inherit the labels.
+func Do(ctx context.Context, f func(ctx context.Context), labels ...string) {
+	if atomic.LoadInt32(&labelsEnabled) == 0 {
+		f(ctx)
+		return
+	}
+	pprof.Do(ctx, pprof.Labels(labels...), f)
+}
+
+// Unit describes the kind of values in a series.
+type Unit string
+
+const (
+	// Duration series hold latencies, in nanoseconds.
+	Duration Unit = "ns"
+	// Bytes series hold sizes, in bytes.
+	Bytes Unit = "bytes"
+)
+
+type seriesKey struct {
+	name  string
+	label string
+	unit  Unit
+}
+
+// histogram summarizes the values in a series with a bucket per power of two.
+type histogram struct {
+	count   int64
+	sum     int64
+	min     int64
+	max     int64
+	buckets [64]int64
+}
+
+func (h *histogram) observe(v int64) {
+	if v < 0 {
+		v = 0
+	}
+	if h.count == 0 || v < h.min {
+		h.min = v
+	}
+	if v > h.max {
+		h.max = v
+	}
+	h.count++
+	h.sum += v
+	h.buckets[bits.Len64(uint64(v))]++
+}
+
+// quantile returns an upper bound on the given quantile of the series' values.
+func (h *histogram) quantile(q float64) int64 {
+	rank := int64(math.Ceil(q * float64(h.count)))
+	var seen int64
+	for i, n := range h.buckets {
+		seen += n
+		if seen >= rank && n > 0 {
+			// Bucket i holds values below 2^i.
+			if i == 0 {
+				return 0
+			}
+			upper := int64(1)<<uint(i) - 1
+			if upper > h.max {
+				return h.max
+			}
+			return upper
+		}
+	}
+	return h.max
+}
+
+func observe(name, label string, unit Unit, v int64) {
+	key := seriesKey{name: name, label: label, unit: unit}
+	m.Lock()
+	defer m.Unlock()
+	h, ok := series[key]
+	if !ok {
+		h = &histogram{}
+		series[key] = h
+	}
+	h.observe(v)
+}
+
+// ObserveDuration records a latency in the named series. The label distinguishes the subjects that share a series,
+// e.g. the package of the provider that served a request.
+func ObserveDuration(name, label string, d time.Duration) {
+	if Enabled() {
+		observe(name, label, Duration, int64(d))
+	}
+}
+
+// ObserveSince records the time elapsed since start in the named series.
+func ObserveSince(name, label string, start time.Time) {
+	if Enabled() {
+		observe(name, label, Duration, int64(time.Since(start)))
+	}
+}
+
+// ObserveBytes records a size in the named series.
+func ObserveBytes(name, label string, n int) {
+	if Enabled() {
+		observe(name, label, Bytes, int64(n))
+	}
+}
+
+// Now returns the current time if metrics are enabled and the zero time otherwise. Pair it with ObserveSince to time
+// a region without reading the clock when metrics are disabled.
+func Now() time.Time {
+	if Enabled() {
+		return time.Now()
+	}
+	return time.Time{}
+}
+
+// Series summarizes the values recorded in one series.
+type Series struct {
+	Name  string `json:"name"`
+	Label string `json:"label,omitempty"`
+	Unit  Unit   `json:"unit"`
+	Count int64  `json:"count"`
+	Sum   int64  `json:"sum"`
+	Min   int64  `json:"min"`
+	Max   int64  `json:"max"`
+	P50   int64  `json:"p50"`
+	P90   int64  `json:"p90"`
+	P99   int64  `json:"p99"`
+}
+
+// Summary is a machine-readable summary of every series recorded so far.
+type Summary struct {
+	Series []Series `json:"series"`
+}
+
+// GetSummary returns a summary of every series recorded so far, sorted by name and label.
+func GetSummary() Summary {
+	m.Lock()
+	defer m.Unlock()
+
+	summary := Summary{Series: make([]Series, 0, len(series))}
+	for key, h := range series {
+		summary.Series = append(summary.Series, Series{
+			Name:  key.name,
+			Label: key.label,
+			Unit:  key.unit,
+			Count: h.count,
+			Sum:   h.sum,
+			Min:   h.min,
+			Max:   h.max,
+			P50:   h.quantile(0.5),
+			P90:   h.quantile(0.9),
+			P99:   h.quantile(0.99),
+		})
+	}
+	sort.Slice(summary.Series, func(i, j int) bool {
+		a, b := summary.Series[i], summary.Series[j]
+		if a.Name != b.Name {
+			return a.Name < b.Name
+		}
+		return a.Label < b.Label
+	})
+	return summary
+}
+
+// WriteSummary writes a summary of every series recorded so far to the given file as JSON.
+func WriteSummary(path string) error {
+	b, err := json.MarshalIndent(GetSummary(), "", "    ")
+	if err != nil {
+		return err
+	}
+	return ioutil.WriteFile(path, b, 0600)
+}
+
+// reset discards every series recorded so far.
+func reset() {
+	m.Lock()
+	defer m.Unlock()
+	series = map[seriesKey]*histogram{}
+}
@@ -0,0 +1,118 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package metrics
+
+import (
+	"context"
+	"encoding/json"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"runtime/pprof"
+	"sync/atomic"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func TestMetricsAreOnlyRecordedOnceEnabled(t *testing.T) {
+	reset()
+	atomic.StoreInt32(&enabled, 0)
+	t.Cleanup(func() {
+		atomic.StoreInt32(&enabled, 0)
+		reset()
+	})
+
+	ObserveDuration("step", "aws", time.Second)
+	assert.True(t, Now().IsZero())
+	assert.Empty(t, GetSummary().Series)
+
+	Enable()
+	ObserveDuration("step", "aws", time.Millisecond)
+	ObserveDuration("step", "aws", 3*time.Millisecond)
+	ObserveDuration("step", "azure", time.Second)
+	ObserveBytes("checkpoint", "", 1024)
+	ObserveSince("generate", "aws", Now())
+
+	summary := GetSummary()
+	if assert.Len(t, summary.Series, 4) {
+		assert.Equal(t, Series{
+			Name: "checkpoint", Unit: Bytes, Count: 1, Sum: 1024, Min: 1024, Max: 1024, P50: 1024, P90: 1024, P99: 1024,
+		}, summary.Series[0])
+		assert.Equal(t, "generate", summary.Series[1].Name)
+
+		aws := summary.Series[2]
+		assert.Equal(t, "aws", aws.Label)
+		assert.Equal(t, int64(2), aws.Count)
+		assert.Equal(t, int64(4*time.Millisecond), aws.Sum)
+		assert.Equal(t, int64(time.Millisecond), aws.Min)
+		assert.Equal(t, int64(3*time.Millisecond), aws.Max)
+		assert.Equal(t, "azure", summary.Series[3].Label)
+	}
+}
+
+func TestHistogramQuantiles(t *testing.T) {
+	var h histogram
+	for i := int64(1); i <= 100; i++ {
+		h.observe(i)
+	}
+
+	// Quantiles are bounded by the top of the bucket that holds them, and never exceed the largest value.
+	assert.Equal(t, int64(63), h.quantile(0.5))
+	assert.Equal(t, int64(100), h.quantile(0.9))
+	assert.Equal(t, int64(100), h.quantile(0.99))
+	assert.Equal(t, int64(1), h.min)
+}
+
+func TestWriteSummary(t *testing.T) {
+	reset()
+	Enable()
+	t.Cleanup(func() {
+		atomic.StoreInt32(&enabled, 0)
+		reset()
+	})
+
+	ObserveBytes("checkpoint", "", 10)
+
+	dir, err := ioutil.TempDir("", "metrics")
+	assert.NoError(t, err)
+	defer os.RemoveAll(dir)
+
+	path := filepath.Join(dir, "metrics.json")
+	assert.NoError(t, WriteSummary(path))
+	b, err := ioutil.ReadFile(path)
+	assert.NoError(t, err)
+
+	var summary Summary
+	assert.NoError(t, json.Unmarshal(b, &summary))
+	assert.Equal(t, GetSummary(), summary)
+}
+
+func TestDoAttachesLabels(t *testing.T) {
+	t.Cleanup(func() { atomic.StoreInt32(&labelsEnabled, 0) })
+
+	Do(context.Background(), func(ctx context.Context) {
+		_, ok := pprof.Label(ctx, "phase")
+		assert.False(t, ok)
+	}, "phase", "create")
+
+	EnableProfilerLabels()
+	Do(context.Background(), func(ctx context.Context) {
+		phase, ok := pprof.Label(ctx, "phase")
+		assert.True(t, ok)
+		assert.Equal(t, "create", phase)
+	}, "phase", "create")
+}
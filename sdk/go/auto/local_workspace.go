@@ -20,8 +20,10 @@ import (
 	"fmt"
 	"io/ioutil"
 	"os"
+	"os/exec"
 	"path/filepath"
 	"strings"
+	"sync"
 
 	"github.com/blang/semver"
 	"github.com/pkg/errors"
@@ -450,18 +452,28 @@ func (l *LocalWorkspace) ImportStack(ctx context.Context, stackName string, stat
 
 // Outputs get the current set of Stack outputs from the last Stack.Up().
 func (l *LocalWorkspace) StackOutputs(ctx context.Context, stackName string) (OutputMap, error) {
+	// The secret outputs are read by an independent command, so run it concurrently with the standard outputs.
+	var secretStdout, secretStderr string
+	var secretCode int
+	var secretErr error
+	var wg sync.WaitGroup
+	wg.Add(1)
+	go func() {
+		defer wg.Done()
+		secretStdout, secretStderr, secretCode, secretErr = l.runPulumiCmdSync(ctx,
+			"stack", "output", "--json", "--show-secrets", "--stack", stackName,
+		)
+	}()
+
 	// standard outputs
 	outStdout, outStderr, code, err := l.runPulumiCmdSync(ctx, "stack", "output", "--json", "--stack", stackName)
+	wg.Wait()
 	if err != nil {
 		return nil, newAutoError(errors.Wrap(err, "could not get outputs"), outStdout, outStderr, code)
 	}
-
-	// secret outputs
-	secretStdout, secretStderr, code, err := l.runPulumiCmdSync(ctx,
-		"stack", "output", "--json", "--show-secrets", "--stack", stackName,
-	)
-	if err != nil {
-		return nil, newAutoError(errors.Wrap(err, "could not get secret outputs"), outStdout, outStderr, code)
+	if secretErr != nil {
+		return nil, newAutoError(errors.Wrap(secretErr, "could not get secret outputs"), secretStdout, secretStderr,
+			secretCode)
 	}
 
 	var outputs map[string]interface{}
@@ -487,7 +499,38 @@ func (l *LocalWorkspace) StackOutputs(ctx context.Context, stackName string) (Ou
 	return res, nil
 }
 
+// pulumiVersions caches the versions of the CLI binaries that workspaces have been created with, so that creating a
+// workspace does not need to start the CLI just to ask for its version. Binaries are identified by their path, size,
+// and modification time, so a CLI that is upgraded in place is asked again.
+var pulumiVersions sync.Map // pulumiBinary -> semver.Version
+
+type pulumiBinary struct {
+	path    string
+	size    int64
+	modTime int64
+}
+
+// lookupPulumiBinary identifies the CLI binary that commands will run, if it can be found.
+func lookupPulumiBinary() (pulumiBinary, bool) {
+	path, err := exec.LookPath("pulumi")
+	if err != nil {
+		return pulumiBinary{}, false
+	}
+	info, err := os.Stat(path)
+	if err != nil {
+		return pulumiBinary{}, false
+	}
+	return pulumiBinary{path: path, size: info.Size(), modTime: info.ModTime().UnixNano()}, true
+}
+
 func (l *LocalWorkspace) getPulumiVersion(ctx context.Context) (semver.Version, error) {
+	binary, cacheable := lookupPulumiBinary()
+	if cacheable {
+		if v, ok := pulumiVersions.Load(binary); ok {
+			return v.(semver.Version), nil
+		}
+	}
+
 	stdout, stderr, errCode, err := l.runPulumiCmdSync(ctx, "version")
 	if err != nil {
 		return semver.Version{}, newAutoError(errors.Wrap(err, "could not determine pulumi version"), stdout, stderr, errCode)
@@ -496,6 +539,9 @@ func (l *LocalWorkspace) getPulumiVersion(ctx context.Context) (semver.Version,
 	if err != nil {
 		return semver.Version{}, newAutoError(errors.Wrap(err, "could not determine pulumi version"), stdout, stderr, errCode)
 	}
+	if cacheable {
+		pulumiVersions.Store(binary, version)
+	}
 	return version, nil
 }
 
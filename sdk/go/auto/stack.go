@@ -100,7 +100,6 @@ import (
 	"sync"
 
 	pbempty "github.com/golang/protobuf/ptypes/empty"
-	"github.com/nxadm/tail"
 	"github.com/pkg/errors"
 	"google.golang.org/grpc"
 
@@ -258,7 +257,9 @@ func (s *Stack) Preview(ctx context.Context, opts ...optpreview.Option) (Preview
 
 	var summaryEvents []apitype.SummaryEvent
 	eventChannel := make(chan events.EngineEvent)
+	eventsDone := make(chan struct{})
 	go func(ch chan events.EngineEvent, events *[]apitype.SummaryEvent) {
+		defer close(eventsDone)
 		for {
 			event, ok := <-eventChannel
 			if !ok {
@@ -277,10 +278,14 @@ func (s *Stack) Preview(ctx context.Context, opts ...optpreview.Option) (Preview
 	if err != nil {
 		return res, errors.Wrap(err, "failed to tail logs")
 	}
-	defer cleanup(t, eventChannels)
-	args = append(args, "--event-log", t.Filename)
+	args = append(args, "--event-log", t.Filename())
 
 	stdout, stderr, code, err := s.runPulumiCmdSync(ctx, preOpts.ProgressStreams /* additionalOutput */, args...)
+
+	// Wait for the summary to arrive before looking for it.
+	cleanup(t, eventChannels)
+	<-eventsDone
+
 	if err != nil {
 		return res, newAutoError(errors.Wrap(err, "failed to run preview"), stdout, stderr, code)
 	}
@@ -356,7 +361,7 @@ func (s *Stack) Up(ctx context.Context, opts ...optup.Option) (UpResult, error)
 			return res, errors.Wrap(err, "failed to tail logs")
 		}
 		defer cleanup(t, eventChannels)
-		args = append(args, "--event-log", t.Filename)
+		args = append(args, "--event-log", t.Filename())
 	}
 
 	args = append(args, sharedArgs...)
@@ -365,26 +370,32 @@ func (s *Stack) Up(ctx context.Context, opts ...optup.Option) (UpResult, error)
 		return res, newAutoError(errors.Wrap(err, "failed to run update"), stdout, stderr, code)
 	}
 
-	outs, err := s.Outputs(ctx)
-	if err != nil {
-		return res, err
+	// The outputs and the summary are read by separate commands that do not depend on one another, so run them
+	// concurrently rather than paying for each command's startup in turn.
+	var outs OutputMap
+	var outsErr error
+	var wg sync.WaitGroup
+	wg.Add(1)
+	go func() {
+		defer wg.Done()
+		outs, outsErr = s.Outputs(ctx)
+	}()
+	summary, err := s.summary(ctx)
+	wg.Wait()
+	if outsErr != nil {
+		return res, outsErr
 	}
-
-	history, err := s.History(ctx, 1 /*pageSize*/, 1 /*page*/)
 	if err != nil {
 		return res, err
 	}
 
 	res = UpResult{
 		Outputs: outs,
+		Summary: summary,
 		StdOut:  stdout,
 		StdErr:  stderr,
 	}
 
-	if len(history) > 0 {
-		res.Summary = history[0]
-	}
-
 	return res, nil
 }
 
@@ -430,7 +441,7 @@ func (s *Stack) Refresh(ctx context.Context, opts ...optrefresh.Option) (Refresh
 			return res, errors.Wrap(err, "failed to tail logs")
 		}
 		defer cleanup(t, eventChannels)
-		args = append(args, "--event-log", t.Filename)
+		args = append(args, "--event-log", t.Filename())
 	}
 
 	stdout, stderr, code, err := s.runPulumiCmdSync(ctx, refreshOpts.ProgressStreams, args...)
@@ -438,16 +449,11 @@ func (s *Stack) Refresh(ctx context.Context, opts ...optrefresh.Option) (Refresh
 		return res, newAutoError(errors.Wrap(err, "failed to refresh stack"), stdout, stderr, code)
 	}
 
-	history, err := s.History(ctx, 1 /*pageSize*/, 1 /*page*/)
+	summary, err := s.summary(ctx)
 	if err != nil {
 		return res, errors.Wrap(err, "failed to refresh stack")
 	}
 
-	var summary UpdateSummary
-	if len(history) > 0 {
-		summary = history[0]
-	}
-
 	res = RefreshResult{
 		Summary: summary,
 		StdOut:  stdout,
@@ -498,7 +504,7 @@ func (s *Stack) Destroy(ctx context.Context, opts ...optdestroy.Option) (Destroy
 			return res, errors.Wrap(err, "failed to tail logs")
 		}
 		defer cleanup(t, eventChannels)
-		args = append(args, "--event-log", t.Filename)
+		args = append(args, "--event-log", t.Filename())
 	}
 
 	stdout, stderr, code, err := s.runPulumiCmdSync(ctx, destroyOpts.ProgressStreams, args...)
@@ -506,16 +512,11 @@ func (s *Stack) Destroy(ctx context.Context, opts ...optdestroy.Option) (Destroy
 		return res, newAutoError(errors.Wrap(err, "failed to destroy stack"), stdout, stderr, code)
 	}
 
-	history, err := s.History(ctx, 1 /*pageSize*/, 1 /*page*/)
+	summary, err := s.summary(ctx)
 	if err != nil {
 		return res, errors.Wrap(err, "failed to destroy stack")
 	}
 
-	var summary UpdateSummary
-	if len(history) > 0 {
-		summary = history[0]
-	}
-
 	res = DestroyResult{
 		Summary: summary,
 		StdOut:  stdout,
@@ -537,6 +538,20 @@ func (s *Stack) History(ctx context.Context, pageSize int, page int) ([]UpdateSu
 	if err != nil {
 		return nil, errors.Wrap(err, "failed to get stack history")
 	}
+	return s.history(ctx, pageSize, page)
+}
+
+// summary returns the summary of the stack's most recent operation. Unlike History, it does not select the stack
+// first: it is only used after an operation on the stack, and the history command names the stack explicitly.
+func (s *Stack) summary(ctx context.Context) (UpdateSummary, error) {
+	history, err := s.history(ctx, 1 /*pageSize*/, 1 /*page*/)
+	if err != nil || len(history) == 0 {
+		return UpdateSummary{}, err
+	}
+	return history[0], nil
+}
+
+func (s *Stack) history(ctx context.Context, pageSize int, page int) ([]UpdateSummary, error) {
 	args := []string{"stack", "history", "--json", "--show-secrets"}
 	if pageSize > 0 {
 		// default page=1 if unset when pageSize is set
@@ -959,14 +974,14 @@ func (s *languageRuntimeServer) GetPluginInfo(ctx context.Context, req *pbempty.
 	}, nil
 }
 
-func tailLogs(command string, receivers []chan<- events.EngineEvent) (*tail.Tail, error) {
+func tailLogs(command string, receivers []chan<- events.EngineEvent) (eventWatcher, error) {
 	logDir, err := ioutil.TempDir("", fmt.Sprintf("automation-logs-%s-", command))
 	if err != nil {
 		return nil, errors.Wrap(err, "failed to create logdir")
 	}
 	logFile := filepath.Join(logDir, "eventlog.txt")
 
-	t, err := watchFile(logFile, receivers)
+	t, err := watchEvents(logFile, receivers)
 	if err != nil {
 		return nil, errors.Wrap(err, "failed to watch file")
 	}
@@ -974,9 +989,9 @@ func tailLogs(command string, receivers []chan<- events.EngineEvent) (*tail.Tail
 	return t, nil
 }
 
-func cleanup(t *tail.Tail, channels []chan<- events.EngineEvent) {
-	logDir := filepath.Dir(t.Filename)
-	t.Cleanup()
+func cleanup(t eventWatcher, channels []chan<- events.EngineEvent) {
+	logDir := filepath.Dir(t.Filename())
+	t.Close()
 	os.RemoveAll(logDir)
 	for _, ch := range channels {
 		close(ch)
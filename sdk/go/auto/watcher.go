@@ -11,17 +11,42 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+
 package auto
 
 import (
 	"encoding/json"
+	"io"
+	"io/ioutil"
+
 	"github.com/nxadm/tail"
 
 	"github.com/pulumi/pulumi/sdk/v3/go/auto/events"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
 )
 
-func watchFile(path string, receivers []chan<- events.EngineEvent) (*tail.Tail, error) {
+// eventWatcher delivers the engine events that the CLI writes to its event log to a set of receivers.
+type eventWatcher interface {
+	// Filename returns the path that the CLI should write its event log to.
+	Filename() string
+	// Close stops watching the event log. It must only be called once the CLI has exited.
+	Close()
+}
+
+// tailWatcher watches an event log by tailing the file that the CLI writes it to.
+type tailWatcher struct {
+	*tail.Tail
+}
+
+func (w tailWatcher) Filename() string {
+	return w.Tail.Filename
+}
+
+func (w tailWatcher) Close() {
+	w.Tail.Cleanup()
+}
+
+func watchFile(path string, receivers []chan<- events.EngineEvent) (eventWatcher, error) {
 	t, err := tail.TailFile(path, tail.Config{
 		Follow: true,
 		Logger: tail.DiscardingLogger,
@@ -50,5 +75,27 @@ func watchFile(path string, receivers []chan<- events.EngineEvent) (*tail.Tail,
 			}
 		}
 	}(t)
-	return t, nil
+	return tailWatcher{Tail: t}, nil
+}
+
+// readEvents decodes the events in an event log as they are written and delivers them to a set of receivers. The
+// log is read no faster than the receivers accept events, so a slow receiver holds back the CLI rather than letting
+// the log grow without bound. If the log is malformed, the error is delivered and the rest of the log is discarded.
+func readEvents(log io.Reader, receivers []chan<- events.EngineEvent) {
+	decoder := json.NewDecoder(log)
+	for {
+		var e apitype.EngineEvent
+		if err := decoder.Decode(&e); err != nil {
+			if err != io.EOF {
+				for _, r := range receivers {
+					r <- events.EngineEvent{Error: err}
+				}
+				_, _ = io.Copy(ioutil.Discard, log)
+			}
+			return
+		}
+		for _, r := range receivers {
+			r <- events.EngineEvent{EngineEvent: e}
+		}
+	}
 }
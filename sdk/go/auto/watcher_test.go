@@ -0,0 +1,111 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// +build !windows
+
+package auto
+
+import (
+	"encoding/json"
+	"fmt"
+	"os"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/auto/events"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/apitype"
+)
+
+// collectEvents receives events until the channel is closed.
+func collectEvents(ch <-chan events.EngineEvent) <-chan []events.EngineEvent {
+	result := make(chan []events.EngineEvent)
+	go func() {
+		var received []events.EngineEvent
+		for e := range ch {
+			received = append(received, e)
+		}
+		result <- received
+	}()
+	return result
+}
+
+func TestPipeWatcherDeliversEveryEvent(t *testing.T) {
+	ch := make(chan events.EngineEvent)
+	received := collectEvents(ch)
+
+	channels := []chan<- events.EngineEvent{ch}
+	w, err := tailLogs("test", channels)
+	assert.NoError(t, err)
+	assert.IsType(t, &pipeWatcher{}, w)
+
+	// Write the event log as the CLI does.
+	const count = 1000
+	log, err := os.Create(w.Filename())
+	assert.NoError(t, err)
+	encoder := json.NewEncoder(log)
+	for i := 0; i < count; i++ {
+		assert.NoError(t, encoder.Encode(apitype.EngineEvent{
+			Sequence:    i,
+			StdoutEvent: &apitype.StdoutEngineEvent{Message: fmt.Sprintf("message %d", i)},
+		}))
+	}
+	assert.NoError(t, log.Close())
+
+	// Every event is delivered before the receivers are closed.
+	cleanup(w, channels)
+	all := <-received
+	assert.Len(t, all, count)
+	for i, e := range all {
+		assert.NoError(t, e.Error)
+		assert.Equal(t, i, e.Sequence)
+	}
+
+	_, err = os.Stat(w.Filename())
+	assert.True(t, os.IsNotExist(err))
+}
+
+func TestPipeWatcherWithoutEventLog(t *testing.T) {
+	ch := make(chan events.EngineEvent)
+	received := collectEvents(ch)
+
+	// The CLI may exit without ever opening the event log.
+	channels := []chan<- events.EngineEvent{ch}
+	w, err := tailLogs("test", channels)
+	assert.NoError(t, err)
+	cleanup(w, channels)
+	assert.Empty(t, <-received)
+}
+
+func TestPipeWatcherReportsMalformedEvents(t *testing.T) {
+	ch := make(chan events.EngineEvent)
+	received := collectEvents(ch)
+
+	channels := []chan<- events.EngineEvent{ch}
+	w, err := tailLogs("test", channels)
+	assert.NoError(t, err)
+
+	log, err := os.Create(w.Filename())
+	assert.NoError(t, err)
+	_, err = log.WriteString("{\"sequence\": 0}\n{\"sequence\": \n{\"sequence\": 2}\n")
+	assert.NoError(t, err)
+	assert.NoError(t, log.Close())
+
+	cleanup(w, channels)
+	all := <-received
+	if assert.Len(t, all, 2) {
+		assert.NoError(t, all[0].Error)
+		assert.Error(t, all[1].Error)
+	}
+}
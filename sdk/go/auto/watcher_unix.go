@@ -0,0 +1,72 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// +build !windows
+
+package auto
+
+import (
+	"os"
+	"syscall"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/auto/events"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
+)
+
+// watchEvents delivers the events that the CLI writes to the event log at the given path to a set of receivers. The
+// event log is a named pipe, so events flow straight from the CLI to the receivers without touching the disk. If a
+// pipe cannot be created, the log falls back to a file that is tailed.
+func watchEvents(path string, receivers []chan<- events.EngineEvent) (eventWatcher, error) {
+	if err := syscall.Mkfifo(path, 0600); err != nil {
+		return watchFile(path, receivers)
+	}
+
+	// Open both ends of the pipe up front. Holding the write end open keeps the reader from seeing the end of the log
+	// before the CLI has opened it, and opening the read end first keeps the CLI from blocking when it opens the log.
+	log, err := os.OpenFile(path, os.O_RDONLY|syscall.O_NONBLOCK, 0)
+	if err != nil {
+		return nil, err
+	}
+	writer, err := os.OpenFile(path, os.O_WRONLY|syscall.O_NONBLOCK, 0)
+	if err != nil {
+		contract.IgnoreClose(log)
+		return nil, err
+	}
+
+	w := &pipeWatcher{path: path, writer: writer, done: make(chan struct{})}
+	go func() {
+		defer close(w.done)
+		defer contract.IgnoreClose(log)
+		readEvents(log, receivers)
+	}()
+	return w, nil
+}
+
+// pipeWatcher reads an event log from a named pipe.
+type pipeWatcher struct {
+	path   string
+	writer *os.File      // the write end of the pipe that is held open until the CLI has exited.
+	done   chan struct{} // closed once every event in the log has been delivered.
+}
+
+func (w *pipeWatcher) Filename() string {
+	return w.path
+}
+
+// Close waits for every event that the CLI wrote to be delivered. Once the CLI has exited, the watcher holds the
+// only write end of the pipe, so closing it lets the reader drain the pipe and reach the end of the log.
+func (w *pipeWatcher) Close() {
+	contract.IgnoreClose(w.writer)
+	<-w.done
+}
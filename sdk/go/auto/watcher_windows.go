@@ -0,0 +1,27 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// +build windows
+
+package auto
+
+import (
+	"github.com/pulumi/pulumi/sdk/v3/go/auto/events"
+)
+
+// watchEvents delivers the events that the CLI writes to the event log at the given path to a set of receivers by
+// tailing the log file.
+func watchEvents(path string, receivers []chan<- events.EngineEvent) (eventWatcher, error) {
+	return watchFile(path, receivers)
+}
@@ -121,6 +121,15 @@ type SecretsProvidersV1 struct {
 	State json.RawMessage `json:"state,omitempty"`
 }
 
+// StackOutputsV1 is the serialized form of the outputs of a stack's root resource. It carries the stack's secrets
+// provider so that secret outputs can be decrypted without loading the stack's deployment.
+type StackOutputsV1 struct {
+	// SecretsProviders is the secrets provider that encrypted the secret outputs, if any.
+	SecretsProviders *SecretsProvidersV1 `json:"secrets_providers,omitempty" yaml:"secrets_providers,omitempty"`
+	// Outputs holds the serialized outputs of the stack's root resource.
+	Outputs map[string]interface{} `json:"outputs,omitempty" yaml:"outputs,omitempty"`
+}
+
 // OperationType is the type of an operation initiated by the engine. Its value indicates the type of operation
 // that the engine initiated.
 type OperationType string
@@ -156,6 +165,52 @@ type OperationV2 struct {
 	Type OperationType `json:"type" yaml:"type"`
 }
 
+// CheckpointDeltaKind identifies the kind of mutation recorded by a CheckpointDeltaRecordV1.
+type CheckpointDeltaKind string
+
+const (
+	// CheckpointDeltaAppend appends a new resource to the deployment's list of resources produced by the current
+	// update. Resources produced by the current update precede any resources carried over from the base deployment.
+	CheckpointDeltaAppend CheckpointDeltaKind = "append"
+	// CheckpointDeltaRewrite replaces the contents of a resource that is already part of the deployment.
+	CheckpointDeltaRewrite CheckpointDeltaKind = "rewrite"
+	// CheckpointDeltaRemove removes a resource that was carried over from the base deployment.
+	CheckpointDeltaRemove CheckpointDeltaKind = "remove"
+	// CheckpointDeltaBeginOperation records a new pending operation.
+	CheckpointDeltaBeginOperation CheckpointDeltaKind = "beginOperation"
+	// CheckpointDeltaEndOperation retires a pending operation.
+	CheckpointDeltaEndOperation CheckpointDeltaKind = "endOperation"
+)
+
+// CheckpointDeltaRecordV1 is a single mutation of a deployment.
+//
+// Resources and operations are identified by journal IDs. The resources and pending operations of the base
+// deployment that a delta applies to are numbered by their position in the deployment, starting at zero; each
+// subsequent append or beginOperation record allocates the next resource or operation ID, respectively.
+type CheckpointDeltaRecordV1 struct {
+	// Kind is the kind of mutation.
+	Kind CheckpointDeltaKind `json:"kind" yaml:"kind"`
+	// ID is the journal ID of the resource (or, for operation records, the operation) this record applies to.
+	ID int `json:"id" yaml:"id"`
+	// URN is the URN of the resource this record applies to. It is informational only.
+	URN resource.URN `json:"urn,omitempty" yaml:"urn,omitempty"`
+	// Resource is the new state of the resource for append, rewrite, and beginOperation records.
+	Resource *ResourceV3 `json:"resource,omitempty" yaml:"resource,omitempty"`
+	// OperationType is the type of the operation for beginOperation records.
+	OperationType OperationType `json:"operationType,omitempty" yaml:"operationType,omitempty"`
+}
+
+// CheckpointDeltaV1 is an ordered set of mutations to be applied to a base deployment.
+type CheckpointDeltaV1 struct {
+	// Sequence is the sequence number of this delta. Sequence numbers increase monotonically within an update.
+	Sequence int `json:"sequence" yaml:"sequence"`
+	// AppendIndex is the index in the base deployment's resource list at which appended resources are inserted. The
+	// resources that precede this index were produced by the update that produced the delta.
+	AppendIndex int `json:"appendIndex" yaml:"appendIndex"`
+	// Records are the mutations contained in this delta, in the order in which they must be applied.
+	Records []CheckpointDeltaRecordV1 `json:"records,omitempty" yaml:"records,omitempty"`
+}
+
 // UntypedDeployment contains an inner, untyped deployment structure.
 type UntypedDeployment struct {
 	// Version indicates the schema of the encoded deployment.
@@ -289,6 +344,9 @@ type ResourceV3 struct {
 	CustomTimeouts *resource.CustomTimeouts `json:"customTimeouts,omitempty" yaml:"customTimeouts,omitempty"`
 	// ImportID is the import input used for imported resources.
 	ImportID resource.ID `json:"importID,omitempty" yaml:"importID,omitempty"`
+	// DiffFingerprint is the fingerprint of the arguments to the last diff of this resource that found no changes. If
+	// the next diff of the resource has the same fingerprint, the engine knows its result without asking the provider.
+	DiffFingerprint string `json:"diffFingerprint,omitempty" yaml:"diffFingerprint,omitempty"`
 }
 
 // ManifestV1 captures meta-information about this checkpoint file, such as versions of binaries, etc.
@@ -77,9 +77,41 @@ type DecryptValueResponse struct {
 	Plaintext []byte `json:"plaintext"`
 }
 
+// BatchEncryptRequest defines the request body for encrypting many values at once.
+type BatchEncryptRequest struct {
+	// The values to encrypt.
+	Plaintexts [][]byte `json:"plaintexts"`
+}
+
+// BatchEncryptResponse defines the response body for a batch of encrypted values.
+type BatchEncryptResponse struct {
+	// The encrypted values, in the same order as the request's plaintexts.
+	Ciphertexts [][]byte `json:"ciphertexts"`
+}
+
+// BatchDecryptRequest defines the request body for decrypting many values at once.
+type BatchDecryptRequest struct {
+	// The values to decrypt.
+	Ciphertexts [][]byte `json:"ciphertexts"`
+}
+
+// BatchDecryptResponse defines the response body for a batch of decrypted values.
+type BatchDecryptResponse struct {
+	// The decrypted values, in the same order as the request's ciphertexts.
+	Plaintexts [][]byte `json:"plaintexts"`
+}
+
 // ExportStackResponse defines the response body for exporting a Stack.
 type ExportStackResponse UntypedDeployment
 
+// ExportStackOutputsResponse defines the response body for exporting the outputs of a Stack.
+type ExportStackOutputsResponse struct {
+	// Version is the version of the stack's checkpoint that the outputs were read from.
+	Version int `json:"version"`
+
+	StackOutputsV1
+}
+
 // ImportStackRequest defines the request body for importing a Stack.
 type ImportStackRequest UntypedDeployment
 
@@ -210,6 +210,14 @@ type PatchUpdateCheckpointRequest struct {
 	Deployment json.RawMessage `json:"deployment,omitempty"`
 }
 
+// PatchUpdateCheckpointDeltaRequest defines the body of a request to the patch update checkpoint delta endpoint of the
+// service API. The `Delta` field is expected to contain a serialized `CheckpointDelta` value, the schema of which is
+// indicated by the `Version` field. The delta applies on top of the checkpoint most recently sent for the update.
+type PatchUpdateCheckpointDeltaRequest struct {
+	Version int             `json:"version"`
+	Delta   json.RawMessage `json:"delta"`
+}
+
 // AppendUpdateLogEntryRequest defines the body of a request to the append update log entry endpoint of the service API.
 // No longer sent from the CLI, but the type definition is still required for backwards compat with older clients.
 type AppendUpdateLogEntryRequest struct {
@@ -0,0 +1,164 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package resource
+
+import (
+	"io"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"sync"
+
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
+)
+
+// Reader returns a stream of the archive's contents in the desired format. Unlike Bytes, the archive is produced as
+// the stream is read, so it is never held in memory in its entirety. The caller must close the stream; closing it
+// before it has been drained stops producing the archive.
+func (a *Archive) Reader(format ArchiveFormat) (io.ReadCloser, error) {
+	// If the source format is the same, just return that.
+	sf, ss, err := a.ReadSourceArchive()
+	if err != nil {
+		return nil, err
+	}
+	if sf != NotArchive && sf == format {
+		return ss, nil
+	}
+	if ss != nil {
+		contract.IgnoreClose(ss)
+	}
+	if _, err := archiveFormatExt(format); err != nil {
+		return nil, err
+	}
+
+	r, w := io.Pipe()
+	go func() {
+		w.CloseWithError(a.Archive(format, w))
+	}()
+	return r, nil
+}
+
+// ArchiveFileCache materializes archives as files on disk, once per archive hash and format. Providers that need
+// seekable or repeatable access to an archive's contents (e.g. to upload it) can use the cache rather than holding the
+// result of Bytes in memory, and archives that are shared by several resources are only produced once. An
+// ArchiveFileCache is safe for concurrent use.
+type ArchiveFileCache struct {
+	dir string
+
+	m     sync.Mutex
+	files map[string]*archiveFile
+}
+
+// archiveFile is an archive that has been, or is being, written to the cache.
+type archiveFile struct {
+	once sync.Once
+	path string
+	err  error
+}
+
+// NewArchiveFileCache creates a new cache that stores archives in the given directory, which is created if necessary.
+func NewArchiveFileCache(dir string) (*ArchiveFileCache, error) {
+	if err := os.MkdirAll(dir, 0700); err != nil {
+		return nil, errors.Wrap(err, "creating archive cache directory")
+	}
+	return &ArchiveFileCache{dir: dir, files: map[string]*archiveFile{}}, nil
+}
+
+// Open returns an open file that holds the contents of the given archive in the desired format, producing the file if
+// it is not already cached. The caller must close the file. Archives whose source is already a file in the desired
+// format are opened directly rather than copied.
+func (c *ArchiveFileCache) Open(a *Archive, format ArchiveFormat) (*os.File, error) {
+	if path, ispath := a.GetPath(); ispath && detectArchiveFormat(path) == format {
+		return os.Open(path)
+	}
+
+	if err := a.EnsureHash(); err != nil {
+		return nil, err
+	}
+	ext, err := archiveFormatExt(format)
+	if err != nil {
+		return nil, err
+	}
+	name := a.Hash + ext
+
+	c.m.Lock()
+	file, ok := c.files[name]
+	if !ok {
+		file = &archiveFile{path: filepath.Join(c.dir, name)}
+		c.files[name] = file
+	}
+	c.m.Unlock()
+
+	file.once.Do(func() {
+		file.err = writeArchiveFile(a, format, file.path)
+	})
+	if file.err != nil {
+		return nil, file.err
+	}
+	return os.Open(file.path)
+}
+
+// Close removes every archive in the cache. Files that are still open remain readable on platforms that permit it.
+func (c *ArchiveFileCache) Close() error {
+	c.m.Lock()
+	defer c.m.Unlock()
+
+	var result error
+	for name, file := range c.files {
+		if err := os.Remove(file.path); err != nil && !os.IsNotExist(err) && result == nil {
+			result = err
+		}
+		delete(c.files, name)
+	}
+	return result
+}
+
+// writeArchiveFile writes the given archive to the given path in the desired format. The archive is written to a
+// temporary file that is then renamed into place.
+func writeArchiveFile(a *Archive, format ArchiveFormat, path string) error {
+	temp, err := ioutil.TempFile(filepath.Dir(path), filepath.Base(path)+".*")
+	if err != nil {
+		return errors.Wrap(err, "creating archive file")
+	}
+	err = a.Archive(format, temp)
+	if closeErr := temp.Close(); err == nil {
+		err = closeErr
+	}
+	if err == nil {
+		err = os.Rename(temp.Name(), path)
+	}
+	if err != nil {
+		contract.IgnoreError(os.Remove(temp.Name()))
+		return errors.Wrap(err, "writing archive file")
+	}
+	return nil
+}
+
+// archiveFormatExt returns the canonical file extension for the given archive format. Only the formats that Archive can
+// produce are supported.
+func archiveFormatExt(format ArchiveFormat) (string, error) {
+	switch format {
+	case TarArchive:
+		return ".tar", nil
+	case TarGZIPArchive:
+		return ".tgz", nil
+	case ZIPArchive:
+		return ".zip", nil
+	default:
+		return "", errors.Errorf("unsupported archive type: %v", format)
+	}
+}
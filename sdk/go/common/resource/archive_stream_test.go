@@ -0,0 +1,112 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package resource
+
+import (
+	"archive/tar"
+	"compress/gzip"
+	"io"
+	"io/ioutil"
+	"os"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func TestArchiveReader(t *testing.T) {
+	arch, err := NewPathArchive("../../../../pkg/resource/testdata/test_dir")
+	assert.NoError(t, err)
+
+	// The streamed archive matches the materialized one.
+	expected, err := arch.Bytes(ZIPArchive)
+	assert.NoError(t, err)
+	r, err := arch.Reader(ZIPArchive)
+	assert.NoError(t, err)
+	actual, err := ioutil.ReadAll(r)
+	assert.NoError(t, err)
+	assert.NoError(t, r.Close())
+	assert.Equal(t, expected, actual)
+
+	// Streamed TGZ archives are complete.
+	r, err = arch.Reader(TarGZIPArchive)
+	assert.NoError(t, err)
+	z, err := gzip.NewReader(r)
+	assert.NoError(t, err)
+	tr := tar.NewReader(z)
+	count := 0
+	for {
+		_, err := tr.Next()
+		if err == io.EOF {
+			break
+		}
+		assert.NoError(t, err)
+		count++
+	}
+	assert.Equal(t, 3, count)
+	assert.NoError(t, z.Close())
+	assert.NoError(t, r.Close())
+
+	// Closing a stream early stops it.
+	r, err = arch.Reader(TarArchive)
+	assert.NoError(t, err)
+	assert.NoError(t, r.Close())
+
+	// Only the formats that can be produced are supported.
+	_, err = arch.Reader(JARArchive)
+	assert.Error(t, err)
+}
+
+func TestArchiveFileCache(t *testing.T) {
+	dir, err := ioutil.TempDir("", "")
+	assert.NoError(t, err)
+	defer os.RemoveAll(dir)
+
+	cache, err := NewArchiveFileCache(dir)
+	assert.NoError(t, err)
+
+	arch, err := NewPathArchive("../../../../pkg/resource/testdata/test_dir")
+	assert.NoError(t, err)
+	expected, err := arch.Bytes(ZIPArchive)
+	assert.NoError(t, err)
+
+	// Archives with the same hash share a file.
+	var paths []string
+	for i := 0; i < 2; i++ {
+		a, err := NewPathArchive("../../../../pkg/resource/testdata/test_dir")
+		assert.NoError(t, err)
+		f, err := cache.Open(a, ZIPArchive)
+		assert.NoError(t, err)
+		actual, err := ioutil.ReadAll(f)
+		assert.NoError(t, err)
+		assert.Equal(t, expected, actual)
+		assert.NoError(t, f.Close())
+		paths = append(paths, f.Name())
+	}
+	assert.Equal(t, paths[0], paths[1])
+
+	// Archives that are already in the desired format are opened directly.
+	tarPath := "../../../../pkg/resource/testdata/test_dir.tar"
+	tarArch, err := NewPathArchive(tarPath)
+	assert.NoError(t, err)
+	f, err := cache.Open(tarArch, TarArchive)
+	assert.NoError(t, err)
+	assert.Equal(t, tarPath, f.Name())
+	assert.NoError(t, f.Close())
+
+	// Closing the cache removes its files.
+	assert.NoError(t, cache.Close())
+	_, err = os.Stat(paths[0])
+	assert.True(t, os.IsNotExist(err))
+}
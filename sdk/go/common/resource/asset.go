@@ -30,6 +30,7 @@ import (
 	"path/filepath"
 	"reflect"
 	"regexp"
+	"runtime"
 	"sort"
 	"strings"
 	"time"
@@ -381,25 +382,53 @@ func (a *Asset) readURI() (*Blob, error) {
 	}
 }
 
-// EnsureHash computes the SHA256 hash of the asset's contents and stores it on the object.
+// EnsureHash computes the SHA256 hash of the asset's contents and stores it on the object. If the asset hash cache is
+// enabled, the hashes of path-based assets are cached.
 func (a *Asset) EnsureHash() error {
 	if a.Hash == "" {
-		blob, err := a.Read()
+		key, stamp := a.hashCacheStamp()
+		hash, err := cachedHash(key, stamp, a.computeHash)
 		if err != nil {
 			return err
 		}
-		defer contract.IgnoreClose(blob)
-
-		hash := sha256.New()
-		_, err = io.Copy(hash, blob)
-		if err != nil {
-			return err
-		}
-		a.Hash = hex.EncodeToString(hash.Sum(nil))
+		a.Hash = hash
 	}
 	return nil
 }
 
+// hashCacheStamp returns the hash cache key and stamp for the asset. The stamp is empty if the asset's hash must not
+// be cached.
+func (a *Asset) hashCacheStamp() (string, string) {
+	path, ispath := a.GetPath()
+	if !ispath {
+		return "", ""
+	}
+	key, ok := hashCacheKey("asset", path)
+	if !ok {
+		return "", ""
+	}
+	info, err := os.Stat(path)
+	if err != nil || !info.Mode().IsRegular() {
+		return "", ""
+	}
+	return key, fileStamp(info)
+}
+
+func (a *Asset) computeHash() (string, error) {
+	blob, err := a.Read()
+	if err != nil {
+		return "", err
+	}
+	defer contract.IgnoreClose(blob)
+
+	hash := sha256.New()
+	_, err = io.Copy(hash, blob)
+	if err != nil {
+		return "", err
+	}
+	return hex.EncodeToString(hash.Sum(nil)), nil
+}
+
 // Blob is a blob that implements ReadCloser and offers Len functionality.
 type Blob struct {
 	rd io.ReadCloser // an underlying reader.
@@ -702,7 +731,8 @@ func (r *assetsArchiveReader) Next() (string, *Blob, error) {
 			name, blob, err := r.archive.Next()
 			switch {
 			case err == io.EOF:
-				// The subarchive is complete. Nil it out and continue on.
+				// The subarchive is complete. Close it, nil it out and continue on.
+				contract.IgnoreClose(r.archive)
 				r.archive = nil
 			case err != nil:
 				// The subarchive produced a legitimate error; return it.
@@ -769,25 +799,104 @@ func (a *Archive) readAssets() (ArchiveReader, error) {
 	return r, nil
 }
 
+// maxPrefetchedFileSize is the size of the largest file that a directory archive reader reads ahead of time. Larger
+// files are streamed from disk once they are reached.
+const maxPrefetchedFileSize = 1 << 20
+
+// directoryArchiveMember is a file in a directory archive.
+type directoryArchiveMember struct {
+	path string
+	info os.FileInfo
+}
+
+// prefetchedMember is the result of reading a directory archive member ahead of time.
+type prefetchedMember struct {
+	blob *Blob
+	err  error
+}
+
 // directoryArchiveReader is used to read an archive that is represented by a directory in the host filesystem.
+//
+// Archives of large directories are often made up of many small files (e.g. node_modules), for which the cost of
+// reading each file dominates. The reader therefore reads the members that follow the current one in parallel, up to
+// a small window, while preserving the order in which members are returned.
 type directoryArchiveReader struct {
 	directoryPath string
-	assetPaths    []string
+	members       []directoryArchiveMember
+
+	next    int                     // the index of the next member to return.
+	results []chan prefetchedMember // the prefetched members, indexed by position.
+	window  chan struct{}           // limits the number of members read ahead of the next member.
+	done    chan struct{}           // closed when the reader is closed.
+	stopped chan struct{}           // closed once the prefetcher has stopped.
+	started int                     // the number of members the prefetcher started reading. Valid once stopped.
+	closed  bool
+}
+
+func newDirectoryArchiveReader(directoryPath string, members []directoryArchiveMember) *directoryArchiveReader {
+	r := &directoryArchiveReader{
+		directoryPath: directoryPath,
+		members:       members,
+		results:       make([]chan prefetchedMember, len(members)),
+		window:        make(chan struct{}, 4*runtime.NumCPU()),
+		done:          make(chan struct{}),
+		stopped:       make(chan struct{}),
+	}
+	for i := range r.results {
+		r.results[i] = make(chan prefetchedMember, 1)
+	}
+	go r.prefetch()
+	return r
+}
+
+func (r *directoryArchiveReader) prefetch() {
+	defer close(r.stopped)
+
+	for i, m := range r.members {
+		select {
+		case r.window <- struct{}{}:
+		case <-r.done:
+			return
+		}
+
+		r.started = i + 1
+		go func(result chan<- prefetchedMember, m directoryArchiveMember) {
+			var blob *Blob
+			var err error
+			if m.info.Size() <= maxPrefetchedFileSize {
+				var data []byte
+				if data, err = ioutil.ReadFile(m.path); err == nil {
+					blob = NewByteBlob(data)
+				} else {
+					err = errors.Wrapf(err, "failed to read asset file '%v'", m.path)
+				}
+			} else {
+				blob, err = (&Asset{Path: m.path}).Read()
+			}
+			result <- prefetchedMember{blob: blob, err: err}
+		}(r.results[i], m)
+	}
 }
 
 func (r *directoryArchiveReader) Next() (string, *Blob, error) {
 	// If there are no more members in this archive, return io.EOF.
-	if len(r.assetPaths) == 0 {
+	if r.closed || r.next == len(r.members) {
 		return "", nil, io.EOF
 	}
 
-	// Fetch the next path in the archive and slice it off of the list.
-	assetPath := r.assetPaths[0]
-	r.assetPaths = r.assetPaths[1:]
+	// Fetch the next member in the archive and wait for its contents.
+	m, result := r.members[r.next], r.results[r.next]
+	r.next++
+	prefetched := <-result
+	<-r.window
+	if prefetched.err != nil {
+		return "", nil, prefetched.err
+	}
 
 	// Crop the asset's path s.t. it is relative to the directory path.
-	name, err := filepath.Rel(r.directoryPath, assetPath)
+	name, err := filepath.Rel(r.directoryPath, m.path)
 	if err != nil {
+		contract.IgnoreClose(prefetched.blob)
 		return "", nil, err
 	}
 	name = filepath.Clean(name)
@@ -795,82 +904,107 @@ func (r *directoryArchiveReader) Next() (string, *Blob, error) {
 	// Replace Windows separators with Linux ones (ToSlash is a no-op on Linux)
 	name = filepath.ToSlash(name)
 
-	// Open and return the blob.
-	blob, err := (&Asset{Path: assetPath}).Read()
-	if err != nil {
-		return "", nil, err
-	}
-	return name, blob, nil
+	return name, prefetched.blob, nil
 }
 
 func (r *directoryArchiveReader) Close() error {
+	if r.closed {
+		return nil
+	}
+	r.closed = true
+
+	// Stop the prefetcher and release any members that it read but that were never returned.
+	close(r.done)
+	<-r.stopped
+	for i := r.next; i < r.started; i++ {
+		if prefetched := <-r.results[i]; prefetched.blob != nil {
+			contract.IgnoreClose(prefetched.blob)
+		}
+	}
 	return nil
 }
 
-func (a *Archive) readPath() (ArchiveReader, error) {
-	// To read a path-based archive, read that file and use its extension to ascertain what format to use.
-	path, ispath := a.GetPath()
-	contract.Assertf(ispath, "Expected a path-based asset")
+// readDirectoryArchiveMembers returns the files in the directory archive at the given path. The files are ordered
+// deterministically by filepath.Walk.
+func readDirectoryArchiveMembers(path string) ([]directoryArchiveMember, error) {
+	members := []directoryArchiveMember{}
+	if walkerr := filepath.Walk(path, func(filePath string, f os.FileInfo, fileerr error) error {
+		// If there was an error, exit.
+		if fileerr != nil {
+			return fileerr
+		}
 
-	format := detectArchiveFormat(path)
+		// If this is a .pulumi directory, we will skip this by default.
+		// TODO[pulumi/pulumi#122]: when we support .pulumiignore, this will be customizable.
+		if f.Name() == BookkeepingDir {
+			if f.IsDir() {
+				return filepath.SkipDir
+			}
+			return nil
+		}
 
-	if format == NotArchive {
-		// If not an archive, it could be a directory; if so, simply expand it out uncompressed as an archive.
-		info, err := os.Stat(path)
-		if err != nil {
-			return nil, errors.Wrapf(err, "couldn't read archive path '%v'", path)
-		} else if !info.IsDir() {
-			return nil, errors.Errorf("'%v' is neither a recognized archive type nor a directory", path)
+		// If this was a directory, skip it.
+		if f.IsDir() {
+			return nil
 		}
 
-		// Accumulate the list of asset paths. This list is ordered deterministically by filepath.Walk.
-		assetPaths := []string{}
-		if walkerr := filepath.Walk(path, func(filePath string, f os.FileInfo, fileerr error) error {
-			// If there was an error, exit.
-			if fileerr != nil {
-				return fileerr
+		// If this is a symlink and it points at a directory, skip it. Otherwise continue along. This will mean
+		// that the file will be added to the list of files to archive. When you go to read this archive, you'll
+		// get a copy of the file (instead of a symlink) to some other file in the archive.
+		if f.Mode()&os.ModeSymlink != 0 {
+			fileInfo, statErr := os.Stat(filePath)
+			if statErr != nil {
+				return statErr
 			}
 
-			// If this is a .pulumi directory, we will skip this by default.
-			// TODO[pulumi/pulumi#122]: when we support .pulumiignore, this will be customizable.
-			if f.Name() == BookkeepingDir {
-				if f.IsDir() {
-					return filepath.SkipDir
-				}
+			if fileInfo.IsDir() {
 				return nil
 			}
+			f = fileInfo
+		}
 
-			// If this was a directory, skip it.
-			if f.IsDir() {
-				return nil
-			}
+		// Otherwise, add this asset to the list of members and keep going.
+		members = append(members, directoryArchiveMember{path: filePath, info: f})
+		return nil
+	}); walkerr != nil {
+		return nil, walkerr
+	}
+	return members, nil
+}
 
-			// If this is a symlink and it points at a directory, skip it. Otherwise continue along. This will mean
-			// that the file will be added to the list of files to archive. When you go to read this archive, you'll
-			// get a copy of the file (instead of a symlink) to some other file in the archive.
-			if f.Mode()&os.ModeSymlink != 0 {
-				fileInfo, statErr := os.Stat(filePath)
-				if statErr != nil {
-					return statErr
-				}
+// isDirectory returns true if the archive is a path-based archive that refers to a directory rather than to an
+// archive file.
+func (a *Archive) isDirectory() (bool, error) {
+	path, ispath := a.GetPath()
+	if !ispath || detectArchiveFormat(path) != NotArchive {
+		return false, nil
+	}
 
-				if fileInfo.IsDir() {
-					return nil
-				}
-			}
+	info, err := os.Stat(path)
+	if err != nil {
+		return false, errors.Wrapf(err, "couldn't read archive path '%v'", path)
+	} else if !info.IsDir() {
+		return false, errors.Errorf("'%v' is neither a recognized archive type nor a directory", path)
+	}
+	return true, nil
+}
 
-			// Otherwise, add this asset to the list of paths and keep going.
-			assetPaths = append(assetPaths, filePath)
-			return nil
-		}); walkerr != nil {
-			return nil, walkerr
-		}
+func (a *Archive) readPath() (ArchiveReader, error) {
+	// To read a path-based archive, read that file and use its extension to ascertain what format to use.
+	path, ispath := a.GetPath()
+	contract.Assertf(ispath, "Expected a path-based asset")
 
-		r := &directoryArchiveReader{
-			directoryPath: path,
-			assetPaths:    assetPaths,
+	// If not an archive, it could be a directory; if so, simply expand it out uncompressed as an archive.
+	isDir, err := a.isDirectory()
+	if err != nil {
+		return nil, err
+	}
+	if isDir {
+		members, err := readDirectoryArchiveMembers(path)
+		if err != nil {
+			return nil, err
 		}
-		return r, nil
+		return newDirectoryArchiveReader(path, members), nil
 	}
 
 	// Otherwise, it's an archive file, and we will go ahead and open it up and read it.
@@ -878,7 +1012,7 @@ func (a *Archive) readPath() (ArchiveReader, error) {
 	if err != nil {
 		return nil, err
 	}
-	return readArchive(file, format)
+	return readArchive(file, detectArchiveFormat(path))
 }
 
 func (a *Archive) readURI() (ArchiveReader, error) {
@@ -936,7 +1070,11 @@ func (a *Archive) Bytes(format ArchiveFormat) ([]byte, error) {
 // copying as is feasible, however if the desired format is different from the source, it will need to translate.
 func (a *Archive) Archive(format ArchiveFormat, w io.Writer) error {
 	// If the source format is the same, just return that.
-	if sf, ss, err := a.ReadSourceArchive(); sf != NotArchive && sf == format {
+	sf, ss, err := a.ReadSourceArchive()
+	if ss != nil {
+		defer contract.IgnoreClose(ss)
+	}
+	if sf != NotArchive && sf == format {
 		if err != nil {
 			return err
 		}
@@ -1012,7 +1150,10 @@ func (a *Archive) archiveTar(w io.Writer) error {
 
 func (a *Archive) archiveTarGZIP(w io.Writer) error {
 	z := gzip.NewWriter(w)
-	return a.archiveTar(z)
+	if err := a.archiveTar(z); err != nil {
+		return err
+	}
+	return z.Close()
 }
 
 // addNextFileToZIP adds the next file in the given archive to the given ZIP file. Returns io.EOF if the archive
@@ -1090,38 +1231,83 @@ func (a *Archive) ReadSourceArchive() (ArchiveFormat, io.ReadCloser, error) {
 	return NotArchive, nil, nil
 }
 
-// EnsureHash computes the SHA256 hash of the archive's contents and stores it on the object.
+// EnsureHash computes the SHA256 hash of the archive's contents and stores it on the object. If the asset hash cache
+// is enabled, the hashes of path-based archives are cached.
 func (a *Archive) EnsureHash() error {
 	if a.Hash == "" {
-		hash := sha256.New()
-
-		// Attempt to compute the hash in the most efficient way.  First try to open the archive directly and copy it
-		// to the hash.  This avoids traversing any of the contents and just treats it as a byte stream.
-		f, r, err := a.ReadSourceArchive()
+		key, stamp, err := a.hashCacheStamp()
 		if err != nil {
 			return err
 		}
-		if f != NotArchive && r != nil {
-			defer contract.IgnoreClose(r)
-			_, err = io.Copy(hash, r)
-			if err != nil {
-				return err
-			}
-		} else {
-			// Otherwise, it's not an archive; we'll need to transform it into one.  Pick tar since it avoids
-			// any superfluous compression which doesn't actually help us in this situation.
-			err := a.Archive(TarArchive, hash)
-			if err != nil {
-				return err
-			}
+		hash, err := cachedHash(key, stamp, a.computeHash)
+		if err != nil {
+			return err
 		}
-
-		// Finally, encode the resulting hash as a string and we're done.
-		a.Hash = hex.EncodeToString(hash.Sum(nil))
+		a.Hash = hash
 	}
 	return nil
 }
 
+// hashCacheStamp returns the hash cache key and stamp for the archive. The stamp is empty if the archive's hash must
+// not be cached. The stamp of a directory archive covers each of its members; determining it only requires walking
+// the directory, not reading its files.
+func (a *Archive) hashCacheStamp() (string, string, error) {
+	path, ispath := a.GetPath()
+	if !ispath {
+		return "", "", nil
+	}
+	key, ok := hashCacheKey("archive", path)
+	if !ok {
+		return "", "", nil
+	}
+
+	isDir, err := a.isDirectory()
+	if err != nil {
+		return "", "", err
+	}
+	if !isDir {
+		info, err := os.Stat(path)
+		if err != nil || !info.Mode().IsRegular() {
+			return "", "", nil
+		}
+		return key, fileStamp(info), nil
+	}
+
+	members, err := readDirectoryArchiveMembers(path)
+	if err != nil {
+		return "", "", err
+	}
+	return key, directoryStamp(path, members), nil
+}
+
+func (a *Archive) computeHash() (string, error) {
+	hash := sha256.New()
+
+	// Attempt to compute the hash in the most efficient way.  First try to open the archive directly and copy it
+	// to the hash.  This avoids traversing any of the contents and just treats it as a byte stream.
+	f, r, err := a.ReadSourceArchive()
+	if err != nil {
+		return "", err
+	}
+	if f != NotArchive && r != nil {
+		defer contract.IgnoreClose(r)
+		_, err = io.Copy(hash, r)
+		if err != nil {
+			return "", err
+		}
+	} else {
+		// Otherwise, it's not an archive; we'll need to transform it into one.  Pick tar since it avoids
+		// any superfluous compression which doesn't actually help us in this situation.
+		err := a.Archive(TarArchive, hash)
+		if err != nil {
+			return "", err
+		}
+	}
+
+	// Finally, encode the resulting hash as a string and we're done.
+	return hex.EncodeToString(hash.Sum(nil)), nil
+}
+
 // ArchiveFormat indicates what archive and/or compression format an archive uses.
 type ArchiveFormat int
 
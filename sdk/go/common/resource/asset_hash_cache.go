@@ -0,0 +1,257 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package resource
+
+import (
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"sync"
+	"time"
+
+	"github.com/pkg/errors"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
+)
+
+const (
+	// hashCacheFormatVersion is the version of the on-disk hash cache format. Caches with a different version are
+	// ignored.
+	hashCacheFormatVersion = 1
+
+	// maxHashCacheEntries is the number of entries past which entries that were not used by this process are dropped
+	// when the cache is saved.
+	maxHashCacheEntries = 10000
+
+	// hashCacheRacyWindow is how recently a file must have been modified for its hash not to be cached. A file that
+	// is modified again within the resolution of its file system's timestamps would otherwise go unnoticed.
+	hashCacheRacyWindow = 2 * time.Second
+)
+
+// hashCacheEntry records the hash of a file or directory along with a stamp that describes its state on disk when it
+// was hashed. The hash is only reused while the stamp still matches.
+type hashCacheEntry struct {
+	Stamp string `json:"stamp"`
+	Hash  string `json:"hash"`
+
+	used bool
+}
+
+// hashCacheFile is the on-disk format of the hash cache.
+type hashCacheFile struct {
+	Version int                        `json:"version"`
+	Entries map[string]*hashCacheEntry `json:"entries"`
+}
+
+// hashCache is a persistent cache of the hashes of path-based assets and archives, keyed by absolute path and
+// invalidated by each file's size, modification time and inode.
+type hashCache struct {
+	m sync.Mutex
+
+	path    string
+	loaded  bool
+	dirty   bool
+	entries map[string]*hashCacheEntry
+}
+
+var (
+	assetHashCacheLock sync.Mutex
+	assetHashCache     *hashCache
+)
+
+// EnableAssetHashCache enables the persistent cache of asset and archive hashes, which is stored at the given path.
+// The cache is loaded on first use; FlushAssetHashCache must be called to save any new entries.
+func EnableAssetHashCache(path string) {
+	assetHashCacheLock.Lock()
+	defer assetHashCacheLock.Unlock()
+
+	assetHashCache = &hashCache{path: path}
+}
+
+// FlushAssetHashCache saves any new entries in the persistent cache of asset and archive hashes.
+func FlushAssetHashCache() error {
+	if c := getAssetHashCache(); c != nil {
+		return c.save()
+	}
+	return nil
+}
+
+func getAssetHashCache() *hashCache {
+	assetHashCacheLock.Lock()
+	defer assetHashCacheLock.Unlock()
+
+	return assetHashCache
+}
+
+// cachedHash returns the hash for the given key, computing it if the cache is disabled or if the key's entry does
+// not have the given stamp. An empty stamp indicates that the hash must not be cached.
+func cachedHash(key, stamp string, compute func() (string, error)) (string, error) {
+	c := getAssetHashCache()
+	if c == nil || stamp == "" {
+		return compute()
+	}
+
+	if hash, ok := c.get(key, stamp); ok {
+		logging.V(9).Infof("using cached hash for %s", key)
+		return hash, nil
+	}
+
+	hash, err := compute()
+	if err != nil {
+		return "", err
+	}
+	c.put(key, stamp, hash)
+	return hash, nil
+}
+
+func (c *hashCache) get(key, stamp string) (string, bool) {
+	c.m.Lock()
+	defer c.m.Unlock()
+
+	c.load()
+	entry, ok := c.entries[key]
+	if !ok || entry.Stamp != stamp {
+		return "", false
+	}
+	entry.used = true
+	return entry.Hash, true
+}
+
+func (c *hashCache) put(key, stamp, hash string) {
+	c.m.Lock()
+	defer c.m.Unlock()
+
+	c.load()
+	c.entries[key] = &hashCacheEntry{Stamp: stamp, Hash: hash, used: true}
+	c.dirty = true
+}
+
+// load reads the cache from disk if it has not yet been read. Must be called with the cache's lock held.
+func (c *hashCache) load() {
+	if c.loaded {
+		return
+	}
+	c.loaded = true
+	c.entries = map[string]*hashCacheEntry{}
+
+	// A missing or unreadable cache is treated as empty.
+	b, err := ioutil.ReadFile(c.path)
+	if err != nil {
+		if !os.IsNotExist(err) {
+			logging.V(5).Infof("failed to read hash cache %s: %v", c.path, err)
+		}
+		return
+	}
+	var file hashCacheFile
+	if err = json.Unmarshal(b, &file); err != nil || file.Version != hashCacheFormatVersion {
+		logging.V(5).Infof("ignoring invalid hash cache %s", c.path)
+		return
+	}
+	for key, entry := range file.Entries {
+		if entry != nil {
+			c.entries[key] = entry
+		}
+	}
+}
+
+// save writes the cache to disk if it has changed. The cache is written to a temporary file that is then renamed into
+// place so that concurrent processes never observe a partially-written cache.
+func (c *hashCache) save() error {
+	c.m.Lock()
+	defer c.m.Unlock()
+
+	if !c.dirty {
+		return nil
+	}
+
+	entries := c.entries
+	if len(entries) > maxHashCacheEntries {
+		entries = map[string]*hashCacheEntry{}
+		for key, entry := range c.entries {
+			if entry.used {
+				entries[key] = entry
+			}
+		}
+	}
+
+	b, err := json.Marshal(hashCacheFile{Version: hashCacheFormatVersion, Entries: entries})
+	if err != nil {
+		return err
+	}
+	if err = os.MkdirAll(filepath.Dir(c.path), 0700); err != nil {
+		return errors.Wrap(err, "creating hash cache directory")
+	}
+	temp, err := ioutil.TempFile(filepath.Dir(c.path), filepath.Base(c.path)+".*")
+	if err != nil {
+		return errors.Wrap(err, "creating hash cache")
+	}
+	_, err = temp.Write(b)
+	if closeErr := temp.Close(); err == nil {
+		err = closeErr
+	}
+	if err == nil {
+		err = os.Rename(temp.Name(), c.path)
+	}
+	if err != nil {
+		_ = os.Remove(temp.Name())
+		return errors.Wrap(err, "writing hash cache")
+	}
+
+	c.dirty = false
+	return nil
+}
+
+// hashCacheKey returns the cache key for the asset or archive of the given kind at the given path.
+func hashCacheKey(kind, path string) (string, bool) {
+	abs, err := filepath.Abs(path)
+	if err != nil {
+		return "", false
+	}
+	return kind + ":" + abs, true
+}
+
+// fileStamp returns the stamp for a file with the given info. If the file has been modified very recently, the stamp
+// is empty so that its hash is not cached.
+func fileStamp(info os.FileInfo) string {
+	mtime := info.ModTime()
+	if time.Since(mtime) < hashCacheRacyWindow {
+		return ""
+	}
+	return fmt.Sprintf("%d:%d:%d", info.Size(), mtime.UnixNano(), fileID(info))
+}
+
+// directoryStamp returns the stamp for a directory archive with the given members. The stamp is empty if any member's
+// stamp is empty.
+func directoryStamp(dir string, members []directoryArchiveMember) string {
+	hash := sha256.New()
+	for _, m := range members {
+		stamp := fileStamp(m.info)
+		if stamp == "" {
+			return ""
+		}
+		name, err := filepath.Rel(dir, m.path)
+		if err != nil {
+			return ""
+		}
+		_, err = fmt.Fprintf(hash, "%s\x00%s\n", filepath.ToSlash(name), stamp)
+		contract.IgnoreError(err)
+	}
+	return hex.EncodeToString(hash.Sum(nil))
+}
@@ -0,0 +1,151 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package resource
+
+import (
+	"encoding/json"
+	"fmt"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// writeOldFile writes the given file and backdates it so that its hash may be cached.
+func writeOldFile(t *testing.T, path, contents string) {
+	assert.NoError(t, os.MkdirAll(filepath.Dir(path), 0700))
+	assert.NoError(t, ioutil.WriteFile(path, []byte(contents), 0600))
+	old := time.Now().Add(-time.Hour)
+	assert.NoError(t, os.Chtimes(path, old, old))
+}
+
+// replaceCachedHashes rewrites every hash in the cache at the given path, so that tests can tell whether a hash was
+// computed or read from the cache.
+func replaceCachedHashes(t *testing.T, path, hash string) {
+	b, err := ioutil.ReadFile(path)
+	assert.NoError(t, err)
+	var file hashCacheFile
+	assert.NoError(t, json.Unmarshal(b, &file))
+	for _, entry := range file.Entries {
+		entry.Hash = hash
+	}
+	b, err = json.Marshal(file)
+	assert.NoError(t, err)
+	assert.NoError(t, ioutil.WriteFile(path, b, 0600))
+}
+
+func withAssetHashCache(t *testing.T, path string, f func()) {
+	EnableAssetHashCache(path)
+	defer func() {
+		assetHashCacheLock.Lock()
+		assetHashCache = nil
+		assetHashCacheLock.Unlock()
+	}()
+	f()
+	assert.NoError(t, FlushAssetHashCache())
+}
+
+func TestAssetHashCache(t *testing.T) {
+	dir, err := ioutil.TempDir("", "")
+	assert.NoError(t, err)
+	defer os.RemoveAll(dir)
+
+	cachePath := filepath.Join(dir, "cache", "hashes.json")
+	assetPath := filepath.Join(dir, "asset.txt")
+	writeOldFile(t, assetPath, "hello")
+
+	var hash string
+	withAssetHashCache(t, cachePath, func() {
+		asset, err := NewPathAsset(assetPath)
+		assert.NoError(t, err)
+		hash = asset.Hash
+	})
+	assert.Equal(t, "2cf24dba5fb0a30e26e83b2ac5b9e29e1b161e5c1fa7425e73043362938b9824", hash)
+
+	// The hash of the unchanged file is read from the cache.
+	replaceCachedHashes(t, cachePath, "cached")
+	withAssetHashCache(t, cachePath, func() {
+		asset, err := NewPathAsset(assetPath)
+		assert.NoError(t, err)
+		assert.Equal(t, "cached", asset.Hash)
+	})
+
+	// Changing the file invalidates its entry.
+	writeOldFile(t, assetPath, "goodbye")
+	withAssetHashCache(t, cachePath, func() {
+		asset, err := NewPathAsset(assetPath)
+		assert.NoError(t, err)
+		assert.Equal(t, "82e35a63ceba37e9646434c5dd412ea577147f1e4a41ccde1614253187e3dbf9", asset.Hash)
+	})
+}
+
+func TestAssetHashCacheSkipsRecentFiles(t *testing.T) {
+	dir, err := ioutil.TempDir("", "")
+	assert.NoError(t, err)
+	defer os.RemoveAll(dir)
+
+	cachePath := filepath.Join(dir, "hashes.json")
+	assetPath := filepath.Join(dir, "asset.txt")
+	assert.NoError(t, ioutil.WriteFile(assetPath, []byte("hello"), 0600))
+
+	withAssetHashCache(t, cachePath, func() {
+		_, err := NewPathAsset(assetPath)
+		assert.NoError(t, err)
+	})
+	_, err = os.Stat(cachePath)
+	assert.True(t, os.IsNotExist(err))
+}
+
+func TestArchiveHashCache(t *testing.T) {
+	dir, err := ioutil.TempDir("", "")
+	assert.NoError(t, err)
+	defer os.RemoveAll(dir)
+
+	cachePath := filepath.Join(dir, "hashes.json")
+	archivePath := filepath.Join(dir, "archive")
+	for i := 0; i < 10; i++ {
+		writeOldFile(t, filepath.Join(archivePath, fmt.Sprintf("dir%d", i%3), fmt.Sprintf("file%d.txt", i)),
+			fmt.Sprintf("file %d", i))
+	}
+
+	// The hash of a cached directory archive matches its uncached hash.
+	uncached, err := NewPathArchive(archivePath)
+	assert.NoError(t, err)
+	withAssetHashCache(t, cachePath, func() {
+		archive, err := NewPathArchive(archivePath)
+		assert.NoError(t, err)
+		assert.Equal(t, uncached.Hash, archive.Hash)
+	})
+
+	// The hash of the unchanged directory is read from the cache.
+	replaceCachedHashes(t, cachePath, "cached")
+	withAssetHashCache(t, cachePath, func() {
+		archive, err := NewPathArchive(archivePath)
+		assert.NoError(t, err)
+		assert.Equal(t, "cached", archive.Hash)
+	})
+
+	// Changing any member invalidates the directory's entry.
+	writeOldFile(t, filepath.Join(archivePath, "dir1", "file4.txt"), "changed")
+	withAssetHashCache(t, cachePath, func() {
+		archive, err := NewPathArchive(archivePath)
+		assert.NoError(t, err)
+		assert.NotEqual(t, "cached", archive.Hash)
+		assert.NotEqual(t, uncached.Hash, archive.Hash)
+	})
+}
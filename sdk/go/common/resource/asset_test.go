@@ -483,6 +483,52 @@ func TestFileExtentionSniffing(t *testing.T) {
 	assert.Equal(t, ArchiveFormat(NotArchive), detectArchiveFormat("./some/path/who.even.knows"))
 }
 
+func TestDirectoryArchiveReader(t *testing.T) {
+	dirName, err := ioutil.TempDir("", "")
+	assert.Nil(t, err)
+	defer os.RemoveAll(dirName)
+
+	// Write enough files to exceed the prefetch window, including one that is too large to prefetch.
+	const count = 200
+	for i := 0; i < count; i++ {
+		contents := []byte(fmt.Sprintf("file %d", i))
+		if i == count/2 {
+			contents = bytes.Repeat([]byte{'x'}, maxPrefetchedFileSize+1)
+		}
+		assert.NoError(t, ioutil.WriteFile(filepath.Join(dirName, fmt.Sprintf("%03d.txt", i)), contents, 0600))
+	}
+	arch, err := NewPathArchive(dirName)
+	assert.Nil(t, err)
+
+	// Members are returned in order.
+	r, err := arch.Open()
+	assert.Nil(t, err)
+	for i := 0; i < count; i++ {
+		name, blob, err := r.Next()
+		assert.NoError(t, err)
+		assert.Equal(t, fmt.Sprintf("%03d.txt", i), name)
+		if i == count/2 {
+			assert.Equal(t, int64(maxPrefetchedFileSize+1), blob.Size())
+			assert.NoError(t, blob.Close())
+		} else {
+			assertAssetBlobEquals(t, blob, fmt.Sprintf("file %d", i))
+		}
+	}
+	_, _, err = r.Next()
+	assert.Equal(t, io.EOF, err)
+	assert.NoError(t, r.Close())
+
+	// Closing a reader before it has been drained releases any prefetched members.
+	r, err = arch.Open()
+	assert.Nil(t, err)
+	_, blob, err := r.Next()
+	assert.NoError(t, err)
+	assert.NoError(t, blob.Close())
+	assert.NoError(t, r.Close())
+	_, _, err = r.Next()
+	assert.Equal(t, io.EOF, err)
+}
+
 func TestInvalidPathArchive(t *testing.T) {
 	// Create a temp file that is not an asset.
 	tmpFile, err := ioutil.TempFile("", "")
@@ -21,7 +21,9 @@ import (
 	"crypto/sha256"
 	"encoding/base64"
 	"fmt"
+	"runtime"
 	"strings"
+	"sync"
 
 	"github.com/pkg/errors"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
@@ -44,6 +46,87 @@ type Crypter interface {
 	Decrypter
 }
 
+// BatchEncrypter is an Encrypter that can encrypt many values at once, e.g. by issuing a single request to a remote
+// key service or by spreading the work across multiple goroutines.
+type BatchEncrypter interface {
+	Encrypter
+
+	// BatchEncrypt encrypts each of the given plaintexts. The returned slice holds the ciphertexts in the same order.
+	BatchEncrypt(plaintexts []string) ([]string, error)
+}
+
+// BatchDecrypter is a Decrypter that can decrypt many values at once.
+type BatchDecrypter interface {
+	Decrypter
+
+	// BatchDecrypt decrypts each of the given ciphertexts. The returned slice holds the plaintexts in the same order.
+	BatchDecrypt(ciphertexts []string) ([]string, error)
+}
+
+// BatchEncrypt encrypts the given plaintexts using the encrypter's BatchEncrypt method if it has one, and one value
+// at a time otherwise.
+func BatchEncrypt(enc Encrypter, plaintexts []string) ([]string, error) {
+	if batch, ok := enc.(BatchEncrypter); ok {
+		return batch.BatchEncrypt(plaintexts)
+	}
+	ciphertexts := make([]string, len(plaintexts))
+	for i, plaintext := range plaintexts {
+		ciphertext, err := enc.EncryptValue(plaintext)
+		if err != nil {
+			return nil, err
+		}
+		ciphertexts[i] = ciphertext
+	}
+	return ciphertexts, nil
+}
+
+// BatchDecrypt decrypts the given ciphertexts using the decrypter's BatchDecrypt method if it has one, and one value
+// at a time otherwise.
+func BatchDecrypt(dec Decrypter, ciphertexts []string) ([]string, error) {
+	if batch, ok := dec.(BatchDecrypter); ok {
+		return batch.BatchDecrypt(ciphertexts)
+	}
+	plaintexts := make([]string, len(ciphertexts))
+	for i, ciphertext := range ciphertexts {
+		plaintext, err := dec.DecryptValue(ciphertext)
+		if err != nil {
+			return nil, err
+		}
+		plaintexts[i] = plaintext
+	}
+	return plaintexts, nil
+}
+
+// parallelCrypt applies crypt to each of the given values using up to GOMAXPROCS goroutines. If any call fails, the
+// error for the lowest-indexed value is returned.
+func parallelCrypt(values []string, crypt func(string) (string, error)) ([]string, error) {
+	results := make([]string, len(values))
+	errs := make([]error, len(values))
+
+	workers := runtime.GOMAXPROCS(0)
+	if workers > len(values) {
+		workers = len(values)
+	}
+	var wg sync.WaitGroup
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func(w int) {
+			defer wg.Done()
+			for i := w; i < len(values); i += workers {
+				results[i], errs[i] = crypt(values[i])
+			}
+		}(w)
+	}
+	wg.Wait()
+
+	for _, err := range errs {
+		if err != nil {
+			return nil, err
+		}
+	}
+	return results, nil
+}
+
 // A nopCrypter simply returns the ciphertext as-is.
 type nopCrypter struct{}
 
@@ -175,6 +258,14 @@ func (s symmetricCrypter) DecryptValue(value string) (string, error) {
 	return decryptAES256GCM(enc, s.key, nonce)
 }
 
+func (s symmetricCrypter) BatchEncrypt(plaintexts []string) ([]string, error) {
+	return parallelCrypt(plaintexts, s.EncryptValue)
+}
+
+func (s symmetricCrypter) BatchDecrypt(ciphertexts []string) ([]string, error) {
+	return parallelCrypt(ciphertexts, s.DecryptValue)
+}
+
 // encryptAES256GCGM returns the ciphertext and the generated nonce
 func encryptAES256GCGM(plaintext string, key []byte) ([]byte, []byte) {
 	contract.Requiref(len(key) == SymmetricCrypterKeyBytes, "key", "AES-256-GCM needs a 32 byte key")
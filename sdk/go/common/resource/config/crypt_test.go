@@ -0,0 +1,48 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package config
+
+import (
+	"fmt"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func TestBatchCrypt(t *testing.T) {
+	plaintexts := make([]string, 100)
+	for i := range plaintexts {
+		plaintexts[i] = fmt.Sprintf("value-%d", i)
+	}
+
+	key := make([]byte, SymmetricCrypterKeyBytes)
+	for _, crypter := range []Crypter{NewSymmetricCrypter(key), newPrefixCrypter("enc:")} {
+		ciphertexts, err := BatchEncrypt(crypter, plaintexts)
+		assert.NoError(t, err)
+		assert.Len(t, ciphertexts, len(plaintexts))
+
+		decrypted, err := BatchDecrypt(crypter, ciphertexts)
+		assert.NoError(t, err)
+		assert.Equal(t, plaintexts, decrypted)
+	}
+
+	// Failures are reported for the batch as a whole.
+	_, err := BatchDecrypt(NewSymmetricCrypter(key), []string{"v1:bad", "bad"})
+	assert.Error(t, err)
+
+	empty, err := BatchEncrypt(NewSymmetricCrypter(key), nil)
+	assert.NoError(t, err)
+	assert.Empty(t, empty)
+}
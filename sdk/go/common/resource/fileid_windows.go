@@ -0,0 +1,27 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// +build windows
+
+package resource
+
+import (
+	"os"
+)
+
+// fileID returns the inode number of the file with the given info. File infos do not carry file IDs on Windows, so
+// the cache relies on each file's size and modification time alone.
+func fileID(info os.FileInfo) uint64 {
+	return 0
+}
@@ -16,6 +16,7 @@ package plugin
 
 import (
 	"os"
+	"sync"
 
 	"github.com/blang/semver"
 	"github.com/hashicorp/go-multierror"
@@ -97,7 +98,8 @@ func NewDefaultHost(ctx *Context, config ConfigSource, runtimeOptions map[string
 		languagePlugins:         make(map[string]*languagePlugin),
 		resourcePlugins:         make(map[Provider]*resourcePlugin),
 		reportedResourcePlugins: make(map[string]struct{}),
-		loadRequests:            make(chan pluginLoadRequest),
+		loads:                   make(map[pluginKey]*pluginLoad),
+		warmProviders:           make(map[pluginKey][]*pluginLoad),
 		disableProviderPreview:  disableProviderPreview,
 	}
 
@@ -109,13 +111,6 @@ func NewDefaultHost(ctx *Context, config ConfigSource, runtimeOptions map[string
 	}
 	host.server = svr
 
-	// Start a goroutine we'll use to satisfy load requests serially and avoid race conditions.
-	go func() {
-		for req := range host.loadRequests {
-			req.result <- req.load()
-		}
-	}()
-
 	return host, nil
 }
 
@@ -127,26 +122,57 @@ type PolicyAnalyzerOptions struct {
 	DryRun  bool
 }
 
-type pluginLoadRequest struct {
-	load   func() error
-	result chan<- error
+// A ProviderPrewarmer is a Host that is able to start resource provider plugins ahead of time.
+type ProviderPrewarmer interface {
+	// PrewarmProviders starts a copy of each of the given resource plugins in the background and returns
+	// immediately. The next call to Provider for the same package and version returns the pre-started copy rather
+	// than launching a new one. Plugins of other kinds are ignored.
+	PrewarmProviders(plugins []workspace.PluginInfo)
 }
 
+// pluginKey identifies a plugin by its kind, name and version.
+type pluginKey struct {
+	kind    workspace.PluginKind
+	name    string
+	version string
+}
+
+func newPluginKey(kind workspace.PluginKind, name string, version *semver.Version) pluginKey {
+	key := pluginKey{kind: kind, name: name}
+	if version != nil {
+		key.version = version.String()
+	}
+	return key
+}
+
+// pluginLoad records the progress of a plugin load. done is closed once plugin and err have been set.
+type pluginLoad struct {
+	done   chan struct{}
+	plugin interface{}
+	err    error
+}
+
+// The defaultHost launches plugins concurrently: its lock only guards its own state and is never held while a
+// plugin is starting. Concurrent requests for the same memoized plugin wait for a single load.
 type defaultHost struct {
-	ctx                     *Context                         // the shared context for this host.
-	config                  ConfigSource                     // the source for provider configuration parameters.
-	runtimeOptions          map[string]interface{}           // options to pass to the language plugins.
+	ctx                    *Context               // the shared context for this host.
+	config                 ConfigSource           // the source for provider configuration parameters.
+	runtimeOptions         map[string]interface{} // options to pass to the language plugins.
+	server                 *hostServer            // the server's RPC machinery.
+	disableProviderPreview bool                   // true if provider plugins should disable provider preview
+
+	m                       sync.Mutex                       // guards the fields below.
 	analyzerPlugins         map[tokens.QName]*analyzerPlugin // a cache of analyzer plugins and their processes.
 	languagePlugins         map[string]*languagePlugin       // a cache of language plugins and their processes.
 	resourcePlugins         map[Provider]*resourcePlugin     // the set of loaded resource plugins.
 	reportedResourcePlugins map[string]struct{}              // the set of unique resource plugins we'll report.
 	plugins                 []workspace.PluginInfo           // a list of plugins allocated by this host.
-	loadRequests            chan pluginLoadRequest           // a channel used to satisfy plugin load requests.
-	server                  *hostServer                      // the server's RPC machinery.
-	disableProviderPreview  bool                             // true if provider plugins should disable provider preview
+	loads                   map[pluginKey]*pluginLoad        // the in-progress loads of memoized plugins.
+	warmProviders           map[pluginKey][]*pluginLoad      // the providers started by PrewarmProviders.
 }
 
 var _ Host = (*defaultHost)(nil)
+var _ ProviderPrewarmer = (*defaultHost)(nil)
 
 type analyzerPlugin struct {
 	Plugin Analyzer
@@ -175,44 +201,72 @@ func (host *defaultHost) LogStatus(sev diag.Severity, urn resource.URN, msg stri
 	host.ctx.StatusDiag.Logf(sev, diag.StreamMessage(urn, msg, streamID))
 }
 
-// loadPlugin sends an appropriate load request to the plugin loader and returns the loaded plugin (if any) and error.
-func (host *defaultHost) loadPlugin(load func() (interface{}, error)) (interface{}, error) {
-	var plugin interface{}
-
-	result := make(chan error)
-	host.loadRequests <- pluginLoadRequest{
-		load: func() error {
-			p, err := load()
-			plugin = p
-			return err
-		},
-		result: result,
+// loadPlugin returns the memoized plugin identified by key, loading it if necessary. The cached function is called
+// with the host's lock held to look up a previously-loaded plugin. Otherwise, load is called without the lock held to
+// start and memoize the plugin. Concurrent loads of the same plugin are deduplicated: the first caller runs load and
+// the others wait for its result.
+func (host *defaultHost) loadPlugin(key pluginKey, cached func() (interface{}, bool),
+	load func() (interface{}, error)) (interface{}, error) {
+
+	host.m.Lock()
+	if plugin, ok := cached(); ok {
+		host.m.Unlock()
+		return plugin, nil
+	}
+	if l, ok := host.loads[key]; ok {
+		host.m.Unlock()
+		<-l.done
+		return l.plugin, l.err
 	}
-	return plugin, <-result
+	l := &pluginLoad{done: make(chan struct{})}
+	host.loads[key] = l
+	host.m.Unlock()
+
+	l.plugin, l.err = load()
+
+	host.m.Lock()
+	delete(host.loads, key)
+	host.m.Unlock()
+	close(l.done)
+
+	return l.plugin, l.err
 }
 
-func (host *defaultHost) Analyzer(name tokens.QName) (Analyzer, error) {
-	plugin, err := host.loadPlugin(func() (interface{}, error) {
-		// First see if we already loaded this plugin.
-		if plug, has := host.analyzerPlugins[name]; has {
-			contract.Assert(plug != nil)
-			return plug.Plugin, nil
+// cachedAnalyzer returns a function that looks up the named analyzer in the host's cache.
+func (host *defaultHost) cachedAnalyzer(name tokens.QName) func() (interface{}, bool) {
+	return func() (interface{}, bool) {
+		plug, has := host.analyzerPlugins[name]
+		if !has {
+			return nil, false
 		}
+		contract.Assert(plug != nil)
+		return plug.Plugin, true
+	}
+}
 
-		// If not, try to load and bind to a plugin.
-		plug, err := NewAnalyzer(host, host.ctx, name)
-		if err == nil && plug != nil {
-			info, infoerr := plug.GetPluginInfo()
-			if infoerr != nil {
-				return nil, infoerr
-			}
-
-			// Memoize the result.
-			host.plugins = append(host.plugins, info)
-			host.analyzerPlugins[name] = &analyzerPlugin{Plugin: plug, Info: info}
+// memoizeAnalyzer records a newly-loaded analyzer in the host's cache.
+func (host *defaultHost) memoizeAnalyzer(name tokens.QName, plug Analyzer, err error) (interface{}, error) {
+	if err == nil && plug != nil {
+		info, infoerr := plug.GetPluginInfo()
+		if infoerr != nil {
+			return nil, infoerr
 		}
 
-		return plug, err
+		// Memoize the result.
+		host.m.Lock()
+		host.plugins = append(host.plugins, info)
+		host.analyzerPlugins[name] = &analyzerPlugin{Plugin: plug, Info: info}
+		host.m.Unlock()
+	}
+	return plug, err
+}
+
+func (host *defaultHost) Analyzer(name tokens.QName) (Analyzer, error) {
+	key := newPluginKey(workspace.AnalyzerPlugin, string(name), nil)
+	plugin, err := host.loadPlugin(key, host.cachedAnalyzer(name), func() (interface{}, error) {
+		// If not, try to load and bind to a plugin.
+		plug, err := NewAnalyzer(host, host.ctx, name)
+		return host.memoizeAnalyzer(name, plug, err)
 	})
 	if plugin == nil || err != nil {
 		return nil, err
@@ -221,27 +275,11 @@ func (host *defaultHost) Analyzer(name tokens.QName) (Analyzer, error) {
 }
 
 func (host *defaultHost) PolicyAnalyzer(name tokens.QName, path string, opts *PolicyAnalyzerOptions) (Analyzer, error) {
-	plugin, err := host.loadPlugin(func() (interface{}, error) {
-		// First see if we already loaded this plugin.
-		if plug, has := host.analyzerPlugins[name]; has {
-			contract.Assert(plug != nil)
-			return plug.Plugin, nil
-		}
-
+	key := newPluginKey(workspace.AnalyzerPlugin, string(name), nil)
+	plugin, err := host.loadPlugin(key, host.cachedAnalyzer(name), func() (interface{}, error) {
 		// If not, try to load and bind to a plugin.
 		plug, err := NewPolicyAnalyzer(host, host.ctx, name, path, opts)
-		if err == nil && plug != nil {
-			info, infoerr := plug.GetPluginInfo()
-			if infoerr != nil {
-				return nil, infoerr
-			}
-
-			// Memoize the result.
-			host.plugins = append(host.plugins, info)
-			host.analyzerPlugins[name] = &analyzerPlugin{Plugin: plug, Info: info}
-		}
-
-		return plug, err
+		return host.memoizeAnalyzer(name, plug, err)
 	})
 	if plugin == nil || err != nil {
 		return nil, err
@@ -250,6 +288,9 @@ func (host *defaultHost) PolicyAnalyzer(name tokens.QName, path string, opts *Po
 }
 
 func (host *defaultHost) ListAnalyzers() []Analyzer {
+	host.m.Lock()
+	defer host.m.Unlock()
+
 	analyzers := []Analyzer{}
 	for _, analyzer := range host.analyzerPlugins {
 		analyzers = append(analyzers, analyzer.Plugin)
@@ -258,7 +299,62 @@ func (host *defaultHost) ListAnalyzers() []Analyzer {
 }
 
 func (host *defaultHost) Provider(pkg tokens.Package, version *semver.Version) (Provider, error) {
-	plugin, err := host.loadPlugin(func() (interface{}, error) {
+	// If a copy of this provider was started ahead of time, use it.
+	key := newPluginKey(workspace.ResourcePlugin, string(pkg), version)
+	host.m.Lock()
+	warm := host.warmProviders[key]
+	if len(warm) != 0 {
+		host.warmProviders[key] = warm[1:]
+	}
+	host.m.Unlock()
+	if len(warm) != 0 {
+		l := warm[0]
+		<-l.done
+		if l.err == nil && l.plugin != nil {
+			logging.V(7).Infof("Using pre-started resource plugin %s", key.name)
+			return l.plugin.(Provider), nil
+		}
+	}
+
+	// Provider plugins are not memoized: each call starts a new copy of the plugin.
+	return host.loadProvider(pkg, version)
+}
+
+// PrewarmProviders starts a copy of each of the given resource plugins in the background. The next call to Provider
+// for the same package and version returns the pre-started copy.
+func (host *defaultHost) PrewarmProviders(plugins []workspace.PluginInfo) {
+	for _, plugin := range plugins {
+		if plugin.Kind != workspace.ResourcePlugin {
+			continue
+		}
+
+		// Only keep a single spare copy of each plugin.
+		key := newPluginKey(workspace.ResourcePlugin, plugin.Name, plugin.Version)
+		host.m.Lock()
+		if len(host.warmProviders[key]) != 0 {
+			host.m.Unlock()
+			continue
+		}
+		l := &pluginLoad{done: make(chan struct{})}
+		host.warmProviders[key] = append(host.warmProviders[key], l)
+		host.m.Unlock()
+
+		logging.V(7).Infof("Pre-starting resource plugin %s", key.name)
+		go func(pkg tokens.Package, version *semver.Version) {
+			defer close(l.done)
+			plug, err := host.loadProvider(pkg, version)
+			if err != nil {
+				// The error will be reported if and when the provider is actually requested.
+				logging.V(7).Infof("Failed to pre-start resource plugin %s: %v", pkg, err)
+			}
+			l.plugin, l.err = plug, err
+		}(tokens.Package(plugin.Name), plugin.Version)
+	}
+}
+
+// loadProvider starts a new copy of the given provider plugin.
+func (host *defaultHost) loadProvider(pkg tokens.Package, version *semver.Version) (Provider, error) {
+	plugin, err := func() (interface{}, error) {
 		// Try to load and bind to a plugin.
 		plug, err := NewProvider(host, host.ctx, pkg, version, host.runtimeOptions, host.disableProviderPreview)
 		if err == nil && plug != nil {
@@ -288,16 +384,18 @@ func (host *defaultHost) Provider(pkg tokens.Package, version *semver.Version) (
 			if info.Version != nil {
 				key += info.Version.String()
 			}
+			host.m.Lock()
 			_, alreadyReported := host.reportedResourcePlugins[key]
 			if !alreadyReported {
 				host.reportedResourcePlugins[key] = struct{}{}
 				host.plugins = append(host.plugins, info)
 			}
 			host.resourcePlugins[plug] = &resourcePlugin{Plugin: plug, Info: info}
+			host.m.Unlock()
 		}
 
 		return plug, err
-	})
+	}()
 	if plugin == nil || err != nil {
 		return nil, err
 	}
@@ -305,13 +403,17 @@ func (host *defaultHost) Provider(pkg tokens.Package, version *semver.Version) (
 }
 
 func (host *defaultHost) LanguageRuntime(runtime string) (LanguageRuntime, error) {
-	plugin, err := host.loadPlugin(func() (interface{}, error) {
+	key := newPluginKey(workspace.LanguagePlugin, runtime, nil)
+	cached := func() (interface{}, bool) {
 		// First see if we already loaded this plugin.
-		if plug, has := host.languagePlugins[runtime]; has {
-			contract.Assert(plug != nil)
-			return plug.Plugin, nil
+		plug, has := host.languagePlugins[runtime]
+		if !has {
+			return nil, false
 		}
-
+		contract.Assert(plug != nil)
+		return plug.Plugin, true
+	}
+	plugin, err := host.loadPlugin(key, cached, func() (interface{}, error) {
 		// If not, allocate a new one.
 		plug, err := NewLanguageRuntime(host, host.ctx, runtime, host.runtimeOptions)
 		if err == nil && plug != nil {
@@ -321,8 +423,10 @@ func (host *defaultHost) LanguageRuntime(runtime string) (LanguageRuntime, error
 			}
 
 			// Memoize the result.
+			host.m.Lock()
 			host.plugins = append(host.plugins, info)
 			host.languagePlugins[runtime] = &languagePlugin{Plugin: plug, Info: info}
+			host.m.Unlock()
 		}
 
 		return plug, err
@@ -334,73 +438,114 @@ func (host *defaultHost) LanguageRuntime(runtime string) (LanguageRuntime, error
 }
 
 func (host *defaultHost) ListPlugins() []workspace.PluginInfo {
-	return host.plugins
+	host.m.Lock()
+	defer host.m.Unlock()
+
+	return append([]workspace.PluginInfo(nil), host.plugins...)
 }
 
 // EnsurePlugins ensures all plugins in the given array are loaded and ready to use.  If any plugins are missing,
-// and/or there are errors loading one or more plugins, a non-nil error is returned.
+// and/or there are errors loading one or more plugins, a non-nil error is returned. The plugins are loaded
+// concurrently.
 func (host *defaultHost) EnsurePlugins(plugins []workspace.PluginInfo, kinds Flags) error {
-	// Use a multieerror to track failures so we can return one big list of all failures at the end.
-	var result error
-	for _, plugin := range plugins {
+	errs := make([]error, len(plugins))
+	var wg sync.WaitGroup
+	for i, plugin := range plugins {
+		plugin := plugin
+
+		var load func() error
 		switch plugin.Kind {
 		case workspace.AnalyzerPlugin:
 			if kinds&AnalyzerPlugins != 0 {
-				if _, err := host.Analyzer(tokens.QName(plugin.Name)); err != nil {
-					result = multierror.Append(result,
-						errors.Wrapf(err, "failed to load analyzer plugin %s", plugin.Name))
+				load = func() error {
+					_, err := host.Analyzer(tokens.QName(plugin.Name))
+					return errors.Wrapf(err, "failed to load analyzer plugin %s", plugin.Name)
 				}
 			}
 		case workspace.LanguagePlugin:
 			if kinds&LanguagePlugins != 0 {
-				if _, err := host.LanguageRuntime(plugin.Name); err != nil {
-					result = multierror.Append(result,
-						errors.Wrapf(err, "failed to load language plugin %s", plugin.Name))
+				load = func() error {
+					_, err := host.LanguageRuntime(plugin.Name)
+					return errors.Wrapf(err, "failed to load language plugin %s", plugin.Name)
 				}
 			}
 		case workspace.ResourcePlugin:
 			if kinds&ResourcePlugins != 0 {
-				if _, err := host.Provider(tokens.Package(plugin.Name), plugin.Version); err != nil {
-					result = multierror.Append(result,
-						errors.Wrapf(err, "failed to load resource plugin %s", plugin.Name))
+				load = func() error {
+					_, err := host.Provider(tokens.Package(plugin.Name), plugin.Version)
+					return errors.Wrapf(err, "failed to load resource plugin %s", plugin.Name)
 				}
 			}
 		default:
 			contract.Failf("unexpected plugin kind: %s", plugin.Kind)
 		}
+		if load == nil {
+			continue
+		}
+
+		wg.Add(1)
+		go func(i int, load func() error) {
+			defer wg.Done()
+			errs[i] = load()
+		}(i, load)
 	}
+	wg.Wait()
 
+	// Use a multieerror to track failures so we can return one big list of all failures at the end.
+	var result error
+	for _, err := range errs {
+		if err != nil {
+			result = multierror.Append(result, err)
+		}
+	}
 	return result
 }
 
 func (host *defaultHost) SignalCancellation() error {
-	// NOTE: we're abusing loadPlugin in order to ensure proper synchronization.
-	_, err := host.loadPlugin(func() (interface{}, error) {
-		var result error
-		for _, plug := range host.resourcePlugins {
-			if err := plug.Plugin.SignalCancellation(); err != nil {
-				result = multierror.Append(result, errors.Wrapf(err,
-					"Error signaling cancellation to resource provider '%s'", plug.Info.Name))
-			}
+	host.m.Lock()
+	plugins := make([]*resourcePlugin, 0, len(host.resourcePlugins))
+	for _, plug := range host.resourcePlugins {
+		plugins = append(plugins, plug)
+	}
+	host.m.Unlock()
+
+	var result error
+	for _, plug := range plugins {
+		if err := plug.Plugin.SignalCancellation(); err != nil {
+			result = multierror.Append(result, errors.Wrapf(err,
+				"Error signaling cancellation to resource provider '%s'", plug.Info.Name))
 		}
-		return nil, result
-	})
-	return err
+	}
+	return result
 }
 
 func (host *defaultHost) CloseProvider(provider Provider) error {
-	// NOTE: we're abusing loadPlugin in order to ensure proper synchronization.
-	_, err := host.loadPlugin(func() (interface{}, error) {
-		if err := provider.Close(); err != nil {
-			return nil, err
-		}
-		delete(host.resourcePlugins, provider)
-		return nil, nil
-	})
-	return err
+	if err := provider.Close(); err != nil {
+		return err
+	}
+
+	host.m.Lock()
+	delete(host.resourcePlugins, provider)
+	host.m.Unlock()
+	return nil
 }
 
 func (host *defaultHost) Close() error {
+	// Wait for any providers that are still starting so that they are closed along with the rest.
+	host.m.Lock()
+	var warm []*pluginLoad
+	for _, loads := range host.warmProviders {
+		warm = append(warm, loads...)
+	}
+	host.warmProviders = make(map[pluginKey][]*pluginLoad)
+	host.m.Unlock()
+	for _, l := range warm {
+		<-l.done
+	}
+
+	host.m.Lock()
+	defer host.m.Unlock()
+
 	// Close all plugins.
 	for _, plug := range host.analyzerPlugins {
 		if err := plug.Plugin.Close(); err != nil {
@@ -423,9 +568,6 @@ func (host *defaultHost) Close() error {
 	host.languagePlugins = make(map[string]*languagePlugin)
 	host.resourcePlugins = make(map[Provider]*resourcePlugin)
 
-	// Shut down the plugin loader.
-	close(host.loadRequests)
-
 	// Finally, shut down the host's gRPC server.
 	return host.server.Cancel()
 }
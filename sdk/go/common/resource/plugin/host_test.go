@@ -0,0 +1,93 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package plugin
+
+import (
+	"sync"
+	"sync/atomic"
+	"testing"
+
+	"github.com/pkg/errors"
+	"github.com/stretchr/testify/assert"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/workspace"
+)
+
+func TestLoadPluginDeduplicatesConcurrentLoads(t *testing.T) {
+	host := &defaultHost{loads: make(map[pluginKey]*pluginLoad)}
+	key := newPluginKey(workspace.LanguagePlugin, "test", nil)
+
+	var cache interface{}
+	cached := func() (interface{}, bool) { return cache, cache != nil }
+
+	var loads int32
+	release := make(chan struct{})
+	load := func() (interface{}, error) {
+		atomic.AddInt32(&loads, 1)
+		<-release
+		host.m.Lock()
+		cache = "plugin"
+		host.m.Unlock()
+		return "plugin", nil
+	}
+
+	const callers = 8
+	var started, wg sync.WaitGroup
+	results := make([]interface{}, callers)
+	for i := 0; i < callers; i++ {
+		started.Add(1)
+		wg.Add(1)
+		go func(i int) {
+			defer wg.Done()
+			started.Done()
+			plugin, err := host.loadPlugin(key, cached, load)
+			assert.NoError(t, err)
+			results[i] = plugin
+		}(i)
+	}
+	started.Wait()
+	close(release)
+	wg.Wait()
+
+	assert.Equal(t, int32(1), atomic.LoadInt32(&loads))
+	for _, plugin := range results {
+		assert.Equal(t, "plugin", plugin)
+	}
+	assert.Empty(t, host.loads)
+
+	// Once memoized, the plugin is returned without loading it again.
+	plugin, err := host.loadPlugin(key, cached, load)
+	assert.NoError(t, err)
+	assert.Equal(t, "plugin", plugin)
+	assert.Equal(t, int32(1), atomic.LoadInt32(&loads))
+}
+
+func TestLoadPluginRetriesFailedLoads(t *testing.T) {
+	host := &defaultHost{loads: make(map[pluginKey]*pluginLoad)}
+	key := newPluginKey(workspace.AnalyzerPlugin, "test", nil)
+	cached := func() (interface{}, bool) { return nil, false }
+
+	calls := 0
+	load := func() (interface{}, error) {
+		calls++
+		return nil, errors.New("failed")
+	}
+
+	_, err := host.loadPlugin(key, cached, load)
+	assert.Error(t, err)
+	_, err = host.loadPlugin(key, cached, load)
+	assert.Error(t, err)
+	assert.Equal(t, 2, calls)
+}
@@ -0,0 +1,313 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package resource
+
+import (
+	"fmt"
+	"math"
+	"strconv"
+)
+
+// PropertyFingerprint is a hash of the contents of a property value or map. Fingerprints are stable across processes
+// and platforms, so they may be persisted and compared against fingerprints computed later. Two values with the same
+// fingerprint are deeply equal barring a hash collision; values that are deeply equal usually, but not always, have
+// the same fingerprint (e.g. an asset whose hash has not yet been computed fingerprints differently from one whose
+// hash has, and DeepEquals ignores an output whose key is missing from the other map, but the fingerprint does not).
+// The zero fingerprint denotes the absence of a fingerprint.
+type PropertyFingerprint uint64
+
+// String returns the fingerprint as a hexadecimal string.
+func (f PropertyFingerprint) String() string {
+	return strconv.FormatUint(uint64(f), 16)
+}
+
+// ParsePropertyFingerprint parses a fingerprint that was formatted by PropertyFingerprint.String.
+func ParsePropertyFingerprint(s string) (PropertyFingerprint, error) {
+	f, err := strconv.ParseUint(s, 16, 64)
+	if err != nil {
+		return 0, fmt.Errorf("invalid property fingerprint %q", s)
+	}
+	return PropertyFingerprint(f), nil
+}
+
+// Fingerprint computes the fingerprint of the property map. The fingerprint does not depend on the order in which the
+// map's keys are visited, and, as with DeepEquals, keys whose values are null do not contribute to it.
+//
+// Secret values contribute their plaintext to the fingerprint, so secret reports whether the map contains a secret. A
+// fingerprint that covers secrets must not be persisted anywhere the secrets themselves would be encrypted.
+func (props PropertyMap) Fingerprint() (fingerprint PropertyFingerprint, secret bool) {
+	f := Fingerprinter{h: fingerprintOffset}
+	f.hashObject(props)
+	return f.Sum(), f.secret
+}
+
+// Fingerprint computes the fingerprint of the property value. See PropertyMap.Fingerprint for details.
+func (v PropertyValue) Fingerprint() (fingerprint PropertyFingerprint, secret bool) {
+	f := Fingerprinter{h: fingerprintOffset}
+	f.hashValue(v)
+	return f.Sum(), f.secret
+}
+
+// Fingerprinter computes a fingerprint over a sequence of values, e.g. the several inputs of an operation whose
+// result is to be remembered. The zero value is not ready for use; call NewFingerprinter or NewExactFingerprinter
+// instead.
+type Fingerprinter struct {
+	h      uint64
+	secret bool
+	exact  bool
+}
+
+// NewFingerprinter returns a Fingerprinter that has not yet been given any values.
+func NewFingerprinter() *Fingerprinter {
+	return &Fingerprinter{h: fingerprintOffset}
+}
+
+// NewExactFingerprinter returns a Fingerprinter that also distinguishes values that are deeply equal but are written
+// differently, e.g. a key whose value is null from a missing key, positive from negative zero, or two assets with the
+// same hash but different contents. Use it when the fingerprint guards a cache of the values' serialized form.
+func NewExactFingerprinter() *Fingerprinter {
+	return &Fingerprinter{h: fingerprintOffset, exact: true}
+}
+
+// Reset discards the values that have been added to the fingerprint.
+func (f *Fingerprinter) Reset() {
+	f.h, f.secret = fingerprintOffset, false
+}
+
+// WriteString adds a string to the fingerprint.
+func (f *Fingerprinter) WriteString(s string) {
+	f.hashString(s)
+}
+
+// WriteBool adds a bool to the fingerprint.
+func (f *Fingerprinter) WriteBool(b bool) {
+	f.hashBool(b)
+}
+
+// WriteUint64 adds an integer to the fingerprint.
+func (f *Fingerprinter) WriteUint64(u uint64) {
+	f.hashUint(u)
+}
+
+// WriteFingerprint adds another fingerprint to the fingerprint.
+func (f *Fingerprinter) WriteFingerprint(fingerprint PropertyFingerprint) {
+	f.hashUint(uint64(fingerprint))
+}
+
+// WriteProperties adds a property map to the fingerprint.
+func (f *Fingerprinter) WriteProperties(props PropertyMap) {
+	f.hashObject(props)
+}
+
+// Secret returns true if any of the values that were added to the fingerprint contain a secret.
+func (f *Fingerprinter) Secret() bool {
+	return f.secret
+}
+
+// Sum returns the fingerprint of the values that have been added so far. The result is never zero.
+func (f *Fingerprinter) Sum() PropertyFingerprint {
+	if sum := PropertyFingerprint(mixFingerprint(f.h)); sum != 0 {
+		return sum
+	}
+	return 1
+}
+
+// The parameters of the 64-bit FNV-1a hash, which fingerprints are built on.
+const (
+	fingerprintOffset uint64 = 14695981039346656037
+	fingerprintPrime  uint64 = 1099511628211
+)
+
+// Tags that distinguish the kinds of values in a fingerprint.
+const (
+	fingerprintNull byte = iota
+	fingerprintComputed
+	fingerprintOutput
+	fingerprintFalse
+	fingerprintTrue
+	fingerprintNumber
+	fingerprintString
+	fingerprintArray
+	fingerprintObject
+	fingerprintAsset
+	fingerprintArchive
+	fingerprintReference
+	fingerprintSecret
+	fingerprintOther
+)
+
+// mixFingerprint scrambles the bits of a hash. Map entries are hashed independently and then summed so that the
+// result does not depend on iteration order; mixing each entry first keeps that sum from being trivially cancelled.
+func mixFingerprint(h uint64) uint64 {
+	h ^= h >> 33
+	h *= 0xff51afd7ed558ccd
+	h ^= h >> 33
+	h *= 0xc4ceb9fe1a85ec53
+	h ^= h >> 33
+	return h
+}
+
+func (f *Fingerprinter) hashByte(b byte) {
+	f.h ^= uint64(b)
+	f.h *= fingerprintPrime
+}
+
+func (f *Fingerprinter) hashUint(u uint64) {
+	for i := 0; i < 8; i++ {
+		f.hashByte(byte(u >> (8 * i)))
+	}
+}
+
+func (f *Fingerprinter) hashString(s string) {
+	f.hashUint(uint64(len(s)))
+	for i := 0; i < len(s); i++ {
+		f.hashByte(s[i])
+	}
+}
+
+func (f *Fingerprinter) hashObject(props PropertyMap) {
+	var sum uint64
+	count := 0
+	for k, v := range props {
+		if v.IsNull() && !f.exact {
+			continue
+		}
+		entry := Fingerprinter{h: fingerprintOffset, exact: f.exact}
+		entry.hashString(string(k))
+		entry.hashValue(v)
+		f.secret = f.secret || entry.secret
+		sum += mixFingerprint(entry.h)
+		count++
+	}
+	f.hashByte(fingerprintObject)
+	f.hashUint(uint64(count))
+	f.hashUint(sum)
+}
+
+func (f *Fingerprinter) hashValue(v PropertyValue) {
+	switch t := v.V.(type) {
+	case nil:
+		f.hashByte(fingerprintNull)
+	case bool:
+		if t {
+			f.hashByte(fingerprintTrue)
+		} else {
+			f.hashByte(fingerprintFalse)
+		}
+	case float64:
+		// Positive and negative zero compare equal, so they must share a fingerprint unless it is exact.
+		if t == 0 && !f.exact {
+			t = 0
+		}
+		f.hashByte(fingerprintNumber)
+		f.hashUint(math.Float64bits(t))
+	case string:
+		f.hashByte(fingerprintString)
+		f.hashString(t)
+	case []PropertyValue:
+		f.hashByte(fingerprintArray)
+		f.hashUint(uint64(len(t)))
+		for _, elem := range t {
+			f.hashValue(elem)
+		}
+	case PropertyMap:
+		f.hashObject(t)
+	case *Asset:
+		f.hashByte(fingerprintAsset)
+		f.hashAsset(t)
+	case *Archive:
+		f.hashByte(fingerprintArchive)
+		f.hashArchive(t)
+	case Computed:
+		f.hashByte(fingerprintComputed)
+		f.hashValue(t.Element)
+	case Output:
+		f.hashByte(fingerprintOutput)
+		f.hashValue(t.Element)
+	case *Secret:
+		f.secret = true
+		f.hashByte(fingerprintSecret)
+		f.hashValue(t.Element)
+	case ResourceReference:
+		f.hashByte(fingerprintReference)
+		f.hashString(string(t.URN))
+		f.hashValue(t.ID)
+		if f.exact {
+			f.hashString(t.PackageVersion)
+		}
+	default:
+		// Values of unexpected types are hashed by their printed form, which is at least stable for equal values.
+		f.hashByte(fingerprintOther)
+		f.hashString(fmt.Sprintf("%T:%#v", t, t))
+	}
+}
+
+// hashAsset hashes an asset by its content hash if it has one, and by its contents otherwise. An exact fingerprint
+// always covers the asset's contents.
+func (f *Fingerprinter) hashAsset(a *Asset) {
+	if a == nil {
+		f.hashByte(fingerprintNull)
+		return
+	}
+	f.hashString(a.Hash)
+	if a.Hash == "" || f.exact {
+		f.hashString(a.Text)
+		f.hashString(a.Path)
+		f.hashString(a.URI)
+	}
+}
+
+// hashArchive hashes an archive by its content hash if it has one, and by its contents otherwise. An exact
+// fingerprint always covers the archive's contents.
+func (f *Fingerprinter) hashArchive(a *Archive) {
+	if a == nil {
+		f.hashByte(fingerprintNull)
+		return
+	}
+	f.hashString(a.Hash)
+	if a.Hash != "" && !f.exact {
+		return
+	}
+	f.hashString(a.Path)
+	f.hashString(a.URI)
+
+	var sum uint64
+	for k, v := range a.Assets {
+		entry := Fingerprinter{h: fingerprintOffset, exact: f.exact}
+		entry.hashString(k)
+		switch t := v.(type) {
+		case *Asset:
+			entry.hashByte(fingerprintAsset)
+			entry.hashAsset(t)
+		case *Archive:
+			entry.hashByte(fingerprintArchive)
+			entry.hashArchive(t)
+		default:
+			entry.hashByte(fingerprintOther)
+		}
+		sum += mixFingerprint(entry.h)
+	}
+	f.hashBool(a.Assets == nil)
+	f.hashUint(uint64(len(a.Assets)))
+	f.hashUint(sum)
+}
+
+func (f *Fingerprinter) hashBool(b bool) {
+	if b {
+		f.hashByte(fingerprintTrue)
+	} else {
+		f.hashByte(fingerprintFalse)
+	}
+}
@@ -0,0 +1,201 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package resource
+
+import (
+	"math"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func fingerprintOf(props PropertyMap) PropertyFingerprint {
+	f, _ := props.Fingerprint()
+	return f
+}
+
+func TestFingerprintDistinguishesValues(t *testing.T) {
+	t.Parallel()
+
+	values := []PropertyValue{
+		NewNullProperty(),
+		NewBoolProperty(false),
+		NewBoolProperty(true),
+		NewNumberProperty(0),
+		NewNumberProperty(1),
+		NewStringProperty(""),
+		NewStringProperty("0"),
+		NewStringProperty("1"),
+		NewArrayProperty(nil),
+		NewArrayProperty([]PropertyValue{NewStringProperty("1")}),
+		NewArrayProperty([]PropertyValue{NewStringProperty("1"), NewStringProperty("2")}),
+		NewArrayProperty([]PropertyValue{NewStringProperty("2"), NewStringProperty("1")}),
+		NewObjectProperty(PropertyMap{}),
+		NewObjectProperty(PropertyMap{"a": NewStringProperty("1")}),
+		NewObjectProperty(PropertyMap{"b": NewStringProperty("1")}),
+		NewObjectProperty(PropertyMap{"a": NewStringProperty("1"), "b": NewStringProperty("2")}),
+		NewObjectProperty(PropertyMap{"a": NewStringProperty("2"), "b": NewStringProperty("1")}),
+		MakeComputed(NewStringProperty("")),
+		MakeOutput(NewStringProperty("")),
+		MakeSecret(NewStringProperty("1")),
+		NewAssetProperty(&Asset{Text: "1"}),
+		NewAssetProperty(&Asset{Path: "1"}),
+		NewArchiveProperty(&Archive{Path: "1"}),
+		NewResourceReferenceProperty(ResourceReference{URN: "urn:a", ID: NewStringProperty("1")}),
+		NewResourceReferenceProperty(ResourceReference{URN: "urn:a", ID: NewStringProperty("2")}),
+	}
+
+	seen := map[PropertyFingerprint]int{}
+	for i, v := range values {
+		f, _ := v.Fingerprint()
+		assert.NotEqual(t, PropertyFingerprint(0), f)
+		if j, ok := seen[f]; ok {
+			assert.Failf(t, "fingerprint collision", "%v and %v", values[j], v)
+		}
+		seen[f] = i
+	}
+}
+
+func TestFingerprintMatchesDeepEquals(t *testing.T) {
+	t.Parallel()
+
+	build := func() PropertyMap {
+		return PropertyMap{
+			"string": NewStringProperty("value"),
+			"number": NewNumberProperty(42),
+			"array":  NewArrayProperty([]PropertyValue{NewBoolProperty(true), NewNumberProperty(1)}),
+			"object": NewObjectProperty(PropertyMap{
+				"nested": NewStringProperty("nested"),
+				"asset":  NewAssetProperty(&Asset{Hash: "abc"}),
+			}),
+		}
+	}
+
+	a, b := build(), build()
+	assert.True(t, a.DeepEquals(b))
+	assert.Equal(t, fingerprintOf(a), fingerprintOf(b))
+
+	// Keys whose values are null do not contribute, just as they are ignored by DeepEquals.
+	b["null"] = NewNullProperty()
+	assert.True(t, a.DeepEquals(b))
+	assert.Equal(t, fingerprintOf(a), fingerprintOf(b))
+
+	// Positive and negative zero are equal.
+	a["zero"], b["zero"] = NewNumberProperty(0), NewNumberProperty(math.Copysign(0, -1))
+	assert.True(t, a.DeepEquals(b))
+	assert.Equal(t, fingerprintOf(a), fingerprintOf(b))
+
+	// Any nested change is reflected in the fingerprint.
+	b["object"].ObjectValue()["nested"] = NewStringProperty("changed")
+	assert.False(t, a.DeepEquals(b))
+	assert.NotEqual(t, fingerprintOf(a), fingerprintOf(b))
+}
+
+func TestFingerprintEqualityMatchesDeepEquals(t *testing.T) {
+	t.Parallel()
+
+	str := NewStringProperty
+	pairs := [][2]PropertyMap{
+		{{}, {"a": NewNullProperty()}},
+		{{"o": NewObjectProperty(PropertyMap{})}, {"o": NewObjectProperty(PropertyMap{"a": NewNullProperty()})}},
+		{{"a": NewNullProperty()}, {"a": MakeOutput(str("x"))}},
+		{{"a": MakeOutput(str("x"))}, {"a": MakeOutput(str("x"))}},
+		{{"a": MakeOutput(str("x"))}, {"a": MakeOutput(str("y"))}},
+		{{"a": MakeOutput(str("x"))}, {"a": str("x")}},
+		{{"a": MakeOutput(str("x"))}, {"a": MakeComputed(str("x"))}},
+		{{"a": MakeComputed(str("x"))}, {"a": MakeComputed(str("y"))}},
+		{{"a": MakeOutput(NewNumberProperty(0))}, {"a": MakeOutput(NewNumberProperty(math.Copysign(0, -1)))}},
+		{{"a": str("x"), "b": MakeOutput(str("x"))}, {"a": str("x"), "b": MakeOutput(str("x"))}},
+		{{"a": str("x"), "b": MakeOutput(str("x"))}, {"a": str("x"), "b": MakeOutput(NewBoolProperty(true))}},
+	}
+	for _, p := range pairs {
+		assert.Equal(t, p[0].DeepEquals(p[1]), fingerprintOf(p[0]) == fingerprintOf(p[1]), "%v and %v", p[0], p[1])
+	}
+}
+
+func TestFingerprintReportsSecrets(t *testing.T) {
+	t.Parallel()
+
+	_, secret := PropertyMap{"a": NewStringProperty("value")}.Fingerprint()
+	assert.False(t, secret)
+
+	_, secret = PropertyMap{
+		"a": NewArrayProperty([]PropertyValue{MakeSecret(NewStringProperty("value"))}),
+	}.Fingerprint()
+	assert.True(t, secret)
+
+	// Secrets contribute their plaintext.
+	f1 := fingerprintOf(PropertyMap{"a": MakeSecret(NewStringProperty("1"))})
+	f2 := fingerprintOf(PropertyMap{"a": MakeSecret(NewStringProperty("2"))})
+	assert.NotEqual(t, f1, f2)
+}
+
+func TestFingerprintIsStable(t *testing.T) {
+	t.Parallel()
+
+	// Fingerprints are persisted, so they must not change between processes or releases.
+	assert.Equal(t, "38a042567673d24d", fingerprintOf(PropertyMap{"a": NewStringProperty("1")}).String())
+
+	f := fingerprintOf(PropertyMap{"a": NewStringProperty("1"), "b": NewNumberProperty(2)})
+	parsed, err := ParsePropertyFingerprint(f.String())
+	assert.NoError(t, err)
+	assert.Equal(t, f, parsed)
+
+	fingerprinter := NewFingerprinter()
+	fingerprinter.WriteString("urn")
+	fingerprinter.WriteFingerprint(f)
+	assert.Equal(t, fingerprinter.Sum(), func() PropertyFingerprint {
+		again := NewFingerprinter()
+		again.WriteString("urn")
+		again.WriteFingerprint(f)
+		return again.Sum()
+	}())
+
+	_, err = ParsePropertyFingerprint("not a fingerprint")
+	assert.Error(t, err)
+}
+
+func TestExactFingerprintDistinguishesEqualValues(t *testing.T) {
+	t.Parallel()
+
+	exact := func(props PropertyMap) PropertyFingerprint {
+		f := NewExactFingerprinter()
+		f.WriteProperties(props)
+		return f.Sum()
+	}
+
+	text, err := NewTextAsset("text")
+	assert.NoError(t, err)
+	other := &Asset{Sig: text.Sig, Hash: text.Hash, Text: "other"}
+
+	// Each pair is deeply equal, but is serialized differently.
+	pairs := [][2]PropertyMap{
+		{{}, {"a": NewNullProperty()}},
+		{{"a": NewNumberProperty(0)}, {"a": NewNumberProperty(math.Copysign(0, -1))}},
+		{{"a": NewAssetProperty(text)}, {"a": NewAssetProperty(other)}},
+	}
+	for _, p := range pairs {
+		assert.True(t, p[0].DeepEquals(p[1]))
+		assert.Equal(t, fingerprintOf(p[0]), fingerprintOf(p[1]))
+		assert.NotEqual(t, exact(p[0]), exact(p[1]))
+	}
+
+	// Resetting an exact fingerprinter keeps it exact.
+	f := NewExactFingerprinter()
+	f.WriteString("discarded")
+	f.Reset()
+	f.WriteProperties(pairs[0][1])
+	assert.Equal(t, exact(pairs[0][1]), f.Sum())
+}
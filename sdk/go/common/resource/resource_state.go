@@ -43,6 +43,7 @@ type State struct {
 	Aliases                 []URN                 // TODO
 	CustomTimeouts          CustomTimeouts        // A config block that will be used to configure timeouts for CRUD operations
 	ImportID                ID                    // the resource's import id, if this was an imported resource.
+	DiffFingerprint         PropertyFingerprint   // the fingerprint of the last diff that found no changes, if any.
 }
 
 // NewState creates a new resource value from existing resource state information.
@@ -12,8 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-// Package archive provides support for creating .tar.gz/.tgz archives of local folders and returning the
-// in-memory buffer.
+// Package archive provides support for creating .tar.gz/.tgz archives of local folders, either streamed to a writer
+// or returned as an in-memory buffer.
 package archive
 
 import (
@@ -23,7 +23,10 @@ import (
 	"io"
 	"os"
 	"path/filepath"
+	"runtime"
+	"sort"
 	"strings"
+	"sync"
 
 	"github.com/pkg/errors"
 	"github.com/pulumi/pulumi/sdk/v3/go/common/util/contract"
@@ -33,9 +36,16 @@ import (
 // TGZ adds the contents of the provided directory to an in-memory .tar.gz/.tgz and returns the bytes.
 func TGZ(dir, prefixPathInsideTar string, useDefaultExcludes bool) ([]byte, error) {
 	buffer := &bytes.Buffer{}
-	gw := gzip.NewWriter(buffer)
-	writer := tar.NewWriter(gw)
+	if err := WriteTGZ(buffer, dir, prefixPathInsideTar, useDefaultExcludes); err != nil {
+		return nil, err
+	}
+	return buffer.Bytes(), nil
+}
 
+// WriteTGZ writes a .tar.gz/.tgz of the contents of the provided directory to w. The archive is compressed on all
+// available processors as it is written, and its files are added in a deterministic order, so archiving the same
+// directory twice produces the same bytes.
+func WriteTGZ(w io.Writer, dir, prefixPathInsideTar string, useDefaultExcludes bool) error {
 	// We trim `dir` from the pathname of every file we add, but we actually want to ensure the files
 	// directly under `path` are not added with a path prefix, so we add an extra os.PathSeparator
 	// here to the end of the string if it doesn't already end with one.
@@ -43,21 +53,43 @@ func TGZ(dir, prefixPathInsideTar string, useDefaultExcludes bool) ([]byte, erro
 		dir = dir + string(os.PathSeparator)
 	}
 
-	if err := addDirectoryToTar(writer, dir, dir, prefixPathInsideTar, useDefaultExcludes, nil); err != nil {
-		return nil, err
+	files, err := collectFiles(dir, useDefaultExcludes)
+	if err != nil {
+		return err
+	}
+
+	counter := &countingWriter{w: w}
+	gw := newParallelGzipWriter(counter)
+	writer := tar.NewWriter(gw)
+	for _, f := range files {
+		if err := addFileToTar(writer, dir, prefixPathInsideTar, f); err != nil {
+			return err
+		}
 	}
 
 	// Close the tar and gzip writers to flush and write footers.
 	if err := writer.Close(); err != nil {
-		return nil, err
+		return err
 	}
 	if err := gw.Close(); err != nil {
-		return nil, err
+		return err
 	}
 
-	logging.V(5).Infof("project archive is %v bytes", buffer.Len())
+	logging.V(5).Infof("project archive is %v bytes", counter.n)
 
-	return buffer.Bytes(), nil
+	return nil
+}
+
+// countingWriter counts the bytes written to an underlying writer.
+type countingWriter struct {
+	w io.Writer
+	n int64
+}
+
+func (c *countingWriter) Write(p []byte) (int, error) {
+	n, err := c.w.Write(p)
+	c.n += int64(n)
+	return n, err
 }
 
 func extractFile(r *tar.Reader, header *tar.Header, dir string) error {
@@ -131,8 +163,27 @@ const (
 	gitIgnoreFile = ".gitignore"
 )
 
-func addDirectoryToTar(writer *tar.Writer, root, dir, prefixPathInsideTar string,
-	useDefaultIgnores bool, ignores *ignoreState) error {
+// archiveFile is a regular file that is to be added to an archive.
+type archiveFile struct {
+	path string
+	info os.FileInfo
+}
+
+// collectFiles returns the regular files under root that are not ignored, sorted by path. Directories are walked
+// (and their ignore files evaluated) concurrently.
+func collectFiles(root string, useDefaultIgnores bool) ([]archiveFile, error) {
+	w := &directoryWalker{useDefaultIgnores: useDefaultIgnores, sem: make(chan struct{}, 4*runtime.GOMAXPROCS(0))}
+	return w.walk(root, nil)
+}
+
+// directoryWalker walks a directory tree. The number of directories that are walked concurrently is bounded by sem.
+type directoryWalker struct {
+	useDefaultIgnores bool
+	sem               chan struct{}
+}
+
+// walk returns the files under dir that are not ignored, sorted by path.
+func (w *directoryWalker) walk(dir string, ignores *ignoreState) ([]archiveFile, error) {
 	ignoreFilePath := filepath.Join(dir, gitIgnoreFile)
 
 	// If there is an ignorefile, process it before looking at any child paths.
@@ -141,13 +192,13 @@ func addDirectoryToTar(writer *tar.Writer, root, dir, prefixPathInsideTar string
 
 		ignore, err := newGitIgnoreIgnorer(ignoreFilePath)
 		if err != nil {
-			return errors.Wrapf(err, "could not read ignore file in %v", dir)
+			return nil, errors.Wrapf(err, "could not read ignore file in %v", dir)
 		}
 
 		ignores = ignores.Append(ignore)
 	}
 
-	if useDefaultIgnores {
+	if w.useDefaultIgnores {
 		dotGitPath := filepath.Join(dir, gitDir)
 		if stat, err := os.Stat(dotGitPath); err == nil {
 			ignores = ignores.Append(newPathIgnorer(dotGitPath, stat.IsDir()))
@@ -156,17 +207,25 @@ func addDirectoryToTar(writer *tar.Writer, root, dir, prefixPathInsideTar string
 
 	file, err := os.Open(dir)
 	if err != nil {
-		return err
+		return nil, err
 	}
 	// No defer because we want to close file as soon as possible (right after we call Readdir).
 
 	infos, err := file.Readdir(-1)
 	contract.IgnoreClose(file)
 	if err != nil {
-		return err
+		return nil, err
 	}
 
-	for _, info := range infos {
+	// Readdir returns entries in directory order, which varies between file systems, so sort them by name.
+	sort.Slice(infos, func(i, j int) bool { return infos[i].Name() < infos[j].Name() })
+
+	// Each entry produces either a single file or the files of a subdirectory. Subdirectories are walked on their
+	// own goroutine when one is available, and inline otherwise.
+	entries := make([][]archiveFile, len(infos))
+	errs := make([]error, len(infos))
+	var wg sync.WaitGroup
+	for i, info := range infos {
 		fullName := filepath.Join(dir, info.Name())
 
 		if !info.IsDir() && ignores.IsIgnored(fullName) {
@@ -178,51 +237,71 @@ func addDirectoryToTar(writer *tar.Writer, root, dir, prefixPathInsideTar string
 		if info.Mode()&os.ModeSymlink == os.ModeSymlink {
 			info, err = os.Stat(fullName)
 			if err != nil {
-				return err
+				return nil, err
 			}
 		}
 
 		if info.Mode().IsDir() {
-			err = addDirectoryToTar(writer, root, fullName, prefixPathInsideTar, useDefaultIgnores, ignores)
-			if err != nil {
-				return err
+			select {
+			case w.sem <- struct{}{}:
+				wg.Add(1)
+				go func(i int) {
+					defer func() {
+						<-w.sem
+						wg.Done()
+					}()
+					entries[i], errs[i] = w.walk(fullName, ignores)
+				}(i)
+			default:
+				entries[i], errs[i] = w.walk(fullName, ignores)
 			}
 		} else if info.Mode().IsRegular() {
-			logging.V(9).Infof("adding %v to archive", fullName)
+			entries[i] = []archiveFile{{path: fullName, info: info}}
+		} else {
+			logging.V(9).Infof("ignoring special file %v with mode %v", fullName, info.Mode())
+		}
+	}
+	wg.Wait()
 
-			header, err := tar.FileInfoHeader(info, info.Name())
-			if err != nil {
-				return err
-			}
+	var files []archiveFile
+	for i := range entries {
+		if errs[i] != nil {
+			return nil, errs[i]
+		}
+		files = append(files, entries[i]...)
+	}
+	return files, nil
+}
 
-			// Specify the file name, by removing the root prefix.
-			// If prefixPathInsideTar is set, use it as a prefix path inside the tar (this, for example,
-			// enables all files to be added in the tar file within a "packages" parent directory).
-			name := strings.TrimPrefix(fullName, root)
-			if prefixPathInsideTar != "" {
-				name = filepath.Join(prefixPathInsideTar, name)
-			}
-			header.Name = filepath.ToSlash(name)
+// addFileToTar writes the header and contents of a file to the archive.
+func addFileToTar(writer *tar.Writer, root, prefixPathInsideTar string, f archiveFile) error {
+	logging.V(9).Infof("adding %v to archive", f.path)
 
-			if err := writer.WriteHeader(header); err != nil {
-				return err
-			}
+	header, err := tar.FileInfoHeader(f.info, f.info.Name())
+	if err != nil {
+		return err
+	}
 
-			file, err := os.Open(fullName)
-			if err != nil {
-				return err
-			}
-			// no defer because we want to close file as soon as possible (right after we call Copy)
+	// Specify the file name, by removing the root prefix.
+	// If prefixPathInsideTar is set, use it as a prefix path inside the tar (this, for example,
+	// enables all files to be added in the tar file within a "packages" parent directory).
+	name := strings.TrimPrefix(f.path, root)
+	if prefixPathInsideTar != "" {
+		name = filepath.Join(prefixPathInsideTar, name)
+	}
+	header.Name = filepath.ToSlash(name)
 
-			_, err = io.Copy(writer, file)
-			contract.IgnoreClose(file)
-			if err != nil {
-				return err
-			}
-		} else {
-			logging.V(9).Infof("ignoring special file %v with mode %v", fullName, info.Mode())
-		}
+	if err := writer.WriteHeader(header); err != nil {
+		return err
 	}
 
-	return nil
+	file, err := os.Open(f.path)
+	if err != nil {
+		return err
+	}
+	// no defer because we want to close file as soon as possible (right after we call Copy)
+
+	_, err = io.Copy(writer, file)
+	contract.IgnoreClose(file)
+	return err
 }
@@ -81,6 +81,33 @@ func TestIgnoreContentOfDotGit(t *testing.T) {
 		fileContents{name: "requirements.txt", shouldRetain: true})
 }
 
+func TestArchiveIsDeterministic(t *testing.T) {
+	files := []fileContents{
+		{name: "b.txt", contents: []byte("b"), shouldRetain: true},
+		{name: "a/z.txt", contents: []byte("z"), shouldRetain: true},
+		{name: "a/b/c.txt", contents: []byte("c"), shouldRetain: true},
+		{name: "c/a.txt", contents: []byte("a"), shouldRetain: true},
+	}
+
+	tarball, err := archiveContents("", files...)
+	assert.NoError(t, err)
+
+	// Files are added in path order.
+	gzr, err := gzip.NewReader(bytes.NewReader(tarball))
+	assert.NoError(t, err)
+	r := tar.NewReader(gzr)
+	var names []string
+	for {
+		header, err := r.Next()
+		if err == io.EOF {
+			break
+		}
+		assert.NoError(t, err)
+		names = append(names, header.Name)
+	}
+	assert.Equal(t, []string{"a/b/c.txt", "a/z.txt", "b.txt", "c/a.txt"}, names)
+}
+
 func doArchiveTest(t *testing.T, files ...fileContents) {
 	doTest := func(prefixPathInsideTar string) {
 		tarball, err := archiveContents(prefixPathInsideTar, files...)
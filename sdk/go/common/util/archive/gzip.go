@@ -0,0 +1,172 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package archive
+
+import (
+	"bytes"
+	"compress/flate"
+	"encoding/binary"
+	"hash/crc32"
+	"io"
+	"runtime"
+
+	"github.com/pkg/errors"
+)
+
+const (
+	// gzipBlockSize is the amount of input that is compressed by each unit of work.
+	gzipBlockSize = 1 << 20
+	// gzipDictSize is the amount of each block that is used as the dictionary of the block after it. This is the
+	// size of the deflate window, so blocks compress nearly as well as they would in a single stream.
+	gzipDictSize = 32 << 10
+)
+
+// gzipHeader is the header written by gzip.Writer when no header fields are set.
+var gzipHeader = []byte{0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 255}
+
+// parallelGzipWriter writes a single gzip member whose contents are compressed in blocks on several goroutines. Each
+// block is compressed as a non-final run of deflate blocks using the end of the previous block as its dictionary, so
+// the compressed blocks concatenate into one deflate stream that any gzip reader can decompress. The output depends
+// only on the input, and not on how the blocks were scheduled.
+type parallelGzipWriter struct {
+	w        io.Writer
+	parallel int
+
+	buf     []byte
+	dict    []byte
+	pending []chan gzipBlock
+	started bool
+
+	crc  uint32
+	size uint32
+	err  error
+}
+
+// gzipBlock is the compressed form of a block of input.
+type gzipBlock struct {
+	data []byte
+	err  error
+}
+
+func newParallelGzipWriter(w io.Writer) *parallelGzipWriter {
+	parallel := runtime.GOMAXPROCS(0)
+	if parallel < 1 {
+		parallel = 1
+	}
+	return &parallelGzipWriter{w: w, parallel: parallel, buf: make([]byte, 0, gzipBlockSize)}
+}
+
+func (z *parallelGzipWriter) Write(p []byte) (int, error) {
+	if z.err != nil {
+		return 0, z.err
+	}
+
+	z.crc = crc32.Update(z.crc, crc32.IEEETable, p)
+	z.size += uint32(len(p))
+
+	written := 0
+	for len(p) > 0 {
+		n := copy(z.buf[len(z.buf):cap(z.buf)], p)
+		z.buf, p, written = z.buf[:len(z.buf)+n], p[n:], written+n
+		if len(z.buf) == cap(z.buf) {
+			if err := z.compressBlock(false); err != nil {
+				return written, err
+			}
+		}
+	}
+	return written, nil
+}
+
+// Close compresses any remaining input and writes the gzip trailer. It does not close the underlying writer.
+func (z *parallelGzipWriter) Close() error {
+	if z.err != nil {
+		return z.err
+	}
+	if err := z.compressBlock(true); err != nil {
+		return err
+	}
+	for len(z.pending) > 0 {
+		if err := z.writeBlock(); err != nil {
+			return err
+		}
+	}
+
+	var trailer [8]byte
+	binary.LittleEndian.PutUint32(trailer[:4], z.crc)
+	binary.LittleEndian.PutUint32(trailer[4:], z.size)
+	if _, err := z.w.Write(trailer[:]); err != nil {
+		z.err = err
+		return err
+	}
+	z.err = errors.New("gzip: write to closed writer")
+	return nil
+}
+
+// compressBlock starts compressing the buffered input. If there are already as many blocks being compressed as
+// there are processors, it first waits for the oldest of those and writes it out.
+func (z *parallelGzipWriter) compressBlock(final bool) error {
+	if !z.started {
+		if _, err := z.w.Write(gzipHeader); err != nil {
+			z.err = err
+			return err
+		}
+		z.started = true
+	}
+	for len(z.pending) >= z.parallel {
+		if err := z.writeBlock(); err != nil {
+			return err
+		}
+	}
+
+	in, dict := z.buf, z.dict
+	result := make(chan gzipBlock, 1)
+	go func() {
+		var out bytes.Buffer
+		fw, err := flate.NewWriterDict(&out, flate.DefaultCompression, dict)
+		if err == nil {
+			_, err = fw.Write(in)
+		}
+		if err == nil {
+			if final {
+				err = fw.Close()
+			} else {
+				err = fw.Flush()
+			}
+		}
+		result <- gzipBlock{data: out.Bytes(), err: err}
+	}()
+	z.pending = append(z.pending, result)
+
+	if len(in) > gzipDictSize {
+		z.dict = in[len(in)-gzipDictSize:]
+	} else {
+		z.dict = in
+	}
+	z.buf = make([]byte, 0, gzipBlockSize)
+	return nil
+}
+
+// writeBlock waits for the oldest pending block and writes it to the underlying writer.
+func (z *parallelGzipWriter) writeBlock() error {
+	block := <-z.pending[0]
+	z.pending = z.pending[1:]
+	if block.err == nil {
+		_, block.err = z.w.Write(block.data)
+	}
+	if block.err != nil {
+		z.err = block.err
+	}
+	return block.err
+}
@@ -0,0 +1,68 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package archive
+
+import (
+	"bytes"
+	"compress/gzip"
+	"io/ioutil"
+	"math/rand"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func compressParallel(t *testing.T, data []byte, parallel int, chunk int) []byte {
+	var buf bytes.Buffer
+	gw := newParallelGzipWriter(&buf)
+	gw.parallel = parallel
+	for len(data) > 0 {
+		n := chunk
+		if n > len(data) {
+			n = len(data)
+		}
+		written, err := gw.Write(data[:n])
+		assert.NoError(t, err)
+		assert.Equal(t, n, written)
+		data = data[n:]
+	}
+	assert.NoError(t, gw.Close())
+	return buf.Bytes()
+}
+
+func TestParallelGzipRoundTrip(t *testing.T) {
+	t.Parallel()
+
+	// Mix compressible and incompressible input so that blocks refer back into the blocks before them.
+	rng := rand.New(rand.NewSource(0))
+	random := make([]byte, 3*gzipBlockSize)
+	rng.Read(random)
+	repeated := bytes.Repeat([]byte("pulumi "), gzipBlockSize/2)
+
+	for _, data := range [][]byte{nil, []byte("hello"), repeated, append(random, repeated...)} {
+		compressed := compressParallel(t, data, 4, 4096)
+
+		gzr, err := gzip.NewReader(bytes.NewReader(compressed))
+		assert.NoError(t, err)
+		gzr.Multistream(false)
+		actual, err := ioutil.ReadAll(gzr)
+		assert.NoError(t, err)
+		assert.Equal(t, len(data), len(actual))
+		assert.True(t, bytes.Equal(data, actual))
+
+		// The output does not depend on the degree of parallelism or on how the input was written.
+		assert.Equal(t, compressed, compressParallel(t, data, 1, len(data)+1))
+	}
+}
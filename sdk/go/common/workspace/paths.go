@@ -39,6 +39,10 @@ const (
 	GitDir = ".git"
 	// HistoryDir is the name of the directory that holds historical information for projects.
 	HistoryDir = "history"
+	// JournalDir is the name of the directory that holds checkpoint journals for stacks.
+	JournalDir = "journals"
+	// OutputsDir is the name of the directory that holds the latest outputs of stacks.
+	OutputsDir = "outputs"
 	// PluginDir is the name of the directory containing plugins.
 	PluginDir = "plugins"
 	// PolicyDir is the name of the directory that holds policy packs.
@@ -65,6 +69,8 @@ const (
 	WorkspaceFile = "workspace.json"
 	// CachedVersionFile is the name of the file we use to store when we last checked if the CLI was out of date
 	CachedVersionFile = ".cachedVersionInfo"
+	// AssetHashCacheFile is the name of the file that caches the hashes of path-based assets and archives.
+	AssetHashCacheFile = "asset-hashes.json"
 
 	// PulumiHomeEnvVar is a path to the '.pulumi' folder with plugins, access token, etc.
 	// The folder can have any name, not necessarily '.pulumi'.
@@ -211,6 +217,11 @@ func GetCachedVersionFilePath() (string, error) {
 	return GetPulumiPath(CachedVersionFile)
 }
 
+// GetAssetHashCachePath returns the location where the CLI caches the hashes of path-based assets and archives.
+func GetAssetHashCachePath() (string, error) {
+	return GetPulumiPath(WorkspaceDir, AssetHashCacheFile)
+}
+
 // GetPulumiHomeDir returns the path of the '.pulumi' folder where Pulumi puts its artifacts.
 func GetPulumiHomeDir() (string, error) {
 	// Allow the folder we use to be overridden by an environment variable
@@ -53,6 +53,8 @@ type Context struct {
 
 	keepResources bool // true if resources should be marshaled as strongly-typed references.
 
+	registrations *registrationBatcher // the batcher for resource registrations, if the monitor supports batches.
+
 	rpcs     int        // the number of outstanding RPC requests.
 	rpcsDone *sync.Cond // an event signaling completion of RPCs.
 	rpcsLock sync.Mutex // a lock protecting the RPC count and event.
@@ -105,6 +107,7 @@ func NewContext(ctx context.Context, info RunInfo) (*Context, error) {
 	}
 
 	var keepResources bool
+	var registrations *registrationBatcher
 	if monitor != nil {
 		supportsFeatureResp, err := monitor.SupportsFeature(ctx, &pulumirpc.SupportsFeatureRequest{
 			Id: "resourceReferences",
@@ -113,6 +116,16 @@ func NewContext(ctx context.Context, info RunInfo) (*Context, error) {
 			return nil, fmt.Errorf("checking monitor features: %w", err)
 		}
 		keepResources = supportsFeatureResp.GetHasSupport()
+
+		supportsFeatureResp, err = monitor.SupportsFeature(ctx, &pulumirpc.SupportsFeatureRequest{
+			Id: "registerResourceBatches",
+		})
+		if err != nil {
+			return nil, fmt.Errorf("checking monitor features: %w", err)
+		}
+		if supportsFeatureResp.GetHasSupport() {
+			registrations = newRegistrationBatcher(ctx, monitor)
+		}
 	}
 
 	context := &Context{
@@ -124,6 +137,7 @@ func NewContext(ctx context.Context, info RunInfo) (*Context, error) {
 		engineConn:    engineConn,
 		engine:        engine,
 		keepResources: keepResources,
+		registrations: registrations,
 	}
 	context.rpcsDone = sync.NewCond(&context.rpcsLock)
 	context.Log = &logState{
@@ -136,6 +150,9 @@ func NewContext(ctx context.Context, info RunInfo) (*Context, error) {
 
 // Close implements io.Closer and relinquishes any outstanding resources held by the context.
 func (ctx *Context) Close() error {
+	if ctx.registrations != nil {
+		ctx.registrations.close()
+	}
 	if ctx.engineConn != nil {
 		if err := ctx.engineConn.Close(); err != nil {
 			return err
@@ -782,7 +799,7 @@ func (ctx *Context) registerResource(
 			}
 		} else {
 			logging.V(9).Infof("RegisterResource(%s, %s): Goroutine spawned, RPC call being made", t, name)
-			resp, err = ctx.monitor.RegisterResource(ctx.ctx, &pulumirpc.RegisterResourceRequest{
+			resp, err = ctx.registerResourceRPC(&pulumirpc.RegisterResourceRequest{
 				Type:                    t,
 				Name:                    name,
 				Parent:                  inputs.parent,
@@ -1362,6 +1379,17 @@ func (ctx *Context) beginRPC() error {
 	return nil
 }
 
+// registerResourceRPC sends the given registration to the resource monitor, batching it with any other registrations
+// that are ready at the same time if the monitor supports it.
+func (ctx *Context) registerResourceRPC(
+	req *pulumirpc.RegisterResourceRequest) (*pulumirpc.RegisterResourceResponse, error) {
+
+	if ctx.registrations != nil {
+		return ctx.registrations.register(req)
+	}
+	return ctx.monitor.RegisterResource(ctx.ctx, req)
+}
+
 // endRPC signals the completion of an RPC and notifies any potential awaiters when outstanding RPCs hit zero.
 func (ctx *Context) endRPC(err error) {
 	ctx.rpcsLock.Lock()
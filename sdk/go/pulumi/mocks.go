@@ -1,6 +1,7 @@
 package pulumi
 
 import (
+	"io"
 	"log"
 	"sync"
 
@@ -238,6 +239,36 @@ func (m *mockMonitor) RegisterResource(ctx context.Context, in *pulumirpc.Regist
 	}, nil
 }
 
+func (m *mockMonitor) RegisterResources(ctx context.Context, in *pulumirpc.RegisterResourcesRequest,
+	opts ...grpc.CallOption) (pulumirpc.ResourceMonitor_RegisterResourcesClient, error) {
+
+	var responses []*pulumirpc.RegisterResourcesResponse
+	for i, req := range in.GetRequests() {
+		resp, err := m.RegisterResource(ctx, req, opts...)
+		if err != nil {
+			return nil, err
+		}
+		responses = append(responses, &pulumirpc.RegisterResourcesResponse{Index: int32(i), Response: resp})
+	}
+	return &mockRegisterResourcesClient{responses: responses}, nil
+}
+
+// mockRegisterResourcesClient replays the responses to a RegisterResources call.
+type mockRegisterResourcesClient struct {
+	grpc.ClientStream
+
+	responses []*pulumirpc.RegisterResourcesResponse
+}
+
+func (c *mockRegisterResourcesClient) Recv() (*pulumirpc.RegisterResourcesResponse, error) {
+	if len(c.responses) == 0 {
+		return nil, io.EOF
+	}
+	resp := c.responses[0]
+	c.responses = c.responses[1:]
+	return resp, nil
+}
+
 func (m *mockMonitor) RegisterResourceOutputs(ctx context.Context, in *pulumirpc.RegisterResourceOutputsRequest,
 	opts ...grpc.CallOption) (*empty.Empty, error) {
 
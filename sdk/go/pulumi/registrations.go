@@ -0,0 +1,168 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package pulumi
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"io"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/util/logging"
+	pulumirpc "github.com/pulumi/pulumi/sdk/v3/proto/go"
+)
+
+// maxRegistrationBatchSize is the maximum number of registrations that are sent in a single RegisterResources call.
+const maxRegistrationBatchSize = 256
+
+// registrationResult is the outcome of a single resource registration.
+type registrationResult struct {
+	resp *pulumirpc.RegisterResourceResponse
+	err  error
+}
+
+// pendingRegistration is a resource registration that is waiting to be sent to the resource monitor.
+type pendingRegistration struct {
+	req  *pulumirpc.RegisterResourceRequest
+	done chan registrationResult
+}
+
+// registrationBatcher coalesces resource registrations that are ready at the same time into a single
+// RegisterResources call. Programs that declare many resources at once would otherwise pay for one round trip to the
+// resource monitor per resource.
+//
+// The batcher never delays a registration in the hope of filling a batch: each batch contains the first waiting
+// registration plus any others that are already waiting when it is sent.
+type registrationBatcher struct {
+	ctx     context.Context
+	monitor pulumirpc.ResourceMonitorClient
+
+	queue  chan *pendingRegistration
+	closed chan struct{}
+}
+
+func newRegistrationBatcher(ctx context.Context, monitor pulumirpc.ResourceMonitorClient) *registrationBatcher {
+	b := &registrationBatcher{
+		ctx:     ctx,
+		monitor: monitor,
+		queue:   make(chan *pendingRegistration),
+		closed:  make(chan struct{}),
+	}
+	go b.run()
+	return b
+}
+
+// register sends the given registration to the resource monitor as part of the next batch and waits for its response.
+func (b *registrationBatcher) register(req *pulumirpc.RegisterResourceRequest) (*pulumirpc.RegisterResourceResponse,
+	error) {
+
+	errClosed := errors.New("attempted to register a resource after the context was closed")
+	select {
+	case <-b.closed:
+		return nil, errClosed
+	default:
+	}
+
+	p := &pendingRegistration{req: req, done: make(chan registrationResult, 1)}
+	select {
+	case b.queue <- p:
+	case <-b.closed:
+		return nil, errClosed
+	}
+
+	result := <-p.done
+	return result.resp, result.err
+}
+
+// close stops the batcher. Registrations that have already been sent are unaffected.
+func (b *registrationBatcher) close() {
+	close(b.closed)
+}
+
+func (b *registrationBatcher) run() {
+	for {
+		var batch []*pendingRegistration
+		select {
+		case p := <-b.queue:
+			batch = append(batch, p)
+		case <-b.closed:
+			return
+		}
+
+		// Pick up any other registrations that are already waiting.
+	drain:
+		for len(batch) < maxRegistrationBatchSize {
+			select {
+			case p := <-b.queue:
+				batch = append(batch, p)
+			default:
+				break drain
+			}
+		}
+
+		// Send the batch on its own goroutine: registrations may take a long time to complete, and later batches must
+		// not wait on earlier ones.
+		go b.send(batch)
+	}
+}
+
+func (b *registrationBatcher) send(batch []*pendingRegistration) {
+	if len(batch) == 1 {
+		resp, err := b.monitor.RegisterResource(b.ctx, batch[0].req)
+		batch[0].done <- registrationResult{resp: resp, err: err}
+		return
+	}
+
+	logging.V(9).Infof("RegisterResources(#reqs=%d): RPC call being made", len(batch))
+
+	reqs := make([]*pulumirpc.RegisterResourceRequest, len(batch))
+	for i, p := range batch {
+		reqs[i] = p.req
+	}
+
+	// Deliver each response as it arrives. If the stream fails, every registration that is still outstanding fails
+	// with the stream's error.
+	err := func() error {
+		stream, err := b.monitor.RegisterResources(b.ctx, &pulumirpc.RegisterResourcesRequest{Requests: reqs})
+		if err != nil {
+			return err
+		}
+		for {
+			resp, err := stream.Recv()
+			if err == io.EOF {
+				return nil
+			}
+			if err != nil {
+				return err
+			}
+
+			index := int(resp.GetIndex())
+			if index < 0 || index >= len(batch) || batch[index] == nil {
+				return fmt.Errorf("RegisterResources: unexpected response index %d", index)
+			}
+			batch[index].done <- registrationResult{resp: resp.GetResponse()}
+			batch[index] = nil
+		}
+	}()
+	if err == nil {
+		err = errors.New("RegisterResources: resource monitor did not respond to every registration")
+	}
+
+	for _, p := range batch {
+		if p != nil {
+			p.done <- registrationResult{err: err}
+		}
+	}
+}
@@ -0,0 +1,131 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package pulumi
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"sync"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+	"google.golang.org/grpc"
+
+	"github.com/pulumi/pulumi/sdk/v3/go/common/resource"
+	pulumirpc "github.com/pulumi/pulumi/sdk/v3/proto/go"
+)
+
+// batchMonitor is a mock monitor that records the size of each batch it receives. Its responses are streamed in reverse
+// order, and a batch fails if it contains a registration named "fail".
+type batchMonitor struct {
+	*mockMonitor
+
+	m       sync.Mutex
+	batches []int
+}
+
+func (m *batchMonitor) RegisterResources(ctx context.Context, in *pulumirpc.RegisterResourcesRequest,
+	opts ...grpc.CallOption) (pulumirpc.ResourceMonitor_RegisterResourcesClient, error) {
+
+	m.m.Lock()
+	m.batches = append(m.batches, len(in.GetRequests()))
+	m.m.Unlock()
+
+	var responses []*pulumirpc.RegisterResourcesResponse
+	for i := len(in.GetRequests()) - 1; i >= 0; i-- {
+		req := in.GetRequests()[i]
+		if req.GetName() == "fail" {
+			return nil, errors.New("registration failed")
+		}
+		resp, err := m.mockMonitor.RegisterResource(ctx, req, opts...)
+		if err != nil {
+			return nil, err
+		}
+		responses = append(responses, &pulumirpc.RegisterResourcesResponse{Index: int32(i), Response: resp})
+	}
+	return &mockRegisterResourcesClient{responses: responses}, nil
+}
+
+func newBatchMonitor() *batchMonitor {
+	return &batchMonitor{mockMonitor: &mockMonitor{project: "project", stack: "stack", mocks: &testMonitor{}}}
+}
+
+func newPendingRegistrations(names ...string) []*pendingRegistration {
+	batch := make([]*pendingRegistration, len(names))
+	for i, name := range names {
+		batch[i] = &pendingRegistration{
+			req:  &pulumirpc.RegisterResourceRequest{Type: "test:index:Resource", Name: name, Custom: true},
+			done: make(chan registrationResult, 1),
+		}
+	}
+	return batch
+}
+
+func TestRegistrationBatchDispatchesResponsesByIndex(t *testing.T) {
+	monitor := newBatchMonitor()
+	b := &registrationBatcher{ctx: context.Background(), monitor: monitor}
+
+	batch := newPendingRegistrations("a", "b", "c")
+	b.send(batch)
+	assert.Equal(t, []int{3}, monitor.batches)
+
+	for _, p := range batch {
+		result := <-p.done
+		if assert.NoError(t, result.err) {
+			assert.Equal(t, p.req.GetName(), result.resp.GetId())
+		}
+	}
+}
+
+func TestRegistrationBatchFailsOutstandingRegistrations(t *testing.T) {
+	b := &registrationBatcher{ctx: context.Background(), monitor: newBatchMonitor()}
+
+	batch := newPendingRegistrations("a", "fail")
+	b.send(batch)
+	for _, p := range batch {
+		result := <-p.done
+		assert.EqualError(t, result.err, "registration failed")
+	}
+}
+
+func TestRegistrationBatcher(t *testing.T) {
+	monitor := newBatchMonitor()
+	b := newRegistrationBatcher(context.Background(), monitor)
+
+	const count = 100
+	var wg sync.WaitGroup
+	wg.Add(count)
+	for i := 0; i < count; i++ {
+		name := fmt.Sprintf("res%d", i)
+		go func() {
+			defer wg.Done()
+			resp, err := b.register(&pulumirpc.RegisterResourceRequest{
+				Type:   "test:index:Resource",
+				Name:   name,
+				Custom: true,
+			})
+			if assert.NoError(t, err) {
+				assert.Equal(t, name, resp.GetId())
+			}
+		}()
+	}
+	wg.Wait()
+
+	// Registrations fail once the batcher has been closed.
+	b.close()
+	_, err := b.register(&pulumirpc.RegisterResourceRequest{Type: string(resource.RootStackType), Name: "stack"})
+	assert.Error(t, err)
+}
@@ -229,6 +229,29 @@ func (p *monitorProxy) RegisterResource(
 	return p.target.RegisterResource(ctx, req)
 }
 
+func (p *monitorProxy) RegisterResources(
+	req *pulumirpc.RegisterResourcesRequest, server pulumirpc.ResourceMonitor_RegisterResourcesServer) error {
+
+	client, err := p.target.RegisterResources(server.Context(), req)
+	if err != nil {
+		return err
+	}
+
+	for {
+		in, err := client.Recv()
+		if err == io.EOF {
+			return nil
+		}
+		if err != nil {
+			return err
+		}
+
+		if err := server.Send(in); err != nil {
+			return err
+		}
+	}
+}
+
 func (p *monitorProxy) RegisterResourceOutputs(
 	ctx context.Context, req *pulumirpc.RegisterResourceOutputsRequest) (*pbempty.Empty, error) {
 	return p.target.RegisterResourceOutputs(ctx, req)
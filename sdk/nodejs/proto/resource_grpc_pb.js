@@ -132,6 +132,28 @@ function deserialize_pulumirpc_RegisterResourceResponse(buffer_arg) {
   return resource_pb.RegisterResourceResponse.deserializeBinary(new Uint8Array(buffer_arg));
 }
 
+function serialize_pulumirpc_RegisterResourcesRequest(arg) {
+  if (!(arg instanceof resource_pb.RegisterResourcesRequest)) {
+    throw new Error('Expected argument of type pulumirpc.RegisterResourcesRequest');
+  }
+  return Buffer.from(arg.serializeBinary());
+}
+
+function deserialize_pulumirpc_RegisterResourcesRequest(buffer_arg) {
+  return resource_pb.RegisterResourcesRequest.deserializeBinary(new Uint8Array(buffer_arg));
+}
+
+function serialize_pulumirpc_RegisterResourcesResponse(arg) {
+  if (!(arg instanceof resource_pb.RegisterResourcesResponse)) {
+    throw new Error('Expected argument of type pulumirpc.RegisterResourcesResponse');
+  }
+  return Buffer.from(arg.serializeBinary());
+}
+
+function deserialize_pulumirpc_RegisterResourcesResponse(buffer_arg) {
+  return resource_pb.RegisterResourcesResponse.deserializeBinary(new Uint8Array(buffer_arg));
+}
+
 function serialize_pulumirpc_SupportsFeatureRequest(arg) {
   if (!(arg instanceof resource_pb.SupportsFeatureRequest)) {
     throw new Error('Expected argument of type pulumirpc.SupportsFeatureRequest');
@@ -223,6 +245,17 @@ var ResourceMonitorService = exports.ResourceMonitorService = {
     responseSerialize: serialize_pulumirpc_RegisterResourceResponse,
     responseDeserialize: deserialize_pulumirpc_RegisterResourceResponse,
   },
+  registerResources: {
+    path: '/pulumirpc.ResourceMonitor/RegisterResources',
+    requestStream: false,
+    responseStream: true,
+    requestType: resource_pb.RegisterResourcesRequest,
+    responseType: resource_pb.RegisterResourcesResponse,
+    requestSerialize: serialize_pulumirpc_RegisterResourcesRequest,
+    requestDeserialize: deserialize_pulumirpc_RegisterResourcesRequest,
+    responseSerialize: serialize_pulumirpc_RegisterResourcesResponse,
+    responseDeserialize: deserialize_pulumirpc_RegisterResourcesResponse,
+  },
   registerResourceOutputs: {
     path: '/pulumirpc.ResourceMonitor/RegisterResourceOutputs',
     requestStream: false,
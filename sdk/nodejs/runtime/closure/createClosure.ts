@@ -420,6 +420,9 @@ async function analyzeFunctionInfoAsync(
         const functionDeclarationName = parsedFunction.functionDeclarationName;
         frame.functionLocation.isArrowFunction = parsedFunction.isArrowFunction;
 
+        // The scope chain of the function is only inspected if it actually captures anything.
+        let lookupCapturedVariable: v8.CapturedVariableLookup | undefined;
+
         const capturedValues: PropertyMap = new Map();
         await processCapturedVariablesAsync(parsedFunction.capturedVariables.required, /*throwOnFailure:*/ true);
         await processCapturedVariablesAsync(parsedFunction.capturedVariables.optional, /*throwOnFailure:*/ false);
@@ -531,7 +534,10 @@ async function analyzeFunctionInfoAsync(
             for (const name of capturedVariables.keys()) {
                 let value: any;
                 try {
-                    value = await v8.lookupCapturedVariableValueAsync(func, name, throwOnFailure);
+                    if (!lookupCapturedVariable) {
+                        lookupCapturedVariable = await v8.getCapturedVariableLookupAsync(func);
+                    }
+                    value = lookupCapturedVariable(name, throwOnFailure);
                 }
                 catch (err) {
                     throwSerializationError(func, context, err.message);
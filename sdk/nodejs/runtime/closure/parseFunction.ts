@@ -95,12 +95,27 @@ const nodeModuleGlobals: {[key: string]: boolean} = {
     "require": true,
 };
 
+// The results of parseFunction, keyed by the text of the function.
+const parsedFunctions = new Map<string, [string, ParsedFunction]>();
+
 // Gets the text of the provided function (using .toString()) and massages it so that it is a legal
 // function declaration.  Note: this ties us heavily to V8 and its representation for functions.  In
 // particular, it has expectations around how functions/lambdas/methods/generators/constructors etc.
 // are represented.  If these change, this will likely break us.
 /** @internal */
 export function parseFunction(funcString: string): [string, ParsedFunction] {
+    // Parsing depends only on the text of the function, and programs frequently serialize many closures that share
+    // the same code, so the result for each distinct function text is kept for the life of the process. Callers must
+    // treat the result as read-only.
+    let result = parsedFunctions.get(funcString);
+    if (result === undefined) {
+        result = parseFunctionWorker(funcString);
+        parsedFunctions.set(funcString, result);
+    }
+    return result;
+}
+
+function parseFunctionWorker(funcString: string): [string, ParsedFunction] {
     const [error, functionCode] = parseFunctionCode(funcString);
     if (error) {
         return [error, <any>undefined];
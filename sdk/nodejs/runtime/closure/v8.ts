@@ -44,9 +44,32 @@ const versionSpecificV8Module =  v8Hooks.isNodeAtLeastV11 ? v8_v11andHigher : v8
  */
 export const lookupCapturedVariableValueAsync = versionSpecificV8Module.lookupCapturedVariableValueAsync;
 
+/**
+ * Given a function, returns a function that looks up the values of free variables in the scope chain of the provided
+ * function, with the same semantics as `lookupCapturedVariableValueAsync`. The scope chain is only inspected once, so
+ * this should be preferred when looking up several variables captured by the same function.
+ *
+ * @param func The function whose scope chain is to be analyzed
+ * @internal
+ */
+export const getCapturedVariableLookupAsync = versionSpecificV8Module.getCapturedVariableLookupAsync;
+
+/** @internal */
+export type CapturedVariableLookup = (freeVariable: string, throwOnFailure: boolean) => any;
+
+// A function's location never changes, so we only query the runtime for it once.
+const functionLocations = new WeakMap<Function, Promise<{ file: string, line: number, column: number }>>();
+
 /**
  * Given a function, returns the file, line and column number in the file where this function was
  * defined. Returns { "", 0, 0 } if the location cannot be found or if the given function has no Script.
  * @internal
  */
-export const getFunctionLocationAsync = versionSpecificV8Module.getFunctionLocationAsync;
+export function getFunctionLocationAsync(func: Function): Promise<{ file: string, line: number, column: number }> {
+    let location = functionLocations.get(func);
+    if (location === undefined) {
+        location = versionSpecificV8Module.getFunctionLocationAsync(func);
+        functionLocations.set(func, location);
+    }
+    return location;
+}
@@ -118,6 +118,18 @@ function scriptPositionInfo(script: V8Script, pos: V8SourcePosition): {line: num
 export async function lookupCapturedVariableValueAsync(
     func: Function, freeVariable: string, throwOnFailure: boolean): Promise<any> {
 
+    return lookupCapturedVariableValue(func, freeVariable, throwOnFailure);
+}
+
+/** @internal */
+export async function getCapturedVariableLookupAsync(
+    func: Function): Promise<(freeVariable: string, throwOnFailure: boolean) => any> {
+
+    // The intrinsics are synchronous and cheap, so there is nothing to share between lookups.
+    return (freeVariable, throwOnFailure) => lookupCapturedVariableValue(func, freeVariable, throwOnFailure);
+}
+
+function lookupCapturedVariableValue(func: Function, freeVariable: string, throwOnFailure: boolean): any {
     // The implementation of this function is now very straightforward since the intrinsics do all of the
     // difficult work.
     const count = getFunctionScopeCount(func);
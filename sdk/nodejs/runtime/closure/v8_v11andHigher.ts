@@ -48,6 +48,38 @@ export async function getFunctionLocationAsync(func: Function) {
 export async function lookupCapturedVariableValueAsync(
     func: Function, freeVariable: string, throwOnFailure: boolean): Promise<any> {
 
+    const lookup = await getCapturedVariableLookupAsync(func);
+    return lookup(freeVariable, throwOnFailure);
+}
+
+/** @internal */
+export async function getCapturedVariableLookupAsync(
+    func: Function): Promise<(freeVariable: string, throwOnFailure: boolean) => any> {
+
+    // Finding the scope chain takes several round trips through the inspector, so we do it once and then look up
+    // each variable in the result.
+    const scopesArray = await getFunctionScopesAsync(func);
+    return (freeVariable, throwOnFailure) => {
+        // scopesArray is ordered from innermost to outermost.
+        for (let i = 0, n = scopesArray.length; i < n; i++) {
+            const scope = scopesArray[i];
+            if (scope.object) {
+                if (freeVariable in scope.object) {
+                    const val = scope.object[freeVariable];
+                    return val;
+                }
+            }
+        }
+
+        if (throwOnFailure) {
+            throw new Error("Unexpected missing variable in closure environment: " + freeVariable);
+        }
+
+        return undefined;
+    };
+}
+
+async function getFunctionScopesAsync(func: Function): Promise<{ object?: Record<string, any> }[]> {
     // First, find the runtime's internal id for this function.
     const functionId = await getRuntimeIdForFunctionAsync(func);
 
@@ -76,24 +108,7 @@ export async function lookupCapturedVariableValueAsync(
     // object.  So we can't call things like .hasOwnProperty on it.  However, the values pointed to
     // by 'object' are the real in-memory JS objects we are looking for.  So we can find and return
     // those successfully to our caller.
-    const scopesArray: { object?: Record<string, any> }[] = await getValueForObjectId(scopes.value.objectId);
-
-    // scopesArray is ordered from innermost to outermost.
-    for (let i = 0, n = scopesArray.length; i < n; i++) {
-        const scope = scopesArray[i];
-        if (scope.object) {
-            if (freeVariable in scope.object) {
-                const val = scope.object[freeVariable];
-                return val;
-            }
-        }
-    }
-
-    if (throwOnFailure) {
-        throw new Error("Unexpected missing variable in closure environment: " + freeVariable);
-    }
-
-    return undefined;
+    return getValueForObjectId(scopes.value.objectId);
 }
 
 // We want to call util.promisify on inspector.Session.post. However, due to all the overloads of
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+import { EventEmitter } from "events";
+
 import { deserializeProperties, serializeProperties } from "./rpc";
 import { getProject, getStack, setMockOptions } from "./settings";
 
@@ -191,6 +193,25 @@ export class MockMonitor {
         }
     }
 
+    public registerResources(req: any): EventEmitter {
+        // Respond to each registration as it completes. As with the engine, a failed registration fails the stream.
+        const stream = new EventEmitter();
+        const registrations = req.getRequestsList().map((r: any, index: number) => new Promise<void>(resolve =>
+            this.registerResource(r, (err: any, innerResponse: any) => {
+                if (err) {
+                    stream.emit("error", err);
+                } else {
+                    const response = new resproto.RegisterResourcesResponse();
+                    response.setIndex(index);
+                    response.setResponse(innerResponse);
+                    stream.emit("data", response);
+                }
+                resolve();
+            })));
+        Promise.all(registrations).then(() => stream.emit("end"));
+        return stream;
+    }
+
     public registerResourceOutputs(req: any, callback: (err: any, innerResponse: any) => void) {
         try {
             const registeredResource = this.resources.get(req.getUrn());
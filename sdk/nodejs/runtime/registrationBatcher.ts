@@ -0,0 +1,130 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import * as log from "../log";
+import { monitorSupportsFeature } from "./settings";
+
+const resproto = require("../proto/resource_pb.js");
+
+/**
+ * The maximum number of registrations that are sent in a single RegisterResources call.
+ */
+export const maxRegistrationBatchSize = 256;
+
+/**
+ * RegistrationCallback receives the result of a resource registration, in the form used by the resource monitor's
+ * registerResource method.
+ */
+export type RegistrationCallback = (err: any, resp: any) => void;
+
+interface PendingRegistration {
+    req: any;
+    callback: RegistrationCallback;
+}
+
+/**
+ * RegistrationBatcher coalesces resource registrations that are ready at the same time into a single
+ * RegisterResources call. Programs that declare many resources at once would otherwise pay for one round trip to the
+ * resource monitor per resource.
+ *
+ * The batcher never delays a registration in the hope of filling a batch: each batch contains the registrations that
+ * became ready during the same turn of the event loop.
+ */
+export class RegistrationBatcher {
+    private pending: PendingRegistration[] = [];
+    private flushScheduled = false;
+
+    constructor(readonly monitor: any) {
+    }
+
+    /**
+     * register sends the given registration to the resource monitor as part of the next batch and calls callback with
+     * its response, or with the error that failed its batch.
+     */
+    public register(req: any, callback: RegistrationCallback): void {
+        this.pending.push({ req, callback });
+        if (!this.flushScheduled) {
+            this.flushScheduled = true;
+            setImmediate(() => this.flush());
+        }
+    }
+
+    private flush(): void {
+        this.flushScheduled = false;
+        const pending = this.pending;
+        this.pending = [];
+        for (let i = 0; i < pending.length; i += maxRegistrationBatchSize) {
+            this.send(pending.slice(i, i + maxRegistrationBatchSize));
+        }
+    }
+
+    private send(batch: PendingRegistration[]): void {
+        if (batch.length === 1) {
+            this.monitor.registerResource(batch[0].req, batch[0].callback);
+            return;
+        }
+
+        log.debug(`RegisterResources(#reqs=${batch.length}): RPC call being made`);
+
+        const req = new resproto.RegisterResourcesRequest();
+        req.setRequestsList(batch.map(p => p.req));
+
+        // Deliver each response as it arrives. If the stream fails or ends early, every registration that is still
+        // outstanding fails with the stream's error.
+        const outstanding: (PendingRegistration | undefined)[] = batch.slice();
+        const fail = (err: any) => {
+            for (let i = 0; i < outstanding.length; i++) {
+                const p = outstanding[i];
+                if (p) {
+                    outstanding[i] = undefined;
+                    p.callback(err, undefined);
+                }
+            }
+        };
+
+        const stream = this.monitor.registerResources(req);
+        stream.on("data", (resp: any) => {
+            const index = resp.getIndex();
+            const p = outstanding[index];
+            if (!p) {
+                fail(new Error(`RegisterResources: unexpected response index ${index}`));
+                return;
+            }
+            outstanding[index] = undefined;
+            p.callback(undefined, resp.getResponse());
+        });
+        stream.on("error", fail);
+        stream.on("end", () =>
+            fail(new Error("RegisterResources: resource monitor did not respond to every registration")));
+    }
+}
+
+let batcher: RegistrationBatcher | undefined;
+
+/**
+ * getRegistrationFunction returns the function that registers resources with the given resource monitor. If the monitor
+ * supports batched registrations, registrations are sent as part of a batch; otherwise each is sent on its own.
+ */
+export async function getRegistrationFunction(
+    monitor: any): Promise<(req: any, callback: RegistrationCallback) => void> {
+    if (!await monitorSupportsFeature("registerResourceBatches")) {
+        return (req, callback) => monitor.registerResource(req, callback);
+    }
+
+    if (!batcher || batcher.monitor !== monitor) {
+        batcher = new RegistrationBatcher(monitor);
+    }
+    const b = batcher;
+    return (req, callback) => b.register(req, callback);
+}
@@ -34,6 +34,7 @@ import {
 } from "../resource";
 import { debuggablePromise } from "./debuggable";
 import { invoke } from "./invoke";
+import { getRegistrationFunction } from "./registrationBatcher";
 
 import {
     deserializeProperties,
@@ -345,9 +346,11 @@ export function registerResource(res: Resource, t: string, name: string, custom:
             let err: Error | undefined;
             try {
                 if (monitor) {
-                    // If we're running with an attachment to the engine, perform the operation.
+                    // If we're running with an attachment to the engine, perform the operation. Registrations are
+                    // batched with any others that are ready at the same time if the monitor supports it.
+                    const register = await getRegistrationFunction(monitor);
                     resp = await debuggablePromise(new Promise((resolve, reject) =>
-                        (monitor as any).registerResource(req, (rpcErr: grpc.ServiceError, innerResponse: any) => {
+                        register(req, (rpcErr: grpc.ServiceError, innerResponse: any) => {
                             if (rpcErr) {
                                 err = rpcErr;
                                 // If the monitor is unavailable, it is in the process of shutting down or has already
@@ -539,13 +542,17 @@ async function prepareResource(label: string, res: Resource, custom: boolean, re
     // The list of all dependencies (implicit or explicit).
     const allDirectDependencies = new Set<Resource>(explicitDirectDependencies);
 
-    const allDirectDependencyURNs = await getAllTransitivelyReferencedResourceURNs(explicitDirectDependencies);
+    // Properties frequently depend on the same resources, so the URNs reachable from each dependency are only
+    // computed once.
+    const dependencyURNs = new Map<Resource, Promise<URN[]>>();
+    const allDirectDependencyURNs = await getAllTransitivelyReferencedResourceURNs(
+        explicitDirectDependencies, dependencyURNs);
     const propertyToDirectDependencyURNs = new Map<string, Set<URN>>();
 
     for (const [propertyName, directDependencies] of propertyToDirectDependencies) {
         addAll(allDirectDependencies, directDependencies);
 
-        const urns = await getAllTransitivelyReferencedResourceURNs(directDependencies);
+        const urns = await getAllTransitivelyReferencedResourceURNs(directDependencies, dependencyURNs);
         addAll(allDirectDependencyURNs, urns);
         propertyToDirectDependencyURNs.set(propertyName, urns);
     }
@@ -584,8 +591,34 @@ function addAll<T>(to: Set<T>, from: Set<T>) {
     }
 }
 
-async function getAllTransitivelyReferencedResourceURNs(resources: Set<Resource>): Promise<Set<string>> {
-    // Go through 'resources', but transitively walk through **Component** resources, collecting any
+/**
+ * getAllTransitivelyReferencedResourceURNs returns the URNs of the custom and remote resources that are reachable from
+ * the given resources. If a cache is provided, the URNs reachable from each resource are computed at most once.
+ */
+async function getAllTransitivelyReferencedResourceURNs(resources: Set<Resource>,
+                                                        cache?: Map<Resource, Promise<URN[]>>): Promise<Set<string>> {
+    const urns = await Promise.all([...resources].map(r => {
+        let result = cache ? cache.get(r) : undefined;
+        if (result === undefined) {
+            result = getTransitivelyReferencedResourceURNs(r);
+            if (cache) {
+                cache.set(r, result);
+            }
+        }
+        return result;
+    }));
+
+    const result = new Set<string>();
+    for (const reachableURNs of urns) {
+        for (const urn of reachableURNs) {
+            result.add(urn);
+        }
+    }
+    return result;
+}
+
+async function getTransitivelyReferencedResourceURNs(resource: Resource): Promise<URN[]> {
+    // Go through 'resource', but transitively walk through **Component** resources, collecting any
     // of their child resources.  This way, a Component acts as an aggregation really of all the
     // reachable resources it parents.  This walking will stop when it hits custom resources.
     //
@@ -613,15 +646,27 @@ async function getAllTransitivelyReferencedResourceURNs(resources: Set<Resource>
     // To do this, first we just get the transitively reachable set of resources (not diving
     // into custom resources).  In the above picture, if we start with 'Comp1', this will be
     // [Comp1, Cust1, Comp2, Cust2, Cust3]
-    const transitivelyReachableResources = await getTransitivelyReferencedChildResourcesOfComponentResources(resources);
+    const transitivelyReachableResources =
+        await getTransitivelyReferencedChildResourcesOfComponentResources(new Set([resource]));
 
     // Then we filter to only include Custom and Remote resources.
     const transitivelyReachableCustomResources =
         [...transitivelyReachableResources]
         .filter(r => CustomResource.isInstance(r) || (r as ComponentResource).__remote);
-    const promises = transitivelyReachableCustomResources.map(r => r.urn.promise());
-    const urns = await Promise.all(promises);
-    return new Set<string>(urns);
+    return Promise.all(transitivelyReachableCustomResources.map(getResourceURN));
+}
+
+// resourceURNs caches the URN of each resource. A resource's URN never changes once it has been registered, and
+// resources are frequently depended upon by many others.
+const resourceURNs = new WeakMap<Resource, Promise<URN>>();
+
+function getResourceURN(res: Resource): Promise<URN> {
+    let urn = resourceURNs.get(res);
+    if (urn === undefined) {
+        urn = res.urn.promise();
+        resourceURNs.set(res, urn);
+    }
+    return urn;
 }
 
 /**
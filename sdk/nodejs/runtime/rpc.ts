@@ -283,18 +283,27 @@ export async function serializeProperty(ctx: string, prop: Input<any>, dependent
     // IMPORTANT: Keep this in sync with serializePropertiesSync in invoke.ts
     // IMPORTANT:
 
-    if (prop === undefined ||
-        prop === null ||
-        typeof prop === "boolean" ||
-        typeof prop === "number" ||
-        typeof prop === "string") {
-
+    // Values that consist solely of primitives, arrays, and plain objects are serialized synchronously. This avoids
+    // awaiting through every level of what are usually large literal values.
+    const notPlain = new Set<any>();
+    const plain = serializePlainValue(prop, notPlain);
+    if (plain !== notPlainValue) {
         if (excessiveDebugOutput) {
-            log.debug(`Serialize property [${ctx}]: primitive=${prop}`);
+            log.debug(`Serialize property [${ctx}]: plain value`);
         }
-        return prop;
+        return plain;
     }
+    return serializePropertyAsync(ctx, prop, dependentResources, notPlain);
+}
 
+/**
+ * serializePropertyAsync serializes a property that serializePlainValue has already found cannot be serialized
+ * synchronously. The elements of arrays and objects are serialized synchronously where possible. notPlain holds the
+ * arrays and objects that serializePlainValue has found not to be plain, which are passed straight back to
+ * serializePropertyAsync rather than being walked again.
+ */
+async function serializePropertyAsync(ctx: string, prop: Input<any>, dependentResources: Set<Resource>,
+                                      notPlain: Set<any>): Promise<any> {
     if (asset.Asset.isInstance(prop) || asset.Archive.isInstance(prop)) {
         // Serializing an asset or archive requires the use of a magical signature key, since otherwise it would look
         // like any old weakly typed object/map when received by the other side of the RPC boundary.
@@ -418,7 +427,11 @@ export async function serializeProperty(ctx: string, prop: Input<any>, dependent
                 log.debug(`Serialize property [${ctx}]: array[${i}] element`);
             }
             // When serializing arrays, we serialize any undefined values as `null`. This matches JSON semantics.
-            const elem = await serializeProperty(`${ctx}[${i}]`, prop[i], dependentResources);
+            const value = prop[i];
+            let elem = notPlain.has(value) ? notPlainValue : serializePlainValue(value, notPlain);
+            if (elem === notPlainValue) {
+                elem = await serializePropertyAsync(`${ctx}[${i}]`, value, dependentResources, notPlain);
+            }
             result.push(elem === undefined ? null : elem);
         }
         return result;
@@ -433,7 +446,11 @@ export async function serializeProperty(ctx: string, prop: Input<any>, dependent
             }
 
             // When serializing an object, we omit any keys with undefined values. This matches JSON semantics.
-            const v = await serializeProperty(`${ctx}.${k}`, innerProp[k], dependentResources);
+            const value = innerProp[k];
+            let v = notPlain.has(value) ? notPlainValue : serializePlainValue(value, notPlain);
+            if (v === notPlainValue) {
+                v = await serializePropertyAsync(`${ctx}.${k}`, value, dependentResources, notPlain);
+            }
             if (v !== undefined) {
                 obj[k] = v;
             }
@@ -443,6 +460,65 @@ export async function serializeProperty(ctx: string, prop: Input<any>, dependent
     }
 }
 
+/**
+ * notPlainValue is returned by serializePlainValue for values that cannot be serialized synchronously.
+ */
+const notPlainValue = {};
+
+/**
+ * serializePlainValue synchronously serializes a value that consists solely of primitives, arrays, and plain objects.
+ * If the value contains anything else (e.g. a Promise, an Output, a Resource, or an Asset), notPlainValue is returned
+ * and the value must be serialized with serializePropertyAsync instead. Every array and object that is found not to be
+ * plain is added to notPlain.
+ */
+function serializePlainValue(prop: any, notPlain: Set<any>): any {
+    if (prop === undefined ||
+        prop === null ||
+        typeof prop === "boolean" ||
+        typeof prop === "number" ||
+        typeof prop === "string") {
+        return prop;
+    }
+
+    if (prop instanceof Array) {
+        const result: any[] = [];
+        for (const elem of prop) {
+            const v = serializePlainValue(elem, notPlain);
+            if (v === notPlainValue) {
+                notPlain.add(prop);
+                return notPlainValue;
+            }
+            // As in serializeProperty, undefined array elements are serialized as `null`.
+            result.push(v === undefined ? null : v);
+        }
+        return result;
+    }
+
+    // Only objects created by object literals (or with a null prototype) are plain. Instances of classes may be
+    // Outputs, Resources, Assets, or other values that serializeProperty handles specially.
+    if (typeof prop !== "object") {
+        return notPlainValue;
+    }
+    const proto = Object.getPrototypeOf(prop);
+    if (proto !== Object.prototype && proto !== null) {
+        return notPlainValue;
+    }
+
+    const obj: any = {};
+    for (const k of Object.keys(prop)) {
+        const v = serializePlainValue(prop[k], notPlain);
+        if (v === notPlainValue) {
+            notPlain.add(prop);
+            return notPlainValue;
+        }
+        // As in serializeProperty, object keys with undefined values are omitted.
+        if (v !== undefined) {
+            obj[k] = v;
+        }
+    }
+    return obj;
+}
+
 /**
  * isRpcSecret returns true if obj is a wrapped secret value (i.e. it's an object with the special key set).
  */
@@ -13,7 +13,7 @@
 // limitations under the License.
 
 import * as assert from "assert";
-import { ComponentResource, CustomResource, Inputs, Resource, ResourceOptions, runtime, secret } from "../../index";
+import { ComponentResource, CustomResource, Inputs, output, Resource, ResourceOptions, runtime, secret } from "../../index";
 import { asyncTest } from "../util";
 
 const gstruct = require("google-protobuf/google/protobuf/struct_pb.js");
@@ -119,6 +119,10 @@ interface TestInputs {
     boolEnum: TestBoolEnum;
 }
 
+class TestClass {
+    public readonly g = "h";
+}
+
 describe("runtime", () => {
     beforeEach(() => {
         runtime._reset();
@@ -261,6 +265,63 @@ describe("runtime", () => {
         }));
     });
 
+    describe("serializeProperty", () => {
+        it("serializes plain values", asyncTest(async () => {
+            const value = {
+                "aNum": 42,
+                "bArr": [ "x", undefined, { "c": null, "d": undefined } ],
+                "eObj": { "f": [] },
+                "gUnd": undefined,
+            };
+            const deps = new Set<Resource>();
+            const result = await runtime.serializeProperty("test", value, deps);
+            assert.deepStrictEqual(result, {
+                "aNum": 42,
+                "bArr": [ "x", null, { "c": null } ],
+                "eObj": { "f": [] },
+            });
+            assert.notStrictEqual(result.bArr, value.bArr);
+            assert.strictEqual(deps.size, 0);
+        }));
+        it("serializes plain values that contain promises and outputs", asyncTest(async () => {
+            const value = {
+                "aArr": [ "x", Promise.resolve([ 1, undefined ]) ],
+                "bObj": { "c": output({ "d": "e" }), "f": new TestClass() },
+            };
+            const result = await runtime.serializeProperty("test", value, new Set<Resource>());
+            assert.deepStrictEqual(result, {
+                "aArr": [ "x", [ 1, null ] ],
+                "bObj": { "c": { "d": "e" }, "f": { "g": "h" } },
+            });
+        }));
+        it("walks plain values once when a deeply nested value is not plain", asyncTest(async () => {
+            // Each level has a plain sibling, and only the innermost level holds an output.
+            const depth = 50;
+            let reads = 0;
+            let value: any = { "leaf": output("x") };
+            for (let i = 0; i < depth; i++) {
+                value = {
+                    get plain() {
+                        reads++;
+                        return [ i ];
+                    },
+                    "next": [ value ],
+                };
+            }
+
+            let result = await runtime.serializeProperty("test", value, new Set<Resource>());
+            for (let i = depth - 1; i >= 0; i--) {
+                assert.deepStrictEqual(result.plain, [ i ]);
+                result = result.next[0];
+            }
+            assert.deepStrictEqual(result, { "leaf": "x" });
+
+            // Each plain sibling is read once by the synchronous attempt and once more when it is serialized, however
+            // deeply it is nested.
+            assert.strictEqual(reads, 2 * depth);
+        }));
+    });
+
     describe("deserializeProperty", () => {
         it("fails on unsupported secret values", () => {
             assert.throws(() => runtime.deserializeProperty({
@@ -0,0 +1,162 @@
+// Copyright 2016-2021, Pulumi Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import * as assert from "assert";
+import { EventEmitter } from "events";
+import { maxRegistrationBatchSize, RegistrationBatcher } from "../../runtime/registrationBatcher";
+import { asyncTest } from "../util";
+
+const resproto = require("../../proto/resource_pb.js");
+
+function newRequest(name: string): any {
+    const req = new resproto.RegisterResourceRequest();
+    req.setName(name);
+    return req;
+}
+
+function newResponse(name: string): any {
+    const resp = new resproto.RegisterResourceResponse();
+    resp.setUrn(`urn:${name}`);
+    return resp;
+}
+
+// TestMonitor records the registrations that it receives. Single registrations succeed on the next turn of the event
+// loop; batches are answered by the test through the batch's stream.
+class TestMonitor {
+    public singles: string[] = [];
+    public batches: string[][] = [];
+    public streams: EventEmitter[] = [];
+
+    public registerResource(req: any, callback: (err: any, resp: any) => void) {
+        this.singles.push(req.getName());
+        setImmediate(() => callback(undefined, newResponse(req.getName())));
+    }
+
+    public registerResources(req: any): EventEmitter {
+        const stream = new EventEmitter();
+        this.batches.push(req.getRequestsList().map((r: any) => r.getName()));
+        this.streams.push(stream);
+        return stream;
+    }
+}
+
+function respond(stream: EventEmitter, index: number, name: string) {
+    const resp = new resproto.RegisterResourcesResponse();
+    resp.setIndex(index);
+    resp.setResponse(newResponse(name));
+    stream.emit("data", resp);
+}
+
+function register(batcher: RegistrationBatcher, name: string): Promise<string> {
+    return new Promise((resolve, reject) => batcher.register(newRequest(name), (err: any, resp: any) => {
+        if (err) {
+            reject(err);
+        } else {
+            resolve(resp.getUrn());
+        }
+    }));
+}
+
+function nextTurn(): Promise<void> {
+    return new Promise(resolve => setImmediate(resolve));
+}
+
+describe("RegistrationBatcher", () => {
+    it("sends a lone registration with RegisterResource", asyncTest(async () => {
+        const monitor = new TestMonitor();
+        const batcher = new RegistrationBatcher(monitor);
+
+        assert.strictEqual(await register(batcher, "a"), "urn:a");
+        assert.deepStrictEqual(monitor.singles, ["a"]);
+        assert.deepStrictEqual(monitor.batches, []);
+    }));
+
+    it("batches registrations that are ready at the same time", asyncTest(async () => {
+        const monitor = new TestMonitor();
+        const batcher = new RegistrationBatcher(monitor);
+
+        const results = [register(batcher, "a"), register(batcher, "b"), register(batcher, "c")];
+        await nextTurn();
+        assert.deepStrictEqual(monitor.batches, [["a", "b", "c"]]);
+
+        // Responses may arrive in any order.
+        const stream = monitor.streams[0];
+        respond(stream, 2, "c");
+        respond(stream, 0, "a");
+        respond(stream, 1, "b");
+        stream.emit("end");
+        assert.deepStrictEqual(await Promise.all(results), ["urn:a", "urn:b", "urn:c"]);
+
+        // Registrations that become ready later are sent in a later batch.
+        const later = [register(batcher, "d"), register(batcher, "e")];
+        await nextTurn();
+        assert.deepStrictEqual(monitor.batches, [["a", "b", "c"], ["d", "e"]]);
+        respond(monitor.streams[1], 0, "d");
+        respond(monitor.streams[1], 1, "e");
+        monitor.streams[1].emit("end");
+        assert.deepStrictEqual(await Promise.all(later), ["urn:d", "urn:e"]);
+        assert.deepStrictEqual(monitor.singles, []);
+    }));
+
+    it("limits the size of batches", asyncTest(async () => {
+        const monitor = new TestMonitor();
+        const batcher = new RegistrationBatcher(monitor);
+
+        const names: string[] = [];
+        for (let i = 0; i <= maxRegistrationBatchSize; i++) {
+            names.push(`r${i}`);
+        }
+        const results = names.map(name => register(batcher, name));
+        await nextTurn();
+
+        assert.strictEqual(monitor.batches.length, 1);
+        assert.deepStrictEqual(monitor.batches[0], names.slice(0, maxRegistrationBatchSize));
+        assert.deepStrictEqual(monitor.singles, [names[maxRegistrationBatchSize]]);
+
+        names.slice(0, maxRegistrationBatchSize).forEach((name, i) => respond(monitor.streams[0], i, name));
+        monitor.streams[0].emit("end");
+        assert.deepStrictEqual(await Promise.all(results), names.map(name => `urn:${name}`));
+    }));
+
+    it("fails outstanding registrations when the stream fails", asyncTest(async () => {
+        const monitor = new TestMonitor();
+        const batcher = new RegistrationBatcher(monitor);
+
+        const a = register(batcher, "a");
+        const b = register(batcher, "b");
+        await nextTurn();
+
+        const err = new Error("monitor unavailable");
+        respond(monitor.streams[0], 0, "a");
+        monitor.streams[0].emit("error", err);
+
+        assert.strictEqual(await a, "urn:a");
+        await assert.rejects(b, err);
+    }));
+
+    it("fails registrations that receive no response", asyncTest(async () => {
+        const monitor = new TestMonitor();
+        const batcher = new RegistrationBatcher(monitor);
+
+        const a = register(batcher, "a");
+        const b = register(batcher, "b");
+        await nextTurn();
+
+        respond(monitor.streams[0], 1, "b");
+        monitor.streams[0].emit("end");
+
+        await assert.rejects(a, /did not respond to every registration/);
+        assert.strictEqual(await b, "urn:b");
+    }));
+});
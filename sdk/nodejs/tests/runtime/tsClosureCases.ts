@@ -1229,6 +1229,44 @@ return function () { return mutable; };
         });
     }
 
+    {
+        let reassigned = 1;
+        const func = function() { return reassigned; };
+        cases.push({
+            title: "Serialize reassigned variables by value at the time of capture (pre-reassignment)",
+            func,
+            expectText: `exports.handler = __f0;
+
+function __f0() {
+  return (function() {
+    with({ reassigned: 1 }) {
+
+return function () { return reassigned; };
+
+    }
+  }).apply(undefined, undefined).apply(this, arguments);
+}
+`,
+            afters: [{
+                pre: () => { reassigned = 2; },
+                title: "Serialize reassigned variables by value at the time of capture (post-reassignment)",
+                func,
+                expectText: `exports.handler = __f0;
+
+function __f0() {
+  return (function() {
+    with({ reassigned: 2 }) {
+
+return function () { return reassigned; };
+
+    }
+  }).apply(undefined, undefined).apply(this, arguments);
+}
+`,
+            }],
+        });
+    }
+
     {
         const v = { d: output(4) };
         cases.push({
@@ -773,6 +773,96 @@ func (m *RegisterResourceOutputsRequest) GetOutputs() *_struct.Struct {
 	return nil
 }
 
+// RegisterResourcesRequest contains a batch of resource registrations. The registrations are processed in order, as if
+// each had been sent in its own RegisterResource call.
+type RegisterResourcesRequest struct {
+	Requests             []*RegisterResourceRequest `protobuf:"bytes,1,rep,name=requests,proto3" json:"requests,omitempty"`
+	XXX_NoUnkeyedLiteral struct{}                   `json:"-"`
+	XXX_unrecognized     []byte                     `json:"-"`
+	XXX_sizecache        int32                      `json:"-"`
+}
+
+func (m *RegisterResourcesRequest) Reset()         { *m = RegisterResourcesRequest{} }
+func (m *RegisterResourcesRequest) String() string { return proto.CompactTextString(m) }
+func (*RegisterResourcesRequest) ProtoMessage()    {}
+func (*RegisterResourcesRequest) Descriptor() ([]byte, []int) {
+	return fileDescriptor_d1b72f771c35e3b8, []int{7}
+}
+
+func (m *RegisterResourcesRequest) XXX_Unmarshal(b []byte) error {
+	return xxx_messageInfo_RegisterResourcesRequest.Unmarshal(m, b)
+}
+func (m *RegisterResourcesRequest) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	return xxx_messageInfo_RegisterResourcesRequest.Marshal(b, m, deterministic)
+}
+func (m *RegisterResourcesRequest) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_RegisterResourcesRequest.Merge(m, src)
+}
+func (m *RegisterResourcesRequest) XXX_Size() int {
+	return xxx_messageInfo_RegisterResourcesRequest.Size(m)
+}
+func (m *RegisterResourcesRequest) XXX_DiscardUnknown() {
+	xxx_messageInfo_RegisterResourcesRequest.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_RegisterResourcesRequest proto.InternalMessageInfo
+
+func (m *RegisterResourcesRequest) GetRequests() []*RegisterResourceRequest {
+	if m != nil {
+		return m.Requests
+	}
+	return nil
+}
+
+// RegisterResourcesResponse is sent once for each registration in a RegisterResourcesRequest, in the order in which the
+// registrations complete.
+type RegisterResourcesResponse struct {
+	Index                int32                     `protobuf:"varint,1,opt,name=index,proto3" json:"index,omitempty"`
+	Response             *RegisterResourceResponse `protobuf:"bytes,2,opt,name=response,proto3" json:"response,omitempty"`
+	XXX_NoUnkeyedLiteral struct{}                  `json:"-"`
+	XXX_unrecognized     []byte                    `json:"-"`
+	XXX_sizecache        int32                     `json:"-"`
+}
+
+func (m *RegisterResourcesResponse) Reset()         { *m = RegisterResourcesResponse{} }
+func (m *RegisterResourcesResponse) String() string { return proto.CompactTextString(m) }
+func (*RegisterResourcesResponse) ProtoMessage()    {}
+func (*RegisterResourcesResponse) Descriptor() ([]byte, []int) {
+	return fileDescriptor_d1b72f771c35e3b8, []int{8}
+}
+
+func (m *RegisterResourcesResponse) XXX_Unmarshal(b []byte) error {
+	return xxx_messageInfo_RegisterResourcesResponse.Unmarshal(m, b)
+}
+func (m *RegisterResourcesResponse) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	return xxx_messageInfo_RegisterResourcesResponse.Marshal(b, m, deterministic)
+}
+func (m *RegisterResourcesResponse) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_RegisterResourcesResponse.Merge(m, src)
+}
+func (m *RegisterResourcesResponse) XXX_Size() int {
+	return xxx_messageInfo_RegisterResourcesResponse.Size(m)
+}
+func (m *RegisterResourcesResponse) XXX_DiscardUnknown() {
+	xxx_messageInfo_RegisterResourcesResponse.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_RegisterResourcesResponse proto.InternalMessageInfo
+
+func (m *RegisterResourcesResponse) GetIndex() int32 {
+	if m != nil {
+		return m.Index
+	}
+	return 0
+}
+
+func (m *RegisterResourcesResponse) GetResponse() *RegisterResourceResponse {
+	if m != nil {
+		return m.Response
+	}
+	return nil
+}
+
 func init() {
 	proto.RegisterType((*SupportsFeatureRequest)(nil), "pulumirpc.SupportsFeatureRequest")
 	proto.RegisterType((*SupportsFeatureResponse)(nil), "pulumirpc.SupportsFeatureResponse")
@@ -787,76 +877,81 @@ func init() {
 	proto.RegisterMapType((map[string]*RegisterResourceResponse_PropertyDependencies)(nil), "pulumirpc.RegisterResourceResponse.PropertyDependenciesEntry")
 	proto.RegisterType((*RegisterResourceResponse_PropertyDependencies)(nil), "pulumirpc.RegisterResourceResponse.PropertyDependencies")
 	proto.RegisterType((*RegisterResourceOutputsRequest)(nil), "pulumirpc.RegisterResourceOutputsRequest")
+	proto.RegisterType((*RegisterResourcesRequest)(nil), "pulumirpc.RegisterResourcesRequest")
+	proto.RegisterType((*RegisterResourcesResponse)(nil), "pulumirpc.RegisterResourcesResponse")
 }
 
 func init() { proto.RegisterFile("resource.proto", fileDescriptor_d1b72f771c35e3b8) }
 
 var fileDescriptor_d1b72f771c35e3b8 = []byte{
-	// 1010 bytes of a gzipped FileDescriptorProto
-	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xa4, 0x57, 0x5f, 0x6f, 0x1b, 0x45,
-	0x10, 0x8f, 0xed, 0xd4, 0xb1, 0x27, 0xa9, 0x13, 0x36, 0xa9, 0xbd, 0x3d, 0x50, 0x08, 0x07, 0x0f,
-	0xa6, 0x0f, 0x4e, 0x13, 0x90, 0x9a, 0xa2, 0x02, 0x12, 0x69, 0x41, 0x7d, 0x28, 0x29, 0x17, 0x84,
-	0x00, 0x09, 0xa4, 0x8d, 0x6f, 0x92, 0x1e, 0x39, 0xdf, 0x5e, 0x77, 0xf7, 0x22, 0xf9, 0x0d, 0xbe,
-	0x07, 0x9f, 0x06, 0xf1, 0xca, 0x77, 0x42, 0xbb, 0x7b, 0xeb, 0xde, 0xf9, 0xce, 0x89, 0xd3, 0xbe,
-	0xdd, 0xfc, 0xe6, 0x9f, 0x77, 0xe6, 0x37, 0xb3, 0x6b, 0xe8, 0x09, 0x94, 0x3c, 0x13, 0x63, 0x1c,
-	0xa5, 0x82, 0x2b, 0x4e, 0xba, 0x69, 0x16, 0x67, 0x93, 0x48, 0xa4, 0x63, 0xef, 0xfd, 0x0b, 0xce,
-	0x2f, 0x62, 0xdc, 0x37, 0x8a, 0xb3, 0xec, 0x7c, 0x1f, 0x27, 0xa9, 0x9a, 0x5a, 0x3b, 0xef, 0x83,
-	0x79, 0xa5, 0x54, 0x22, 0x1b, 0xab, 0x5c, 0xdb, 0x4b, 0x05, 0xbf, 0x8a, 0x42, 0x14, 0x56, 0xf6,
-	0x87, 0xd0, 0x3f, 0xcd, 0xd2, 0x94, 0x0b, 0x25, 0xbf, 0x45, 0xa6, 0x32, 0x81, 0x01, 0xbe, 0xce,
-	0x50, 0x2a, 0xd2, 0x83, 0x66, 0x14, 0xd2, 0xc6, 0x5e, 0x63, 0xd8, 0x0d, 0x9a, 0x51, 0xe8, 0x3f,
-	0x86, 0x41, 0xc5, 0x52, 0xa6, 0x3c, 0x91, 0x48, 0x76, 0x01, 0x5e, 0x31, 0x99, 0x6b, 0x8d, 0x4b,
-	0x27, 0x28, 0x20, 0xfe, 0xdf, 0x2d, 0xd8, 0x0e, 0x90, 0x85, 0x41, 0x7e, 0xa2, 0x05, 0x29, 0x08,
-	0x81, 0x55, 0x35, 0x4d, 0x91, 0x36, 0x0d, 0x62, 0xbe, 0x35, 0x96, 0xb0, 0x09, 0xd2, 0x96, 0xc5,
-	0xf4, 0x37, 0xe9, 0x43, 0x3b, 0x65, 0x02, 0x13, 0x45, 0x57, 0x0d, 0x9a, 0x4b, 0xe4, 0x11, 0x40,
-	0x2a, 0x78, 0x8a, 0x42, 0x45, 0x28, 0xe9, 0x9d, 0xbd, 0xc6, 0x70, 0xfd, 0x70, 0x30, 0xb2, 0xf5,
-	0x18, 0xb9, 0x7a, 0x8c, 0x4e, 0x4d, 0x3d, 0x82, 0x82, 0x29, 0xf1, 0x61, 0x23, 0xc4, 0x14, 0x93,
-	0x10, 0x93, 0xb1, 0x76, 0x6d, 0xef, 0xb5, 0x86, 0xdd, 0xa0, 0x84, 0x11, 0x0f, 0x3a, 0xae, 0x76,
-	0x74, 0xcd, 0xa4, 0x9d, 0xc9, 0x84, 0xc2, 0xda, 0x15, 0x0a, 0x19, 0xf1, 0x84, 0x76, 0x8c, 0xca,
-	0x89, 0xe4, 0x13, 0xb8, 0xcb, 0xc6, 0x63, 0x4c, 0xd5, 0x29, 0x8e, 0x05, 0x2a, 0x49, 0xbb, 0xa6,
-	0x3a, 0x65, 0x90, 0x1c, 0xc1, 0x80, 0x85, 0x61, 0xa4, 0x22, 0x9e, 0xb0, 0xd8, 0x82, 0x27, 0x99,
-	0x4a, 0x33, 0x25, 0x29, 0x98, 0x9f, 0xb2, 0x48, 0xad, 0x33, 0xb3, 0x38, 0x62, 0x12, 0x25, 0x5d,
-	0x37, 0x96, 0x4e, 0x24, 0x43, 0xd8, 0xb4, 0x49, 0x5c, 0xd5, 0x25, 0xdd, 0x30, 0xb9, 0xe7, 0x61,
-	0x9f, 0xc1, 0x4e, 0xb9, 0x3b, 0x79, 0x5b, 0xb7, 0xa0, 0x95, 0x89, 0x24, 0xef, 0x8f, 0xfe, 0x9c,
-	0x2b, 0x70, 0x73, 0xe9, 0x02, 0xfb, 0xff, 0x01, 0x0c, 0x02, 0xbc, 0x88, 0xa4, 0x42, 0x31, 0xcf,
-	0x02, 0xd7, 0xf5, 0x46, 0x4d, 0xd7, 0x9b, 0xb5, 0x5d, 0x6f, 0x95, 0xba, 0xde, 0x87, 0xf6, 0x38,
-	0x93, 0x8a, 0x4f, 0x0c, 0x1b, 0x3a, 0x41, 0x2e, 0x91, 0x7d, 0x68, 0xf3, 0xb3, 0x3f, 0x70, 0xac,
-	0x6e, 0x62, 0x42, 0x6e, 0xa6, 0x6b, 0xa9, 0x55, 0xda, 0xa3, 0x6d, 0x22, 0x39, 0xb1, 0xc2, 0x8f,
-	0xb5, 0x1b, 0xf8, 0xd1, 0x99, 0xe3, 0x47, 0x0a, 0x3b, 0x79, 0x31, 0xa6, 0x4f, 0x8b, 0x71, 0xba,
-	0x7b, 0xad, 0xe1, 0xfa, 0xe1, 0x93, 0xd1, 0x6c, 0xb4, 0x47, 0x0b, 0x8a, 0x34, 0x7a, 0x59, 0xe3,
-	0xfe, 0x2c, 0x51, 0x62, 0x1a, 0xd4, 0x46, 0x26, 0x0f, 0x61, 0x3b, 0xc4, 0x18, 0x15, 0x7e, 0x83,
-	0xe7, 0x5c, 0x8f, 0x6a, 0x1a, 0xb3, 0x31, 0x52, 0x30, 0xe7, 0xaa, 0x53, 0x15, 0x39, 0xbc, 0x5e,
-	0xe1, 0x70, 0x74, 0x91, 0x70, 0x81, 0xc7, 0xaf, 0x58, 0x72, 0x61, 0x78, 0xa4, 0x8f, 0x5f, 0x06,
-	0xab, 0x4c, 0xbf, 0x7b, 0x4b, 0xa6, 0xf7, 0x96, 0x66, 0xfa, 0x66, 0x99, 0xe9, 0x1e, 0x74, 0xa2,
-	0x89, 0x5e, 0x34, 0xcf, 0x43, 0xba, 0x65, 0x2b, 0xef, 0x64, 0xf2, 0x0b, 0xf4, 0x2c, 0x1d, 0x7e,
-	0x8c, 0x26, 0xc8, 0x75, 0x9a, 0xf7, 0x0c, 0x19, 0x0e, 0x96, 0xa8, 0xf9, 0x71, 0xc9, 0x31, 0x98,
-	0x0b, 0x44, 0xbe, 0x02, 0xaf, 0xa6, 0x8e, 0x4f, 0xf1, 0x3c, 0x4a, 0x30, 0xa4, 0xc4, 0x9c, 0xfe,
-	0x1a, 0x0b, 0xf2, 0x39, 0xdc, 0x93, 0xf9, 0x42, 0x7d, 0xc9, 0x84, 0x8a, 0x58, 0xfc, 0x13, 0x8b,
-	0x33, 0x94, 0x74, 0xdb, 0xb8, 0xd6, 0x2b, 0x35, 0xdb, 0x05, 0x4e, 0xb8, 0x42, 0xba, 0x63, 0xd9,
-	0x6e, 0xa5, 0xba, 0x71, 0xbf, 0x57, 0x3b, 0xee, 0xe4, 0x04, 0xba, 0x8e, 0x98, 0x92, 0xf6, 0x0d,
-	0x03, 0x0f, 0x96, 0x63, 0xa0, 0xf5, 0xb1, 0xb4, 0x7b, 0x13, 0x83, 0x3c, 0x80, 0x2d, 0x61, 0x8f,
-	0x76, 0x92, 0x38, 0x8a, 0x0c, 0x4c, 0x8b, 0x2a, 0xb8, 0xf7, 0x00, 0x76, 0xea, 0xa8, 0xac, 0x07,
-	0x3e, 0x13, 0x89, 0xa4, 0x0d, 0xe3, 0x67, 0xbe, 0xbd, 0x9f, 0xa1, 0x57, 0x6e, 0x81, 0x19, 0x75,
-	0x81, 0x4c, 0xb9, 0x65, 0x91, 0x4b, 0x1a, 0xcf, 0xd2, 0x50, 0xe3, 0x76, 0x61, 0xe4, 0x92, 0xc6,
-	0x6d, 0x03, 0xdc, 0xca, 0xb0, 0x92, 0xf7, 0x67, 0x03, 0xee, 0x2f, 0x9c, 0x28, 0xbd, 0xf7, 0x2e,
-	0x71, 0xea, 0xf6, 0xde, 0x25, 0x4e, 0xc9, 0x0b, 0xb8, 0x73, 0xa5, 0xcb, 0x9f, 0xaf, 0xbc, 0x47,
-	0x6f, 0x39, 0xb0, 0x81, 0x8d, 0xf2, 0x45, 0xf3, 0xa8, 0xe1, 0x3d, 0x81, 0x5e, 0xb9, 0xa2, 0x35,
-	0x69, 0x77, 0x8a, 0x69, 0xbb, 0x05, 0x6f, 0xff, 0x9f, 0x16, 0xd0, 0x6a, 0xe6, 0x85, 0x7b, 0xdb,
-	0x5e, 0xb4, 0xcd, 0xd9, 0x45, 0xfb, 0x66, 0x35, 0xb6, 0x96, 0x5b, 0x8d, 0x7d, 0x68, 0x4b, 0xc5,
-	0xce, 0x62, 0x74, 0x3b, 0xd6, 0x4a, 0x7a, 0x28, 0xed, 0x97, 0xbe, 0x6e, 0xcd, 0x50, 0xe6, 0x22,
-	0x79, 0xbd, 0x60, 0xe5, 0xb5, 0x0d, 0xe1, 0xbe, 0xbc, 0xb6, 0x82, 0xf6, 0x1c, 0xb7, 0xdd, 0x79,
-	0xb7, 0xe2, 0xd6, 0x5f, 0xb7, 0x64, 0xc0, 0xf7, 0x65, 0x06, 0x1c, 0xbd, 0xed, 0xef, 0x2f, 0x36,
-	0x11, 0x61, 0x77, 0xde, 0x37, 0x5f, 0x76, 0xee, 0x6a, 0xac, 0x76, 0xf2, 0x00, 0xd6, 0x78, 0xbe,
-	0x2f, 0x6f, 0xb8, 0x7e, 0x9d, 0xdd, 0xe1, 0xbf, 0xab, 0xb0, 0xe9, 0xe2, 0xbf, 0xe0, 0x49, 0xa4,
-	0xb8, 0x20, 0xbf, 0xc2, 0xe6, 0xdc, 0x63, 0x8e, 0x7c, 0x54, 0x38, 0x52, 0xfd, 0x93, 0xd0, 0xf3,
-	0xaf, 0x33, 0xb1, 0x87, 0xf6, 0x57, 0xc8, 0xd7, 0xd0, 0x7e, 0x9e, 0x5c, 0xf1, 0x4b, 0x24, 0xb4,
-	0x60, 0x6f, 0x21, 0x17, 0xe9, 0x7e, 0x8d, 0x66, 0x16, 0xe0, 0x3b, 0xd8, 0x38, 0x55, 0x02, 0xd9,
-	0xe4, 0x9d, 0xc2, 0x3c, 0x6c, 0x90, 0xc7, 0xb0, 0x7a, 0xcc, 0xe2, 0x98, 0xf4, 0x0b, 0x66, 0x1a,
-	0x70, 0xee, 0x83, 0x0a, 0x3e, 0xfb, 0x0d, 0x3f, 0xc0, 0x46, 0xf1, 0x4d, 0x44, 0x76, 0x4b, 0x0d,
-	0xaf, 0x3c, 0x65, 0xbd, 0x0f, 0x17, 0xea, 0x67, 0x21, 0x7f, 0x83, 0xad, 0xf9, 0x76, 0x13, 0xff,
-	0xe6, 0x4d, 0xe2, 0x7d, 0xbc, 0x04, 0xd7, 0xfc, 0x15, 0xf2, 0x7b, 0xf5, 0x85, 0xe5, 0xae, 0xce,
-	0x4f, 0xaf, 0x89, 0x50, 0x66, 0x9c, 0xd7, 0xaf, 0xd0, 0xe9, 0x99, 0xfe, 0x6f, 0xe1, 0xaf, 0x9c,
-	0xb5, 0x0d, 0xf2, 0xd9, 0xff, 0x01, 0x00, 0x00, 0xff, 0xff, 0xf1, 0x1f, 0xaf, 0x2d, 0x98, 0x0c,
-	0x00, 0x00,
+	// 1070 bytes of a gzipped FileDescriptorProto
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xa5, 0x57, 0xdd, 0x72, 0xd3, 0x46,
+	0x14, 0xc6, 0x76, 0xe2, 0xd8, 0xc7, 0xc1, 0x09, 0x1b, 0x63, 0x2b, 0x6a, 0x27, 0xa5, 0x82, 0x8b,
+	0x94, 0x0b, 0x87, 0xa4, 0xcc, 0x10, 0x3a, 0x40, 0x67, 0x1a, 0x68, 0x87, 0x0b, 0x1a, 0xaa, 0x74,
+	0x3a, 0x94, 0x99, 0x76, 0x46, 0x96, 0x4e, 0x8c, 0x8a, 0x2c, 0x89, 0xd5, 0x2a, 0x83, 0xef, 0xda,
+	0xf7, 0xe8, 0x03, 0xf4, 0x39, 0x7a, 0xcf, 0x3b, 0x75, 0x7f, 0xb4, 0x46, 0xb2, 0x64, 0xc7, 0xa1,
+	0x57, 0xde, 0xf3, 0xaf, 0xfd, 0xce, 0x77, 0x8e, 0x64, 0xe8, 0x52, 0x4c, 0xa2, 0x94, 0xba, 0x38,
+	0x8c, 0x69, 0xc4, 0x22, 0xd2, 0x8e, 0xd3, 0x20, 0x9d, 0xf8, 0x34, 0x76, 0xcd, 0xcf, 0xc6, 0x51,
+	0x34, 0x0e, 0xf0, 0x40, 0x1a, 0x46, 0xe9, 0xf9, 0x01, 0x4e, 0x62, 0x36, 0x55, 0x7e, 0xe6, 0xe7,
+	0xf3, 0xc6, 0x84, 0xd1, 0xd4, 0x65, 0x99, 0xb5, 0xcb, 0x7f, 0x2e, 0x7c, 0x0f, 0xa9, 0x92, 0xad,
+	0x7d, 0xe8, 0x9f, 0xa5, 0x71, 0x1c, 0x51, 0x96, 0x7c, 0x8f, 0x0e, 0x4b, 0x29, 0xda, 0xf8, 0x2e,
+	0xc5, 0x84, 0x91, 0x2e, 0xd4, 0x7d, 0xcf, 0xa8, 0xdd, 0xaa, 0xed, 0xb7, 0x6d, 0x7e, 0xb2, 0x1e,
+	0xc2, 0xa0, 0xe4, 0x99, 0xc4, 0x51, 0x98, 0x20, 0xd9, 0x03, 0x78, 0xe3, 0x24, 0x99, 0x55, 0x86,
+	0xb4, 0xec, 0x9c, 0xc6, 0xfa, 0xbb, 0x01, 0x3b, 0x36, 0x3a, 0x9e, 0x9d, 0xdd, 0x68, 0x41, 0x09,
+	0x42, 0x60, 0x8d, 0x4d, 0x63, 0x34, 0xea, 0x52, 0x23, 0xcf, 0x42, 0x17, 0x3a, 0x13, 0x34, 0x1a,
+	0x4a, 0x27, 0xce, 0xa4, 0x0f, 0xcd, 0xd8, 0xa1, 0x18, 0x32, 0x63, 0x4d, 0x6a, 0x33, 0x89, 0x3c,
+	0x00, 0xe0, 0xb7, 0x8a, 0x91, 0x32, 0x1f, 0x13, 0x63, 0x9d, 0xdb, 0x3a, 0x47, 0x83, 0xa1, 0xc2,
+	0x63, 0xa8, 0xf1, 0x18, 0x9e, 0x49, 0x3c, 0xec, 0x9c, 0x2b, 0xb1, 0x60, 0xd3, 0xc3, 0x18, 0x43,
+	0x0f, 0x43, 0x57, 0x84, 0x36, 0x6f, 0x35, 0x78, 0xda, 0x82, 0x8e, 0x98, 0xd0, 0xd2, 0xd8, 0x19,
+	0x1b, 0xb2, 0xec, 0x4c, 0x26, 0x06, 0x6c, 0x5c, 0x20, 0x4d, 0xfc, 0x28, 0x34, 0x5a, 0xd2, 0xa4,
+	0x45, 0x72, 0x07, 0xae, 0x3b, 0xae, 0x8b, 0x31, 0x3b, 0x43, 0x97, 0x22, 0x4b, 0x8c, 0xb6, 0x44,
+	0xa7, 0xa8, 0x24, 0xc7, 0x30, 0x70, 0x3c, 0xcf, 0x67, 0x3c, 0xc2, 0x09, 0x94, 0xf2, 0x34, 0x65,
+	0x71, 0xca, 0xfd, 0x41, 0x3e, 0xca, 0x22, 0xb3, 0xa8, 0xec, 0x04, 0xbe, 0x93, 0xf0, 0x87, 0xee,
+	0x48, 0x4f, 0x2d, 0x92, 0x7d, 0xd8, 0x52, 0x45, 0x34, 0xea, 0x89, 0xb1, 0x29, 0x6b, 0xcf, 0xab,
+	0x2d, 0x07, 0x7a, 0xc5, 0xee, 0x64, 0x6d, 0xdd, 0x86, 0x46, 0x4a, 0xc3, 0xac, 0x3f, 0xe2, 0x38,
+	0x07, 0x70, 0x7d, 0x65, 0x80, 0xad, 0x0f, 0x00, 0x03, 0x1b, 0xc7, 0x7e, 0xc2, 0x90, 0xce, 0xb3,
+	0x40, 0x77, 0xbd, 0x56, 0xd1, 0xf5, 0x7a, 0x65, 0xd7, 0x1b, 0x85, 0xae, 0x73, 0xbd, 0x9b, 0x26,
+	0x2c, 0x9a, 0x48, 0x36, 0xb4, 0xec, 0x4c, 0x22, 0x07, 0xd0, 0x8c, 0x46, 0x7f, 0xa0, 0xcb, 0x2e,
+	0x63, 0x42, 0xe6, 0x26, 0xb0, 0x14, 0x26, 0x11, 0xd1, 0x94, 0x99, 0xb4, 0x58, 0xe2, 0xc7, 0xc6,
+	0x25, 0xfc, 0x68, 0xcd, 0xf1, 0x23, 0x86, 0x5e, 0x06, 0xc6, 0xf4, 0x69, 0x3e, 0x4f, 0x9b, 0xe7,
+	0xe9, 0x1c, 0x3d, 0x1a, 0xce, 0x46, 0x7b, 0xb8, 0x00, 0xa4, 0xe1, 0xcb, 0x8a, 0xf0, 0x67, 0x21,
+	0xa3, 0x53, 0xbb, 0x32, 0x33, 0xb9, 0x07, 0x3b, 0x1e, 0x06, 0xc8, 0xf0, 0x3b, 0x3c, 0x8f, 0xc4,
+	0xa8, 0xc6, 0x81, 0xe3, 0x22, 0x67, 0x93, 0xb8, 0x57, 0x95, 0x29, 0xcf, 0xe1, 0x4e, 0x89, 0xc3,
+	0xfe, 0x38, 0xe4, 0xae, 0x27, 0x6f, 0x9c, 0x70, 0x2c, 0x79, 0x24, 0xae, 0x5f, 0x54, 0x96, 0x99,
+	0x7e, 0xfd, 0x8a, 0x4c, 0xef, 0xae, 0xcc, 0xf4, 0xad, 0x22, 0xd3, 0x39, 0xf2, 0xfe, 0x44, 0x2c,
+	0x9a, 0xe7, 0x9e, 0xb1, 0xad, 0x90, 0xd7, 0x32, 0xf9, 0x15, 0xba, 0x8a, 0x0e, 0x3f, 0xfb, 0x13,
+	0x8c, 0x44, 0x99, 0x1b, 0x92, 0x0c, 0x87, 0x2b, 0x60, 0x7e, 0x52, 0x08, 0xb4, 0xe7, 0x12, 0x91,
+	0x27, 0x60, 0x56, 0xe0, 0xf8, 0x14, 0xcf, 0xfd, 0x10, 0x3d, 0x83, 0xc8, 0xdb, 0x2f, 0xf1, 0x20,
+	0xf7, 0xe1, 0x66, 0x92, 0x2d, 0xd4, 0x97, 0x0e, 0x1f, 0x13, 0x27, 0xf8, 0xc5, 0x09, 0x78, 0x61,
+	0x63, 0x47, 0x86, 0x56, 0x1b, 0x05, 0xdb, 0x29, 0x4e, 0x38, 0x2d, 0x8d, 0x9e, 0x62, 0xbb, 0x92,
+	0xaa, 0xc6, 0xfd, 0x66, 0xe5, 0xb8, 0x93, 0x53, 0x68, 0x6b, 0x62, 0x26, 0x46, 0x5f, 0x32, 0xf0,
+	0x70, 0x35, 0x06, 0xaa, 0x18, 0x45, 0xbb, 0x8f, 0x39, 0xc8, 0x5d, 0xd8, 0xa6, 0xea, 0x6a, 0xa7,
+	0xa1, 0xa6, 0xc8, 0x40, 0xb6, 0xa8, 0xa4, 0x37, 0xef, 0x42, 0xaf, 0x8a, 0xca, 0x62, 0xe0, 0xf9,
+	0x82, 0x49, 0xf8, 0x12, 0x10, 0x71, 0xf2, 0x6c, 0xbe, 0x82, 0x6e, 0xb1, 0x05, 0x72, 0xd4, 0x29,
+	0x7f, 0xf9, 0xe8, 0x65, 0x91, 0x49, 0x42, 0x9f, 0xc6, 0x9e, 0xd0, 0xab, 0x85, 0x91, 0x49, 0x42,
+	0xaf, 0x1a, 0xa0, 0x57, 0x86, 0x92, 0xcc, 0x3f, 0x6b, 0xb0, 0xbb, 0x70, 0xa2, 0xc4, 0xde, 0x7b,
+	0x8b, 0x53, 0xbd, 0xf7, 0xf8, 0x91, 0xbc, 0x80, 0xf5, 0x0b, 0x01, 0x7f, 0xb6, 0xf2, 0x1e, 0x7c,
+	0xe2, 0xc0, 0xda, 0x2a, 0xcb, 0x37, 0xf5, 0xe3, 0x9a, 0xf9, 0x08, 0xba, 0x45, 0x44, 0x2b, 0xca,
+	0xf6, 0xf2, 0x65, 0xdb, 0xb9, 0x68, 0xeb, 0xdf, 0x06, 0x18, 0xe5, 0xca, 0x0b, 0xf7, 0xb6, 0x7a,
+	0xd1, 0xd6, 0x67, 0x2f, 0xda, 0x8f, 0xab, 0xb1, 0xb1, 0xda, 0x6a, 0xe4, 0x40, 0x26, 0xcc, 0x19,
+	0x05, 0xa8, 0x77, 0xac, 0x92, 0xc4, 0x50, 0xaa, 0x93, 0x78, 0xdd, 0xca, 0xa1, 0xcc, 0x44, 0xf2,
+	0x6e, 0xc1, 0xca, 0x6b, 0x4a, 0xc2, 0x3d, 0x5e, 0x8a, 0xa0, 0xba, 0xc7, 0x55, 0x77, 0xde, 0x95,
+	0xb8, 0xf5, 0xd7, 0x15, 0x19, 0xf0, 0x63, 0x91, 0x01, 0xc7, 0x9f, 0xfa, 0xfc, 0xf9, 0x26, 0x22,
+	0xec, 0xcd, 0xc7, 0x66, 0xcb, 0x4e, 0xbf, 0x1a, 0xcb, 0x9d, 0x3c, 0x84, 0x8d, 0x28, 0xdb, 0x97,
+	0x97, 0xbc, 0x7e, 0xb5, 0x9f, 0xf5, 0xba, 0x4c, 0x95, 0x59, 0x81, 0x27, 0xd0, 0xa2, 0xea, 0xa8,
+	0xe0, 0xe9, 0x1c, 0x59, 0x97, 0x73, 0xdb, 0x9e, 0xc5, 0x58, 0x14, 0x76, 0x2b, 0x72, 0x67, 0x3c,
+	0xe4, 0xf4, 0xf5, 0xf9, 0xbd, 0xdf, 0xcb, 0xe7, 0x5f, 0xb7, 0x95, 0x40, 0xbe, 0x15, 0x25, 0x95,
+	0x47, 0x76, 0x85, 0xdb, 0x2b, 0x80, 0x69, 0xcf, 0x82, 0x8e, 0xfe, 0x59, 0x87, 0x2d, 0x6d, 0x7e,
+	0x11, 0x85, 0x3e, 0x8b, 0x28, 0x79, 0x0d, 0x5b, 0x73, 0x1f, 0xa7, 0xe4, 0xcb, 0x5c, 0xd6, 0xea,
+	0x4f, 0x5c, 0xd3, 0x5a, 0xe6, 0xa2, 0xaa, 0x59, 0xd7, 0xf8, 0x03, 0x37, 0x9f, 0x87, 0x17, 0xd1,
+	0x5b, 0xce, 0xf6, 0x9c, 0xbf, 0x52, 0xe9, 0x4c, 0xbb, 0x15, 0x96, 0x59, 0x82, 0x1f, 0x60, 0x93,
+	0xf7, 0x04, 0x9d, 0xc9, 0xff, 0x4a, 0x73, 0xaf, 0x46, 0x1e, 0xc2, 0xda, 0x89, 0x13, 0x04, 0xa4,
+	0x9f, 0x73, 0x13, 0x0a, 0x1d, 0x3e, 0x28, 0xe9, 0x67, 0xcf, 0xf0, 0x13, 0x6c, 0xe6, 0xbf, 0xf1,
+	0xc8, 0x5e, 0x01, 0xf3, 0xd2, 0xa7, 0xb9, 0xf9, 0xc5, 0x42, 0xfb, 0x2c, 0xe5, 0x6f, 0xb0, 0x3d,
+	0xdf, 0x2d, 0xb2, 0x02, 0x7b, 0xcc, 0x55, 0xda, 0xcd, 0xd3, 0x8f, 0xe0, 0x46, 0x89, 0x5a, 0x64,
+	0x59, 0xac, 0x26, 0xb5, 0x79, 0x67, 0xb9, 0x53, 0x0e, 0xd0, 0xdf, 0xcb, 0x5f, 0xa5, 0xfa, 0x73,
+	0xe3, 0xab, 0x25, 0x49, 0x8a, 0x53, 0x6a, 0xf6, 0x4b, 0x23, 0xf8, 0x4c, 0xfc, 0x1f, 0xb3, 0xae,
+	0x8d, 0x9a, 0x52, 0xf3, 0xf5, 0x7f, 0x25, 0xcb, 0x52, 0xa7, 0xcc, 0x0d, 0x00, 0x00,
 }
 
 // Reference imports to suppress errors if they are not otherwise used.
@@ -877,6 +972,7 @@ type ResourceMonitorClient interface {
 	Call(ctx context.Context, in *CallRequest, opts ...grpc.CallOption) (*CallResponse, error)
 	ReadResource(ctx context.Context, in *ReadResourceRequest, opts ...grpc.CallOption) (*ReadResourceResponse, error)
 	RegisterResource(ctx context.Context, in *RegisterResourceRequest, opts ...grpc.CallOption) (*RegisterResourceResponse, error)
+	RegisterResources(ctx context.Context, in *RegisterResourcesRequest, opts ...grpc.CallOption) (ResourceMonitor_RegisterResourcesClient, error)
 	RegisterResourceOutputs(ctx context.Context, in *RegisterResourceOutputsRequest, opts ...grpc.CallOption) (*empty.Empty, error)
 }
 
@@ -965,6 +1061,38 @@ func (c *resourceMonitorClient) RegisterResource(ctx context.Context, in *Regist
 	return out, nil
 }
 
+func (c *resourceMonitorClient) RegisterResources(ctx context.Context, in *RegisterResourcesRequest, opts ...grpc.CallOption) (ResourceMonitor_RegisterResourcesClient, error) {
+	stream, err := c.cc.NewStream(ctx, &_ResourceMonitor_serviceDesc.Streams[1], "/pulumirpc.ResourceMonitor/RegisterResources", opts...)
+	if err != nil {
+		return nil, err
+	}
+	x := &resourceMonitorRegisterResourcesClient{stream}
+	if err := x.ClientStream.SendMsg(in); err != nil {
+		return nil, err
+	}
+	if err := x.ClientStream.CloseSend(); err != nil {
+		return nil, err
+	}
+	return x, nil
+}
+
+type ResourceMonitor_RegisterResourcesClient interface {
+	Recv() (*RegisterResourcesResponse, error)
+	grpc.ClientStream
+}
+
+type resourceMonitorRegisterResourcesClient struct {
+	grpc.ClientStream
+}
+
+func (x *resourceMonitorRegisterResourcesClient) Recv() (*RegisterResourcesResponse, error) {
+	m := new(RegisterResourcesResponse)
+	if err := x.ClientStream.RecvMsg(m); err != nil {
+		return nil, err
+	}
+	return m, nil
+}
+
 func (c *resourceMonitorClient) RegisterResourceOutputs(ctx context.Context, in *RegisterResourceOutputsRequest, opts ...grpc.CallOption) (*empty.Empty, error) {
 	out := new(empty.Empty)
 	err := c.cc.Invoke(ctx, "/pulumirpc.ResourceMonitor/RegisterResourceOutputs", in, out, opts...)
@@ -982,6 +1110,7 @@ type ResourceMonitorServer interface {
 	Call(context.Context, *CallRequest) (*CallResponse, error)
 	ReadResource(context.Context, *ReadResourceRequest) (*ReadResourceResponse, error)
 	RegisterResource(context.Context, *RegisterResourceRequest) (*RegisterResourceResponse, error)
+	RegisterResources(*RegisterResourcesRequest, ResourceMonitor_RegisterResourcesServer) error
 	RegisterResourceOutputs(context.Context, *RegisterResourceOutputsRequest) (*empty.Empty, error)
 }
 
@@ -1007,6 +1136,9 @@ func (*UnimplementedResourceMonitorServer) ReadResource(ctx context.Context, req
 func (*UnimplementedResourceMonitorServer) RegisterResource(ctx context.Context, req *RegisterResourceRequest) (*RegisterResourceResponse, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method RegisterResource not implemented")
 }
+func (*UnimplementedResourceMonitorServer) RegisterResources(req *RegisterResourcesRequest, srv ResourceMonitor_RegisterResourcesServer) error {
+	return status.Errorf(codes.Unimplemented, "method RegisterResources not implemented")
+}
 func (*UnimplementedResourceMonitorServer) RegisterResourceOutputs(ctx context.Context, req *RegisterResourceOutputsRequest) (*empty.Empty, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method RegisterResourceOutputs not implemented")
 }
@@ -1126,6 +1258,27 @@ func _ResourceMonitor_RegisterResource_Handler(srv interface{}, ctx context.Cont
 	return interceptor(ctx, in, info, handler)
 }
 
+func _ResourceMonitor_RegisterResources_Handler(srv interface{}, stream grpc.ServerStream) error {
+	m := new(RegisterResourcesRequest)
+	if err := stream.RecvMsg(m); err != nil {
+		return err
+	}
+	return srv.(ResourceMonitorServer).RegisterResources(m, &resourceMonitorRegisterResourcesServer{stream})
+}
+
+type ResourceMonitor_RegisterResourcesServer interface {
+	Send(*RegisterResourcesResponse) error
+	grpc.ServerStream
+}
+
+type resourceMonitorRegisterResourcesServer struct {
+	grpc.ServerStream
+}
+
+func (x *resourceMonitorRegisterResourcesServer) Send(m *RegisterResourcesResponse) error {
+	return x.ServerStream.SendMsg(m)
+}
+
 func _ResourceMonitor_RegisterResourceOutputs_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
 	in := new(RegisterResourceOutputsRequest)
 	if err := dec(in); err != nil {
@@ -1179,6 +1332,11 @@ var _ResourceMonitor_serviceDesc = grpc.ServiceDesc{
 			Handler:       _ResourceMonitor_StreamInvoke_Handler,
 			ServerStreams: true,
 		},
+		{
+			StreamName:    "RegisterResources",
+			Handler:       _ResourceMonitor_RegisterResources_Handler,
+			ServerStreams: true,
+		},
 	},
 	Metadata: "resource.proto",
 }
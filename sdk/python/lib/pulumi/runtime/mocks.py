@@ -209,6 +209,10 @@ class MockMonitor:
 
         return resource_pb2.RegisterResourceResponse(urn=urn, id=id_, object=obj_proto)
 
+    def RegisterResources(self, request):
+        for i, req in enumerate(request.requests):
+            yield resource_pb2.RegisterResourcesResponse(index=i, response=self.RegisterResource(req))
+
     def RegisterResourceOutputs(self, request):
         # pylint: disable=unused-argument
         return empty_pb2.Empty()
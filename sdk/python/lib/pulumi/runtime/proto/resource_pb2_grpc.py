@@ -46,6 +46,11 @@ class ResourceMonitorStub(object):
         request_serializer=resource__pb2.RegisterResourceRequest.SerializeToString,
         response_deserializer=resource__pb2.RegisterResourceResponse.FromString,
         )
+    self.RegisterResources = channel.unary_stream(
+        '/pulumirpc.ResourceMonitor/RegisterResources',
+        request_serializer=resource__pb2.RegisterResourcesRequest.SerializeToString,
+        response_deserializer=resource__pb2.RegisterResourcesResponse.FromString,
+        )
     self.RegisterResourceOutputs = channel.unary_unary(
         '/pulumirpc.ResourceMonitor/RegisterResourceOutputs',
         request_serializer=resource__pb2.RegisterResourceOutputsRequest.SerializeToString,
@@ -99,6 +104,13 @@ class ResourceMonitorServicer(object):
     context.set_details('Method not implemented!')
     raise NotImplementedError('Method not implemented!')
 
+  def RegisterResources(self, request, context):
+    # missing associated documentation comment in .proto file
+    pass
+    context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+    context.set_details('Method not implemented!')
+    raise NotImplementedError('Method not implemented!')
+
   def RegisterResourceOutputs(self, request, context):
     # missing associated documentation comment in .proto file
     pass
@@ -139,6 +151,11 @@ def add_ResourceMonitorServicer_to_server(servicer, server):
           request_deserializer=resource__pb2.RegisterResourceRequest.FromString,
           response_serializer=resource__pb2.RegisterResourceResponse.SerializeToString,
       ),
+      'RegisterResources': grpc.unary_stream_rpc_method_handler(
+          servicer.RegisterResources,
+          request_deserializer=resource__pb2.RegisterResourcesRequest.FromString,
+          response_serializer=resource__pb2.RegisterResourcesResponse.SerializeToString,
+      ),
       'RegisterResourceOutputs': grpc.unary_unary_rpc_method_handler(
           servicer.RegisterResourceOutputs,
           request_deserializer=resource__pb2.RegisterResourceOutputsRequest.FromString,
@@ -0,0 +1,156 @@
+# Copyright 2016-2021, Pulumi Corporation.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+import asyncio
+from typing import Any, List, Optional, Tuple
+
+from .. import log
+from ..runtime.proto import resource_pb2
+from . import rpc_manager, settings
+
+MAX_BATCH_SIZE = 256
+"""
+The maximum number of registrations that are sent in a single RegisterResources call.
+"""
+
+
+class RegistrationBatcher:
+    """
+    RegistrationBatcher coalesces resource registrations that are ready at the same time into a single
+    RegisterResources call. Programs that declare many resources at once would otherwise pay for one round trip to the
+    resource monitor per resource.
+
+    The batcher never delays a registration in the hope of filling a batch: each batch contains the registrations that
+    became ready during the same turn of the event loop, plus any that became ready while the batch was waiting for an
+    in-flight slot.
+    """
+
+    monitor: Any
+    """
+    The resource monitor that registrations are sent to.
+    """
+
+    loop: asyncio.AbstractEventLoop
+    """
+    The event loop that the batcher's futures belong to.
+    """
+
+    def __init__(self, monitor: Any, loop: asyncio.AbstractEventLoop):
+        self.monitor = monitor
+        self.loop = loop
+        self._pending: List[Tuple[resource_pb2.RegisterResourceRequest, asyncio.Future]] = []
+        self._flush_scheduled = False
+
+    async def register(self, req: resource_pb2.RegisterResourceRequest) -> resource_pb2.RegisterResourceResponse:
+        """
+        Sends the given registration to the resource monitor as part of the next batch and waits for its response.
+        Raises the grpc.RpcError that failed the registration's batch, if any.
+        """
+        future = self.loop.create_future()
+        self._pending.append((req, future))
+        if not self._flush_scheduled:
+            self._flush_scheduled = True
+            self.loop.call_soon(self._flush)
+        return await future
+
+    def _flush(self):
+        self._flush_scheduled = False
+        if self._pending:
+            asyncio.ensure_future(self._send())
+
+    async def _send(self):
+        # Wait for an in-flight slot before taking the batch so that registrations that become ready in the meantime
+        # are sent along with it.
+        inflight = rpc_manager.RPC_MANAGER.inflight_semaphore()
+        if inflight is not None:
+            await inflight.acquire()
+        try:
+            batch, self._pending = self._pending[:MAX_BATCH_SIZE], self._pending[MAX_BATCH_SIZE:]
+            if self._pending and not self._flush_scheduled:
+                self._flush_scheduled = True
+                self.loop.call_soon(self._flush)
+            if batch:
+                await self._send_batch(batch)
+        finally:
+            if inflight is not None:
+                inflight.release()
+
+    async def _send_batch(self, batch: List[Tuple[resource_pb2.RegisterResourceRequest, asyncio.Future]]):
+        monitor = self.monitor
+        futures = [future for _, future in batch]
+
+        if len(batch) == 1:
+            req = batch[0][0]
+            try:
+                resp = await self.loop.run_in_executor(None, lambda: monitor.RegisterResource(req))
+            except Exception as exn:  # pylint: disable=broad-except
+                _fail(futures, exn)
+                return
+            _resolve(futures, 0, resp)
+            return
+
+        log.debug(f"RegisterResources(#reqs={len(batch)}): RPC call being made")
+
+        loop = self.loop
+        req = resource_pb2.RegisterResourcesRequest(requests=[req for req, _ in batch])
+
+        # Deliver each response to its registration as it arrives rather than once the whole batch has completed.
+        def do_rpc_call() -> Optional[Exception]:
+            try:
+                for resp in monitor.RegisterResources(req):
+                    if resp.index < 0 or resp.index >= len(futures):
+                        return Exception(f"RegisterResources: unexpected response index {resp.index}")
+                    loop.call_soon_threadsafe(_resolve, futures, resp.index, resp.response)
+            except Exception as exn:  # pylint: disable=broad-except
+                return exn
+            return None
+
+        # The responses scheduled above are delivered before the call's result, as loop callbacks run in order.
+        exn = await self.loop.run_in_executor(None, do_rpc_call)
+
+        # If the stream ended early, every registration that is still outstanding fails with the stream's error.
+        if exn is None:
+            exn = Exception("RegisterResources: resource monitor did not respond to every registration")
+        _fail(futures, exn)
+
+
+def _resolve(futures: List[asyncio.Future], index: int, resp: resource_pb2.RegisterResourceResponse):
+    future = futures[index]
+    if not future.done():
+        future.set_result(resp)
+
+
+def _fail(futures: List[asyncio.Future], exn: Exception):
+    for future in futures:
+        if not future.done():
+            future.set_exception(exn)
+
+
+_BATCHER: Optional[RegistrationBatcher] = None
+
+
+async def register_resource(monitor: Any, req: resource_pb2.RegisterResourceRequest) -> \
+        resource_pb2.RegisterResourceResponse:
+    """
+    Registers a resource with the given resource monitor. If the monitor supports batched registrations, the request is
+    sent as part of a batch; otherwise it is sent on its own. Either way, the call counts against the RPC manager's
+    in-flight limit.
+    """
+    if not await settings.monitor_supports_feature("registerResourceBatches"):
+        return await rpc_manager.RPC_MANAGER.call(lambda: monitor.RegisterResource(req))
+
+    global _BATCHER  # pylint: disable=global-statement
+    loop = asyncio.get_event_loop()
+    if _BATCHER is None or _BATCHER.monitor is not monitor or _BATCHER.loop is not loop:
+        _BATCHER = RegistrationBatcher(monitor, loop)
+    return await _BATCHER.register(req)
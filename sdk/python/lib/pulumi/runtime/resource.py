@@ -19,7 +19,7 @@ from typing import Optional, Any, Callable, List, NamedTuple, Dict, Set, Tuple,
 from google.protobuf import struct_pb2
 import grpc
 
-from . import rpc, settings, known_types
+from . import rpc, registrations, settings, known_types
 from .. import log
 from ..runtime.proto import provider_pb2, resource_pb2
 from .rpc_manager import RPC_MANAGER
@@ -507,19 +507,20 @@ def register_resource(res: 'Resource',
             from ..resource import create_urn  # pylint: disable=import-outside-toplevel
             mock_urn = await create_urn(name, ty, resolver.parent_urn).future()
 
-            def do_rpc_call():
+            async def do_rpc_call():
                 if monitor is None:
                     # If no monitor is available, we'll need to fake up a response, for testing.
                     return RegisterResponse(mock_urn, None, resolver.serialized_props, None)
 
-                # If there is a monitor available, make the true RPC request to the engine.
+                # If there is a monitor available, make the true RPC request to the engine. Registrations are
+                # batched where the monitor supports it.
                 try:
-                    return monitor.RegisterResource(req)
+                    return await registrations.register_resource(monitor, req)
                 except grpc.RpcError as exn:
                     handle_grpc_error(exn)
                     return None
 
-            resp = await asyncio.get_event_loop().run_in_executor(None, do_rpc_call)
+            resp = await do_rpc_call()
         except Exception as exn:
             log.debug(f"exception when preparing or executing rpc: {traceback.format_exc()}")
             rpc.resolve_outputs_due_to_exception(resolvers, exn)
@@ -605,7 +606,7 @@ def register_resource_outputs(res: 'Resource', outputs: 'Union[Inputs, Output[In
                 handle_grpc_error(exn)
                 return None
 
-        await asyncio.get_event_loop().run_in_executor(None, do_rpc_call)
+        await RPC_MANAGER.call(do_rpc_call)
         log.debug(
             f"resource registration successful: urn={urn}, props={serialized_props}")
 
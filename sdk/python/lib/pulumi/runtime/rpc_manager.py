@@ -12,11 +12,14 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 import asyncio
+import os
 import sys
 import traceback
-from typing import Callable, Awaitable, Tuple, Any, Optional, List
+from typing import Callable, Awaitable, Tuple, Any, Optional, List, TypeVar
 from .. import log
 
+T = TypeVar('T')
+
 
 class RPCManager:
     """
@@ -41,10 +44,19 @@ class RPCManager:
     The traceback associated with unhandled_exception, if any.
     """
 
-    def __init__(self):
+    max_inflight: Optional[int]
+    """
+    The maximum number of calls to the engine that may be in flight at once, if any. Defaults to the value of the
+    PULUMI_MAX_INFLIGHT_RPCS environment variable.
+    """
+
+    def __init__(self, max_inflight: Optional[int] = None):
         self.rpcs = []
         self.unhandled_exception = None
         self.exception_traceback = None
+        self.max_inflight = max_inflight if max_inflight is not None else _max_inflight_from_env()
+        self._inflight: Optional[asyncio.Semaphore] = None
+        self._inflight_loop: Optional[asyncio.AbstractEventLoop] = None
 
     def do_rpc(self, name: str, rpc_function: Callable[..., Awaitable[Tuple[Any, Exception]]]) -> Callable[..., Awaitable[Tuple[Any, Exception]]]:
         """
@@ -79,6 +91,51 @@ class RPCManager:
 
         return rpc_wrapper
 
+    async def call(self, fn: Callable[[], T]) -> T:
+        """
+        Runs the given blocking call to the engine on the event loop's default executor and returns its result. If
+        max_inflight is set, the call waits until fewer than max_inflight calls are in flight before it is started.
+
+        Unlike do_rpc, which tracks an entire operation (including any time spent waiting on its inputs), call should
+        wrap just the gRPC request itself so that operations waiting on each other cannot exhaust the limit.
+        :param fn: The blocking function that performs the call
+        :return: The result of the call
+        """
+        loop = asyncio.get_event_loop()
+
+        inflight = self.inflight_semaphore()
+        if inflight is None:
+            return await loop.run_in_executor(None, fn)
+        async with inflight:
+            return await loop.run_in_executor(None, fn)
+
+    def inflight_semaphore(self) -> Optional[asyncio.Semaphore]:
+        """
+        Returns the semaphore that limits the number of calls in flight on the current event loop, or None if there is
+        no limit. Callers that issue calls to the engine without going through call must hold the semaphore for the
+        duration of each call.
+        """
+        if self.max_inflight is None:
+            return None
+
+        loop = asyncio.get_event_loop()
+
+        # Semaphores are bound to the event loop that is current when they are created, so create a new one if the loop
+        # has changed (e.g. between tests).
+        if self._inflight is None or self._inflight_loop is not loop:
+            self._inflight = asyncio.Semaphore(self.max_inflight)
+            self._inflight_loop = loop
+        return self._inflight
+
+
+def _max_inflight_from_env() -> Optional[int]:
+    value = os.getenv("PULUMI_MAX_INFLIGHT_RPCS", "")
+    try:
+        max_inflight = int(value)
+    except ValueError:
+        return None
+    return max_inflight if max_inflight > 0 else None
+
 
 RPC_MANAGER: RPCManager = RPCManager()
 """
@@ -0,0 +1,115 @@
+# Copyright 2016-2021, Pulumi Corporation.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+import asyncio
+import threading
+import unittest
+
+from pulumi.runtime import registrations, rpc_manager, settings
+from pulumi.runtime.proto import resource_pb2
+import pulumi
+
+
+def pulumi_test(coro):
+    wrapped = pulumi.runtime.test(coro)
+    def wrapper(*args, **kwargs):
+        settings.configure(settings.Settings())
+        rpc_manager.RPC_MANAGER = rpc_manager.RPCManager()
+
+        wrapped(*args, **kwargs)
+
+    return wrapper
+
+
+class BatchMonitor:
+    """
+    BatchMonitor records the size of each batch it receives. Its responses are streamed in reverse order, and a batch
+    fails if it contains a registration named "fail".
+    """
+
+    def __init__(self):
+        self.batches = []
+
+    def RegisterResource(self, request):
+        self.batches.append(1)
+        return resource_pb2.RegisterResourceResponse(urn=request.name, id=request.name)
+
+    def RegisterResources(self, request):
+        self.batches.append(len(request.requests))
+        for i in reversed(range(len(request.requests))):
+            req = request.requests[i]
+            if req.name == "fail":
+                raise Exception("registration failed")
+            yield resource_pb2.RegisterResourcesResponse(
+                index=i, response=resource_pb2.RegisterResourceResponse(urn=req.name, id=req.name))
+
+
+def new_request(name: str) -> resource_pb2.RegisterResourceRequest:
+    return resource_pb2.RegisterResourceRequest(type="test:index:Resource", name=name, custom=True)
+
+
+class RegistrationBatcherTests(unittest.TestCase):
+    @pulumi_test
+    async def test_batches_ready_registrations(self):
+        monitor = BatchMonitor()
+        batcher = registrations.RegistrationBatcher(monitor, asyncio.get_event_loop())
+
+        names = [f"res{i}" for i in range(10)]
+        resps = await asyncio.gather(*[batcher.register(new_request(name)) for name in names])
+        self.assertEqual([10], monitor.batches)
+        self.assertEqual(names, [resp.id for resp in resps])
+
+        # A registration on its own is sent using RegisterResource.
+        resp = await batcher.register(new_request("single"))
+        self.assertEqual([10, 1], monitor.batches)
+        self.assertEqual("single", resp.id)
+
+    @pulumi_test
+    async def test_limits_batch_size(self):
+        monitor = BatchMonitor()
+        batcher = registrations.RegistrationBatcher(monitor, asyncio.get_event_loop())
+
+        count = registrations.MAX_BATCH_SIZE + 1
+        await asyncio.gather(*[batcher.register(new_request(f"res{i}")) for i in range(count)])
+        self.assertEqual([registrations.MAX_BATCH_SIZE, 1], sorted(monitor.batches, reverse=True))
+
+    @pulumi_test
+    async def test_fails_outstanding_registrations(self):
+        monitor = BatchMonitor()
+        batcher = registrations.RegistrationBatcher(monitor, asyncio.get_event_loop())
+
+        results = await asyncio.gather(batcher.register(new_request("a")), batcher.register(new_request("fail")),
+                                       return_exceptions=True)
+        for result in results:
+            self.assertIsInstance(result, Exception)
+            self.assertEqual("registration failed", str(result))
+
+
+class RPCManagerTests(unittest.TestCase):
+    @pulumi_test
+    async def test_limits_inflight_calls(self):
+        manager = rpc_manager.RPCManager(max_inflight=2)
+
+        lock = threading.Lock()
+        counts = {"inflight": 0, "max": 0}
+
+        def do_call():
+            with lock:
+                counts["inflight"] += 1
+                counts["max"] = max(counts["max"], counts["inflight"])
+            threading.Event().wait(0.01)
+            with lock:
+                counts["inflight"] -= 1
+
+        await asyncio.gather(*[manager.call(do_call) for _ in range(10)])
+        self.assertEqual(2, counts["max"])
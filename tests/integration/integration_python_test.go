@@ -430,6 +430,28 @@ func TestLargeResourcePython(t *testing.T) {
 	})
 }
 
+// TestRegistrationPerfPython measures how quickly Python programs can register large numbers of resources. The
+// registration rate is printed by the program.
+func TestRegistrationPerfPython(t *testing.T) {
+	for _, count := range []int{1000, 10000} {
+		count := count
+		t.Run(fmt.Sprint(count), func(t *testing.T) {
+			integration.ProgramTest(t, &integration.ProgramTestOptions{
+				Dir: filepath.Join("registration_perf", "python"),
+				Dependencies: []string{
+					filepath.Join("..", "..", "sdk", "python", "env", "src"),
+				},
+				Config: map[string]string{
+					"count": fmt.Sprint(count),
+				},
+				Quick: true,
+				// Don't run in parallel since it is sensitive to system resources.
+				NoParallel: true,
+			})
+		})
+	}
+}
+
 // Test enum outputs
 func TestEnumOutputsPython(t *testing.T) {
 	integration.ProgramTest(t, &integration.ProgramTestOptions{
@@ -0,0 +1,28 @@
+# Copyright 2016-2021, Pulumi Corporation.  All rights reserved.
+
+import time
+
+import pulumi
+
+
+class Component(pulumi.ComponentResource):
+    def __init__(self, name: str):
+        super().__init__("perf:index:Component", name)
+
+
+config = pulumi.Config()
+count = config.get_int("count") or 1000
+
+# Register many resources at once and measure how long it takes for the engine to acknowledge all of them.
+start = time.monotonic()
+urns = [Component(f"res{i}").urn for i in range(count)]
+
+
+def report(_):
+    elapsed = time.monotonic() - start
+    rate = count / elapsed if elapsed > 0 else float("inf")
+    print(f"registered {count} resources in {elapsed:.2f}s ({rate:.0f} registrations/sec)")
+    return rate
+
+
+pulumi.export("registrations_per_second", pulumi.Output.all(*urns).apply(report))